@@ -3,28 +3,163 @@
 #include "AssimpToLuaConverter.h"
 #include "lua_converter.hpp"
 #include <iostream>
-#include <assimp/cimport.h>
+#include <assimp/Importer.hpp>
+#include <assimp/Profiler.h>
+#include <assimp/config.h>
 #include <assimp/scene.h>
 #include <assimp/postprocess.h>
 #include <iomanip>
 #include <fstream>
 #include <chrono>
+#include <cstdlib>
+#include <new>
+#include <string>
 #include <thread>
+#include <vector>
 
 using namespace std;
 using namespace Assimp;
 using namespace AssimpToLua;
 
+// Counts every allocation of the process, including the ones of assimp, for the profile.
+// Only switched on for --profile/--trace, before any worker thread exists.
+static Profiling::AllocationCounters allocationCounters;
+static bool countAllocations = false;
+
+void* operator new(size_t size)
+{
+	if (countAllocations) {
+		allocationCounters.count.fetch_add(1, memory_order_relaxed);
+		allocationCounters.bytes.fetch_add(size, memory_order_relaxed);
+	}
+	void* ptr = malloc(size ? size : 1);
+	if (!ptr) throw bad_alloc();
+	return ptr;
+}
+
+void operator delete(void* ptr) noexcept
+{
+	free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept
+{
+	free(ptr);
+}
+
+static void usage()
+{
+	cerr << "usage: AssimpToLuaConverter [input [output]] [--profile file.json] [--trace file.json] [--bake] [--bake-rate fps] [--skin] [--quantize] [--compact] [--split] [--extract-textures]" << endl
+		<< "  --profile  write the timings of the import steps as JSON" << endl
+		<< "  --trace    write the timings in the Chrome trace format (chrome://tracing, Perfetto)" << endl
+		<< "  --bake     resample node animations into uniform frames, at the ticks per second of each animation" << endl
+		<< "  --bake-rate  like --bake, but sampled at the given frames per second" << endl
+		<< "  --skin     write packed bone influences, the bone palette and inverse bind matrices of skinned meshes" << endl
+		<< "  --quantize write vertex streams as 16 bit positions and uvs, octahedral normals and 8 bit colors," << endl
+		<< "             baked rotations as 48 bit smallest-three values" << endl
+		<< "  --compact  write every string once into a table at the top and use short field keys" << endl
+		<< "  --split    write meshes, materials, textures and animations to their own files next to output," << endl
+		<< "             output becomes a manifest listing them" << endl
+		<< "  --extract-textures  write embedded textures as image files next to output instead of inlining them" << endl;
+}
+
 int main(int argc, char **argv)
 {
-	ofstream outfile;
-	outfile.open("temp.lua");
-	auto scene = aiImportFile("animation_with_skeleton.fbx", aiProcessPreset_TargetRealtime_Fast);
-	outfile << setprecision(15);
-	outfile << "return ";
-	convert(outfile, scene);
-	outfile << endl;
-	outfile.flush();
-	outfile.close();
+	string input = "animation_with_skeleton.fbx";
+	string output = "temp.lua";
+	string profileFile, traceFile;
+	Options options;
+	bool split = false, extractTextures = false;
+	vector<string> files;
+	for (int i = 1; i < argc; i++) {
+		string arg = argv[i];
+		if ((arg == "--profile" || arg == "--trace") && i + 1 < argc) {
+			(arg == "--profile" ? profileFile : traceFile) = argv[++i];
+		} else if (arg == "--bake") {
+			options.bake_animations = true;
+		} else if (arg == "--extract-textures") {
+			extractTextures = true;
+		} else if (arg == "--split") {
+			split = true;
+		} else if (arg == "--compact") {
+			options.compact = true;
+		} else if (arg == "--quantize") {
+			options.quantize = true;
+		} else if (arg == "--skin") {
+			options.skinning = true;
+		} else if (arg == "--bake-rate" && i + 1 < argc) {
+			options.bake_animations = true;
+			options.bake_rate = atof(argv[++i]);
+			if (!(options.bake_rate > 0.0)) {
+				usage();
+				return 1;
+			}
+		} else if (!arg.empty() && arg[0] == '-') {
+			usage();
+			return 1;
+		} else {
+			files.push_back(arg);
+		}
+	}
+	if (files.size() > 2) {
+		usage();
+		return 1;
+	}
+	if (files.size() > 0) input = files[0];
+	if (files.size() > 1) output = files[1];
+	// the parts and images are named after the output, without its extension
+	const size_t dot = output.find_last_of('.');
+	const size_t slash = output.find_last_of("/\\");
+	const string base = (dot != string::npos && (slash == string::npos || dot > slash)) ? output.substr(0, dot) : output;
+	if (split) options.split_path = base;
+	if (extractTextures) options.texture_path = base;
+
+	Importer importer;
+	const bool profile = !profileFile.empty() || !traceFile.empty();
+	if (profile) {
+		countAllocations = true;
+		importer.SetPropertyInteger(AI_CONFIG_GLOB_MEASURE_TIME, 1);
+		importer.SetPropertyPointer(AI_CONFIG_GLOB_MEASURE_ALLOCATIONS, &allocationCounters);
+	}
+	unsigned int flags = aiProcessPreset_TargetRealtime_Fast;
+	if (options.skinning) {
+		importer.SetPropertyInteger(AI_CONFIG_PP_LBW_PACK_INFLUENCES, 4);
+		flags |= aiProcess_LimitBoneWeights;
+	}
+	if (options.quantize) {
+		flags |= aiProcess_GenBoundingBoxes;
+	}
+	auto scene = importer.ReadFile(input, flags);
+	if (!scene) {
+		cerr << importer.GetErrorString() << endl;
+		return 1;
+	}
+
+	Profiling::Profiler* profiler = importer.GetProfiler();
+	{
+		Profiling::ProfileScope scope(profiler, "lua", scene);
+		ofstream outfile;
+		outfile.open(output);
+		outfile << setprecision(15);
+		try {
+			convert_file(outfile, scene, options);
+		} catch (const exception& e) {
+			cerr << e.what() << endl;
+			return 1;
+		}
+		outfile.flush();
+		outfile.close();
+	}
+
+	if (profiler) {
+		if (!profileFile.empty()) {
+			ofstream out(profileFile);
+			profiler->ExportJSON(out);
+		}
+		if (!traceFile.empty()) {
+			ofstream out(traceFile);
+			profiler->ExportChromeTrace(out);
+		}
+	}
 	return 0;
 }
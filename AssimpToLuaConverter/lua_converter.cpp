@@ -1,6 +1,14 @@
 #include "lua_converter.hpp"
 
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <functional>
 #include <iomanip>
+#include <sstream>
+#include <stdexcept>
 #include <unordered_map>
 #include <vector>
 
@@ -8,32 +16,362 @@ using namespace std;
 
 static const char *NL = "\n";
 
+// Schema of the short field keys written by Options::compact. Keys of metadata
+// and material tables are data, not fields, and are never shortened.
+static const pair<const char *, const char *> compact_keys[] = {
+    {"aabb", "bb"},
+    {"allow_shared", "as"},
+    {"anim_meshes", "am"},
+    {"animations", "A"},
+    {"baked", "bk"},
+    {"bitangents", "bt"},
+    {"bone_indices", "bi"},
+    {"bones", "b"},
+    {"channel_count", "cn"},
+    {"children", "c"},
+    {"color_channels", "cc"},
+    {"components", "cp"},
+    {"data", "d"},
+    {"data_length", "dl"},
+    {"duration", "du"},
+    {"face_size", "fs"},
+    {"face_sizes", "fz"},
+    {"faces", "f"},
+    {"file", "fi"},
+    {"filename", "fn"},
+    {"flags", "fl"},
+    {"format", "fm"},
+    {"fps", "tp"},
+    {"frame_count", "fc"},
+    {"height", "h"},
+    {"incomplete", "ic"},
+    {"index", "ix"},
+    {"index_size", "xs"},
+    {"indices", "id"},
+    {"influence_count", "ni"},
+    {"inverse_bind", "ib"},
+    {"keys", "k"},
+    {"line", "ln"},
+    {"material_index", "mi"},
+    {"materials", "M"},
+    {"matrix", "mx"},
+    {"max", "hi"},
+    {"mesh_anims", "ma"},
+    {"mesh_name", "mn"},
+    {"meshes", "m"},
+    {"metadata", "md"},
+    {"min", "lo"},
+    {"morph_mesh_anims", "mo"},
+    {"morph_method", "mm"},
+    {"name", "n"},
+    {"ngon_encoded", "ng"},
+    {"node_anims", "na"},
+    {"node_name", "nd"},
+    {"node_names", "nn"},
+    {"nodes", "N"},
+    {"nonverbose", "nv"},
+    {"normals", "nr"},
+    {"offset", "o"},
+    {"palette", "pl"},
+    {"parent", "p"},
+    {"point", "pt"},
+    {"polygon", "pg"},
+    {"position_keys", "pk"},
+    {"position_offset", "po"},
+    {"position_scale", "pc"},
+    {"position_times", "pi"},
+    {"positions", "ps"},
+    {"post_state", "st"},
+    {"pre_state", "sp"},
+    {"primitives", "pr"},
+    {"quantization", "q"},
+    {"rate", "r"},
+    {"rotation_keys", "rk"},
+    {"rotation_times", "ri"},
+    {"rotations", "rs"},
+    {"scale_keys", "sk"},
+    {"scale_times", "si"},
+    {"scales", "ss"},
+    {"skeletons", "K"},
+    {"size", "sz"},
+    {"skin", "sn"},
+    {"tangents", "tg"},
+    {"terrain", "te"},
+    {"texture_coords", "uv"},
+    {"texture_type", "tt"},
+    {"textures", "T"},
+    {"times", "ti"},
+    {"transform", "t"},
+    {"triangle", "tr"},
+    {"type", "ty"},
+    {"uv_offsets", "uo"},
+    {"uv_scales", "us"},
+    {"validated", "va"},
+    {"value_keys", "vk"},
+    {"vertex_ids", "vi"},
+    {"vertices", "v"},
+    {"warning", "wa"},
+    {"weight_idxs", "wi"},
+    {"weight_keys", "wk"},
+    {"weights", "w"},
+    {"width", "wd"},
+};
+
+// Emitter state of a stream in compact mode, reachable through pword so the
+// convert overloads keep their signatures
+struct CompactState {
+    unordered_map<string, size_t> string_indices;
+    vector<const string *> strings;
+    unordered_map<string, const char *> short_keys;
+};
+
+static int compact_state_slot() {
+    static const int slot = std::ios_base::xalloc();
+    return slot;
+}
+
+static CompactState *compact_state(std::ostream &os) {
+    return static_cast<CompactState *>(os.pword(compact_state_slot()));
+}
+
+// A field key followed by '=', shortened in compact mode
+struct Key {
+    const char *name;
+};
+
+static inline Key key(const char *name) {
+    return Key{name};
+}
+
+static std::ostream &operator<<(std::ostream &os, Key k) {
+    if (CompactState *state = compact_state(os)) {
+        auto it = state->short_keys.find(k.name);
+        if (it != state->short_keys.end()) {
+            return os << it->second << '=';
+        }
+    }
+    return os << k.name << '=';
+}
+
 static inline const char *b2str(bool b) {
     return b ? "true" : "false";
 }
 
+static bool is_little_endian_host() {
+    const uint16_t probe = 1;
+    unsigned char first;
+    memcpy(&first, &probe, 1);
+    return first == 1;
+}
+
+// Writes the bytes of a Lua string body. Only the bytes the lexer or a text mode stream
+// would alter are escaped, always with three digits so a following digit is safe. The
+// runs between them are written in one piece.
+static void write_escaped(std::ostream &os, const unsigned char *bytes, size_t size) {
+    size_t run = 0;
+    for (size_t i = 0; i < size; i++) {
+        const unsigned char c = bytes[i];
+        if (c == '"' || c == '\\' || c == '\n' || c == '\r' || c == 0 || c == 26) {
+            os.write((const char *)bytes + run, i - run);
+            const char escape[5] = {'\\', char('0' + c / 100), char('0' + c / 10 % 10), char('0' + c % 10), 0};
+            os << escape;
+            run = i + 1;
+        }
+    }
+    os.write((const char *)bytes + run, size - run);
+}
+
+// Writes raw bytes as a quoted Lua string, escaped by write_escaped().
+// Elements wider than a byte are written little endian, swapped on big endian hosts.
+static void write_blob(std::ostream &os, const void *data, size_t size, size_t element_size = 1) {
+    const unsigned char *bytes = (const unsigned char *)data;
+    vector<unsigned char> swapped;
+    if (element_size > 1 && !is_little_endian_host()) {
+        swapped.assign(bytes, bytes + size);
+        for (size_t i = 0; i + element_size <= size; i += element_size) {
+            std::reverse(swapped.begin() + i, swapped.begin() + i + element_size);
+        }
+        bytes = swapped.data();
+    }
+    os << '"';
+    write_escaped(os, bytes, size);
+    os << '"';
+}
+
+// Octahedral encoding of a unit vector as two snorm16 values
+static void oct_encode(const aiVector3D &v, int16_t out[2]) {
+    const float l1 = std::fabs(v.x) + std::fabs(v.y) + std::fabs(v.z);
+    float x = 0.0f, y = 0.0f;
+    if (l1 > 0.0f) {
+        x = v.x / l1;
+        y = v.y / l1;
+        if (v.z < 0.0f) {
+            const float ox = x;
+            x = (1.0f - std::fabs(y)) * (x >= 0.0f ? 1.0f : -1.0f);
+            y = (1.0f - std::fabs(ox)) * (y >= 0.0f ? 1.0f : -1.0f);
+        }
+    }
+    out[0] = (int16_t)std::lround(std::min(std::max(x, -1.0f), 1.0f) * 32767.0f);
+    out[1] = (int16_t)std::lround(std::min(std::max(y, -1.0f), 1.0f) * 32767.0f);
+}
+
+// Smallest-three encoding of a rotation in the low 48 bits, the same layout as
+// ReduceAnimationKeysProcess::EncodeQuaternion48: 2 bits for the index of the largest
+// of x, y, z, w, then 15 bits for each of the other three in [-1/sqrt(2), 1/sqrt(2)].
+// The largest component is restored as sqrt(1 - sum of squares) and is always positive.
+static uint64_t encode_quaternion48(aiQuaternion q) {
+    static const double range = 0.70710678118654752;
+    q.Normalize();
+    const double c[4] = {q.x, q.y, q.z, q.w};
+    unsigned int largest = 0;
+    for (unsigned int i = 1; i < 4; i++) {
+        if (std::fabs(c[i]) > std::fabs(c[largest])) {
+            largest = i;
+        }
+    }
+    const double sign = c[largest] < 0.0 ? -1.0 : 1.0;
+    uint64_t bits = largest;
+    for (unsigned int i = 0; i < 4; i++) {
+        if (i != largest) {
+            const double t = (c[i] * sign + range) / (2.0 * range) * 32767.0;
+            bits = (bits << 15) | (uint64_t)std::lround(std::min(std::max(t, 0.0), 32767.0));
+        }
+    }
+    return bits;
+}
+
+// Maps value from [offset, offset + 65535 * scale] to unorm16
+static uint16_t quantize16(float value, float offset, float scale) {
+    const float q = scale > 0.0f ? (value - offset) / scale : 0.0f;
+    return (uint16_t)std::lround(std::min(std::max(q, 0.0f), 65535.0f));
+}
+
+static uint8_t quantize8(float value) {
+    return (uint8_t)std::lround(std::min(std::max(value, 0.0f), 1.0f) * 255.0f);
+}
+
+// Per axis offset and step that map [min, max] to unorm16
+static void quantization_range(const aiVector3D &min, const aiVector3D &max, aiVector3D &offset, aiVector3D &scale) {
+    offset = min;
+    scale = (max - min) / 65535.0f;
+}
+
+// Samples a key track at increasing times. The cursor only moves forward,
+// so sampling a whole track costs O(keys + frames).
+template <class KeyType, class ValueType, class Interpolate>
+static ValueType sample_track(const KeyType *keys, unsigned int num_keys, double time, unsigned int &cursor,
+        const ValueType &fallback, Interpolate interpolate) {
+    if (num_keys == 0) {
+        return fallback;
+    }
+    while (cursor + 1 < num_keys && keys[cursor + 1].mTime <= time) {
+        cursor++;
+    }
+    if (cursor + 1 >= num_keys || time <= keys[cursor].mTime) {
+        return keys[cursor].mValue;
+    }
+    const KeyType &a = keys[cursor], &b = keys[cursor + 1];
+    const float factor = (float)((time - a.mTime) / (b.mTime - a.mTime));
+    return interpolate(a.mValue, b.mValue, factor);
+}
+
 namespace AssimpToLua {
 
+static void convert_mesh_fields(std::ostream &os, const aiMesh *mesh, bool quantize);
+
 void convert(std::ostream &os, const string &str) {
-    os << quoted(str);
+    CompactState *state = compact_state(os);
+    if (state == nullptr) {
+        os << quoted(str);
+        return;
+    }
+    auto inserted = state->string_indices.emplace(str, state->strings.size() + 1);
+    if (inserted.second) {
+        state->strings.push_back(&inserted.first->first);
+    }
+    os << "S[" << inserted.first->second << ']';
+}
+
+
+// Writes "return <body>", with the string table in front of it in compact mode
+static void convert_chunk(std::ostream &os, const Options &options, const function<void(std::ostream &)> &body) {
+    if (!options.compact) {
+        os << "return ";
+        body(os);
+        os << NL;
+        return;
+    }
+    // the body goes first into a buffer, the string table it collects is written in front of it
+    CompactState state;
+    for (const auto &k : compact_keys) {
+        state.short_keys.emplace(k.first, k.second);
+    }
+    stringstream buffer;
+    buffer.copyfmt(os);
+    buffer.pword(compact_state_slot()) = &state;
+    body(buffer);
+    buffer.pword(compact_state_slot()) = nullptr;
+
+    os << "local S={" << NL;
+    for (const string *str : state.strings) {
+        os << quoted(*str) << ',' << NL;
+    }
+    os << '}' << NL;
+    os << "return ";
+    os << buffer.rdbuf();
+    os << NL;
+}
+
+// Writes an asset in place, or in split mode into its own chunk file and a
+// manifest entry {file=; size=; name=} in place
+static void convert_part(std::ostream &os, const Options &options, const char *kind, unsigned int index,
+        const string &name, const function<void(std::ostream &)> &body) {
+    if (options.split_path.empty()) {
+        body(os);
+        return;
+    }
+    const string path = options.split_path + '.' + kind + to_string(index) + ".lua";
+    ofstream part(path, ios::binary);
+    if (!part) {
+        throw runtime_error("cannot open " + path);
+    }
+    part.precision(os.precision());
+    convert_chunk(part, options, body);
+    const auto size = (long long)part.tellp();
+    part.close();
+
+    const size_t slash = path.find_last_of("/\\");
+    os << '{' << NL;
+    os << key("file");
+    convert(os, slash == string::npos ? path : path.substr(slash + 1));
+    os << ';' << NL;
+    os << key("size") << size << ';' << NL;
+    os << key("name");
+    convert(os, name);
+    os << ';' << NL;
+    os << '}';
+}
+
+void convert_file(std::ostream &os, const aiScene *scene, const Options &options) {
+    convert_chunk(os, options, [&](std::ostream &out) { convert(out, scene, options); });
 }
 
-void convert(std::ostream &os, const aiScene *scene) {
+void convert(std::ostream &os, const aiScene *scene, const Options &options) {
     os << "{" << NL;
 
-    os << "name=";
+    os << key("name");
     convert(os, scene->mName.C_Str());
     os << ';' << NL;
 
     // flags
     unsigned int flags = scene->mFlags;
-    os << "flags={" << NL;
-    os << "incomplete=" << b2str((flags & AI_SCENE_FLAGS_INCOMPLETE) != 0) << ';' << NL;
-    os << "validated=" << b2str((flags & AI_SCENE_FLAGS_VALIDATED) != 0) << ';' << NL;
-    os << "warning=" << b2str((flags & AI_SCENE_FLAGS_VALIDATION_WARNING) != 0) << ';' << NL;
-    os << "nonverbose=" << b2str((flags & AI_SCENE_FLAGS_NON_VERBOSE_FORMAT) != 0) << ';' << NL;
-    os << "terrain=" << b2str((flags & AI_SCENE_FLAGS_TERRAIN) != 0) << ';' << NL;
-    os << "allow_shared=" << b2str((flags & AI_SCENE_FLAGS_ALLOW_SHARED) != 0) << ';' << NL;
+    os << key("flags") << '{' << NL;
+    os << key("incomplete") << b2str((flags & AI_SCENE_FLAGS_INCOMPLETE) != 0) << ';' << NL;
+    os << key("validated") << b2str((flags & AI_SCENE_FLAGS_VALIDATED) != 0) << ';' << NL;
+    os << key("warning") << b2str((flags & AI_SCENE_FLAGS_VALIDATION_WARNING) != 0) << ';' << NL;
+    os << key("nonverbose") << b2str((flags & AI_SCENE_FLAGS_NON_VERBOSE_FORMAT) != 0) << ';' << NL;
+    os << key("terrain") << b2str((flags & AI_SCENE_FLAGS_TERRAIN) != 0) << ';' << NL;
+    os << key("allow_shared") << b2str((flags & AI_SCENE_FLAGS_ALLOW_SHARED) != 0) << ';' << NL;
     os << "};" << NL;
     os.flush();
 
@@ -43,41 +381,43 @@ void convert(std::ostream &os, const aiScene *scene) {
     size_t nodestack_i = 0;
     vector<const aiNode *> nodelist;  // used as stack
     unordered_map<const aiNode *, size_t> node_indices;
+    unordered_map<string, size_t> node_indices_by_name;
 
     nodelist.push_back(scene->mRootNode);
     while (nodestack_i < nodelist.size()) {
         const aiNode *current = nodelist[nodestack_i];
         node_indices[current] = nodestack_i;
+        node_indices_by_name.emplace(current->mName.C_Str(), nodestack_i);
         for (unsigned int i = 0; i < current->mNumChildren; i++) {
             nodelist.push_back(current->mChildren[i]);
         }
         nodestack_i += 1;
     }
     
-    os << "nodes={";
+    os << key("nodes") << '{';
     for (const aiNode *node : nodelist) {
         os << '{' << NL;
-        os << "name=";
+        os << key("name");
         convert(os, node->mName.C_Str());
         os << ';' << NL;
-        os << "transform=";
+        os << key("transform");
         convert(os, &node->mTransformation);
         os << ';' << NL;
         if (node->mMetaData != nullptr) {
-            os << "metadata=";
+            os << key("metadata");
             convert(os, node->mMetaData);
             os << ';' << NL;
         }
-        os << "meshes={";
+        os << key("meshes") << '{';
         for (unsigned int i = 0; i < node->mNumMeshes; i++) {
             unsigned int idx = node->mMeshes[i];
             os << idx << ", ";
         }
         os << "};" << NL;
         if (node->mParent != nullptr) {
-            os << "parent=" << node_indices.at(node->mParent) << ';' << NL;
+            os << key("parent") << node_indices.at(node->mParent) << ';' << NL;
         }
-        os << "children={";
+        os << key("children") << '{';
         for (unsigned int i = 0; i < node->mNumChildren; i++) {
             const aiNode *child = node->mChildren[i];
             os << node_indices.at(child) << ", ";
@@ -89,33 +429,51 @@ void convert(std::ostream &os, const aiScene *scene) {
     os << "};" << NL;
 
     // meshes
-    os << "meshes={" << NL;
+    os << key("meshes") << '{' << NL;
     for (unsigned int i = 0; i < scene->mNumMeshes; i++) {
         auto mesh = scene->mMeshes[i];
-        convert(os, mesh);
+        auto write_mesh = [&](std::ostream &out) {
+            out << '{' << NL;
+            convert_mesh_fields(out, mesh, options.quantize);
+            if (options.skinning && mesh->mSkinInfluences != nullptr) {
+                out << key("skin");
+                convert_skin(out, mesh, node_indices_by_name);
+                out << ';' << NL;
+            }
+            out << '}';
+        };
+        convert_part(os, options, "mesh", i, mesh->mName.C_Str(), write_mesh);
         os << ',' << NL;
     }
     os << "};" << NL;
     os.flush();
     // material
-    os << "materials={" << NL;
+    os << key("materials") << '{' << NL;
     for (unsigned int i = 0; i < scene->mNumMaterials; i++) {
         auto mat = scene->mMaterials[i];
-        convert(os, mat);
+        aiString name;
+        mat->Get(AI_MATKEY_NAME, name);
+        convert_part(os, options, "material", i, name.C_Str(), [&](std::ostream &out) { convert(out, mat); });
         os << ',' << NL;
     }
     os << "};" << NL;
     os.flush();
     // textures
-    os << "textures={" << NL;
+    os << key("textures") << '{' << NL;
     for (unsigned int i = 0; i < scene->mNumTextures; i++) {
-        convert(os, scene->mTextures[i]);
+        auto texture = scene->mTextures[i];
+        if (!options.texture_path.empty()) {
+            convert(os, texture, options.texture_path + ".texture" + to_string(i));
+            os << ',' << NL;
+            continue;
+        }
+        convert_part(os, options, "texture", i, texture->mFilename.C_Str(), [&](std::ostream &out) { convert(out, texture); });
         os << ',' << NL;
     }
     os << "};" << NL;
     os.flush();
     // skeletons
-    os << "skeletons={" << NL;
+    os << key("skeletons") << '{' << NL;
     for (unsigned int i = 0; i < scene->mNumSkeletons; i++) {
         convert(os, scene->mSkeletons[i]);
         os << ';' << NL;
@@ -123,9 +481,16 @@ void convert(std::ostream &os, const aiScene *scene) {
     os << "};" << NL;
     os.flush();
     // animation
-    os << "animations={" << NL;
+    os << key("animations") << '{' << NL;
     for (unsigned int i = 0; i < scene->mNumAnimations; i++) {
-        convert(os, scene->mAnimations[i]);
+        auto anim = scene->mAnimations[i];
+        convert_part(os, options, "animation", i, anim->mName.C_Str(), [&](std::ostream &out) {
+            if (options.bake_animations) {
+                convert_baked(out, anim, options.bake_rate, options.quantize);
+            } else {
+                convert(out, anim);
+            }
+        });
         os << ';' << NL;
     }
     os << "};" << NL;
@@ -135,7 +500,7 @@ void convert(std::ostream &os, const aiScene *scene) {
     // cameras
 
     // metadata
-    os << "metadata=";
+    os << key("metadata");
     convert(os, scene->mMetaData);
     os << ';' << NL;
 
@@ -143,54 +508,324 @@ void convert(std::ostream &os, const aiScene *scene) {
     os.flush();
 }
 
-void convert(std::ostream &os, const aiMesh *mesh) {
+static void convert_octahedral(std::ostream &os, Key name, const aiVector3D *vectors, unsigned int count) {
+    vector<int16_t> encoded((size_t)count * 2);
+    for (unsigned int i = 0; i < count; i++) {
+        oct_encode(vectors[i], &encoded[(size_t)i * 2]);
+    }
+    os << name;
+    write_blob(os, encoded.data(), encoded.size() * sizeof(int16_t), sizeof(int16_t));
+    os << ';' << NL;
+}
+
+template <typename Index>
+static void write_faces_blob(std::ostream &os, const aiMesh *mesh, bool uniform) {
+    vector<Index> indices, sizes;
+    indices.reserve((size_t)mesh->mNumFaces * 3);
+    for (unsigned int i = 0; i < mesh->mNumFaces; i++) {
+        const aiFace &face = mesh->mFaces[i];
+        indices.insert(indices.end(), face.mIndices, face.mIndices + face.mNumIndices);
+        if (!uniform) {
+            sizes.push_back((Index)face.mNumIndices);
+        }
+    }
+    if (!uniform) {
+        os << key("face_sizes");
+        write_blob(os, sizes.data(), sizes.size() * sizeof(Index), sizeof(Index));
+        os << ';' << NL;
+    }
+    os << key("indices");
+    write_blob(os, indices.data(), indices.size() * sizeof(Index), sizeof(Index));
+    os << ';' << NL;
+}
+
+// Writes the faces as one little endian blob of the smallest index type that
+// fits the vertex count: uint8, uint16 or uint32. face_size is the index count of
+// every face, or 0 if they differ and face_sizes lists them in the index type.
+static void convert_quantized_faces(std::ostream &os, const aiMesh *mesh) {
+    unsigned int face_size = mesh->mNumFaces > 0 ? mesh->mFaces[0].mNumIndices : 0;
+    unsigned int max_face_size = 0;
+    for (unsigned int i = 0; i < mesh->mNumFaces; i++) {
+        const unsigned int n = mesh->mFaces[i].mNumIndices;
+        max_face_size = std::max(max_face_size, n);
+        if (n != face_size) {
+            face_size = 0;
+        }
+    }
+    unsigned int index_size = 4;
+    if (mesh->mNumVertices <= 0x100 && max_face_size <= 0xff) {
+        index_size = 1;
+    } else if (mesh->mNumVertices <= 0x10000 && max_face_size <= 0xffff) {
+        index_size = 2;
+    }
+
+    os << key("faces") << '{' << NL;
+    os << key("index_size") << index_size << ';' << NL;
+    os << key("face_size") << face_size << ';' << NL;
+    const bool uniform = face_size != 0 || mesh->mNumFaces == 0;
+    if (index_size == 1) {
+        write_faces_blob<uint8_t>(os, mesh, uniform);
+    } else if (index_size == 2) {
+        write_faces_blob<uint16_t>(os, mesh, uniform);
+    } else {
+        write_faces_blob<uint32_t>(os, mesh, uniform);
+    }
+    os << "};" << NL;
+}
+
+// Writes the vertex streams as little endian blobs: positions and uvs as unorm16
+// in the range given by the quantization table, normals, tangents and bitangents
+// octahedral encoded as two snorm16, colors as unorm8. XMesh is the mesh or one of
+// its morph targets, the uv and color channels and uv components follow the mesh.
+template <class XMesh>
+static void convert_quantized_streams(std::ostream &os, const XMesh *mesh, const aiMesh *base, aiAABB aabb) {
+    const unsigned int count = mesh->mNumVertices;
+    const bool has_positions = mesh->mVertices != nullptr;
+
+    if (aabb.mMin == aabb.mMax && count > 0 && has_positions) {
+        // aiProcess_GenBoundingBoxes did not run, or this is a morph target
+        aabb.mMin = aabb.mMax = mesh->mVertices[0];
+        for (unsigned int i = 1; i < count; i++) {
+            aabb.mMin.x = std::min(aabb.mMin.x, mesh->mVertices[i].x);
+            aabb.mMin.y = std::min(aabb.mMin.y, mesh->mVertices[i].y);
+            aabb.mMin.z = std::min(aabb.mMin.z, mesh->mVertices[i].z);
+            aabb.mMax.x = std::max(aabb.mMax.x, mesh->mVertices[i].x);
+            aabb.mMax.y = std::max(aabb.mMax.y, mesh->mVertices[i].y);
+            aabb.mMax.z = std::max(aabb.mMax.z, mesh->mVertices[i].z);
+        }
+    }
+    aiVector3D offset, scale;
+    quantization_range(aabb.mMin, aabb.mMax, offset, scale);
+
+    // value = offset + quantized * scale
+    os << key("quantization") << '{' << NL;
+    if (has_positions) {
+        os << key("position_offset");
+        convert(os, &offset);
+        os << ';' << NL;
+        os << key("position_scale");
+        convert(os, &scale);
+        os << ';' << NL;
+    }
+
+    vector<uint16_t> positions(has_positions ? (size_t)count * 3 : 0);
+    for (unsigned int i = 0; i < positions.size() / 3; i++) {
+        const aiVector3D &v = mesh->mVertices[i];
+        positions[(size_t)i * 3 + 0] = quantize16(v.x, offset.x, scale.x);
+        positions[(size_t)i * 3 + 1] = quantize16(v.y, offset.y, scale.y);
+        positions[(size_t)i * 3 + 2] = quantize16(v.z, offset.z, scale.z);
+    }
+
+    // uv ranges, one per channel
+    vector<vector<uint16_t>> uvs;
+    os << key("uv_offsets") << '{';
+    vector<aiVector3D> uv_scales;
+    for (unsigned int c = 0; c < base->GetNumUVChannels(); c++) {
+        const aiVector3D *uv = mesh->mTextureCoords[c];
+        if (uv == nullptr || count == 0) {
+            os << "false, ";
+            uv_scales.emplace_back();
+            uvs.emplace_back();
+            continue;
+        }
+        aiVector3D min = uv[0], max = uv[0];
+        for (unsigned int i = 1; i < count; i++) {
+            min.x = std::min(min.x, uv[i].x);
+            min.y = std::min(min.y, uv[i].y);
+            min.z = std::min(min.z, uv[i].z);
+            max.x = std::max(max.x, uv[i].x);
+            max.y = std::max(max.y, uv[i].y);
+            max.z = std::max(max.z, uv[i].z);
+        }
+        aiVector3D uv_offset, uv_scale;
+        quantization_range(min, max, uv_offset, uv_scale);
+        convert(os, &uv_offset);
+        os << ", ";
+        uv_scales.push_back(uv_scale);
+
+        const unsigned int components = base->mNumUVComponents[c];
+        vector<uint16_t> encoded((size_t)count * components);
+        for (unsigned int i = 0; i < count; i++) {
+            for (unsigned int k = 0; k < components; k++) {
+                encoded[(size_t)i * components + k] = quantize16(uv[i][k], uv_offset[k], uv_scale[k]);
+            }
+        }
+        uvs.push_back(std::move(encoded));
+    }
+    os << "};" << NL;
+    os << key("uv_scales") << '{';
+    for (unsigned int c = 0; c < uv_scales.size(); c++) {
+        if (mesh->mTextureCoords[c] == nullptr || count == 0) {
+            os << "false, ";
+        } else {
+            convert(os, &uv_scales[c]);
+            os << ", ";
+        }
+    }
+    os << "};" << NL;
+    os << "};" << NL;
+
+    if (mesh->mNormals != nullptr) {
+        convert_octahedral(os, key("normals"), mesh->mNormals, count);
+    }
+    if (mesh->mTangents != nullptr) {
+        convert_octahedral(os, key("tangents"), mesh->mTangents, count);
+    }
+    if (mesh->mBitangents != nullptr) {
+        convert_octahedral(os, key("bitangents"), mesh->mBitangents, count);
+    }
+
+    if (base->GetNumUVChannels() > 0) {
+        os << key("texture_coords") << '{' << NL;
+        for (unsigned int c = 0; c < base->GetNumUVChannels(); c++) {
+            if (uvs[c].empty()) {
+                os << "false," << NL;
+                continue;
+            }
+            os << '{' << NL;
+            os << key("name");
+            convert(os, base->HasTextureCoordsName(c) ? base->GetTextureCoordsName(c)->C_Str() : "");
+            os << ';' << NL;
+            os << key("components") << base->mNumUVComponents[c] << ';' << NL;
+            os << key("data");
+            write_blob(os, uvs[c].data(), uvs[c].size() * sizeof(uint16_t), sizeof(uint16_t));
+            os << ';' << NL;
+            os << "}," << NL;
+        }
+        os << "};" << NL;
+    }
+
+    if (base->GetNumColorChannels() > 0) {
+        os << key("color_channels") << '{' << NL;
+        for (unsigned int c = 0; c < base->GetNumColorChannels(); c++) {
+            const aiColor4D *col = mesh->mColors[c];
+            if (col == nullptr) {
+                os << "false," << NL;
+                continue;
+            }
+            vector<uint8_t> encoded((size_t)count * 4);
+            for (unsigned int i = 0; i < count; i++) {
+                encoded[(size_t)i * 4 + 0] = quantize8(col[i].r);
+                encoded[(size_t)i * 4 + 1] = quantize8(col[i].g);
+                encoded[(size_t)i * 4 + 2] = quantize8(col[i].b);
+                encoded[(size_t)i * 4 + 3] = quantize8(col[i].a);
+            }
+            write_blob(os, encoded.data(), encoded.size());
+            os << ',' << NL;
+        }
+        os << "};" << NL;
+    }
+
+    if (has_positions) {
+        os << key("vertices");
+        write_blob(os, positions.data(), positions.size() * sizeof(uint16_t), sizeof(uint16_t));
+        os << ';' << NL;
+    }
+}
+
+// Writes a morph target like its mesh, with a position range of its own
+static void convert_quantized_anim_mesh(std::ostream &os, const aiAnimMesh *anim_mesh, const aiMesh *mesh) {
     os << '{' << NL;
-    os << "name=";
+    os << key("name");
+    convert(os, anim_mesh->mName.C_Str());
+    os << ";" << NL;
+    convert_quantized_streams(os, anim_mesh, mesh, aiAABB());
+    os << '}';
+}
+
+// Writes the weights of a bone as little endian blobs: the vertex ids in the smallest
+// index type that fits the vertex count, index_size bytes each, and the weights as unorm16
+static void convert_quantized_bone(std::ostream &os, const aiBone *bone, unsigned int num_vertices) {
+    const unsigned int index_size = num_vertices <= 0x100 ? 1 : (num_vertices <= 0x10000 ? 2 : 4);
+    vector<uint8_t> ids((size_t)bone->mNumWeights * index_size);
+    vector<uint16_t> weights(bone->mNumWeights);
+    for (unsigned int i = 0; i < bone->mNumWeights; i++) {
+        const unsigned int id = bone->mWeights[i].mVertexId;
+        if (index_size == 1) {
+            ids[i] = (uint8_t)id;
+        } else if (index_size == 2) {
+            const uint16_t id16 = (uint16_t)id;
+            memcpy(&ids[(size_t)i * 2], &id16, 2);
+        } else {
+            memcpy(&ids[(size_t)i * 4], &id, 4);
+        }
+        weights[i] = quantize16(bone->mWeights[i].mWeight, 0.0f, 1.0f / 65535.0f);
+    }
+
+    os << '{' << NL;
+    os << key("name");
+    convert(os, bone->mName.C_Str());
+    os << ';' << NL;
+    os << key("offset");
+    convert(os, &bone->mOffsetMatrix);
+    os << ';' << NL;
+    os << key("index_size") << index_size << ';' << NL;
+    os << key("weight_idxs");
+    write_blob(os, ids.data(), ids.size(), index_size);
+    os << ';' << NL;
+    os << key("weights");
+    write_blob(os, weights.data(), weights.size() * sizeof(uint16_t), sizeof(uint16_t));
+    os << ';' << NL;
+    os << '}';
+}
+
+
+
+static void convert_mesh_fields(std::ostream &os, const aiMesh *mesh, bool quantize) {
+    os << key("name");
     convert(os, mesh->mName.C_Str());
     os << ";" << NL;
 
-    os << "aabb=";
+    os << key("aabb");
     convert(os, &mesh->mAABB);
     os << ";" << NL;
 
-    os << "primitives={" << NL;
+    os << key("primitives") << '{' << NL;
     if ((mesh->mPrimitiveTypes & aiPrimitiveType_POINT) != 0) {
-        os << "point=true;" << NL;
+        os << key("point") << "true;" << NL;
     }
     if ((mesh->mPrimitiveTypes & aiPrimitiveType_LINE) != 0) {
-        os << "line=true;" << NL;
+        os << key("line") << "true;" << NL;
     }
     if ((mesh->mPrimitiveTypes & aiPrimitiveType_TRIANGLE) != 0) {
-        os << "triangle=true;" << NL;
+        os << key("triangle") << "true;" << NL;
     }
     if ((mesh->mPrimitiveTypes & aiPrimitiveType_POLYGON) != 0) {
-        os << "polygon=true;" << NL;
+        os << key("polygon") << "true;" << NL;
     }
     if ((mesh->mPrimitiveTypes & aiPrimitiveType_NGONEncodingFlag) != 0) {
-        os << "ngon_encoded=true;" << NL;
+        os << key("ngon_encoded") << "true;" << NL;
     }
     os << "};" << NL;
 
     if (mesh->mNumAnimMeshes > 0) {
-        os << "anim_meshes={" << NL;
+        os << key("anim_meshes") << '{' << NL;
         for (unsigned int i = 0; i < mesh->mNumAnimMeshes; i++) {
-            convert(os, mesh->mAnimMeshes[i]);
+            if (quantize) {
+                convert_quantized_anim_mesh(os, mesh->mAnimMeshes[i], mesh);
+            } else {
+                convert(os, mesh->mAnimMeshes[i]);
+            }
             os << ',' << NL;
         }
         os << "};" << NL;
     }
 
     if (mesh->mNumBones > 0) {
-        os << "bones={" << NL;
+        os << key("bones") << '{' << NL;
         for (unsigned int i = 0; i < mesh->mNumBones; i++) {
-            convert(os, mesh->mBones[i]);
+            if (quantize) {
+                convert_quantized_bone(os, mesh->mBones[i], mesh->mNumVertices);
+            } else {
+                convert(os, mesh->mBones[i]);
+            }
             os << ',' << NL;
         }
         os << "};" << NL;
     }
 
-    if (mesh->mColors != nullptr) {
-        os << "color_channels={" << NL;
+    if (mesh->mColors != nullptr && !quantize) {
+        os << key("color_channels") << '{' << NL;
         for (unsigned int i = 0; i < mesh->GetNumColorChannels(); i++) {
             if (mesh->HasVertexColors(i)) {
                 os << '{' << NL;
@@ -207,18 +842,27 @@ void convert(std::ostream &os, const aiMesh *mesh) {
         os << "};" << NL;
     }
 
-    os << "faces={" << NL;
-    for (unsigned int i = 0; i < mesh->mNumFaces; i++) {
-        convert(os, &mesh->mFaces[i]);
-        os << ',' << NL;
+    if (quantize) {
+        convert_quantized_faces(os, mesh);
+    } else {
+        os << key("faces") << '{' << NL;
+        for (unsigned int i = 0; i < mesh->mNumFaces; i++) {
+            convert(os, &mesh->mFaces[i]);
+            os << ',' << NL;
+        }
+        os << "};" << NL;
     }
-    os << "};" << NL;
 
-    os << "material_index=" << mesh->mMaterialIndex << ';' << NL;
-    os << "morph_method=" << mesh->mMethod << ';' << NL;
+    os << key("material_index") << mesh->mMaterialIndex << ';' << NL;
+    os << key("morph_method") << mesh->mMethod << ';' << NL;
+
+    if (quantize) {
+        convert_quantized_streams(os, mesh, mesh, mesh->mAABB);
+        return;
+    }
 
     if (mesh->mNormals != nullptr) {
-        os << "normals={" << NL;
+        os << key("normals") << '{' << NL;
         for (unsigned int i = 0; i < mesh->mNumVertices; i++) {
             convert(os, &mesh->mNormals[i]);
             os << ',' << NL;
@@ -227,7 +871,7 @@ void convert(std::ostream &os, const aiMesh *mesh) {
     }
 
     if (mesh->mTangents != nullptr) {
-        os << "tangents={" << NL;
+        os << key("tangents") << '{' << NL;
         for (unsigned int i = 0; i < mesh->mNumVertices; i++) {
             convert(os, &mesh->mTangents[i]);
             os << ',' << NL;
@@ -236,7 +880,7 @@ void convert(std::ostream &os, const aiMesh *mesh) {
     }
 
     if (mesh->mBitangents != nullptr) {
-        os << "bitangents={" << NL;
+        os << key("bitangents") << '{' << NL;
         for (unsigned int i = 0; i < mesh->mNumVertices; i++) {
             convert(os, &mesh->mBitangents[i]);
             os << ',' << NL;
@@ -245,11 +889,11 @@ void convert(std::ostream &os, const aiMesh *mesh) {
     }
 
     if (mesh->mTextureCoords != nullptr) {
-        os << "texture_coords={" << NL;
+        os << key("texture_coords") << '{' << NL;
         for (unsigned int i = 0; i < mesh->GetNumUVChannels(); i++) {
             if (mesh->HasTextureCoords(i)) {
                 os << '{' << NL;
-                os << "name=";
+                os << key("name");
                 convert(os, mesh->mTextureCoordsNames[i]->C_Str());
                 os << ';' << NL;
                 auto uv_array = mesh->mTextureCoords[i];
@@ -265,13 +909,55 @@ void convert(std::ostream &os, const aiMesh *mesh) {
         os << "};" << NL;
     }
 
-    os << "vertices={" << NL;
+    os << key("vertices") << '{' << NL;
     for (unsigned int i = 0; i < mesh->mNumVertices; i++) {
         convert(os, &mesh->mVertices[i]);
         os << ',' << NL;
     }
     os << "};" << NL;
+}
 
+void convert(std::ostream &os, const aiMesh *mesh) {
+    os << '{' << NL;
+    convert_mesh_fields(os, mesh, false);
+    os << '}';
+}
+
+void convert_skin(std::ostream &os, const aiMesh *mesh, const unordered_map<string, size_t> &node_indices) {
+    const aiSkinInfluences *influences = mesh->mSkinInfluences;
+    const size_t num_slots = (size_t)mesh->mNumVertices * influences->mNumInfluences;
+    os << '{' << NL;
+    os << key("influence_count") << influences->mNumInfluences << ';' << NL;
+    // per vertex, little endian indices into the palette (uint8 or uint16) and unorm16 weights adding up to 65535
+    os << key("index_size") << influences->mIndexSize << ';' << NL;
+    os << key("bone_indices");
+    write_blob(os, influences->mBoneIndices, num_slots * influences->mIndexSize, influences->mIndexSize);
+    os << ';' << NL;
+    os << key("weights");
+    write_blob(os, influences->mWeights, num_slots * sizeof(unsigned short), sizeof(unsigned short));
+    os << ';' << NL;
+    // node index of every bone, -1 if no node has the name of the bone
+    os << key("palette") << '{';
+    for (unsigned int i = 0; i < mesh->mNumBones; i++) {
+        auto it = node_indices.find(mesh->mBones[i]->mName.C_Str());
+        if (it != node_indices.end()) {
+            os << it->second << ", ";
+        } else {
+            os << "-1, ";
+        }
+    }
+    os << "};" << NL;
+    // float32 row major, 16 per bone in palette order
+    vector<float> inverse_bind((size_t)mesh->mNumBones * 16);
+    for (unsigned int i = 0; i < mesh->mNumBones; i++) {
+        const aiMatrix4x4 &m = mesh->mBones[i]->mOffsetMatrix;
+        for (unsigned int j = 0; j < 16; j++) {
+            inverse_bind[i * 16 + j] = m[j / 4][j % 4];
+        }
+    }
+    os << key("inverse_bind");
+    write_blob(os, inverse_bind.data(), inverse_bind.size() * sizeof(float), sizeof(float));
+    os << ';' << NL;
     os << '}';
 }
 
@@ -285,12 +971,12 @@ void convert(std::ostream &os, const aiFace *face) {
 
 void convert(std::ostream &os, const aiAnimMesh *mesh) {
     os << '{' << NL;
-    os << "name=";
+    os << key("name");
     convert(os, mesh->mName.C_Str());
     os << ";" << NL;
 
     if (mesh->mColors != nullptr) {
-        os << "color_channels={" << NL;
+        os << key("color_channels") << '{' << NL;
         for (unsigned int i = 0; i < AI_MAX_NUMBER_OF_COLOR_SETS; i++) {
             if (mesh->HasVertexColors(i)) {
                 os << '{' << NL;
@@ -308,7 +994,7 @@ void convert(std::ostream &os, const aiAnimMesh *mesh) {
     }
 
     if (mesh->mNormals != nullptr) {
-        os << "normals={" << NL;
+        os << key("normals") << '{' << NL;
         for (unsigned int i = 0; i < mesh->mNumVertices; i++) {
             convert(os, &mesh->mNormals[i]);
             os << ',' << NL;
@@ -317,7 +1003,7 @@ void convert(std::ostream &os, const aiAnimMesh *mesh) {
     }
 
     if (mesh->mTangents != nullptr) {
-        os << "tangents={" << NL;
+        os << key("tangents") << '{' << NL;
         for (unsigned int i = 0; i < mesh->mNumVertices; i++) {
             convert(os, &mesh->mTangents[i]);
             os << ',' << NL;
@@ -326,7 +1012,7 @@ void convert(std::ostream &os, const aiAnimMesh *mesh) {
     }
 
     if (mesh->mBitangents != nullptr) {
-        os << "bitangents={" << NL;
+        os << key("bitangents") << '{' << NL;
         for (unsigned int i = 0; i < mesh->mNumVertices; i++) {
             convert(os, &mesh->mBitangents[i]);
             os << ',' << NL;
@@ -335,7 +1021,7 @@ void convert(std::ostream &os, const aiAnimMesh *mesh) {
     }
 
     if (mesh->mTextureCoords != nullptr) {
-        os << "texture_coords={" << NL;
+        os << key("texture_coords") << '{' << NL;
         for (unsigned int i = 0; i < AI_MAX_NUMBER_OF_TEXTURECOORDS; i++) {
             if (mesh->HasTextureCoords(i)) {
                 os << '{' << NL;
@@ -352,7 +1038,7 @@ void convert(std::ostream &os, const aiAnimMesh *mesh) {
         os << "};" << NL;
     }
     if (mesh->mVertices != nullptr) {
-        os << "vertices={" << NL;
+        os << key("vertices") << '{' << NL;
         for (unsigned int i = 0; i < mesh->mNumVertices; i++) {
             convert(os, &mesh->mVertices[i]);
             os << ',' << NL;
@@ -365,23 +1051,23 @@ void convert(std::ostream &os, const aiAnimMesh *mesh) {
 
 void convert(std::ostream &os, const aiAABB *aabb) {
     os << '{' << NL;
-    os << "min={" << aabb->mMin.x << ", " << aabb->mMin.y << ", " << aabb->mMin.z << "};" << NL;
-    os << "max={" << aabb->mMax.x << ", " << aabb->mMax.y << ", " << aabb->mMax.z << "};" << NL;
+    os << key("min") << '{' << aabb->mMin.x << ", " << aabb->mMin.y << ", " << aabb->mMin.z << "};" << NL;
+    os << key("max") << '{' << aabb->mMax.x << ", " << aabb->mMax.y << ", " << aabb->mMax.z << "};" << NL;
     os << '}';
 }
 
 void convert(std::ostream &os, const aiNode *node) {
     os << '{' << NL;
-    os << "name=";
+    os << key("name");
     convert(os, node->mName.C_Str());
     os << ';' << NL;
-    os << "transform=";
+    os << key("transform");
     convert(os, &node->mTransformation);
     os << ';' << NL;
-    os << "metadata=";
+    os << key("metadata");
     convert(os, node->mMetaData);
     os << ';' << NL;
-    os << "meshes={";
+    os << key("meshes") << '{';
     for (unsigned int i = 0; i < node->mNumMeshes; i++) {
         unsigned int idx = node->mMeshes[i];
         os << idx << ", ";
@@ -408,13 +1094,13 @@ void convert(std::ostream &os, const aiMaterial *mat) {
 void convert(std::ostream &os, const aiMaterialProperty *prop) {
     os << '{' << NL;
 
-    os << "name=";
+    os << key("name");
     convert(os, prop->mKey.C_Str());
     os << ';' << NL;
 
-    os << "index=" << prop->mIndex << ';' << NL;
+    os << key("index") << prop->mIndex << ';' << NL;
 
-    os << "type=";
+    os << key("type");
     switch (prop->mType) {
         case aiPropertyTypeInfo::aiPTI_Float:
         case aiPropertyTypeInfo::aiPTI_Double:
@@ -430,7 +1116,7 @@ void convert(std::ostream &os, const aiMaterialProperty *prop) {
     }
     os << ';' << NL;
 
-    os << "texture_type=";
+    os << key("texture_type");
     switch (prop->mSemantic) {
         case aiTextureType_DIFFUSE:
             convert(os, "diffuse");
@@ -502,73 +1188,239 @@ void convert(std::ostream &os, const aiMaterialProperty *prop) {
     os << ';' << NL;
 
     if (prop->mDataLength > 0) {
-        os << "data_length=" << prop->mDataLength << ';' << NL;
-        os << "data=[========[";
-        os.write(prop->mData, prop->mDataLength);
-        os << "]========];" << NL;
+        os << key("data_length") << prop->mDataLength << ';' << NL;
+        os << key("data");
+        write_blob(os, prop->mData, prop->mDataLength);
+        os << ';' << NL;
     }
 
     os << '}';
 }
 
+// Writes aiTexel (b, g, r, a) as a quoted string of r, g, b, a, escaped in chunks. The
+// loop is a plain byte shuffle over the buffer, which compilers turn into vector shuffles.
+static void write_texels_rgba(std::ostream &os, const aiTexel *texels, size_t count) {
+    static const size_t chunk_texels = 16384;
+    unsigned char rgba[chunk_texels * 4];
+    const unsigned char *bgra = (const unsigned char *)texels;
+    os << '"';
+    for (size_t first = 0; first < count; first += chunk_texels) {
+        const size_t n = std::min(chunk_texels, count - first);
+        const unsigned char *in = bgra + first * 4;
+        for (size_t i = 0; i < n * 4; i += 4) {
+            rgba[i] = in[i + 2];
+            rgba[i + 1] = in[i + 1];
+            rgba[i + 2] = in[i];
+            rgba[i + 3] = in[i + 3];
+        }
+        write_escaped(os, rgba, n * 4);
+    }
+    os << '"';
+}
+
 void convert(std::ostream &os, const aiTexture *texture) {
     os << '{' << NL;
-    os << "filename=";
+    os << key("filename");
     convert(os, texture->mFilename.C_Str());
     os << ';' << NL;
     if (texture->mHeight > 0) {
-        os << "format=";
+        os << key("format");
         convert(os, "rgba8");
         os << ';' << NL;
-        os << "width=" << texture->mWidth << ';' << NL;
-        os << "height=" << texture->mHeight << ';' << NL;
-        const unsigned int size = texture->mWidth * texture->mHeight;
-        os << "data=[========[";
-        for (unsigned int i = 0; i < size; i++) {
-            auto texel = texture->pcData[i];
-            const unsigned char pixel_rgba[4] = {texel.r, texel.g, texel.b, texel.a};
-            os.write((const char *)pixel_rgba, 4);  // send unsigned char as signed char to preserve bits
-        }
-        os << "]========];" << NL;
+        os << key("width") << texture->mWidth << ';' << NL;
+        os << key("height") << texture->mHeight << ';' << NL;
+        os << key("data");
+        write_texels_rgba(os, texture->pcData, (size_t)texture->mWidth * texture->mHeight);
+        os << ';' << NL;
     } else {
-        os << "format=";
+        os << key("format");
         convert(os, texture->achFormatHint);
         os << ';' << NL;
-        os << "data=[========[";
-        os.write((const char *)texture->pcData, texture->mWidth);
-        os << "]========];" << NL;
+        os << key("data");
+        write_blob(os, texture->pcData, texture->mWidth);
+        os << ';' << NL;
     }
     os << '}';
 }
 
-void convert(std::ostream &os, const aiAnimation *anim) {
+void convert(std::ostream &os, const aiTexture *texture, const std::string &path) {
+    const bool compressed = texture->mHeight == 0;
+    const string file = path + '.' + (compressed ? (texture->achFormatHint[0] ? texture->achFormatHint : "bin") : "tga");
+    ofstream image(file, ios::binary);
+    if (!image) {
+        throw runtime_error("cannot open " + file);
+    }
+    if (compressed) {
+        // the embedded file as it is
+        image.write((const char *)texture->pcData, texture->mWidth);
+    } else {
+        // aiTexel is laid out like 32 bit TGA pixels, so the texels go out in one write
+        if (texture->mWidth > 0xffff || texture->mHeight > 0xffff) {
+            throw runtime_error("texture too large for TGA: " + file);
+        }
+        const unsigned char header[18] = {
+            0, 0, 2, // no id, no color map, uncompressed true color
+            0, 0, 0, 0, 0,
+            0, 0, 0, 0, // origin
+            (unsigned char)(texture->mWidth & 0xff), (unsigned char)(texture->mWidth >> 8),
+            (unsigned char)(texture->mHeight & 0xff), (unsigned char)(texture->mHeight >> 8),
+            32, 0x28 // 8 alpha bits, top left origin
+        };
+        image.write((const char *)header, sizeof(header));
+        image.write((const char *)texture->pcData, (size_t)texture->mWidth * texture->mHeight * sizeof(aiTexel));
+    }
+    if (!image) {
+        throw runtime_error("cannot write " + file);
+    }
+
+    const size_t slash = file.find_last_of("/\\");
     os << '{' << NL;
-    os << "name=";
-    convert(os, anim->mName.C_Str());
+    os << key("filename");
+    convert(os, texture->mFilename.C_Str());
     os << ';' << NL;
-    os << "duration=" << anim->mDuration << ';' << NL;
-    os << "fps=" << anim->mTicksPerSecond << ';' << NL;
-    os << "node_anims={";
-    for (unsigned int i = 0; i < anim->mNumChannels; i++) {
-        auto c = anim->mChannels[i];
-        convert(os, c);
-        os << ',' << NL;
+    os << key("format");
+    convert(os, compressed ? texture->achFormatHint : "tga");
+    os << ';' << NL;
+    if (!compressed) {
+        os << key("width") << texture->mWidth << ';' << NL;
+        os << key("height") << texture->mHeight << ';' << NL;
     }
-    os << "};" << NL;
-    os << "mesh_anims={";
+    os << key("file");
+    convert(os, slash == string::npos ? file : file.substr(slash + 1));
+    os << ';' << NL;
+    os << '}';
+}
+
+static void convert_mesh_channels(std::ostream &os, const aiAnimation *anim) {
+    os << key("mesh_anims") << '{';
     for (unsigned int i = 0; i < anim->mNumMeshChannels; i++) {
         auto c = anim->mMeshChannels[i];
         convert(os, c);
         os << ',' << NL;
     }
     os << "};" << NL;
-    os << "morph_mesh_anims={";
+    os << key("morph_mesh_anims") << '{';
     for (unsigned int i = 0; i < anim->mNumMorphMeshChannels; i++) {
         auto c = anim->mMorphMeshChannels[i];
         convert(os, c);
         os << ',' << NL;
     }
     os << "};" << NL;
+}
+
+void convert(std::ostream &os, const aiAnimation *anim) {
+    os << '{' << NL;
+    os << key("name");
+    convert(os, anim->mName.C_Str());
+    os << ';' << NL;
+    os << key("duration") << anim->mDuration << ';' << NL;
+    os << key("fps") << anim->mTicksPerSecond << ';' << NL;
+    os << key("node_anims") << '{';
+    for (unsigned int i = 0; i < anim->mNumChannels; i++) {
+        auto c = anim->mChannels[i];
+        convert(os, c);
+        os << ',' << NL;
+    }
+    os << "};" << NL;
+    convert_mesh_channels(os, anim);
+    os << '}';
+}
+
+void convert_baked(std::ostream &os, const aiAnimation *anim, double rate, bool quantize) {
+    const double ticks_per_second = anim->mTicksPerSecond > 0.0 ? anim->mTicksPerSecond : 25.0;
+    if (rate <= 0.0) {
+        rate = ticks_per_second;
+    }
+    const unsigned int num_channels = anim->mNumChannels;
+    const unsigned int num_frames = (unsigned int)std::floor(anim->mDuration / ticks_per_second * rate + 1e-6) + 1;
+
+    // frame major: the values of all channels for one frame are contiguous
+    vector<float> positions((size_t)num_frames * num_channels * 3);
+    vector<float> rotations((size_t)num_frames * num_channels * 4);
+    vector<float> scales((size_t)num_frames * num_channels * 3);
+    for (unsigned int c = 0; c < num_channels; c++) {
+        const aiNodeAnim *channel = anim->mChannels[c];
+        unsigned int pos_cursor = 0, rot_cursor = 0, scale_cursor = 0;
+        aiQuaternion previous;
+        for (unsigned int f = 0; f < num_frames; f++) {
+            const double time = f * ticks_per_second / rate;
+            const size_t slot = (size_t)f * num_channels + c;
+
+            const aiVector3D pos = sample_track(channel->mPositionKeys, channel->mNumPositionKeys, time, pos_cursor,
+                    aiVector3D(), [](const aiVector3D &a, const aiVector3D &b, float t) { return a + (b - a) * t; });
+            positions[slot * 3 + 0] = pos.x;
+            positions[slot * 3 + 1] = pos.y;
+            positions[slot * 3 + 2] = pos.z;
+
+            aiQuaternion rot = sample_track(channel->mRotationKeys, channel->mNumRotationKeys, time, rot_cursor,
+                    aiQuaternion(), [](const aiQuaternion &a, const aiQuaternion &b, float t) {
+                        aiQuaternion out;
+                        aiQuaternion::Interpolate(out, a, b, t);
+                        return out.Normalize();
+                    });
+            // keep neighbouring frames in the same hemisphere so a plain lerp between them is valid
+            if (f > 0 && rot.x * previous.x + rot.y * previous.y + rot.z * previous.z + rot.w * previous.w < 0.0f) {
+                rot = aiQuaternion(-rot.w, -rot.x, -rot.y, -rot.z);
+            }
+            previous = rot;
+            rotations[slot * 4 + 0] = rot.x;
+            rotations[slot * 4 + 1] = rot.y;
+            rotations[slot * 4 + 2] = rot.z;
+            rotations[slot * 4 + 3] = rot.w;
+
+            const aiVector3D scale = sample_track(channel->mScalingKeys, channel->mNumScalingKeys, time, scale_cursor,
+                    aiVector3D(1.0f), [](const aiVector3D &a, const aiVector3D &b, float t) { return a + (b - a) * t; });
+            scales[slot * 3 + 0] = scale.x;
+            scales[slot * 3 + 1] = scale.y;
+            scales[slot * 3 + 2] = scale.z;
+        }
+    }
+
+    os << '{' << NL;
+    os << key("name");
+    convert(os, anim->mName.C_Str());
+    os << ';' << NL;
+    os << key("duration") << anim->mDuration << ';' << NL;
+    os << key("fps") << anim->mTicksPerSecond << ';' << NL;
+    os << key("baked") << '{' << NL;
+    os << key("rate") << rate << ';' << NL;
+    os << key("frame_count") << num_frames << ';' << NL;
+    os << key("channel_count") << num_channels << ';' << NL;
+    os << key("node_names") << '{';
+    for (unsigned int c = 0; c < num_channels; c++) {
+        convert(os, anim->mChannels[c]->mNodeName.C_Str());
+        os << ", ";
+    }
+    os << "};" << NL;
+    // little endian float32, frame f of channel c starts at (f * channel_count + c) * components
+    os << key("positions");
+    write_blob(os, positions.data(), positions.size() * sizeof(float), sizeof(float));
+    os << ';' << NL;
+    // rotations are 4 float32 each, or with quantization 48 bit smallest-three values,
+    // three little endian uint16 from the most significant one down
+    os << key("format");
+    convert(os, quantize ? "smallest_three48" : "float32");
+    os << ';' << NL;
+    os << key("rotations");
+    if (quantize) {
+        vector<uint16_t> packed(rotations.size() / 4 * 3);
+        for (size_t i = 0; i < rotations.size() / 4; i++) {
+            const uint64_t bits = encode_quaternion48(
+                    aiQuaternion(rotations[i * 4 + 3], rotations[i * 4 + 0], rotations[i * 4 + 1], rotations[i * 4 + 2]));
+            packed[i * 3 + 0] = (uint16_t)(bits >> 32);
+            packed[i * 3 + 1] = (uint16_t)(bits >> 16);
+            packed[i * 3 + 2] = (uint16_t)bits;
+        }
+        write_blob(os, packed.data(), packed.size() * sizeof(uint16_t), sizeof(uint16_t));
+    } else {
+        write_blob(os, rotations.data(), rotations.size() * sizeof(float), sizeof(float));
+    }
+    os << ';' << NL;
+    os << key("scales");
+    write_blob(os, scales.data(), scales.size() * sizeof(float), sizeof(float));
+    os << ';' << NL;
+    os << "};" << NL;
+    convert_mesh_channels(os, anim);
     os << '}';
 }
 
@@ -591,48 +1443,48 @@ void convert(std::ostream &os, const aiAnimBehaviour behavior) {
 
 void convert(std::ostream &os, const aiNodeAnim *anim) {
     os << '{' << NL;
-    os << "node_name=";
+    os << key("node_name");
     convert(os, anim->mNodeName.C_Str());
     os << ';' << NL;
-    os << "pre_state=";
+    os << key("pre_state");
     convert(os, anim->mPreState);
     os << ';' << NL;
-    os << "post_state=";
+    os << key("post_state");
     convert(os, anim->mPostState);
     os << ';' << NL;
-    os << "position_times={" << NL;
+    os << key("position_times") << '{' << NL;
     for (unsigned int i = 0; i < anim->mNumPositionKeys; i++) {
         auto key = anim->mPositionKeys[i];
         os << key.mTime << ',' << NL;
     }
     os << "};" << NL;
-    os << "position_keys={" << NL;
+    os << key("position_keys") << '{' << NL;
     for (unsigned int i = 0; i < anim->mNumPositionKeys; i++) {
         auto key = anim->mPositionKeys[i];
         convert(os, &key.mValue);
         os << ',' << NL;
     }
     os << "};" << NL;
-    os << "rotation_times={" << NL;
+    os << key("rotation_times") << '{' << NL;
     for (unsigned int i = 0; i < anim->mNumRotationKeys; i++) {
         auto key = anim->mRotationKeys[i];
         os << key.mTime << ',' << NL;
     }
     os << "};" << NL;
-    os << "rotation_keys={" << NL;
+    os << key("rotation_keys") << '{' << NL;
     for (unsigned int i = 0; i < anim->mNumRotationKeys; i++) {
         auto key = anim->mRotationKeys[i];
         convert(os, &key.mValue);
         os << ',' << NL;
     }
     os << "};" << NL;
-    os << "scale_times={" << NL;
+    os << key("scale_times") << '{' << NL;
     for (unsigned int i = 0; i < anim->mNumScalingKeys; i++) {
         auto key = anim->mScalingKeys[i];
         os << key.mTime << ',' << NL;
     }
     os << "};" << NL;
-    os << "scale_keys={" << NL;
+    os << key("scale_keys") << '{' << NL;
     for (unsigned int i = 0; i < anim->mNumScalingKeys; i++) {
         auto key = anim->mScalingKeys[i];
         convert(os, &key.mValue);
@@ -644,16 +1496,16 @@ void convert(std::ostream &os, const aiNodeAnim *anim) {
 
 void convert(std::ostream &os, const aiMeshAnim *anim) {
     os << '{' << NL;
-    os << "mesh_name=";
+    os << key("mesh_name");
     convert(os, anim->mName.C_Str());
     os << ';' << NL;
-    os << "times={" << NL;
+    os << key("times") << '{' << NL;
     for (unsigned int i = 0; i < anim->mNumKeys; i++) {
         auto key = anim->mKeys[i];
         os << key.mTime << ',' << NL;
     }
     os << "};" << NL;
-    os << "keys={" << NL;
+    os << key("keys") << '{' << NL;
     for (unsigned int i = 0; i < anim->mNumKeys; i++) {
         auto key = anim->mKeys[i];
         os << key.mValue << ',' << NL;
@@ -664,18 +1516,18 @@ void convert(std::ostream &os, const aiMeshAnim *anim) {
 
 void convert(std::ostream &os, const aiMeshMorphAnim *anim) {
     os << '{' << NL;
-    os << "mesh_name=";
+    os << key("mesh_name");
     convert(os, anim->mName.C_Str());
     os << ';' << NL;
-    os << "times={" << NL;
+    os << key("times") << '{' << NL;
     for (unsigned int i = 0; i < anim->mNumKeys; i++) {
-        auto key = anim->mKeys[i];
+        const auto &key = anim->mKeys[i];
         os << key.mTime << ',' << NL;
     }
     os << "};" << NL;
-    os << "value_keys={" << NL;
+    os << key("value_keys") << '{' << NL;
     for (unsigned int i = 0; i < anim->mNumKeys; i++) {
-        auto key = anim->mKeys[i];
+        const auto &key = anim->mKeys[i];
         os << '{';
         for (unsigned int j = 0; j < key.mNumValuesAndWeights; j++) {
             os << key.mValues[j] << ", ";
@@ -683,9 +1535,9 @@ void convert(std::ostream &os, const aiMeshMorphAnim *anim) {
         os << "}," << NL;
     }
     os << "};" << NL;
-    os << "weight_keys={" << NL;
+    os << key("weight_keys") << '{' << NL;
     for (unsigned int i = 0; i < anim->mNumKeys; i++) {
-        auto key = anim->mKeys[i];
+        const auto &key = anim->mKeys[i];
         os << '{';
         for (unsigned int j = 0; j < key.mNumValuesAndWeights; j++) {
             os << key.mWeights[j] << ", ";
@@ -698,10 +1550,10 @@ void convert(std::ostream &os, const aiMeshMorphAnim *anim) {
 
 void convert(std::ostream &os, const aiSkeleton *skely) {
     os << '{' << NL;
-    os << "name=";
+    os << key("name");
     convert(os, skely->mName.C_Str());
     os << ';' << NL;
-    os << "bones={" << NL;
+    os << key("bones") << '{' << NL;
     for (unsigned int i = 0; i < skely->mNumBones; i++) {
         convert(os, skely->mBones[i]);
         os << ',' << NL;
@@ -712,20 +1564,20 @@ void convert(std::ostream &os, const aiSkeleton *skely) {
 
 void convert(std::ostream &os, const aiSkeletonBone *bone) {
     os << '{' << NL;
-    os << "parent=" << bone->mParent << ';' << NL;
-    os << "matrix=";
+    os << key("parent") << bone->mParent << ';' << NL;
+    os << key("matrix");
     convert(os, &bone->mLocalMatrix);
     os << ';' << NL;
-    os << "offset=";
+    os << key("offset");
     convert(os, &bone->mOffsetMatrix);
     os << ';' << NL;
-    os << "vertex_ids={";
+    os << key("vertex_ids") << '{';
     for (unsigned int i = 0; i < bone->mNumnWeights; i++) {
         auto w = bone->mWeights[i];
         os << w.mVertexId << ", ";
     }
     os << "};" << NL;
-    os << "weights={";
+    os << key("weights") << '{';
     for (unsigned int i = 0; i < bone->mNumnWeights; i++) {
         auto w = bone->mWeights[i];
         os << w.mWeight << ", ";
@@ -740,18 +1592,18 @@ void convert(std::ostream &os, const aiSkeletonBone *bone) {
 
 void convert(std::ostream &os, const aiBone *bone) {
     os << '{' << NL;
-    os << "name=";
+    os << key("name");
     convert(os, bone->mName.C_Str());
     os << ';' << NL;
-    os << "offset=";
+    os << key("offset");
     convert(os, &bone->mOffsetMatrix);
     os << ';' << NL;
-    os << "weight_idxs={";
+    os << key("weight_idxs") << '{';
     for (unsigned int i = 0; i < bone->mNumWeights; i++) {
         os << bone->mWeights[i].mVertexId << ", ";
     }
     os << "};" << NL;
-    os << "weights={";
+    os << key("weights") << '{';
     for (unsigned int i = 0; i < bone->mNumWeights; i++) {
         os << bone->mWeights[i].mWeight << ", ";
     }
@@ -2,22 +2,54 @@
 #define LUA_CONVERTER_H
 
 #include <ostream>
+#include <string>
+#include <unordered_map>
 
 #include "assimp/scene.h"
 
 namespace AssimpToLua {
 
+// Settings that change the layout of the generated table
+struct Options {
+    // Resample node animations into uniform frames instead of writing the raw keys
+    bool bake_animations = false;
+    // Frames per second of baked animations, 0 uses the ticks per second of each animation
+    double bake_rate = 0.0;
+    // Write the packed influences, bone palette and inverse bind matrices of skinned meshes
+    bool skinning = false;
+    // Write vertex streams as quantized blobs instead of decimal text, and baked
+    // rotations as 48 bit smallest-three values
+    bool quantize = false;
+    // Intern all strings into a table S at the top of the file and write short
+    // field keys, see compact_keys in lua_converter.cpp for the schema
+    bool compact = false;
+    // When set, meshes, materials, textures and animations are written to their own
+    // chunks <split_path>.mesh0.lua etc. and the scene lists {file, size, name} for them
+    std::string split_path;
+    // When set, embedded textures are written as image files <texture_path>.texture0.png etc.,
+    // uncompressed ones as TGA, and the scene references them by file name
+    std::string texture_path;
+};
+
+// Writes a Lua chunk that returns the scene table
+void convert_file(std::ostream& os, const aiScene* scene, const Options& options = Options());
+
 void convert(std::ostream& os, const std::string& str);
-void convert(std::ostream& os, const aiScene* scene);
+void convert(std::ostream& os, const aiScene* scene, const Options& options = Options());
 void convert(std::ostream& os, const aiNode* node);
 void convert(std::ostream& os, const aiMesh* mesh);
+void convert_skin(std::ostream& os, const aiMesh* mesh, const std::unordered_map<std::string, size_t>& node_indices);
 void convert(std::ostream& os, const aiFace* face);
 void convert(std::ostream& os, const aiAnimMesh* animMesh);
 void convert(std::ostream& os, const aiAABB* aabb);
 void convert(std::ostream& os, const aiMaterial* mat);
 void convert(std::ostream& os, const aiMaterialProperty* prop);
 void convert(std::ostream& os, const aiTexture* texture);
+// Writes the texture as an image file at path plus extension and a table that references it
+void convert(std::ostream& os, const aiTexture* texture, const std::string& path);
 void convert(std::ostream& os, const aiAnimation* anim);
+// Rotations are written as 48 bit smallest-three values if quantize is set
+void convert_baked(std::ostream& os, const aiAnimation* anim, double rate, bool quantize = false);
 void convert(std::ostream& os, const aiNodeAnim* anim);
 void convert(std::ostream& os, const aiMeshAnim* anim);
 void convert(std::ostream& os, const aiMeshMorphAnim* anim);
@@ -53,6 +53,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/StringUtils.h>
 
 #include <iterator>
+#include <string_view>
+#include <unordered_set>
 
 namespace Assimp {
 
@@ -803,24 +805,35 @@ void AMFImporter::Postprocess_BuildScene(aiScene *pScene) {
     // "When multiple objects and constellations are defined in a single file, only the top level objects and constellations are available for printing."
     // What that means? For example: if some object is used in constellation then you must show only constellation but not original object.
     // And at this step we are checking that relations.
-nl_clean_loop:
-
+    //
+    // A top node is dropped if its name is found in a later top node which is kept. The names of the
+    // later nodes are collected walking backwards, so every subtree is visited once.
     if (nodeArray.size() > 1) {
-        // walk through all nodes
-        for (NodeArray::iterator nl_it = nodeArray.begin(); nl_it != nodeArray.end(); ++nl_it) {
-            // and try to find them in another top nodes.
-            NodeArray::const_iterator next_it = nl_it;
-
-            ++next_it;
-            for (; next_it != nodeArray.end(); ++next_it) {
-                if ((*next_it)->FindNode((*nl_it)->mName) != nullptr) {
-                    // if current top node(nl_it) found in another top node then erase it from node_list and restart search loop.
-                    nodeArray.erase(nl_it);
-
-                    goto nl_clean_loop;
-                }
-            } // for(; next_it != node_list.end(); next_it++)
-        } // for(std::list<aiNode*>::const_iterator nl_it = node_list.begin(); nl_it != node_list.end(); nl_it++)
+        std::unordered_set<std::string_view> laterNames;
+        std::vector<const aiNode *> stack;
+        std::vector<bool> keep(nodeArray.size(), true);
+        for (size_t i = nodeArray.size(); i-- > 0;) {
+            if (laterNames.count(std::string_view(nodeArray[i]->mName.data))) {
+                keep[i] = false;
+                continue;
+            }
+
+            stack.push_back(nodeArray[i]);
+            while (!stack.empty()) {
+                const aiNode *node = stack.back();
+                stack.pop_back();
+                laterNames.insert(std::string_view(node->mName.data));
+                stack.insert(stack.end(), node->mChildren, node->mChildren + node->mNumChildren);
+            }
+        }
+
+        size_t numKept = 0;
+        for (size_t i = 0; i < nodeArray.size(); ++i) {
+            if (keep[i]) {
+                nodeArray[numKept++] = nodeArray[i];
+            }
+        }
+        nodeArray.resize(numKept);
     }
 
     //
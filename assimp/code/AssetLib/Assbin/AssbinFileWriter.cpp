@@ -44,6 +44,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "AssbinFileWriter.h"
 #include "Common/assbin_chunks.h"
+#include "Common/ParallelFor.h"
 #include "PostProcessing/ProcessHelper.h"
 
 #include <assimp/Exceptional.h>
@@ -57,6 +58,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #endif
 
 #include <ctime>
+#include <vector>
 
 #if _MSC_VER
 #pragma warning(push)
@@ -321,6 +323,114 @@ public:
     }
 };
 
+// ----------------------------------------------------------------------------------
+/** @class  AssbinBlockCompressor
+ *  @brief  Compresses everything written to it into independent DEFLATE blocks
+ *
+ *  The data is collected until a batch of one block per worker thread is full.
+ *  The batch is compressed in parallel and appended to the container, each block
+ *  prefixed with its compressed and uncompressed size. Finish() writes the last,
+ *  partial batch and the end marker, a compressed size of 0.
+ */
+class AssbinBlockCompressor : public IOStream {
+private:
+    IOStream *container;
+    std::vector<uint8_t> pending;
+    std::vector<std::vector<uint8_t>> blocks;
+    size_t blockSize, batchSize, cursor;
+
+    // -------------------------------------------------------------------
+    void CompressBatch(const uint8_t *data, size_t size) {
+        const size_t count = (size + blockSize - 1) / blockSize;
+        ParallelFor(count, 1, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                const uLong sourceSize = static_cast<uLong>(std::min(blockSize, size - i * blockSize));
+                uLongf compressedSize = compressBound(sourceSize);
+                blocks[i].resize(compressedSize);
+                if (compress2(blocks[i].data(), &compressedSize, data + i * blockSize, sourceSize, 9) != Z_OK) {
+                    throw DeadlyExportError("Compression failed.");
+                }
+                blocks[i].resize(compressedSize);
+            }
+        });
+        for (size_t i = 0; i < count; ++i) {
+            const uint32_t sizes[2] = {
+                static_cast<uint32_t>(blocks[i].size()),
+                static_cast<uint32_t>(std::min(blockSize, size - i * blockSize))
+            };
+            container->Write(sizes, sizeof(uint32_t), 2);
+            container->Write(blocks[i].data(), sizeof(char), blocks[i].size());
+        }
+    }
+
+public:
+    explicit AssbinBlockCompressor(IOStream *container) :
+            container(container),
+            pending(),
+            blocks(GetNumWorkerThreads()),
+            blockSize(ASSBIN_COMPRESSION_BLOCK_SIZE),
+            batchSize(GetNumWorkerThreads() * ASSBIN_COMPRESSION_BLOCK_SIZE),
+            cursor(0) {
+        const uint32_t size = static_cast<uint32_t>(blockSize);
+        container->Write(&size, sizeof(uint32_t), 1);
+    }
+
+    // -------------------------------------------------------------------
+    // Compress the rest and terminate the block list
+    void Finish() {
+        if (!pending.empty()) {
+            CompressBatch(pending.data(), pending.size());
+            pending.clear();
+        }
+        const uint32_t end = 0;
+        container->Write(&end, sizeof(uint32_t), 1);
+    }
+
+    size_t Read(void * /*pvBuffer*/, size_t /*pSize*/, size_t /*pCount*/) override {
+        return 0;
+    }
+
+    aiReturn Seek(size_t /*pOffset*/, aiOrigin /*pOrigin*/) override {
+        return aiReturn_FAILURE;
+    }
+
+    size_t Tell() const override {
+        return cursor;
+    }
+
+    void Flush() override {
+        // not implemented, blocks are only written in full batches
+    }
+
+    size_t FileSize() const override {
+        return cursor;
+    }
+
+    size_t Write(const void *pvBuffer, size_t pSize, size_t pCount) override {
+        const uint8_t *data = static_cast<const uint8_t *>(pvBuffer);
+        size_t size = pSize * pCount;
+        cursor += size;
+
+        // top up a started batch first, then compress full batches straight from the input
+        if (!pending.empty()) {
+            const size_t n = std::min(size, batchSize - pending.size());
+            pending.insert(pending.end(), data, data + n);
+            data += n;
+            size -= n;
+            if (pending.size() < batchSize) {
+                return pCount;
+            }
+            CompressBatch(pending.data(), pending.size());
+            pending.clear();
+        }
+        for (; size >= batchSize; data += batchSize, size -= batchSize) {
+            CompressBatch(data, batchSize);
+        }
+        pending.assign(data, data + size);
+        return pCount;
+    }
+};
+
 // ----------------------------------------------------------------------------------
 /** @class  AssbinFileWriter
  *  @brief  Assbin file writer class
@@ -773,7 +883,7 @@ public:
             Write<unsigned int>(out, aiGetVersionRevision());
             Write<unsigned int>(out, aiGetCompileFlags());
             Write<uint16_t>(out, shortened);
-            Write<uint16_t>(out, compressed);
+            Write<uint16_t>(out, compressed ? ASSBIN_COMPRESSION_DEFLATE_BLOCKS : ASSBIN_COMPRESSION_NONE);
             // ==  20 bytes
 
             char buff[256] = { 0 };
@@ -792,26 +902,12 @@ public:
             // ==== total header size: 512 bytes
             ai_assert(out->Tell() == ASSBIN_HEADER_LENGTH);
 
-            // Up to here the data is uncompressed. For compressed files, the rest
-            // is compressed using standard DEFLATE from zlib.
+            // Up to here the data is uncompressed. For compressed files, the rest is
+            // streamed through independent blocks using standard DEFLATE from zlib.
             if (compressed) {
-                AssbinChunkWriter uncompressedStream(nullptr, 0);
-                WriteBinaryScene(&uncompressedStream, pScene);
-
-                uLongf uncompressedSize = static_cast<uLongf>(uncompressedStream.Tell());
-                uLongf compressedSize = (uLongf)compressBound(uncompressedSize);
-                uint8_t *compressedBuffer = new uint8_t[compressedSize];
-
-                int res = compress2(compressedBuffer, &compressedSize, (const Bytef *)uncompressedStream.GetBufferPointer(), uncompressedSize, 9);
-                if (res != Z_OK) {
-                    delete[] compressedBuffer;
-                    throw DeadlyExportError("Compression failed.");
-                }
-
-                out->Write(&uncompressedSize, sizeof(uint32_t), 1);
-                out->Write(compressedBuffer, sizeof(char), compressedSize);
-
-                delete[] compressedBuffer;
+                AssbinBlockCompressor compressor(out);
+                WriteBinaryScene(&compressor, pScene);
+                compressor.Finish();
             } else {
                 WriteBinaryScene(out, pScene);
             }
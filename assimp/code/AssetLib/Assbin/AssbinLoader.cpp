@@ -50,12 +50,15 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 // internal headers
 #include "AssetLib/Assbin/AssbinLoader.h"
 #include "Common/assbin_chunks.h"
+#include "Common/ParallelFor.h"
 #include <assimp/MemoryIOWrapper.h>
 #include <assimp/anim.h>
 #include <assimp/importerdesc.h>
 #include <assimp/mesh.h>
 #include <assimp/scene.h>
+#include <algorithm>
 #include <memory>
+#include <vector>
 
 #ifdef ASSIMP_BUILD_NO_OWN_ZLIB
 #include <zlib.h>
@@ -459,6 +462,7 @@ void AssbinImporter::ReadBinaryMaterial(IOStream *stream, aiMaterial *mat) {
             ReadBinaryMaterialProperty(stream, mat->mProperties[i]);
         }
     }
+    mat->InvalidatePropertyIndex();
 }
 
 // -----------------------------------------------------------------------------------
@@ -671,6 +675,120 @@ void AssbinImporter::ReadBinaryScene(IOStream *stream, aiScene *scene) {
     }
 }
 
+// -----------------------------------------------------------------------------------
+/** Reads the body of a file written in independent DEFLATE blocks. The blocks are
+ *  read from the file a batch at a time, one block per worker thread, and inflated
+ *  in parallel when the reader reaches the end of the previous batch. Only one
+ *  batch is held in memory. Seeking is supported forward only, which is all the
+ *  chunk reader needs. */
+class AssbinBlockDecompressor : public IOStream {
+public:
+    explicit AssbinBlockDecompressor(IOStream *container) :
+            mContainer(container),
+            mBlockSize(::Read<uint32_t>(container)),
+            mBatchSize(GetNumWorkerThreads()),
+            mData(),
+            mPos(0),
+            mTell(0),
+            mEnd(false) {
+        if (mBlockSize == 0 || mBlockSize > ASSBIN_COMPRESSION_MAX_BLOCK_SIZE) {
+            throw DeadlyImportError("ASSBIN: Invalid compressed block size.");
+        }
+    }
+
+    size_t Read(void *pvBuffer, size_t pSize, size_t pCount) override {
+        uint8_t *out = static_cast<uint8_t *>(pvBuffer);
+        const size_t total = pSize * pCount;
+        size_t done = 0;
+        while (done < total) {
+            if (mPos == mData.size() && !NextBatch()) {
+                break;
+            }
+            const size_t n = std::min(total - done, mData.size() - mPos);
+            if (out != nullptr) {
+                memcpy(out + done, mData.data() + mPos, n);
+            }
+            mPos += n;
+            done += n;
+        }
+        mTell += done;
+        return pSize ? done / pSize : 0;
+    }
+
+    size_t Write(const void * /*pvBuffer*/, size_t /*pSize*/, size_t /*pCount*/) override {
+        return 0;
+    }
+
+    aiReturn Seek(size_t pOffset, aiOrigin pOrigin) override {
+        if (pOrigin != aiOrigin_CUR) {
+            return aiReturn_FAILURE;
+        }
+        return Read(nullptr, 1, pOffset) == pOffset ? aiReturn_SUCCESS : aiReturn_FAILURE;
+    }
+
+    size_t Tell() const override {
+        return mTell;
+    }
+
+    size_t FileSize() const override {
+        // not known before the last block was read
+        return 0;
+    }
+
+    void Flush() override {
+        // read only
+    }
+
+private:
+    // -------------------------------------------------------------------
+    // Read the compressed blocks of the next batch and inflate them in parallel
+    bool NextBatch() {
+        std::vector<std::vector<uint8_t>> compressed;
+        std::vector<size_t> offsets;
+        size_t size = 0;
+        while (!mEnd && compressed.size() < mBatchSize) {
+            const uint32_t compressedSize = ::Read<uint32_t>(mContainer);
+            if (compressedSize == 0) {
+                mEnd = true;
+                break;
+            }
+            const uint32_t blockSize = ::Read<uint32_t>(mContainer);
+            if (blockSize == 0 || blockSize > mBlockSize || compressedSize > compressBound(blockSize)) {
+                throw DeadlyImportError("ASSBIN: Invalid compressed block layout.");
+            }
+            compressed.emplace_back(compressedSize);
+            if (mContainer->Read(compressed.back().data(), compressedSize, 1) != 1) {
+                throw DeadlyImportError("Unexpected EOF");
+            }
+            offsets.push_back(size);
+            size += blockSize;
+        }
+        offsets.push_back(size);
+
+        mData.resize(size);
+        mPos = 0;
+        ParallelFor(compressed.size(), 1, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                const uLongf expectedSize = static_cast<uLongf>(offsets[i + 1] - offsets[i]);
+                uLongf blockSize = expectedSize;
+                if (uncompress(mData.data() + offsets[i], &blockSize, compressed[i].data(), static_cast<uLong>(compressed[i].size())) != Z_OK ||
+                        blockSize != expectedSize) {
+                    throw DeadlyImportError("Zlib decompression failed.");
+                }
+            }
+        });
+        return size != 0;
+    }
+
+    IOStream *mContainer;
+    const size_t mBlockSize;
+    const size_t mBatchSize;
+    std::vector<uint8_t> mData;
+    size_t mPos;
+    size_t mTell;
+    bool mEnd;
+};
+
 // -----------------------------------------------------------------------------------
 void AssbinImporter::InternReadFile(const std::string &pFile, aiScene *pScene, IOSystem *pIOHandler) {
     IOStream *stream = pIOHandler->Open(pFile, "rb");
@@ -691,7 +809,8 @@ void AssbinImporter::InternReadFile(const std::string &pFile, aiScene *pScene, I
     /*unsigned int compileFlags =*/Read<unsigned int>(stream);
 
     shortened = Read<uint16_t>(stream) > 0;
-    compressed = Read<uint16_t>(stream) > 0;
+    const uint16_t compression = Read<uint16_t>(stream);
+    compressed = compression != ASSBIN_COMPRESSION_NONE;
 
     if (shortened)
         throw DeadlyImportError("Shortened binaries are not supported!");
@@ -700,7 +819,15 @@ void AssbinImporter::InternReadFile(const std::string &pFile, aiScene *pScene, I
     stream->Seek(128, aiOrigin_CUR); // options
     stream->Seek(64, aiOrigin_CUR); // padding
 
-    if (compressed) {
+    if (compression == ASSBIN_COMPRESSION_DEFLATE_BLOCKS) {
+        try {
+            AssbinBlockDecompressor io(stream);
+            ReadBinaryScene(&io, pScene);
+        } catch (...) {
+            pIOHandler->Close(stream);
+            throw;
+        }
+    } else if (compressed) {
         uLongf uncompressedSize = Read<uint32_t>(stream);
         uLongf compressedSize = static_cast<uLongf>(stream->FileSize() - stream->Tell());
 
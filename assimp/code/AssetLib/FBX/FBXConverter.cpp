@@ -52,6 +52,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "FBXParser.h"
 #include "FBXProperties.h"
 #include "FBXUtil.h"
+#include "Common/ParallelFor.h"
 
 #include <assimp/MathFunctions.h>
 #include <assimp/StringComparison.h>
@@ -2624,20 +2625,43 @@ void FBXConverter::ConvertAnimationStack(const AnimationStack &st) {
     }
 
     try {
+        std::vector<KeyConversion> conversions;
         for (const NodeMap::value_type &kv : node_map) {
             GenerateNodeAnimations(node_anims,
                     kv.first,
                     kv.second,
                     layer_map,
                     start_time, stop_time,
-                    max_time,
-                    min_time);
+                    conversions);
+        }
+
+        // the key conversions only read the already parsed curves, so all
+        // channels are converted in parallel
+        std::vector<double> max_times(conversions.size(), max_time);
+        std::vector<double> min_times(conversions.size(), min_time);
+        ParallelFor(conversions.size(), 4, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                conversions[i](max_times[i], min_times[i]);
+            }
+        });
+        for (size_t i = 0; i < conversions.size(); ++i) {
+            max_time = std::max(max_time, max_times[i]);
+            min_time = std::min(min_time, min_times[i]);
         }
     } catch (std::exception &) {
         std::for_each(node_anims.begin(), node_anims.end(), Util::delete_fun<aiNodeAnim>());
         throw;
     }
 
+    // drop channels which ended up without any keys
+    node_anims.erase(std::remove_if(node_anims.begin(), node_anims.end(), [](aiNodeAnim *na) {
+        if (na->mNumPositionKeys == 0 && na->mNumRotationKeys == 0 && na->mNumScalingKeys == 0) {
+            delete na;
+            return true;
+        }
+        return false;
+    }), node_anims.end());
+
     if (node_anims.size() || morphAnimDatas.size()) {
         if (node_anims.size()) {
             anim->mChannels = new aiNodeAnim *[node_anims.size()]();
@@ -2796,8 +2820,7 @@ void FBXConverter::GenerateNodeAnimations(std::vector<aiNodeAnim *> &node_anims,
         const std::vector<const AnimationCurveNode *> &curves,
         const LayerMap &layer_map,
         int64_t start, int64_t stop,
-        double &max_time,
-        double &min_time) {
+        std::vector<KeyConversion> &conversions) {
 
     NodeMap node_property_map;
     ai_assert(curves.size());
@@ -2819,6 +2842,11 @@ void FBXConverter::GenerateNodeAnimations(std::vector<aiNodeAnim *> &node_anims,
             FBXImporter::LogWarn("no animation curves assigned to AnimationCurveNode: ", node->Name());
             continue;
         }
+        for (const AnimationCurveMap::value_type &kv : node->Curves()) {
+            if (kv.first != "d|X" && kv.first != "d|Y" && kv.first != "d|Z") {
+                FBXImporter::LogWarn("ignoring animation curve, did not recognize target component");
+            }
+        }
 
         node_property_map[node->TargetProperty()].push_back(node);
     }
@@ -2876,16 +2904,11 @@ void FBXConverter::GenerateNodeAnimations(std::vector<aiNodeAnim *> &node_anims,
         aiNodeAnim* const nd = GenerateSimpleNodeAnim(fixed_name, target, chain,
                 node_property_map.end(),
                 start, stop,
-                max_time,
-                min_time
+                conversions
         );
 
         ai_assert(nd);
-        if (nd->mNumPositionKeys == 0 && nd->mNumRotationKeys == 0 && nd->mNumScalingKeys == 0) {
-            delete nd;
-        } else {
-            node_anims.push_back(nd);
-        }
+        node_anims.push_back(nd);
         return;
     }
 
@@ -2917,8 +2940,7 @@ void FBXConverter::GenerateNodeAnimations(std::vector<aiNodeAnim *> &node_anims,
                             (*chain[i]).second,
                             layer_map,
                             start, stop,
-                            max_time,
-                            min_time);
+                            conversions);
 
                     break;
 
@@ -2933,8 +2955,7 @@ void FBXConverter::GenerateNodeAnimations(std::vector<aiNodeAnim *> &node_anims,
                             (*chain[i]).second,
                             layer_map,
                             start, stop,
-                            max_time,
-                            min_time);
+                            conversions);
 
                     // pivoting requires us to generate an implicit inverse channel to undo the pivot translation
                     if (comp == TransformationComp_RotationPivot) {
@@ -2946,16 +2967,11 @@ void FBXConverter::GenerateNodeAnimations(std::vector<aiNodeAnim *> &node_anims,
                                 (*chain[i]).second,
                                 layer_map,
                                 start, stop,
-                                max_time,
-                                min_time,
+                                conversions,
                                 true);
 
                         ai_assert(inv);
-                        if (inv->mNumPositionKeys == 0 && inv->mNumRotationKeys == 0 && inv->mNumScalingKeys == 0) {
-                            delete inv;
-                        } else {
-                            node_anims.push_back(inv);
-                        }
+                        node_anims.push_back(inv);
 
                         ai_assert(TransformationComp_RotationPivotInverse > i);
                         flags |= bit << (TransformationComp_RotationPivotInverse - i);
@@ -2968,16 +2984,11 @@ void FBXConverter::GenerateNodeAnimations(std::vector<aiNodeAnim *> &node_anims,
                                 (*chain[i]).second,
                                 layer_map,
                                 start, stop,
-                                max_time,
-                                min_time,
+                                conversions,
                                 true);
 
                         ai_assert(inv);
-                        if (inv->mNumPositionKeys == 0 && inv->mNumRotationKeys == 0 && inv->mNumScalingKeys == 0) {
-                            delete inv;
-                        } else {
-                            node_anims.push_back(inv);
-                        }
+                        node_anims.push_back(inv);
 
                         ai_assert(TransformationComp_RotationPivotInverse > i);
                         flags |= bit << (TransformationComp_RotationPivotInverse - i);
@@ -2992,8 +3003,7 @@ void FBXConverter::GenerateNodeAnimations(std::vector<aiNodeAnim *> &node_anims,
                             (*chain[i]).second,
                             layer_map,
                             start, stop,
-                            max_time,
-                            min_time);
+                            conversions);
 
                     break;
 
@@ -3002,11 +3012,7 @@ void FBXConverter::GenerateNodeAnimations(std::vector<aiNodeAnim *> &node_anims,
             }
 
             ai_assert(na);
-            if (na->mNumPositionKeys == 0 && na->mNumRotationKeys == 0 && na->mNumScalingKeys == 0) {
-                delete na;
-            } else {
-                node_anims.push_back(na);
-            }
+            node_anims.push_back(na);
             continue;
         }
     }
@@ -3062,12 +3068,15 @@ aiNodeAnim *FBXConverter::GenerateRotationNodeAnim(const std::string &name,
         const std::vector<const AnimationCurveNode *> &curves,
         const LayerMap &layer_map,
         int64_t start, int64_t stop,
-        double &max_time,
-        double &min_time) {
+        std::vector<KeyConversion> &conversions) {
     std::unique_ptr<aiNodeAnim> na(new aiNodeAnim());
     na->mNodeName.Set(name);
 
-    ConvertRotationKeys(na.get(), curves, layer_map, start, stop, max_time, min_time, target.RotationOrder());
+    aiNodeAnim *const out = na.get();
+    const Model::RotOrder order = target.RotationOrder();
+    conversions.emplace_back([this, out, curves, &layer_map, start, stop, order](double &max_time, double &min_time) {
+        ConvertRotationKeys(out, curves, layer_map, start, stop, max_time, min_time, order);
+    });
 
     // dummy scaling key
     na->mScalingKeys = new aiVectorKey[1];
@@ -3091,12 +3100,14 @@ aiNodeAnim *FBXConverter::GenerateScalingNodeAnim(const std::string &name,
         const std::vector<const AnimationCurveNode *> &curves,
         const LayerMap &layer_map,
         int64_t start, int64_t stop,
-        double &max_time,
-        double &min_time) {
+        std::vector<KeyConversion> &conversions) {
     std::unique_ptr<aiNodeAnim> na(new aiNodeAnim());
     na->mNodeName.Set(name);
 
-    ConvertScaleKeys(na.get(), curves, layer_map, start, stop, max_time, min_time);
+    aiNodeAnim *const out = na.get();
+    conversions.emplace_back([this, out, curves, &layer_map, start, stop](double &max_time, double &min_time) {
+        ConvertScaleKeys(out, curves, layer_map, start, stop, max_time, min_time);
+    });
 
     // dummy rotation key
     na->mRotationKeys = new aiQuatKey[1];
@@ -3120,19 +3131,21 @@ aiNodeAnim *FBXConverter::GenerateTranslationNodeAnim(const std::string &name,
         const std::vector<const AnimationCurveNode *> &curves,
         const LayerMap &layer_map,
         int64_t start, int64_t stop,
-        double &max_time,
-        double &min_time,
+        std::vector<KeyConversion> &conversions,
         bool inverse) {
     std::unique_ptr<aiNodeAnim> na(new aiNodeAnim());
     na->mNodeName.Set(name);
 
-    ConvertTranslationKeys(na.get(), curves, layer_map, start, stop, max_time, min_time);
+    aiNodeAnim *const out = na.get();
+    conversions.emplace_back([this, out, curves, &layer_map, start, stop, inverse](double &max_time, double &min_time) {
+        ConvertTranslationKeys(out, curves, layer_map, start, stop, max_time, min_time);
 
-    if (inverse) {
-        for (unsigned int i = 0; i < na->mNumPositionKeys; ++i) {
-            na->mPositionKeys[i].mValue *= -1.0f;
+        if (inverse) {
+            for (unsigned int i = 0; i < out->mNumPositionKeys; ++i) {
+                out->mPositionKeys[i].mValue *= -1.0f;
+            }
         }
-    }
+    });
 
     // dummy scaling key
     na->mScalingKeys = new aiVectorKey[1];
@@ -3156,121 +3169,134 @@ aiNodeAnim* FBXConverter::GenerateSimpleNodeAnim(const std::string& name,
         NodeMap::const_iterator chain[TransformationComp_MAXIMUM],
         NodeMap::const_iterator iterEnd,
         int64_t start, int64_t stop,
-        double& maxTime,
-        double& minTime)
+        std::vector<KeyConversion>& conversions)
 {
     std::unique_ptr<aiNodeAnim> na(new aiNodeAnim());
     na->mNodeName.Set(name);
 
+    // properties are parsed on first access, so everything the key conversion
+    // needs from the document is read here and not on the worker threads
     const PropertyTable &props = target.Props();
+    const Model::RotOrder rotOrder = target.RotationOrder();
 
-    // collect unique times and keyframe lists
-    KeyFrameListList keyframeLists[TransformationComp_MAXIMUM];
-    KeyTimeList keytimes;
+    const aiVector3D defTranslate = PropertyGet(props, "Lcl Translation", aiVector3D(0.f, 0.f, 0.f));
+    const aiVector3D defRotation = PropertyGet(props, "Lcl Rotation", aiVector3D(0.f, 0.f, 0.f));
+    const aiVector3D defScale = PropertyGet(props, "Lcl Scaling", aiVector3D(1.f, 1.f, 1.f));
+    const aiQuaternion defQuat = EulerToQuaternion(defRotation, rotOrder);
 
-    for (size_t i = 0; i < TransformationComp_MAXIMUM; ++i) {
-        if (chain[i] == iterEnd)
-            continue;
+    bool ok = false;
 
-        if (i == TransformationComp_Rotation || i == TransformationComp_PreRotation
-                || i == TransformationComp_PostRotation || i == TransformationComp_GeometricRotation) {
-            keyframeLists[i] = GetRotationKeyframeList((*chain[i]).second, start, stop);
-        } else {
-            keyframeLists[i] = GetKeyframeList((*chain[i]).second, start, stop);
-        }
+    const auto zero_epsilon = ai_epsilon;
 
-        for (KeyFrameListList::const_iterator it = keyframeLists[i].begin(); it != keyframeLists[i].end(); ++it) {
-            const KeyTimeList& times = *std::get<0>(*it);
-            keytimes.insert(keytimes.end(), times.begin(), times.end());
-        }
+    const aiVector3D& preRotation = PropertyGet<aiVector3D>(props, "PreRotation", ok);
+    const bool hasPreRotation = ok && preRotation.SquareLength() > zero_epsilon;
+    const aiQuaternion preQuat = hasPreRotation ? EulerToQuaternion(preRotation, Model::RotOrder_EulerXYZ) : aiQuaternion();
 
-        // remove duplicates
-        std::sort(keytimes.begin(), keytimes.end());
+    const aiVector3D& postRotation = PropertyGet<aiVector3D>(props, "PostRotation", ok);
+    const bool hasPostRotation = ok && postRotation.SquareLength() > zero_epsilon;
+    const aiQuaternion postQuat = hasPostRotation ? EulerToQuaternion(postRotation, Model::RotOrder_EulerXYZ) : aiQuaternion();
 
-        auto last = std::unique(keytimes.begin(), keytimes.end());
-        keytimes.erase(last, keytimes.end());
+    std::vector<std::vector<const AnimationCurveNode *>> curves(TransformationComp_MAXIMUM);
+    for (size_t i = 0; i < TransformationComp_MAXIMUM; ++i) {
+        if (chain[i] != iterEnd) {
+            curves[i] = (*chain[i]).second;
+        }
     }
 
-    const Model::RotOrder rotOrder = target.RotationOrder();
-    const size_t keyCount = keytimes.size();
-
-    aiVector3D defTranslate = PropertyGet(props, "Lcl Translation", aiVector3D(0.f, 0.f, 0.f));
-    aiVector3D defRotation = PropertyGet(props, "Lcl Rotation", aiVector3D(0.f, 0.f, 0.f));
-    aiVector3D defScale = PropertyGet(props, "Lcl Scaling", aiVector3D(1.f, 1.f, 1.f));
-    aiQuaternion defQuat = EulerToQuaternion(defRotation, rotOrder);
+    aiNodeAnim *const out = na.get();
+    conversions.emplace_back([=](double& maxTime, double& minTime) {
+        // collect unique times and keyframe lists
+        KeyFrameListList keyframeLists[TransformationComp_MAXIMUM];
+        KeyFrameListList allKeyframeLists;
 
-    aiVectorKey* outTranslations = new aiVectorKey[keyCount];
-    aiQuatKey* outRotations = new aiQuatKey[keyCount];
-    aiVectorKey* outScales = new aiVectorKey[keyCount];
+        for (size_t i = 0; i < TransformationComp_MAXIMUM; ++i) {
+            if (curves[i].empty())
+                continue;
 
-    if (keyframeLists[TransformationComp_Translation].size() > 0) {
-        InterpolateKeys(outTranslations, keytimes, keyframeLists[TransformationComp_Translation], defTranslate, maxTime, minTime);
-    } else {
-        for (size_t i = 0; i < keyCount; ++i) {
-            outTranslations[i].mTime = CONVERT_FBX_TIME(keytimes[i]) * anim_fps;
-            outTranslations[i].mValue = defTranslate;
+            if (i == TransformationComp_Rotation || i == TransformationComp_PreRotation
+                    || i == TransformationComp_PostRotation || i == TransformationComp_GeometricRotation) {
+                keyframeLists[i] = GetRotationKeyframeList(curves[i], start, stop);
+            } else {
+                keyframeLists[i] = GetKeyframeList(curves[i], start, stop);
+            }
+            allKeyframeLists.insert(allKeyframeLists.end(), keyframeLists[i].begin(), keyframeLists[i].end());
         }
-    }
 
-    if (keyframeLists[TransformationComp_Rotation].size() > 0) {
-        InterpolateKeys(outRotations, keytimes, keyframeLists[TransformationComp_Rotation], defRotation, maxTime, minTime, rotOrder);
-    } else {
-        for (size_t i = 0; i < keyCount; ++i) {
-            outRotations[i].mTime = CONVERT_FBX_TIME(keytimes[i]) * anim_fps;
-            outRotations[i].mValue = defQuat;
+        KeyTimeList keytimes;
+        if (!allKeyframeLists.empty()) {
+            keytimes = GetKeyTimeList(allKeyframeLists);
         }
-    }
+        const size_t keyCount = keytimes.size();
 
-    if (keyframeLists[TransformationComp_Scaling].size() > 0) {
-        InterpolateKeys(outScales, keytimes, keyframeLists[TransformationComp_Scaling], defScale, maxTime, minTime);
-    } else {
-        for (size_t i = 0; i < keyCount; ++i) {
-            outScales[i].mTime = CONVERT_FBX_TIME(keytimes[i]) * anim_fps;
-            outScales[i].mValue = defScale;
+        aiVectorKey* outTranslations = new aiVectorKey[keyCount];
+        aiQuatKey* outRotations = new aiQuatKey[keyCount];
+        aiVectorKey* outScales = new aiVectorKey[keyCount];
+
+        out->mNumScalingKeys = static_cast<unsigned int>(keyCount);
+        out->mNumRotationKeys = out->mNumScalingKeys;
+        out->mNumPositionKeys = out->mNumScalingKeys;
+
+        out->mScalingKeys = outScales;
+        out->mRotationKeys = outRotations;
+        out->mPositionKeys = outTranslations;
+
+        if (keyCount == 0) {
+            return;
         }
-    }
 
-    bool ok = false;
-    
-    const auto zero_epsilon = ai_epsilon;
+        if (keyframeLists[TransformationComp_Translation].size() > 0) {
+            InterpolateKeys(outTranslations, keytimes, keyframeLists[TransformationComp_Translation], defTranslate, maxTime, minTime);
+        } else {
+            for (size_t i = 0; i < keyCount; ++i) {
+                outTranslations[i].mTime = CONVERT_FBX_TIME(keytimes[i]) * anim_fps;
+                outTranslations[i].mValue = defTranslate;
+            }
+        }
 
-    const aiVector3D& preRotation = PropertyGet<aiVector3D>(props, "PreRotation", ok);
-    if (ok && preRotation.SquareLength() > zero_epsilon) {
-        const aiQuaternion preQuat = EulerToQuaternion(preRotation, Model::RotOrder_EulerXYZ);
-        for (size_t i = 0; i < keyCount; ++i) {
-            outRotations[i].mValue = preQuat * outRotations[i].mValue;
+        if (keyframeLists[TransformationComp_Rotation].size() > 0) {
+            InterpolateKeys(outRotations, keytimes, keyframeLists[TransformationComp_Rotation], defRotation, maxTime, minTime, rotOrder);
+        } else {
+            for (size_t i = 0; i < keyCount; ++i) {
+                outRotations[i].mTime = CONVERT_FBX_TIME(keytimes[i]) * anim_fps;
+                outRotations[i].mValue = defQuat;
+            }
         }
-    }
 
-    const aiVector3D& postRotation = PropertyGet<aiVector3D>(props, "PostRotation", ok);
-    if (ok && postRotation.SquareLength() > zero_epsilon) {
-        const aiQuaternion postQuat = EulerToQuaternion(postRotation, Model::RotOrder_EulerXYZ);
-        for (size_t i = 0; i < keyCount; ++i) {
-            outRotations[i].mValue = outRotations[i].mValue * postQuat;
+        if (keyframeLists[TransformationComp_Scaling].size() > 0) {
+            InterpolateKeys(outScales, keytimes, keyframeLists[TransformationComp_Scaling], defScale, maxTime, minTime);
+        } else {
+            for (size_t i = 0; i < keyCount; ++i) {
+                outScales[i].mTime = CONVERT_FBX_TIME(keytimes[i]) * anim_fps;
+                outScales[i].mValue = defScale;
+            }
         }
-    }
 
-    // convert TRS to SRT
-    for (size_t i = 0; i < keyCount; ++i) {
-        aiQuaternion& r = outRotations[i].mValue;
-        aiVector3D& s = outScales[i].mValue;
-        aiVector3D& t = outTranslations[i].mValue;
+        if (hasPreRotation) {
+            for (size_t i = 0; i < keyCount; ++i) {
+                outRotations[i].mValue = preQuat * outRotations[i].mValue;
+            }
+        }
 
-        aiMatrix4x4 mat, temp;
-        aiMatrix4x4::Translation(t, mat);
-        mat *= aiMatrix4x4(r.GetMatrix());
-        mat *= aiMatrix4x4::Scaling(s, temp);
+        if (hasPostRotation) {
+            for (size_t i = 0; i < keyCount; ++i) {
+                outRotations[i].mValue = outRotations[i].mValue * postQuat;
+            }
+        }
 
-        mat.Decompose(s, r, t);
-    }
+        // convert TRS to SRT
+        for (size_t i = 0; i < keyCount; ++i) {
+            aiQuaternion& r = outRotations[i].mValue;
+            aiVector3D& s = outScales[i].mValue;
+            aiVector3D& t = outTranslations[i].mValue;
 
-    na->mNumScalingKeys = static_cast<unsigned int>(keyCount);
-    na->mNumRotationKeys = na->mNumScalingKeys;
-    na->mNumPositionKeys = na->mNumScalingKeys;
+            aiMatrix4x4 mat, temp;
+            aiMatrix4x4::Translation(t, mat);
+            mat *= aiMatrix4x4(r.GetMatrix());
+            mat *= aiMatrix4x4::Scaling(s, temp);
 
-    na->mScalingKeys = outScales;
-    na->mRotationKeys = outRotations;
-    na->mPositionKeys = outTranslations;
+            mat.Decompose(s, r, t);
+        }
+    });
 
     return na.release();
 }
@@ -3297,7 +3323,7 @@ FBXConverter::KeyFrameListList FBXConverter::GetKeyframeList(const std::vector<c
             } else if (kv.first == "d|Z") {
                 mapto = 2;
             } else {
-                FBXImporter::LogWarn("ignoring scale animation curve, did not recognize target component");
+                // reported by GenerateNodeAnimations()
                 continue;
             }
 
@@ -3312,10 +3338,10 @@ FBXConverter::KeyFrameListList FBXConverter::GetKeyframeList(const std::vector<c
             Keys->reserve(count);
             Values->reserve(count);
             for (size_t n = 0; n < count; n++) {
-                int64_t k = curve->GetKeys().at(n);
+                int64_t k = curve->GetKeys()[n];
                 if (k >= adj_start && k <= adj_stop) {
                     Keys->push_back(k);
-                    Values->push_back(curve->GetValues().at(n));
+                    Values->push_back(curve->GetValues()[n]);
                 }
             }
 
@@ -3348,26 +3374,29 @@ FBXConverter::KeyFrameListList FBXConverter::GetRotationKeyframeList(const std::
             } else if (kv.first == "d|Z") {
                 mapto = 2;
             } else {
-                FBXImporter::LogWarn("ignoring scale animation curve, did not recognize target component");
+                // reported by GenerateNodeAnimations()
                 continue;
             }
 
             const AnimationCurve *const curve = kv.second;
             ai_assert(curve->GetKeys().size() == curve->GetValues().size());
-            ai_assert(curve->GetKeys().size());
 
             //get values within the start/stop time window
             std::shared_ptr<KeyTimeList> Keys(new KeyTimeList());
             std::shared_ptr<KeyValueList> Values(new KeyValueList());
             const size_t count = curve->GetKeys().size();
+            if (count == 0) {
+                // an empty KeyTime array is legal, there is nothing to read
+                continue;
+            }
 
-            int64_t tp = curve->GetKeys().at(0);
-            float vp = curve->GetValues().at(0);
+            int64_t tp = curve->GetKeys()[0];
+            float vp = curve->GetValues()[0];
             Keys->push_back(tp);
             Values->push_back(vp);
             if (count > 1) {
-                int64_t tc = curve->GetKeys().at(1);
-                float vc = curve->GetValues().at(1);
+                int64_t tc = curve->GetKeys()[1];
+                float vc = curve->GetValues()[1];
                 for (size_t n = 1; n < count; n++) {
                     while (std::abs(vc - vp) >= 180.0f) {
                         double step = std::floor(double(tc - tp) / std::abs(vc - vp) * 179.0f);
@@ -3391,8 +3420,8 @@ FBXConverter::KeyFrameListList FBXConverter::GetRotationKeyframeList(const std::
                     if (n + 1 < count) {
                         tp = tc;
                         vp = vc;
-                        tc = curve->GetKeys().at(n + 1);
-                        vc = curve->GetValues().at(n + 1);
+                        tc = curve->GetKeys()[n + 1];
+                        vc = curve->GetValues()[n + 1];
                     }
                 }
             }
@@ -3417,32 +3446,41 @@ KeyTimeList FBXConverter::GetKeyTimeList(const KeyFrameListList &inputs) {
 
     keys.reserve(estimate);
 
-    std::vector<unsigned int> next_pos;
-    next_pos.resize(inputs.size(), 0);
-
-    const size_t count = inputs.size();
-    while (true) {
+    // k-way merge of the sorted lists: a min-heap holds the next key of
+    // every list, so each input key is only touched once
+    typedef std::pair<int64_t, size_t> Cursor;
+    std::vector<Cursor> heap;
+    heap.reserve(inputs.size());
 
-        int64_t min_tick = std::numeric_limits<int64_t>::max();
-        for (size_t i = 0; i < count; ++i) {
-            const KeyFrameList &kfl = inputs[i];
+    std::vector<size_t> next_pos;
+    next_pos.resize(inputs.size(), 0);
 
-            if (std::get<0>(kfl)->size() > next_pos[i] && std::get<0>(kfl)->at(next_pos[i]) < min_tick) {
-                min_tick = std::get<0>(kfl)->at(next_pos[i]);
-            }
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        const KeyTimeList &times = *std::get<0>(inputs[i]);
+        if (!times.empty()) {
+            heap.emplace_back(times[0], i);
         }
+    }
+    std::make_heap(heap.begin(), heap.end(), std::greater<Cursor>());
 
-        if (min_tick == std::numeric_limits<int64_t>::max()) {
-            break;
+    while (!heap.empty()) {
+        std::pop_heap(heap.begin(), heap.end(), std::greater<Cursor>());
+        Cursor &cursor = heap.back();
+        if (keys.empty() || keys.back() != cursor.first) {
+            keys.push_back(cursor.first);
         }
-        keys.push_back(min_tick);
 
-        for (size_t i = 0; i < count; ++i) {
-            const KeyFrameList &kfl = inputs[i];
+        const KeyTimeList &times = *std::get<0>(inputs[cursor.second]);
+        size_t &pos = next_pos[cursor.second];
+        while (pos < times.size() && times[pos] == cursor.first) {
+            ++pos;
+        }
 
-            while (std::get<0>(kfl)->size() > next_pos[i] && std::get<0>(kfl)->at(next_pos[i]) == min_tick) {
-                ++next_pos[i];
-            }
+        if (pos < times.size()) {
+            cursor.first = times[pos];
+            std::push_heap(heap.begin(), heap.end(), std::greater<Cursor>());
+        } else {
+            heap.pop_back();
         }
     }
 
@@ -3456,52 +3494,58 @@ void FBXConverter::InterpolateKeys(aiVectorKey *valOut, const KeyTimeList &keys,
     ai_assert(!keys.empty());
     ai_assert(nullptr != valOut);
 
-    std::vector<unsigned int> next_pos;
-    const size_t count(inputs.size());
+    const size_t count = keys.size();
 
-    next_pos.resize(inputs.size(), 0);
+    // interpolate one curve at a time into separate X/Y/Z streams, later
+    // curves for the same component override earlier ones
+    std::vector<ai_real> result[3];
+    result[0].assign(count, def_value.x);
+    result[1].assign(count, def_value.y);
+    result[2].assign(count, def_value.z);
 
-    for (KeyTimeList::value_type time : keys) {
-        ai_real result[3] = { def_value.x, def_value.y, def_value.z };
+    for (const KeyFrameList &kfl : inputs) {
+        const KeyTimeList &times = *std::get<0>(kfl);
+        const KeyValueList &values = *std::get<1>(kfl);
 
-        for (size_t i = 0; i < count; ++i) {
-            const KeyFrameList &kfl = inputs[i];
+        const size_t ksize = times.size();
+        if (ksize == 0) {
+            continue;
+        }
 
-            const size_t ksize = std::get<0>(kfl)->size();
-            if (ksize == 0) {
-                continue;
-            }
-            if (ksize > next_pos[i] && std::get<0>(kfl)->at(next_pos[i]) == time) {
-                ++next_pos[i];
+        // a single cursor walks the curve alongside the output keys
+        ai_real *out = result[std::get<2>(kfl)].data();
+        size_t next_pos = 0;
+        for (size_t k = 0; k < count; ++k) {
+            const KeyTimeList::value_type time = keys[k];
+            while (next_pos < ksize && times[next_pos] <= time) {
+                ++next_pos;
             }
 
-            const size_t id0 = next_pos[i] > 0 ? next_pos[i] - 1 : 0;
-            const size_t id1 = next_pos[i] == ksize ? ksize - 1 : next_pos[i];
+            const size_t id0 = next_pos > 0 ? next_pos - 1 : 0;
+            const size_t id1 = next_pos == ksize ? ksize - 1 : next_pos;
 
             // use lerp for interpolation
-            const KeyValueList::value_type valueA = std::get<1>(kfl)->at(id0);
-            const KeyValueList::value_type valueB = std::get<1>(kfl)->at(id1);
+            const KeyValueList::value_type valueA = values[id0];
+            const KeyValueList::value_type valueB = values[id1];
 
-            const KeyTimeList::value_type timeA = std::get<0>(kfl)->at(id0);
-            const KeyTimeList::value_type timeB = std::get<0>(kfl)->at(id1);
+            const KeyTimeList::value_type timeA = times[id0];
+            const KeyTimeList::value_type timeB = times[id1];
 
             const ai_real factor = timeB == timeA ? ai_real(0.) : static_cast<ai_real>((time - timeA)) / (timeB - timeA);
-            const ai_real interpValue = static_cast<ai_real>(valueA + (valueB - valueA) * factor);
-
-            result[std::get<2>(kfl)] = interpValue;
+            out[k] = static_cast<ai_real>(valueA + (valueB - valueA) * factor);
         }
+    }
 
+    for (size_t k = 0; k < count; ++k) {
         // magic value to convert fbx times to seconds
-        valOut->mTime = CONVERT_FBX_TIME(time) * anim_fps;
-
-        min_time = std::min(min_time, valOut->mTime);
-        max_time = std::max(max_time, valOut->mTime);
+        valOut[k].mTime = CONVERT_FBX_TIME(keys[k]) * anim_fps;
 
-        valOut->mValue.x = result[0];
-        valOut->mValue.y = result[1];
-        valOut->mValue.z = result[2];
+        min_time = std::min(min_time, valOut[k].mTime);
+        max_time = std::max(max_time, valOut[k].mTime);
 
-        ++valOut;
+        valOut[k].mValue.x = result[0][k];
+        valOut[k].mValue.y = result[1][k];
+        valOut[k].mValue.z = result[2][k];
     }
 }
 
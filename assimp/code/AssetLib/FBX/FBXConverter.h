@@ -59,6 +59,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/texture.h>
 #include <assimp/camera.h>
 #include <assimp/StringComparison.h>
+#include <functional>
 #include <unordered_map>
 #include <unordered_set>
 
@@ -308,6 +309,11 @@ private:
     // XXX: better use multi_map ..
     typedef std::map<std::string, std::vector<const AnimationCurveNode*> > NodeMap;
 
+    // deferred conversion of the curves of one node animation channel. It only
+    // reads already parsed curves, so the conversions of an animation stack can
+    // run in parallel. The arguments receive the time range of the keys.
+    typedef std::function<void(double& max_time, double& min_time)> KeyConversion;
+
     // ------------------------------------------------------------------------------------------------
     void ConvertAnimationStack(const AnimationStack& st);
 
@@ -321,8 +327,7 @@ private:
         const std::vector<const AnimationCurveNode*>& curves,
         const LayerMap& layer_map,
         int64_t start, int64_t stop,
-        double& max_time,
-        double& min_time);
+        std::vector<KeyConversion>& conversions);
 
     // ------------------------------------------------------------------------------------------------
     bool IsRedundantAnimationData(const Model& target,
@@ -335,8 +340,7 @@ private:
         const std::vector<const AnimationCurveNode*>& curves,
         const LayerMap& layer_map,
         int64_t start, int64_t stop,
-        double& max_time,
-        double& min_time);
+        std::vector<KeyConversion>& conversions);
 
     // ------------------------------------------------------------------------------------------------
     aiNodeAnim* GenerateScalingNodeAnim(const std::string& name,
@@ -344,8 +348,7 @@ private:
         const std::vector<const AnimationCurveNode*>& curves,
         const LayerMap& layer_map,
         int64_t start, int64_t stop,
-        double& max_time,
-        double& min_time);
+        std::vector<KeyConversion>& conversions);
 
     // ------------------------------------------------------------------------------------------------
     aiNodeAnim* GenerateTranslationNodeAnim(const std::string& name,
@@ -353,8 +356,7 @@ private:
         const std::vector<const AnimationCurveNode*>& curves,
         const LayerMap& layer_map,
         int64_t start, int64_t stop,
-        double& max_time,
-        double& min_time,
+        std::vector<KeyConversion>& conversions,
         bool inverse = false);
 
     // ------------------------------------------------------------------------------------------------
@@ -364,8 +366,7 @@ private:
         NodeMap::const_iterator chain[TransformationComp_MAXIMUM],
         NodeMap::const_iterator iterEnd,
         int64_t start, int64_t stop,
-        double& maxTime,
-        double& minTime);
+        std::vector<KeyConversion>& conversions);
 
     // key (time), value, mapto (component index)
     typedef std::tuple<std::shared_ptr<KeyTimeList>, std::shared_ptr<KeyValueList>, unsigned int > KeyFrameList;
@@ -46,6 +46,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "FBXExportProperty.h"
 #include "FBXCommon.h"
 #include "FBXUtil.h"
+#include "Common/ScenePrivate.h"
 
 #include <assimp/version.h> // aiGetVersion
 #include <assimp/IOSystem.hpp>
@@ -1901,7 +1902,7 @@ void FBXExporter::WriteObjects ()
             if (elem != node_by_bone.end()) {
                 n = elem->second;
             } else {
-                n = mScene->mRootNode->FindNode(b->mName);
+                n = FindNodeByName(mScene, b->mName);
                 if (!n) {
                     // this should never happen
                     std::stringstream err;
@@ -2357,7 +2358,7 @@ void FBXExporter::WriteObjects ()
         for (size_t nai = 0; nai < anim->mNumChannels; ++nai) {
             const aiNodeAnim* na = anim->mChannels[nai];
             // get the corresponding aiNode
-            const aiNode* node = mScene->mRootNode->FindNode(na->mNodeName);
+            const aiNode* node = FindNodeByName(mScene, na->mNodeName);
             // and its transform
             const aiMatrix4x4 node_xfm = get_world_transform(node, mScene);
             aiVector3D T, R, S;
@@ -2401,7 +2402,7 @@ void FBXExporter::WriteObjects ()
         for (size_t nai = 0; nai < anim->mNumChannels; ++nai) {
             const aiNodeAnim* na = anim->mChannels[nai];
             // get the corresponding aiNode
-            const aiNode* node = mScene->mRootNode->FindNode(na->mNodeName);
+            const aiNode* node = FindNodeByName(mScene, na->mNodeName);
             // and its transform
             const aiMatrix4x4 node_xfm = get_world_transform(node, mScene);
             aiVector3D T, R, S;
@@ -57,6 +57,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/StreamReader.h>
 #include <assimp/importerdesc.h>
 #include <assimp/Importer.hpp>
+#include <assimp/Profiler.h>
+
+#include <memory>
 
 namespace Assimp {
 
@@ -148,9 +151,12 @@ void FBXImporter::InternReadFile(const std::string &pFile, aiScene *pScene, IOSy
 	// streaming for its output data structures so the net win with
 	// streaming input data would be very low.
 	std::vector<char> contents;
-	contents.resize(stream->FileSize() + 1);
-	stream->Read(&*contents.begin(), 1, contents.size() - 1);
-	contents[contents.size() - 1] = 0;
+	{
+		Profiling::ProfileScope profile(m_profiler, "read");
+		contents.resize(stream->FileSize() + 1);
+		stream->Read(&*contents.begin(), 1, contents.size() - 1);
+		contents[contents.size() - 1] = 0;
+	}
 	const char *const begin = &*contents.begin();
 
 	// broad-phase tokenized pass in which we identify the core
@@ -159,25 +165,37 @@ void FBXImporter::InternReadFile(const std::string &pFile, aiScene *pScene, IOSy
 	try {
 
 		bool is_binary = false;
-		if (!strncmp(begin, "Kaydara FBX Binary", 18)) {
-			is_binary = true;
-			TokenizeBinary(tokens, begin, contents.size());
-		} else {
-			Tokenize(tokens, begin);
+		{
+			Profiling::ProfileScope profile(m_profiler, "tokenize");
+			if (!strncmp(begin, "Kaydara FBX Binary", 18)) {
+				is_binary = true;
+				TokenizeBinary(tokens, begin, contents.size());
+			} else {
+				Tokenize(tokens, begin);
+			}
 		}
 
-		// use this information to construct a very rudimentary
-		// parse-tree representing the FBX scope structure
-		Parser parser(tokens, is_binary);
+		std::unique_ptr<Parser> parser;
+		std::unique_ptr<Document> doc;
+		{
+			Profiling::ProfileScope profile(m_profiler, "parse");
 
-		// take the raw parse-tree and convert it to a FBX DOM
-		Document doc(parser, mSettings);
+			// use this information to construct a very rudimentary
+			// parse-tree representing the FBX scope structure
+			parser.reset(new Parser(tokens, is_binary));
+
+			// take the raw parse-tree and convert it to a FBX DOM
+			doc.reset(new Document(*parser, mSettings));
+		}
 
 		// convert the FBX DOM to aiScene
-		ConvertToAssimpScene(pScene, doc, mSettings.removeEmptyBones);
+		{
+			Profiling::ProfileScope profile(m_profiler, "convert", pScene);
+			ConvertToAssimpScene(pScene, *doc, mSettings.removeEmptyBones);
+		}
 
 		// size relative to cm
-		float size_relative_to_cm = doc.GlobalSettings().UnitScaleFactor();
+		float size_relative_to_cm = doc->GlobalSettings().UnitScaleFactor();
         if (size_relative_to_cm == 0.0) {
 			// BaseImporter later asserts that fileScale is non-zero.
 			ThrowException("The UnitScaleFactor must be non-zero");
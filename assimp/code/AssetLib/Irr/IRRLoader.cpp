@@ -598,6 +598,7 @@ void SetupMapping(aiMaterial *mat, aiTextureMapping mode, const aiVector3D &axis
 	}
 	mat->mNumProperties = (unsigned int)p.size();
 	::memcpy(mat->mProperties, &p[0], sizeof(void *) * mat->mNumProperties);
+	mat->InvalidatePropertyIndex();
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -54,6 +54,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "AssetLib/MD3/MD3Loader.h"
 #include "Common/Importer.h"
+#include "Common/ScenePrivate.h"
 
 #include <assimp/GenericProperty.h>
 #include <assimp/ParsingUtils.h>
@@ -587,7 +588,7 @@ bool MD3Importer::ReadMultipartFile() {
         attach.emplace_back(scene_lower, nd);
 
         // tag_torso
-        tag_torso = scene_lower->mRootNode->FindNode("tag_torso");
+        tag_torso = FindNodeByName(scene_lower, "tag_torso");
         if (!tag_torso) {
             ASSIMP_LOG_ERROR("M3D: Failed to find attachment tag for multi part model: tag_torso expected");
             goto error_cleanup;
@@ -596,7 +597,7 @@ bool MD3Importer::ReadMultipartFile() {
         attach.emplace_back(scene_upper, tag_torso);
 
         // tag_head
-        tag_head = scene_upper->mRootNode->FindNode("tag_head");
+        tag_head = FindNodeByName(scene_upper, "tag_head");
         if (!tag_head) {
             ASSIMP_LOG_ERROR("M3D: Failed to find attachment tag for multi part model: tag_head expected");
             goto error_cleanup;
@@ -607,8 +608,10 @@ bool MD3Importer::ReadMultipartFile() {
         // Remove tag_head and tag_torso from all other model parts ...
         // this ensures (together with AI_INT_MERGE_SCENE_GEN_UNIQUE_NAMES_IF_NECESSARY)
         // that tag_torso/tag_head is also the name of the (unique) output node
-        RemoveSingleNodeFromList(scene_upper->mRootNode->FindNode("tag_torso"));
-        RemoveSingleNodeFromList(scene_head->mRootNode->FindNode("tag_head"));
+        RemoveSingleNodeFromList(FindNodeByName(scene_upper, "tag_torso"));
+        RemoveSingleNodeFromList(FindNodeByName(scene_head, "tag_head"));
+        InvalidateNodeIndex(scene_upper);
+        InvalidateNodeIndex(scene_head);
 
         // Undo the rotations which we applied to the coordinate systems. We're
         // working in global Quake space here
@@ -52,6 +52,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/DefaultLogger.hpp>
 #include <assimp/Importer.hpp>
 #include <assimp/ObjMaterial.h>
+#include <assimp/Profiler.h>
 #include <memory>
 
 static const aiImporterDesc desc = {
@@ -78,7 +79,9 @@ using namespace std;
 ObjFileImporter::ObjFileImporter() :
         m_Buffer(),
         m_pRootObject(nullptr),
-        m_strAbsPath(std::string(1, DefaultIOSystem().getOsSeparator())) {}
+        m_strAbsPath(std::string(1, DefaultIOSystem().getOsSeparator())),
+        m_streamBufferCacheSize(4096 * 4096),
+        m_streamBufferPrefetchDepth(0) {}
 
 // ------------------------------------------------------------------------------------------------
 //  Destructor.
@@ -99,6 +102,15 @@ const aiImporterDesc *ObjFileImporter::GetInfo() const {
     return &desc;
 }
 
+// ------------------------------------------------------------------------------------------------
+//  Setup configuration properties for the loader
+void ObjFileImporter::SetupProperties(const Importer *pImp) {
+    const int cacheSize = pImp->GetPropertyInteger(AI_CONFIG_IMPORT_STREAMBUFFER_CACHE_SIZE, 0);
+    m_streamBufferCacheSize = cacheSize > 0 ? static_cast<size_t>(cacheSize) : 4096 * 4096;
+    const int prefetchDepth = pImp->GetPropertyInteger(AI_CONFIG_IMPORT_STREAMBUFFER_PREFETCH_DEPTH, 0);
+    m_streamBufferPrefetchDepth = prefetchDepth > 0 ? static_cast<size_t>(prefetchDepth) : 0;
+}
+
 // ------------------------------------------------------------------------------------------------
 //  Obj-file import implementation
 void ObjFileImporter::InternReadFile(const std::string &file, aiScene *pScene, IOSystem *pIOHandler) {
@@ -118,7 +130,7 @@ void ObjFileImporter::InternReadFile(const std::string &file, aiScene *pScene, I
         throw DeadlyImportError("OBJ-file is too small.");
     }
 
-    IOStreamBuffer<char> streamedBuffer;
+    IOStreamBuffer<char> streamedBuffer(m_streamBufferCacheSize, m_streamBufferPrefetchDepth);
     streamedBuffer.open(fileStream.get());
 
     // Allocate buffer and read file into it
@@ -137,11 +149,18 @@ void ObjFileImporter::InternReadFile(const std::string &file, aiScene *pScene, I
         modelName = file;
     }
 
-    // parse the file into a temporary representation
-    ObjFileParser parser(streamedBuffer, modelName, pIOHandler, m_progress, file);
+    // parse the file into a temporary representation, the file is read while parsing
+    std::unique_ptr<ObjFileParser> parser;
+    {
+        Profiling::ProfileScope profile(m_profiler, "parse");
+        parser.reset(new ObjFileParser(streamedBuffer, modelName, pIOHandler, m_progress, file));
+    }
 
     // And create the proper return structures out of it
-    CreateDataFromImport(parser.GetModel(), pScene);
+    {
+        Profiling::ProfileScope profile(m_profiler, "convert", pScene);
+        CreateDataFromImport(parser->GetModel(), pScene);
+    }
 
     streamedBuffer.close();
 
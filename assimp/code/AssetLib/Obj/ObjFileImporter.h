@@ -76,6 +76,9 @@ protected:
     //! \brief  Appends the supported extension.
     const aiImporterDesc *GetInfo() const override;
 
+    //! \brief  Reads the stream buffer configuration.
+    void SetupProperties(const Importer *pImp) override;
+
     //! \brief  File import implementation.
     void InternReadFile(const std::string &pFile, aiScene *pScene, IOSystem *pIOHandler) override;
 
@@ -113,6 +116,10 @@ private:
     ObjFile::Object *m_pRootObject;
     //! Absolute pathname of model in file system
     std::string m_strAbsPath;
+    //! Block size of the stream buffer
+    size_t m_streamBufferCacheSize;
+    //! Number of blocks the stream buffer reads ahead
+    size_t m_streamBufferPrefetchDepth;
 };
 
 // ------------------------------------------------------------------------------------------------
@@ -100,8 +100,8 @@ ObjFileParser::ObjFileParser(IOStreamBuffer<char> &streamBuffer, const std::stri
 ObjFileParser::~ObjFileParser() = default;
 
 void ObjFileParser::setBuffer(std::vector<char> &buffer) {
-    m_DataIt = buffer.begin();
-    m_DataItEnd = buffer.end();
+    m_DataIt = buffer.data();
+    m_DataItEnd = buffer.data() + buffer.size();
 }
 
 ObjFile::Model *ObjFileParser::GetModel() const {
@@ -117,10 +117,11 @@ void ObjFileParser::parseFile(IOStreamBuffer<char> &streamBuffer) {
     size_t lastFilePos(0);
 
     bool insideCstype = false;
-    std::vector<char> buffer;
-    while (streamBuffer.getNextDataLine(buffer, '\\')) {
-        m_DataIt = buffer.begin();
-        m_DataItEnd = buffer.end();
+    std::string_view line;
+    while (streamBuffer.getNextDataLine(line, '\\')) {
+        // the line is parsed in place, the range includes the line end following the view
+        m_DataIt = line.data();
+        m_DataItEnd = line.data() + line.size() + 1;
 
         // Handle progress reporting
         const size_t filePos(streamBuffer.getFilePos());
@@ -547,7 +548,7 @@ void ObjFileParser::getMaterialDesc() {
         return;
     }
 
-    char *pStart = &(*m_DataIt);
+    const char *pStart = &(*m_DataIt);
     while (m_DataIt != m_DataItEnd && !IsLineEnd(*m_DataIt)) {
         ++m_DataIt;
     }
@@ -611,7 +612,7 @@ void ObjFileParser::getMaterialLib() {
         return;
     }
 
-    char *pStart = &(*m_DataIt);
+    const char *pStart = &(*m_DataIt);
     while (m_DataIt != m_DataItEnd && !IsLineEnd(*m_DataIt)) {
         ++m_DataIt;
     }
@@ -671,7 +672,7 @@ void ObjFileParser::getNewMaterial() {
         return;
     }
 
-    char *pStart = &(*m_DataIt);
+    const char *pStart = &(*m_DataIt);
     std::string strMat(pStart, *m_DataIt);
     while (m_DataIt != m_DataItEnd && IsSpaceOrNewLine(*m_DataIt)) {
         ++m_DataIt;
@@ -764,7 +765,7 @@ void ObjFileParser::getObjectName() {
     if (m_DataIt == m_DataItEnd) {
         return;
     }
-    char *pStart = &(*m_DataIt);
+    const char *pStart = &(*m_DataIt);
     while (m_DataIt != m_DataItEnd && !IsSpaceOrNewLine(*m_DataIt)) {
         ++m_DataIt;
     }
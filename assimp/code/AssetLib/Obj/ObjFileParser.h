@@ -71,8 +71,8 @@ class ASSIMP_API ObjFileParser {
 public:
     static const size_t Buffersize = 4096;
     typedef std::vector<char> DataArray;
-    typedef std::vector<char>::iterator DataArrayIt;
-    typedef std::vector<char>::const_iterator ConstDataArrayIt;
+    typedef const char *DataArrayIt;
+    typedef const char *ConstDataArrayIt;
 
     /// @brief  The default constructor.
     ObjFileParser();
@@ -142,7 +142,7 @@ inline char_t getName(char_t it, char_t end, std::string &name) {
         return end;
     }
 
-    char *pStart = &(*it);
+    const char *pStart = &(*it);
     while (!isEndOfBuffer(it, end) && !IsLineEnd(*it)) {
         ++it;
     }
@@ -155,7 +155,7 @@ inline char_t getName(char_t it, char_t end, std::string &name) {
     while (&(*it) < pStart) {
         ++it;
     }
-    std::string strName(pStart, &(*it));
+    std::string strName(pStart, &(*it) - pStart);
     if (!strName.empty()) {
         name = strName;
     } 
@@ -179,7 +179,7 @@ inline char_t getNameNoSpace(char_t it, char_t end, std::string &name) {
         return end;
     }
 
-    char *pStart = &(*it);
+    const char *pStart = &(*it);
     while (!isEndOfBuffer(it, end) && !IsLineEnd(*it) && !IsSpaceOrNewLine(*it)) {
         ++it;
     }
@@ -194,7 +194,7 @@ inline char_t getNameNoSpace(char_t it, char_t end, std::string &name) {
     while (&(*it) < pStart) {
         ++it;
     }
-    std::string strName(pStart, &(*it));
+    std::string strName(pStart, &(*it) - pStart);
     if (!strName.empty()) {
         name = strName;
     }
@@ -51,6 +51,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/importerdesc.h>
 #include <assimp/scene.h>
 #include <assimp/IOSystem.hpp>
+#include <assimp/Importer.hpp>
 #include <memory>
 
 using namespace ::Assimp;
@@ -88,7 +89,9 @@ inline const T &GetProperty(const std::vector<T> &props, int idx) {
 PLYImporter::PLYImporter() :
         mBuffer(nullptr),
         pcDOM(nullptr),
-        mGeneratedMesh(nullptr) {
+        mGeneratedMesh(nullptr),
+        mStreamBufferCacheSize(1024 * 1024),
+        mStreamBufferPrefetchDepth(0) {
     // empty
 }
 
@@ -108,6 +111,15 @@ const aiImporterDesc *PLYImporter::GetInfo() const {
     return &desc;
 }
 
+// ------------------------------------------------------------------------------------------------
+// Setup configuration properties for the loader
+void PLYImporter::SetupProperties(const Importer *pImp) {
+    const int cacheSize = pImp->GetPropertyInteger(AI_CONFIG_IMPORT_STREAMBUFFER_CACHE_SIZE, 0);
+    mStreamBufferCacheSize = cacheSize > 0 ? static_cast<size_t>(cacheSize) : 1024 * 1024;
+    const int prefetchDepth = pImp->GetPropertyInteger(AI_CONFIG_IMPORT_STREAMBUFFER_PREFETCH_DEPTH, 0);
+    mStreamBufferPrefetchDepth = prefetchDepth > 0 ? static_cast<size_t>(prefetchDepth) : 0;
+}
+
 // ------------------------------------------------------------------------------------------------
 static bool isBigEndian(const char *szMe) {
     ai_assert(nullptr != szMe);
@@ -143,11 +155,11 @@ void PLYImporter::InternReadFile(const std::string &pFile, aiScene *pScene, IOSy
         throw DeadlyImportError("File ", pFile, " is empty.");
     }
 
-    IOStreamBuffer<char> streamedBuffer(1024 * 1024);
+    IOStreamBuffer<char> streamedBuffer(mStreamBufferCacheSize, mStreamBufferPrefetchDepth);
     streamedBuffer.open(fileStream.get());
 
     // the beginning of the file must be PLY - magic, magic
-    std::vector<char> headerCheck;
+    std::string_view headerCheck;
     streamedBuffer.getNextLine(headerCheck);
 
     if ((headerCheck.size() < 3) ||
@@ -158,9 +170,13 @@ void PLYImporter::InternReadFile(const std::string &pFile, aiScene *pScene, IOSy
         throw DeadlyImportError("Invalid .ply file: Incorrect magic number (expected 'ply' or 'PLY').");
     }
 
-    std::vector<char> mBuffer2;
-    streamedBuffer.getNextLine(mBuffer2);
-    mBuffer = (unsigned char *)&mBuffer2[0];
+    // the format line is parsed in place, it stays valid until the DOM reads the next line
+    std::string_view formatLine;
+    if (!streamedBuffer.getNextLine(formatLine)) {
+        streamedBuffer.close();
+        throw DeadlyImportError("Invalid .ply file: Missing format specification");
+    }
+    mBuffer = (unsigned char *)formatLine.data();
 
     char *szMe = (char *)&this->mBuffer[0];
     SkipSpacesAndLineEnd(szMe, (const char **)&szMe);
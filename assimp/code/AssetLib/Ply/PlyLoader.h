@@ -91,6 +91,13 @@ protected:
      */
     const aiImporterDesc *GetInfo() const override;
 
+    // -------------------------------------------------------------------
+    /** Called prior to ReadFile().
+    * The function is a request to the importer to update its configuration
+    * basing on the Importer's configuration property list.
+    */
+    void SetupProperties(const Importer *pImp) override;
+
     // -------------------------------------------------------------------
     /** Imports the given file into the given scene structure.
     * See BaseImporter::InternReadFile() for details
@@ -128,6 +135,10 @@ protected:
 
     /** Mesh generated by loader */
     aiMesh *mGeneratedMesh;
+
+    /** Configuration of the stream buffer */
+    size_t mStreamBufferCacheSize;
+    size_t mStreamBufferPrefetchDepth;
 };
 
 } // end of namespace Assimp
@@ -559,7 +559,9 @@ bool PLY::ElementInstanceList::ParseInstanceList(
             streamBuffer.getNextLine(buffer);
         }
     } else {
-        const char *pCur = (const char *)&buffer[0];
+        // the instance lines are parsed in place, only the line following the element is copied
+        std::string_view line(buffer.data(), buffer.size());
+        const char *pCur = line.data();
         // be sure to have enough storage
         for (unsigned int i = 0; i < pcElement->NumOccur; ++i) {
             if (p_pcOut)
@@ -581,9 +583,17 @@ bool PLY::ElementInstanceList::ParseInstanceList(
                 }
             }
 
-            streamBuffer.getNextLine(buffer);
-            pCur = (buffer.empty()) ? nullptr : (const char *)&buffer[0];
+            if (!streamBuffer.getNextLine(line)) {
+                if (i + 1 < pcElement->NumOccur) {
+                    ASSIMP_LOG_WARN("PLY: The file ends before all instances of an element were read");
+                }
+                line = std::string_view();
+                break;
+            }
+            pCur = line.data();
         }
+        buffer.assign(line.begin(), line.end());
+        buffer.push_back('\n');
     }
     return true;
 }
@@ -0,0 +1,462 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2022, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file  SceneCacheExporter.cpp
+ *  @brief Writer of the scene cache format, see SceneCacheFormat.h
+ */
+
+#ifndef ASSIMP_BUILD_NO_EXPORT
+#ifndef ASSIMP_BUILD_NO_SCENECACHE_EXPORTER
+
+#include "AssetLib/SceneCache/SceneCacheExporter.h"
+#include "AssetLib/SceneCache/SceneCacheFormat.h"
+
+#include <assimp/Exceptional.h>
+#include <assimp/IOStream.hpp>
+#include <assimp/IOSystem.hpp>
+#include <assimp/scene.h>
+
+#include <memory>
+#include <vector>
+
+namespace Assimp {
+
+using namespace SceneCache;
+
+namespace {
+
+// -----------------------------------------------------------------------------------
+/** Lays out a scene in one growing buffer. Nested data is appended before
+ *  the record referring to it, so records are always written complete. */
+class SceneCacheWriter {
+public:
+    SceneCacheWriter() :
+            mBuffer(sizeof(Header), 0) {
+        // empty
+    }
+
+    std::vector<uint8_t> &Write(const aiScene *pScene) {
+        Header header;
+        memset(&header, 0, sizeof(header));
+        memcpy(header.mMagic, Magic, sizeof(Magic));
+        header.mVersion = Version;
+        header.mByteOrderMark = ByteOrderMark;
+        header.mRealSize = sizeof(ai_real);
+        header.mFlags = pScene->mFlags;
+        header.mName = AppendString(pScene->mName);
+
+        std::vector<Node> nodes;
+        if (pScene->mRootNode) {
+            WriteNode(pScene->mRootNode, ~0u, nodes);
+        }
+        header.mNodes = AppendArray(nodes.data(), nodes.size());
+
+        std::vector<Mesh> meshes(pScene->mNumMeshes);
+        for (unsigned int i = 0; i < pScene->mNumMeshes; ++i) {
+            WriteMesh(pScene->mMeshes[i], meshes[i]);
+        }
+        header.mMeshes = AppendArray(meshes.data(), meshes.size());
+
+        std::vector<Array> materials(pScene->mNumMaterials);
+        for (unsigned int i = 0; i < pScene->mNumMaterials; ++i) {
+            materials[i] = WriteMaterial(pScene->mMaterials[i]);
+        }
+        header.mMaterials = AppendArray(materials.data(), materials.size());
+
+        std::vector<Animation> animations(pScene->mNumAnimations);
+        for (unsigned int i = 0; i < pScene->mNumAnimations; ++i) {
+            WriteAnimation(pScene->mAnimations[i], animations[i]);
+        }
+        header.mAnimations = AppendArray(animations.data(), animations.size());
+
+        std::vector<Texture> textures(pScene->mNumTextures);
+        for (unsigned int i = 0; i < pScene->mNumTextures; ++i) {
+            WriteTexture(pScene->mTextures[i], textures[i]);
+        }
+        header.mTextures = AppendArray(textures.data(), textures.size());
+
+        std::vector<Light> lights(pScene->mNumLights);
+        for (unsigned int i = 0; i < pScene->mNumLights; ++i) {
+            WriteLight(pScene->mLights[i], lights[i]);
+        }
+        header.mLights = AppendArray(lights.data(), lights.size());
+
+        std::vector<Camera> cameras(pScene->mNumCameras);
+        for (unsigned int i = 0; i < pScene->mNumCameras; ++i) {
+            WriteCamera(pScene->mCameras[i], cameras[i]);
+        }
+        header.mCameras = AppendArray(cameras.data(), cameras.size());
+
+        header.mMetadata = WriteMetadata(pScene->mMetaData);
+
+        Align();
+        header.mFileSize = mBuffer.size();
+        memcpy(mBuffer.data(), &header, sizeof(header));
+        return mBuffer;
+    }
+
+private:
+    void Align() {
+        mBuffer.resize((mBuffer.size() + Alignment - 1) / Alignment * Alignment, 0);
+    }
+
+    //! Appends count elements and returns their offset, 0 if there are none
+    template <typename T>
+    uint64_t Append(const T *data, size_t count) {
+        static_assert(std::is_trivially_copyable<T>::value, "scene cache elements must be trivially copyable");
+        if (data == nullptr || count == 0) {
+            return 0;
+        }
+        Align();
+        const uint64_t offset = mBuffer.size();
+        mBuffer.resize(offset + count * sizeof(T));
+        memcpy(mBuffer.data() + offset, data, count * sizeof(T));
+        return offset;
+    }
+
+    template <typename T>
+    Array AppendArray(const T *data, size_t count) {
+        Array array;
+        array.mOffset = Append(data, count);
+        array.mCount = array.mOffset ? count : 0;
+        return array;
+    }
+
+    String AppendString(const aiString &str) {
+        String out;
+        out.mCount = str.length;
+        out.mOffset = Append(str.data, str.length + 1);
+        return out;
+    }
+
+    static void CopyMatrix(const aiMatrix4x4 &in, ai_real *out) {
+        for (unsigned int i = 0; i < 16; ++i) {
+            out[i] = in[i / 4][i % 4];
+        }
+    }
+
+    static void CopyVector(const aiVector3D &in, ai_real *out) {
+        out[0] = in.x;
+        out[1] = in.y;
+        out[2] = in.z;
+    }
+
+    static void CopyColor(const aiColor3D &in, ai_real *out) {
+        out[0] = in.r;
+        out[1] = in.g;
+        out[2] = in.b;
+    }
+
+    Array WriteMetadata(const aiMetadata *metadata) {
+        if (metadata == nullptr) {
+            return Array();
+        }
+        std::vector<MetadataEntry> entries(metadata->mNumProperties);
+        for (unsigned int i = 0; i < metadata->mNumProperties; ++i) {
+            const aiMetadataEntry &in = metadata->mValues[i];
+            MetadataEntry &out = entries[i];
+            memset(&out, 0, sizeof(out));
+            out.mKey = AppendString(metadata->mKeys[i]);
+            out.mType = in.mType;
+            if (in.mData == nullptr) {
+                continue;
+            }
+            const uint8_t *bytes = static_cast<const uint8_t *>(in.mData);
+            switch (in.mType) {
+            case AI_BOOL:
+                out.mData = AppendArray(bytes, sizeof(bool));
+                break;
+            case AI_INT32:
+                out.mData = AppendArray(bytes, sizeof(int32_t));
+                break;
+            case AI_UINT64:
+                out.mData = AppendArray(bytes, sizeof(uint64_t));
+                break;
+            case AI_FLOAT:
+                out.mData = AppendArray(bytes, sizeof(float));
+                break;
+            case AI_DOUBLE:
+                out.mData = AppendArray(bytes, sizeof(double));
+                break;
+            case AI_AIVECTOR3D:
+                out.mData = AppendArray(bytes, sizeof(aiVector3D));
+                break;
+            case AI_AISTRING:
+                out.mData = AppendString(*static_cast<const aiString *>(in.mData));
+                break;
+            case AI_AIMETADATA:
+                out.mData = WriteMetadata(static_cast<const aiMetadata *>(in.mData));
+                break;
+            default:
+                break;
+            }
+        }
+        return AppendArray(entries.data(), entries.size());
+    }
+
+    void WriteNode(const aiNode *node, uint32_t parent, std::vector<Node> &nodes) {
+        const uint32_t index = static_cast<uint32_t>(nodes.size());
+        nodes.emplace_back();
+        Node out;
+        memset(&out, 0, sizeof(out));
+        out.mName = AppendString(node->mName);
+        CopyMatrix(node->mTransformation, out.mTransformation);
+        out.mParent = parent;
+        out.mNumChildren = node->mNumChildren;
+        out.mMeshes = AppendArray(node->mMeshes, node->mNumMeshes);
+        out.mMetadata = WriteMetadata(node->mMetaData);
+        nodes[index] = out;
+        for (unsigned int i = 0; i < node->mNumChildren; ++i) {
+            WriteNode(node->mChildren[i], index, nodes);
+        }
+    }
+
+    void WriteMesh(const aiMesh *mesh, Mesh &out) {
+        memset(&out, 0, sizeof(out));
+        out.mName = AppendString(mesh->mName);
+        out.mPrimitiveTypes = mesh->mPrimitiveTypes;
+        out.mNumVertices = mesh->mNumVertices;
+        out.mNumFaces = mesh->mNumFaces;
+        out.mMaterialIndex = mesh->mMaterialIndex;
+        out.mMethod = mesh->mMethod;
+        CopyVector(mesh->mAABB.mMin, out.mAABB);
+        CopyVector(mesh->mAABB.mMax, out.mAABB + 3);
+
+        out.mVertices = Append(mesh->mVertices, mesh->mNumVertices);
+        out.mNormals = Append(mesh->mNormals, mesh->mNumVertices);
+        out.mTangents = Append(mesh->mTangents, mesh->mNumVertices);
+        out.mBitangents = Append(mesh->mBitangents, mesh->mNumVertices);
+        for (unsigned int i = 0; i < AI_MAX_NUMBER_OF_COLOR_SETS; ++i) {
+            out.mColors[i] = Append(mesh->mColors[i], mesh->mNumVertices);
+        }
+        for (unsigned int i = 0; i < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++i) {
+            out.mTextureCoords[i] = Append(mesh->mTextureCoords[i], mesh->mNumVertices);
+            out.mNumUVComponents[i] = mesh->mNumUVComponents[i];
+            if (mesh->mTextureCoordsNames && mesh->mTextureCoordsNames[i]) {
+                out.mTextureCoordsNames[i] = AppendString(*mesh->mTextureCoordsNames[i]);
+            }
+        }
+
+        // faces as one array of sizes and one of indices
+        std::vector<uint32_t> sizes(mesh->mNumFaces);
+        size_t numIndices = 0;
+        for (unsigned int i = 0; i < mesh->mNumFaces; ++i) {
+            sizes[i] = mesh->mFaces[i].mNumIndices;
+            numIndices += sizes[i];
+        }
+        std::vector<uint32_t> indices;
+        indices.reserve(numIndices);
+        for (unsigned int i = 0; i < mesh->mNumFaces; ++i) {
+            const aiFace &face = mesh->mFaces[i];
+            indices.insert(indices.end(), face.mIndices, face.mIndices + face.mNumIndices);
+        }
+        out.mFaceSizes = Append(sizes.data(), sizes.size());
+        out.mIndices = AppendArray(indices.data(), indices.size());
+
+        std::vector<Bone> bones(mesh->mNumBones);
+        for (unsigned int i = 0; i < mesh->mNumBones; ++i) {
+            const aiBone *bone = mesh->mBones[i];
+            memset(&bones[i], 0, sizeof(Bone));
+            bones[i].mName = AppendString(bone->mName);
+            CopyMatrix(bone->mOffsetMatrix, bones[i].mOffsetMatrix);
+            bones[i].mWeights = AppendArray(bone->mWeights, bone->mNumWeights);
+        }
+        out.mBones = AppendArray(bones.data(), bones.size());
+
+        std::vector<AnimMesh> animMeshes(mesh->mNumAnimMeshes);
+        for (unsigned int i = 0; i < mesh->mNumAnimMeshes; ++i) {
+            const aiAnimMesh *in = mesh->mAnimMeshes[i];
+            AnimMesh &am = animMeshes[i];
+            memset(&am, 0, sizeof(AnimMesh));
+            am.mName = AppendString(in->mName);
+            am.mNumVertices = in->mNumVertices;
+            am.mWeight = in->mWeight;
+            am.mVertices = Append(in->mVertices, in->mNumVertices);
+            am.mNormals = Append(in->mNormals, in->mNumVertices);
+            am.mTangents = Append(in->mTangents, in->mNumVertices);
+            am.mBitangents = Append(in->mBitangents, in->mNumVertices);
+            for (unsigned int c = 0; c < AI_MAX_NUMBER_OF_COLOR_SETS; ++c) {
+                am.mColors[c] = Append(in->mColors[c], in->mNumVertices);
+            }
+            for (unsigned int c = 0; c < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++c) {
+                am.mTextureCoords[c] = Append(in->mTextureCoords[c], in->mNumVertices);
+            }
+        }
+        out.mAnimMeshes = AppendArray(animMeshes.data(), animMeshes.size());
+
+        if (const aiSkinInfluences *influences = mesh->mSkinInfluences) {
+            const size_t numSlots = static_cast<size_t>(mesh->mNumVertices) * influences->mNumInfluences;
+            out.mNumInfluences = influences->mNumInfluences;
+            out.mInfluenceIndexSize = influences->mIndexSize;
+            out.mInfluenceIndices = Append(influences->mBoneIndices, numSlots * influences->mIndexSize);
+            out.mInfluenceWeights = Append(influences->mWeights, numSlots);
+        }
+    }
+
+    Array WriteMaterial(const aiMaterial *mat) {
+        std::vector<MaterialProperty> props(mat->mNumProperties);
+        for (unsigned int i = 0; i < mat->mNumProperties; ++i) {
+            const aiMaterialProperty *in = mat->mProperties[i];
+            MaterialProperty &out = props[i];
+            memset(&out, 0, sizeof(out));
+            out.mKey = AppendString(in->mKey);
+            out.mSemantic = in->mSemantic;
+            out.mIndex = in->mIndex;
+            out.mType = in->mType;
+            out.mData = AppendArray(in->mData, in->mDataLength);
+        }
+        return AppendArray(props.data(), props.size());
+    }
+
+    void WriteAnimation(const aiAnimation *anim, Animation &out) {
+        memset(&out, 0, sizeof(out));
+        out.mName = AppendString(anim->mName);
+        out.mDuration = anim->mDuration;
+        out.mTicksPerSecond = anim->mTicksPerSecond;
+
+        std::vector<NodeAnim> channels(anim->mNumChannels);
+        for (unsigned int i = 0; i < anim->mNumChannels; ++i) {
+            const aiNodeAnim *in = anim->mChannels[i];
+            NodeAnim &na = channels[i];
+            memset(&na, 0, sizeof(NodeAnim));
+            na.mNodeName = AppendString(in->mNodeName);
+            na.mPreState = in->mPreState;
+            na.mPostState = in->mPostState;
+            na.mPositionKeys = AppendArray(in->mPositionKeys, in->mNumPositionKeys);
+            na.mRotationKeys = AppendArray(in->mRotationKeys, in->mNumRotationKeys);
+            na.mScalingKeys = AppendArray(in->mScalingKeys, in->mNumScalingKeys);
+        }
+        out.mChannels = AppendArray(channels.data(), channels.size());
+
+        std::vector<MeshAnim> meshChannels(anim->mNumMeshChannels);
+        for (unsigned int i = 0; i < anim->mNumMeshChannels; ++i) {
+            const aiMeshAnim *in = anim->mMeshChannels[i];
+            memset(&meshChannels[i], 0, sizeof(MeshAnim));
+            meshChannels[i].mName = AppendString(in->mName);
+            meshChannels[i].mKeys = AppendArray(in->mKeys, in->mNumKeys);
+        }
+        out.mMeshChannels = AppendArray(meshChannels.data(), meshChannels.size());
+
+        std::vector<MeshMorphAnim> morphChannels(anim->mNumMorphMeshChannels);
+        for (unsigned int i = 0; i < anim->mNumMorphMeshChannels; ++i) {
+            const aiMeshMorphAnim *in = anim->mMorphMeshChannels[i];
+            std::vector<MeshMorphKey> keys(in->mNumKeys);
+            for (unsigned int k = 0; k < in->mNumKeys; ++k) {
+                const aiMeshMorphKey &key = in->mKeys[k];
+                keys[k].mTime = key.mTime;
+                keys[k].mValues = AppendArray(key.mValues, key.mNumValuesAndWeights);
+                keys[k].mWeights = AppendArray(key.mWeights, key.mNumValuesAndWeights);
+            }
+            memset(&morphChannels[i], 0, sizeof(MeshMorphAnim));
+            morphChannels[i].mName = AppendString(in->mName);
+            morphChannels[i].mKeys = AppendArray(keys.data(), keys.size());
+        }
+        out.mMorphMeshChannels = AppendArray(morphChannels.data(), morphChannels.size());
+    }
+
+    void WriteTexture(const aiTexture *tex, Texture &out) {
+        memset(&out, 0, sizeof(out));
+        out.mFilename = AppendString(tex->mFilename);
+        out.mWidth = tex->mWidth;
+        out.mHeight = tex->mHeight;
+        memcpy(out.mFormatHint, tex->achFormatHint, HINTMAXTEXTURELEN);
+        if (tex->mHeight) {
+            out.mData = AppendArray(tex->pcData, static_cast<size_t>(tex->mWidth) * tex->mHeight);
+        } else {
+            out.mData = AppendArray(reinterpret_cast<const uint8_t *>(tex->pcData), tex->mWidth);
+        }
+    }
+
+    void WriteLight(const aiLight *light, Light &out) {
+        memset(&out, 0, sizeof(out));
+        out.mName = AppendString(light->mName);
+        out.mType = light->mType;
+        out.mAttenuationConstant = light->mAttenuationConstant;
+        out.mAttenuationLinear = light->mAttenuationLinear;
+        out.mAttenuationQuadratic = light->mAttenuationQuadratic;
+        out.mAngleInnerCone = light->mAngleInnerCone;
+        out.mAngleOuterCone = light->mAngleOuterCone;
+        CopyVector(light->mPosition, out.mPosition);
+        CopyVector(light->mDirection, out.mDirection);
+        CopyVector(light->mUp, out.mUp);
+        CopyColor(light->mColorDiffuse, out.mColorDiffuse);
+        CopyColor(light->mColorSpecular, out.mColorSpecular);
+        CopyColor(light->mColorAmbient, out.mColorAmbient);
+        out.mSize[0] = light->mSize.x;
+        out.mSize[1] = light->mSize.y;
+    }
+
+    void WriteCamera(const aiCamera *cam, Camera &out) {
+        memset(&out, 0, sizeof(out));
+        out.mName = AppendString(cam->mName);
+        CopyVector(cam->mPosition, out.mPosition);
+        CopyVector(cam->mUp, out.mUp);
+        CopyVector(cam->mLookAt, out.mLookAt);
+        out.mHorizontalFOV = cam->mHorizontalFOV;
+        out.mClipPlaneNear = cam->mClipPlaneNear;
+        out.mClipPlaneFar = cam->mClipPlaneFar;
+        out.mAspect = cam->mAspect;
+        out.mOrthographicWidth = cam->mOrthographicWidth;
+    }
+
+    std::vector<uint8_t> mBuffer;
+};
+
+} // namespace
+
+// -----------------------------------------------------------------------------------
+void ExportSceneCache(const char *pFile, IOSystem *pIOSystem, const aiScene *pScene, const ExportProperties * /*pProperties*/) {
+    SceneCacheWriter writer;
+    const std::vector<uint8_t> &buffer = writer.Write(pScene);
+
+    std::unique_ptr<IOStream> out(pIOSystem->Open(pFile, "wb"));
+    if (!out) {
+        throw DeadlyExportError("could not open output .aicache file: " + std::string(pFile));
+    }
+    if (out->Write(buffer.data(), buffer.size(), 1) != 1) {
+        throw DeadlyExportError("could not write .aicache file: " + std::string(pFile));
+    }
+}
+
+} // namespace Assimp
+
+#endif // ASSIMP_BUILD_NO_SCENECACHE_EXPORTER
+#endif // ASSIMP_BUILD_NO_EXPORT
@@ -0,0 +1,316 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2022, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file  SceneCacheFormat.h
+ *  @brief On-disk layout of the scene cache format.
+ *
+ *  A scene cache is a single block of memory. All records and arrays are
+ *  addressed by their byte offset from the start of the file and are
+ *  stored contiguously, so a loaded (or memory-mapped) file can be read
+ *  in place through a SceneCacheView without parsing. The file is only
+ *  valid for the byte order and the ai_real size of the writing build.
+ */
+#pragma once
+#ifndef AI_SCENECACHEFORMAT_H_INC
+#define AI_SCENECACHEFORMAT_H_INC
+
+#include <assimp/Exceptional.h>
+#include <assimp/mesh.h>
+#include <assimp/texture.h>
+#include <assimp/types.h>
+
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace Assimp {
+namespace SceneCache {
+
+static const char Magic[8] = { 'A', 'I', 'C', 'A', 'C', 'H', 'E', '\0' };
+static const uint32_t Version = 1;
+static const uint32_t ByteOrderMark = 0x01020304;
+
+//! Every array starts at a multiple of this
+static const uint64_t Alignment = 16;
+
+// ---------------------------------------------------------------------------
+/** A contiguous array of mCount elements. An offset of 0 means the array
+ *  is absent, the header lives there. Strings are arrays of mCount chars
+ *  followed by a terminating zero. */
+struct Array {
+    uint64_t mOffset;
+    uint64_t mCount;
+};
+
+typedef Array String;
+
+// ---------------------------------------------------------------------------
+struct Header {
+    char mMagic[8];
+    uint32_t mVersion;
+    uint32_t mByteOrderMark;
+    uint32_t mRealSize;         //!< sizeof(ai_real) of the writer
+    uint32_t mFlags;            //!< aiScene::mFlags
+    uint64_t mFileSize;
+    String mName;
+    Array mNodes;               //!< Node, depth-first pre-order with the root first
+    Array mMeshes;              //!< Mesh
+    Array mMaterials;           //!< Array of MaterialProperty per material
+    Array mAnimations;          //!< Animation
+    Array mTextures;            //!< Texture
+    Array mLights;              //!< Light
+    Array mCameras;             //!< Camera
+    Array mMetadata;            //!< MetadataEntry
+};
+
+// ---------------------------------------------------------------------------
+struct MetadataEntry {
+    String mKey;
+    uint32_t mType;             //!< aiMetadataType
+    uint32_t mPad;
+    Array mData;                //!< String, MetadataEntry or the bytes of the value
+};
+
+struct Node {
+    String mName;
+    ai_real mTransformation[16];
+    uint32_t mParent;           //!< index of the parent, ~0u for the root
+    uint32_t mNumChildren;
+    Array mMeshes;              //!< uint32_t
+    Array mMetadata;            //!< MetadataEntry
+};
+
+struct Bone {
+    String mName;
+    ai_real mOffsetMatrix[16];
+    Array mWeights;             //!< aiVertexWeight
+};
+
+struct AnimMesh {
+    String mName;
+    uint32_t mNumVertices;
+    float mWeight;
+    uint64_t mVertices;         //!< offsets of mNumVertices aiVector3D each, 0 if absent
+    uint64_t mNormals;
+    uint64_t mTangents;
+    uint64_t mBitangents;
+    uint64_t mColors[AI_MAX_NUMBER_OF_COLOR_SETS];                //!< aiColor4D
+    uint64_t mTextureCoords[AI_MAX_NUMBER_OF_TEXTURECOORDS];      //!< aiVector3D
+};
+
+struct Mesh {
+    String mName;
+    uint32_t mPrimitiveTypes;
+    uint32_t mNumVertices;
+    uint32_t mNumFaces;
+    uint32_t mMaterialIndex;
+    uint32_t mMethod;
+    uint32_t mNumUVComponents[AI_MAX_NUMBER_OF_TEXTURECOORDS];
+    uint32_t mPad;
+    ai_real mAABB[6];
+    uint64_t mVertices;         //!< offsets of mNumVertices aiVector3D each, 0 if absent
+    uint64_t mNormals;
+    uint64_t mTangents;
+    uint64_t mBitangents;
+    uint64_t mColors[AI_MAX_NUMBER_OF_COLOR_SETS];                //!< aiColor4D
+    uint64_t mTextureCoords[AI_MAX_NUMBER_OF_TEXTURECOORDS];      //!< aiVector3D
+    String mTextureCoordsNames[AI_MAX_NUMBER_OF_TEXTURECOORDS];
+    uint64_t mFaceSizes;        //!< mNumFaces uint32_t
+    Array mIndices;             //!< uint32_t, the indices of all faces one after another
+    Array mBones;               //!< Bone
+    Array mAnimMeshes;          //!< AnimMesh
+    uint32_t mNumInfluences;    //!< aiSkinInfluences, 0 if the mesh has none
+    uint32_t mInfluenceIndexSize;
+    uint64_t mInfluenceIndices;
+    uint64_t mInfluenceWeights;
+};
+
+struct MaterialProperty {
+    String mKey;
+    uint32_t mSemantic;
+    uint32_t mIndex;
+    uint32_t mType;             //!< aiPropertyTypeInfo
+    uint32_t mPad;
+    Array mData;                //!< raw bytes
+};
+
+struct Texture {
+    String mFilename;
+    uint32_t mWidth;
+    uint32_t mHeight;
+    char mFormatHint[HINTMAXTEXTURELEN];
+    char mPad[16 - HINTMAXTEXTURELEN % 16];
+    Array mData;                //!< aiTexel for uncompressed textures, raw bytes otherwise
+};
+
+struct NodeAnim {
+    String mNodeName;
+    uint32_t mPreState;
+    uint32_t mPostState;
+    Array mPositionKeys;        //!< aiVectorKey
+    Array mRotationKeys;        //!< aiQuatKey
+    Array mScalingKeys;         //!< aiVectorKey
+};
+
+struct MeshAnim {
+    String mName;
+    Array mKeys;                //!< aiMeshKey
+};
+
+struct MeshMorphKey {
+    double mTime;
+    Array mValues;              //!< uint32_t
+    Array mWeights;             //!< double
+};
+
+struct MeshMorphAnim {
+    String mName;
+    Array mKeys;                //!< MeshMorphKey
+};
+
+struct Animation {
+    String mName;
+    double mDuration;
+    double mTicksPerSecond;
+    Array mChannels;            //!< NodeAnim
+    Array mMeshChannels;        //!< MeshAnim
+    Array mMorphMeshChannels;   //!< MeshMorphAnim
+};
+
+struct Light {
+    String mName;
+    uint32_t mType;
+    float mAttenuationConstant;
+    float mAttenuationLinear;
+    float mAttenuationQuadratic;
+    float mAngleInnerCone;
+    float mAngleOuterCone;
+    ai_real mPosition[3];
+    ai_real mDirection[3];
+    ai_real mUp[3];
+    ai_real mColorDiffuse[3];
+    ai_real mColorSpecular[3];
+    ai_real mColorAmbient[3];
+    ai_real mSize[2];
+};
+
+struct Camera {
+    String mName;
+    ai_real mPosition[3];
+    ai_real mUp[3];
+    ai_real mLookAt[3];
+    float mHorizontalFOV;
+    float mClipPlaneNear;
+    float mClipPlaneFar;
+    float mAspect;
+    float mOrthographicWidth;
+};
+
+// ---------------------------------------------------------------------------
+/** @brief Read-only, bounds checked access to a scene cache in memory.
+ *
+ *  The memory must stay alive as long as the view and be aligned to at
+ *  least 8 bytes, which holds for heap blocks and mapped files. Invalid
+ *  offsets throw a DeadlyImportError.
+ */
+class SceneCacheView {
+public:
+    SceneCacheView(const void *data, size_t size) :
+            mData(static_cast<const uint8_t *>(data)), mSize(size) {
+        if (mSize < sizeof(Header) || (reinterpret_cast<uintptr_t>(mData) & 7) != 0) {
+            throw DeadlyImportError("Scene cache: file too small or misaligned");
+        }
+        const Header &header = GetHeader();
+        if (memcmp(header.mMagic, Magic, sizeof(Magic)) != 0) {
+            throw DeadlyImportError("Scene cache: magic token is wrong");
+        }
+        if (header.mVersion != Version) {
+            throw DeadlyImportError("Scene cache: unsupported version ", header.mVersion);
+        }
+        if (header.mByteOrderMark != ByteOrderMark || header.mRealSize != sizeof(ai_real)) {
+            throw DeadlyImportError("Scene cache: written for a different byte order or ai_real size");
+        }
+        if (header.mFileSize != mSize) {
+            throw DeadlyImportError("Scene cache: file is truncated");
+        }
+    }
+
+    const Header &GetHeader() const {
+        return *reinterpret_cast<const Header *>(mData);
+    }
+
+    //! Returns the elements of an array, nullptr if it is absent or empty
+    template <typename T>
+    const T *Get(const Array &array) const {
+        return Get<T>(array.mOffset, array.mCount);
+    }
+
+    //! Returns count elements at offset, nullptr if offset is 0 or count is 0
+    template <typename T>
+    const T *Get(uint64_t offset, uint64_t count) const {
+        static_assert(std::is_trivially_copyable<T>::value, "scene cache elements must be trivially copyable");
+        if (offset == 0 || count == 0) {
+            return nullptr;
+        }
+        if (offset % alignof(T) != 0 || offset > mSize || count > (mSize - offset) / sizeof(T)) {
+            throw DeadlyImportError("Scene cache: array out of bounds");
+        }
+        return reinterpret_cast<const T *>(mData + offset);
+    }
+
+    //! Returns a string as an aiString
+    aiString GetString(const String &str) const {
+        aiString out;
+        if (const char *chars = Get<char>(str.mOffset, str.mCount + 1)) {
+            out.Set(std::string(chars, static_cast<size_t>(str.mCount)));
+        }
+        return out;
+    }
+
+private:
+    const uint8_t *mData;
+    size_t mSize;
+};
+
+} // namespace SceneCache
+} // namespace Assimp
+
+#endif // AI_SCENECACHEFORMAT_H_INC
@@ -0,0 +1,532 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2022, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file  SceneCacheLoader.cpp
+ *  @brief Implementation of the scene cache importer, see SceneCacheFormat.h
+ */
+
+#ifndef ASSIMP_BUILD_NO_SCENECACHE_IMPORTER
+
+#include "AssetLib/SceneCache/SceneCacheLoader.h"
+#include "AssetLib/SceneCache/SceneCacheFormat.h"
+
+#include <assimp/IOStream.hpp>
+#include <assimp/IOSystem.hpp>
+#include <assimp/importerdesc.h>
+#include <assimp/scene.h>
+
+#include <algorithm>
+#include <memory>
+
+using namespace Assimp;
+using namespace Assimp::SceneCache;
+
+static const aiImporterDesc desc = {
+    "Assimp Scene Cache Importer",
+    "",
+    "",
+    "",
+    aiImporterFlags_SupportBinaryFlavour,
+    0,
+    0,
+    0,
+    0,
+    "aicache"
+};
+
+namespace {
+
+// -----------------------------------------------------------------------------------
+// Copies an optional array of count elements into a new[] block
+template <typename T>
+T *CopyArray(const SceneCacheView &view, uint64_t offset, uint64_t count) {
+    const T *in = view.Get<T>(offset, count);
+    if (in == nullptr) {
+        return nullptr;
+    }
+    T *out = new T[static_cast<size_t>(count)];
+    memcpy(static_cast<void *>(out), in, static_cast<size_t>(count) * sizeof(T));
+    return out;
+}
+
+// -----------------------------------------------------------------------------------
+aiMatrix4x4 ToMatrix(const ai_real *in) {
+    aiMatrix4x4 out;
+    for (unsigned int i = 0; i < 16; ++i) {
+        out[i / 4][i % 4] = in[i];
+    }
+    return out;
+}
+
+// -----------------------------------------------------------------------------------
+// Nesting limit of metadata, deeper levels are taken as a cycle in the offsets
+static const unsigned int MaxMetadataDepth = 32;
+
+// -----------------------------------------------------------------------------------
+aiMetadata *ReadMetadata(const SceneCacheView &view, const Array &array, unsigned int depth = 0) {
+    const MetadataEntry *entries = view.Get<MetadataEntry>(array);
+    if (entries == nullptr) {
+        return nullptr;
+    }
+    if (depth > MaxMetadataDepth) {
+        throw DeadlyImportError("Scene cache: metadata nested deeper than ", MaxMetadataDepth, " levels");
+    }
+    std::unique_ptr<aiMetadata> metadata(aiMetadata::Alloc(static_cast<unsigned int>(array.mCount)));
+    for (unsigned int i = 0; i < metadata->mNumProperties; ++i) {
+        const MetadataEntry &in = entries[i];
+        aiMetadataEntry &out = metadata->mValues[i];
+        metadata->mKeys[i] = view.GetString(in.mKey);
+        out.mType = static_cast<aiMetadataType>(in.mType);
+        switch (out.mType) {
+        case AI_BOOL:
+            out.mData = CopyArray<bool>(view, in.mData.mOffset, 1);
+            break;
+        case AI_INT32:
+            out.mData = CopyArray<int32_t>(view, in.mData.mOffset, 1);
+            break;
+        case AI_UINT64:
+            out.mData = CopyArray<uint64_t>(view, in.mData.mOffset, 1);
+            break;
+        case AI_FLOAT:
+            out.mData = CopyArray<float>(view, in.mData.mOffset, 1);
+            break;
+        case AI_DOUBLE:
+            out.mData = CopyArray<double>(view, in.mData.mOffset, 1);
+            break;
+        case AI_AIVECTOR3D:
+            out.mData = CopyArray<aiVector3D>(view, in.mData.mOffset, 1);
+            break;
+        case AI_AISTRING:
+            out.mData = new aiString(view.GetString(in.mData));
+            break;
+        case AI_AIMETADATA:
+            out.mData = ReadMetadata(view, in.mData, depth + 1);
+            if (out.mData == nullptr) {
+                out.mData = new aiMetadata();
+            }
+            break;
+        default:
+            throw DeadlyImportError("Scene cache: unknown metadata type ", in.mType);
+        }
+    }
+    return metadata.release();
+}
+
+// -----------------------------------------------------------------------------------
+aiNode *ReadNodes(const SceneCacheView &view, const Array &array, uint64_t numMeshes) {
+    const Node *nodes = view.Get<Node>(array);
+    if (nodes == nullptr) {
+        return nullptr;
+    }
+    std::vector<aiNode *> out(static_cast<size_t>(array.mCount), nullptr);
+    try {
+        for (size_t i = 0; i < out.size(); ++i) {
+            const Node &in = nodes[i];
+            if (i > 0 && in.mParent >= i) {
+                throw DeadlyImportError("Scene cache: node ", i, " has an invalid parent");
+            }
+            aiNode *node = out[i] = new aiNode();
+            if (i > 0) {
+                // pre-order: the parent comes first and its children slots fill up in order
+                aiNode *parent = out[in.mParent];
+                if (parent->mNumChildren >= nodes[in.mParent].mNumChildren) {
+                    delete node;
+                    throw DeadlyImportError("Scene cache: node ", in.mParent, " has too many children");
+                }
+                node->mParent = parent;
+                parent->mChildren[parent->mNumChildren++] = node;
+            }
+            node->mName = view.GetString(in.mName);
+            node->mTransformation = ToMatrix(in.mTransformation);
+            node->mNumMeshes = static_cast<unsigned int>(in.mMeshes.mCount);
+            node->mMeshes = CopyArray<unsigned int>(view, in.mMeshes.mOffset, in.mMeshes.mCount);
+            for (unsigned int m = 0; node->mMeshes && m < node->mNumMeshes; ++m) {
+                if (node->mMeshes[m] >= numMeshes) {
+                    throw DeadlyImportError("Scene cache: node ", i, " references mesh ", node->mMeshes[m], " out of range");
+                }
+            }
+            node->mMetaData = ReadMetadata(view, in.mMetadata);
+            if (in.mNumChildren) {
+                node->mChildren = new aiNode *[in.mNumChildren]();
+            }
+        }
+        for (size_t i = 0; i < out.size(); ++i) {
+            if (out[i]->mNumChildren != nodes[i].mNumChildren) {
+                throw DeadlyImportError("Scene cache: node ", i, " misses children");
+            }
+        }
+    } catch (...) {
+        // all nodes but the root are attached to their parent right away
+        delete out[0];
+        throw;
+    }
+    return out[0];
+}
+
+// -----------------------------------------------------------------------------------
+aiMesh *ReadMesh(const SceneCacheView &view, const Mesh &in) {
+    std::unique_ptr<aiMesh> mesh(new aiMesh());
+    mesh->mName = view.GetString(in.mName);
+    mesh->mPrimitiveTypes = in.mPrimitiveTypes;
+    mesh->mNumVertices = in.mNumVertices;
+    mesh->mMaterialIndex = in.mMaterialIndex;
+    mesh->mMethod = in.mMethod;
+    mesh->mAABB.mMin = aiVector3D(in.mAABB[0], in.mAABB[1], in.mAABB[2]);
+    mesh->mAABB.mMax = aiVector3D(in.mAABB[3], in.mAABB[4], in.mAABB[5]);
+
+    mesh->mVertices = CopyArray<aiVector3D>(view, in.mVertices, in.mNumVertices);
+    if (mesh->mVertices == nullptr && in.mNumVertices) {
+        throw DeadlyImportError("Scene cache: mesh without vertex positions");
+    }
+    mesh->mNormals = CopyArray<aiVector3D>(view, in.mNormals, in.mNumVertices);
+    mesh->mTangents = CopyArray<aiVector3D>(view, in.mTangents, in.mNumVertices);
+    mesh->mBitangents = CopyArray<aiVector3D>(view, in.mBitangents, in.mNumVertices);
+    for (unsigned int i = 0; i < AI_MAX_NUMBER_OF_COLOR_SETS; ++i) {
+        mesh->mColors[i] = CopyArray<aiColor4D>(view, in.mColors[i], in.mNumVertices);
+    }
+    for (unsigned int i = 0; i < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++i) {
+        mesh->mTextureCoords[i] = CopyArray<aiVector3D>(view, in.mTextureCoords[i], in.mNumVertices);
+        mesh->mNumUVComponents[i] = in.mNumUVComponents[i];
+        if (in.mTextureCoordsNames[i].mOffset) {
+            mesh->SetTextureCoordsName(i, view.GetString(in.mTextureCoordsNames[i]));
+        }
+    }
+
+    const uint32_t *sizes = view.Get<uint32_t>(in.mFaceSizes, in.mNumFaces);
+    const uint32_t *indices = view.Get<uint32_t>(in.mIndices);
+    if (sizes) {
+        mesh->mNumFaces = in.mNumFaces;
+        mesh->mFaces = new aiFace[in.mNumFaces];
+        uint64_t next = 0;
+        for (unsigned int i = 0; i < in.mNumFaces; ++i) {
+            aiFace &face = mesh->mFaces[i];
+            if (sizes[i] > in.mIndices.mCount - next) {
+                throw DeadlyImportError("Scene cache: face indices out of bounds");
+            }
+            face.mNumIndices = sizes[i];
+            face.mIndices = new unsigned int[sizes[i]];
+            memcpy(face.mIndices, indices + next, sizes[i] * sizeof(unsigned int));
+            next += sizes[i];
+            for (unsigned int k = 0; k < face.mNumIndices; ++k) {
+                if (face.mIndices[k] >= in.mNumVertices) {
+                    throw DeadlyImportError("Scene cache: face ", i, " references vertex ", face.mIndices[k], " out of range");
+                }
+            }
+        }
+    }
+
+    if (const Bone *bones = view.Get<Bone>(in.mBones)) {
+        mesh->mNumBones = static_cast<unsigned int>(in.mBones.mCount);
+        mesh->mBones = new aiBone *[mesh->mNumBones]();
+        for (unsigned int i = 0; i < mesh->mNumBones; ++i) {
+            aiBone *bone = mesh->mBones[i] = new aiBone();
+            bone->mName = view.GetString(bones[i].mName);
+            bone->mOffsetMatrix = ToMatrix(bones[i].mOffsetMatrix);
+            bone->mNumWeights = static_cast<unsigned int>(bones[i].mWeights.mCount);
+            bone->mWeights = CopyArray<aiVertexWeight>(view, bones[i].mWeights.mOffset, bones[i].mWeights.mCount);
+            if (bone->mWeights == nullptr && bone->mNumWeights) {
+                throw DeadlyImportError("Scene cache: bone ", i, " misses its weights");
+            }
+            for (unsigned int w = 0; w < bone->mNumWeights; ++w) {
+                if (bone->mWeights[w].mVertexId >= in.mNumVertices) {
+                    throw DeadlyImportError("Scene cache: bone ", i, " references vertex ", bone->mWeights[w].mVertexId, " out of range");
+                }
+            }
+        }
+    }
+
+    if (const AnimMesh *animMeshes = view.Get<AnimMesh>(in.mAnimMeshes)) {
+        mesh->mNumAnimMeshes = static_cast<unsigned int>(in.mAnimMeshes.mCount);
+        mesh->mAnimMeshes = new aiAnimMesh *[mesh->mNumAnimMeshes]();
+        for (unsigned int i = 0; i < mesh->mNumAnimMeshes; ++i) {
+            const AnimMesh &am = animMeshes[i];
+            aiAnimMesh *out = mesh->mAnimMeshes[i] = new aiAnimMesh();
+            out->mName = view.GetString(am.mName);
+            out->mNumVertices = am.mNumVertices;
+            out->mWeight = am.mWeight;
+            out->mVertices = CopyArray<aiVector3D>(view, am.mVertices, am.mNumVertices);
+            out->mNormals = CopyArray<aiVector3D>(view, am.mNormals, am.mNumVertices);
+            out->mTangents = CopyArray<aiVector3D>(view, am.mTangents, am.mNumVertices);
+            out->mBitangents = CopyArray<aiVector3D>(view, am.mBitangents, am.mNumVertices);
+            for (unsigned int c = 0; c < AI_MAX_NUMBER_OF_COLOR_SETS; ++c) {
+                out->mColors[c] = CopyArray<aiColor4D>(view, am.mColors[c], am.mNumVertices);
+            }
+            for (unsigned int c = 0; c < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++c) {
+                out->mTextureCoords[c] = CopyArray<aiVector3D>(view, am.mTextureCoords[c], am.mNumVertices);
+            }
+        }
+    }
+
+    if (in.mNumInfluences) {
+        const uint64_t numSlots = static_cast<uint64_t>(in.mNumVertices) * in.mNumInfluences;
+        aiSkinInfluences *influences = mesh->mSkinInfluences = new aiSkinInfluences();
+        influences->mNumInfluences = in.mNumInfluences;
+        influences->mIndexSize = in.mInfluenceIndexSize;
+        influences->mBoneIndices = CopyArray<unsigned char>(view, in.mInfluenceIndices, numSlots * in.mInfluenceIndexSize);
+        influences->mWeights = CopyArray<unsigned short>(view, in.mInfluenceWeights, numSlots);
+        if (in.mInfluenceIndexSize != 1 && in.mInfluenceIndexSize != 2) {
+            throw DeadlyImportError("Scene cache: invalid influence index size ", in.mInfluenceIndexSize);
+        }
+        if ((influences->mBoneIndices == nullptr || influences->mWeights == nullptr) && numSlots) {
+            throw DeadlyImportError("Scene cache: mesh misses its skin influences");
+        }
+        for (uint64_t k = 0; k < numSlots; ++k) {
+            const unsigned int v = static_cast<unsigned int>(k / in.mNumInfluences);
+            const unsigned int bone = influences->GetBoneIndex(v, static_cast<unsigned int>(k % in.mNumInfluences));
+            if (bone >= mesh->mNumBones && (bone || influences->mWeights[k])) {
+                throw DeadlyImportError("Scene cache: skin influence of vertex ", v, " references bone ", bone, " out of range");
+            }
+        }
+    }
+    return mesh.release();
+}
+
+// -----------------------------------------------------------------------------------
+aiMaterial *ReadMaterial(const SceneCacheView &view, const Array &array) {
+    std::unique_ptr<aiMaterial> mat(new aiMaterial());
+    const MaterialProperty *props = view.Get<MaterialProperty>(array);
+    for (uint64_t i = 0; i < array.mCount; ++i) {
+        const MaterialProperty &in = props[i];
+        const aiString key = view.GetString(in.mKey);
+        const char *data = view.Get<char>(in.mData);
+        mat->AddBinaryProperty(data, static_cast<unsigned int>(data ? in.mData.mCount : 0), key.C_Str(),
+                in.mSemantic, in.mIndex, static_cast<aiPropertyTypeInfo>(in.mType));
+    }
+    return mat.release();
+}
+
+// -----------------------------------------------------------------------------------
+aiAnimation *ReadAnimation(const SceneCacheView &view, const Animation &in) {
+    std::unique_ptr<aiAnimation> anim(new aiAnimation());
+    anim->mName = view.GetString(in.mName);
+    anim->mDuration = in.mDuration;
+    anim->mTicksPerSecond = in.mTicksPerSecond;
+
+    if (const NodeAnim *channels = view.Get<NodeAnim>(in.mChannels)) {
+        anim->mNumChannels = static_cast<unsigned int>(in.mChannels.mCount);
+        anim->mChannels = new aiNodeAnim *[anim->mNumChannels]();
+        for (unsigned int i = 0; i < anim->mNumChannels; ++i) {
+            const NodeAnim &na = channels[i];
+            aiNodeAnim *out = anim->mChannels[i] = new aiNodeAnim();
+            out->mNodeName = view.GetString(na.mNodeName);
+            out->mPreState = static_cast<aiAnimBehaviour>(na.mPreState);
+            out->mPostState = static_cast<aiAnimBehaviour>(na.mPostState);
+            out->mNumPositionKeys = static_cast<unsigned int>(na.mPositionKeys.mCount);
+            out->mPositionKeys = CopyArray<aiVectorKey>(view, na.mPositionKeys.mOffset, na.mPositionKeys.mCount);
+            out->mNumRotationKeys = static_cast<unsigned int>(na.mRotationKeys.mCount);
+            out->mRotationKeys = CopyArray<aiQuatKey>(view, na.mRotationKeys.mOffset, na.mRotationKeys.mCount);
+            out->mNumScalingKeys = static_cast<unsigned int>(na.mScalingKeys.mCount);
+            out->mScalingKeys = CopyArray<aiVectorKey>(view, na.mScalingKeys.mOffset, na.mScalingKeys.mCount);
+        }
+    }
+
+    if (const MeshAnim *channels = view.Get<MeshAnim>(in.mMeshChannels)) {
+        anim->mNumMeshChannels = static_cast<unsigned int>(in.mMeshChannels.mCount);
+        anim->mMeshChannels = new aiMeshAnim *[anim->mNumMeshChannels]();
+        for (unsigned int i = 0; i < anim->mNumMeshChannels; ++i) {
+            aiMeshAnim *out = anim->mMeshChannels[i] = new aiMeshAnim();
+            out->mName = view.GetString(channels[i].mName);
+            out->mNumKeys = static_cast<unsigned int>(channels[i].mKeys.mCount);
+            out->mKeys = CopyArray<aiMeshKey>(view, channels[i].mKeys.mOffset, channels[i].mKeys.mCount);
+        }
+    }
+
+    if (const MeshMorphAnim *channels = view.Get<MeshMorphAnim>(in.mMorphMeshChannels)) {
+        anim->mNumMorphMeshChannels = static_cast<unsigned int>(in.mMorphMeshChannels.mCount);
+        anim->mMorphMeshChannels = new aiMeshMorphAnim *[anim->mNumMorphMeshChannels]();
+        for (unsigned int i = 0; i < anim->mNumMorphMeshChannels; ++i) {
+            aiMeshMorphAnim *out = anim->mMorphMeshChannels[i] = new aiMeshMorphAnim();
+            out->mName = view.GetString(channels[i].mName);
+            const MeshMorphKey *keys = view.Get<MeshMorphKey>(channels[i].mKeys);
+            if (keys == nullptr) {
+                continue;
+            }
+            out->mNumKeys = static_cast<unsigned int>(channels[i].mKeys.mCount);
+            out->mKeys = new aiMeshMorphKey[out->mNumKeys];
+            for (unsigned int k = 0; k < out->mNumKeys; ++k) {
+                const MeshMorphKey &key = keys[k];
+                if (key.mValues.mCount != key.mWeights.mCount) {
+                    throw DeadlyImportError("Scene cache: morph key values and weights differ in size");
+                }
+                out->mKeys[k].mTime = key.mTime;
+                out->mKeys[k].mNumValuesAndWeights = static_cast<unsigned int>(key.mValues.mCount);
+                out->mKeys[k].mValues = CopyArray<unsigned int>(view, key.mValues.mOffset, key.mValues.mCount);
+                out->mKeys[k].mWeights = CopyArray<double>(view, key.mWeights.mOffset, key.mWeights.mCount);
+            }
+        }
+    }
+    return anim.release();
+}
+
+// -----------------------------------------------------------------------------------
+aiTexture *ReadTexture(const SceneCacheView &view, const Texture &in) {
+    std::unique_ptr<aiTexture> tex(new aiTexture());
+    tex->mFilename = view.GetString(in.mFilename);
+    tex->mWidth = in.mWidth;
+    tex->mHeight = in.mHeight;
+    memcpy(tex->achFormatHint, in.mFormatHint, HINTMAXTEXTURELEN);
+    tex->achFormatHint[HINTMAXTEXTURELEN - 1] = '\0';
+    if (in.mHeight) {
+        tex->pcData = CopyArray<aiTexel>(view, in.mData.mOffset, static_cast<uint64_t>(in.mWidth) * in.mHeight);
+        if (tex->pcData == nullptr && in.mWidth) {
+            throw DeadlyImportError("Scene cache: texture misses its texels");
+        }
+    } else {
+        // compressed textures are a block of mWidth bytes, allocated as texels like the other importers do
+        const uint8_t *data = view.Get<uint8_t>(in.mData.mOffset, in.mWidth);
+        if (data == nullptr && in.mWidth) {
+            throw DeadlyImportError("Scene cache: texture misses its data");
+        }
+        tex->pcData = new aiTexel[in.mWidth / sizeof(aiTexel) + 1];
+        memcpy(static_cast<void *>(tex->pcData), data, in.mWidth);
+    }
+    return tex.release();
+}
+
+// -----------------------------------------------------------------------------------
+aiLight *ReadLight(const SceneCacheView &view, const Light &in) {
+    aiLight *light = new aiLight();
+    light->mName = view.GetString(in.mName);
+    light->mType = static_cast<aiLightSourceType>(in.mType);
+    light->mAttenuationConstant = in.mAttenuationConstant;
+    light->mAttenuationLinear = in.mAttenuationLinear;
+    light->mAttenuationQuadratic = in.mAttenuationQuadratic;
+    light->mAngleInnerCone = in.mAngleInnerCone;
+    light->mAngleOuterCone = in.mAngleOuterCone;
+    light->mPosition = aiVector3D(in.mPosition[0], in.mPosition[1], in.mPosition[2]);
+    light->mDirection = aiVector3D(in.mDirection[0], in.mDirection[1], in.mDirection[2]);
+    light->mUp = aiVector3D(in.mUp[0], in.mUp[1], in.mUp[2]);
+    light->mColorDiffuse = aiColor3D(in.mColorDiffuse[0], in.mColorDiffuse[1], in.mColorDiffuse[2]);
+    light->mColorSpecular = aiColor3D(in.mColorSpecular[0], in.mColorSpecular[1], in.mColorSpecular[2]);
+    light->mColorAmbient = aiColor3D(in.mColorAmbient[0], in.mColorAmbient[1], in.mColorAmbient[2]);
+    light->mSize = aiVector2D(in.mSize[0], in.mSize[1]);
+    return light;
+}
+
+// -----------------------------------------------------------------------------------
+aiCamera *ReadCamera(const SceneCacheView &view, const Camera &in) {
+    aiCamera *cam = new aiCamera();
+    cam->mName = view.GetString(in.mName);
+    cam->mPosition = aiVector3D(in.mPosition[0], in.mPosition[1], in.mPosition[2]);
+    cam->mUp = aiVector3D(in.mUp[0], in.mUp[1], in.mUp[2]);
+    cam->mLookAt = aiVector3D(in.mLookAt[0], in.mLookAt[1], in.mLookAt[2]);
+    cam->mHorizontalFOV = in.mHorizontalFOV;
+    cam->mClipPlaneNear = in.mClipPlaneNear;
+    cam->mClipPlaneFar = in.mClipPlaneFar;
+    cam->mAspect = in.mAspect;
+    cam->mOrthographicWidth = in.mOrthographicWidth;
+    return cam;
+}
+
+// -----------------------------------------------------------------------------------
+// Allocates the pointer array of a scene list and fills it with read(view, record)
+template <typename Out, typename Record, typename ReadFunc>
+void ReadList(const SceneCacheView &view, const Array &array, Out **&list, unsigned int &count, ReadFunc read) {
+    const Record *records = view.Get<Record>(array);
+    if (records == nullptr) {
+        return;
+    }
+    count = static_cast<unsigned int>(array.mCount);
+    list = new Out *[count]();
+    for (unsigned int i = 0; i < count; ++i) {
+        list[i] = read(view, records[i]);
+    }
+}
+
+} // namespace
+
+// -----------------------------------------------------------------------------------
+const aiImporterDesc *SceneCacheImporter::GetInfo() const {
+    return &desc;
+}
+
+// -----------------------------------------------------------------------------------
+bool SceneCacheImporter::CanRead(const std::string &pFile, IOSystem *pIOHandler, bool /*checkSig*/) const {
+    std::unique_ptr<IOStream> in(pIOHandler->Open(pFile, "rb"));
+    if (!in) {
+        return false;
+    }
+    char magic[sizeof(Magic)] = {};
+    return in->Read(magic, sizeof(magic), 1) == 1 && memcmp(magic, Magic, sizeof(Magic)) == 0;
+}
+
+// -----------------------------------------------------------------------------------
+void SceneCacheImporter::InternReadFile(const std::string &pFile, aiScene *pScene, IOSystem *pIOHandler) {
+    std::unique_ptr<IOStream> in(pIOHandler->Open(pFile, "rb"));
+    if (!in) {
+        throw DeadlyImportError("Failed to open file ", pFile, ".");
+    }
+
+    // one read into 8 byte aligned memory, the view reads the records in place
+    const size_t size = in->FileSize();
+    std::unique_ptr<uint64_t[]> buffer(new uint64_t[size / sizeof(uint64_t) + 1]);
+    if (size == 0 || in->Read(buffer.get(), size, 1) != 1) {
+        throw DeadlyImportError("Scene cache: failed to read ", pFile);
+    }
+    ReadScene(SceneCacheView(buffer.get(), size), pScene);
+}
+
+// -----------------------------------------------------------------------------------
+void SceneCacheImporter::ReadScene(const SceneCacheView &view, aiScene *pScene) {
+    const Header &header = view.GetHeader();
+    pScene->mFlags = header.mFlags;
+    pScene->mName = view.GetString(header.mName);
+    pScene->mRootNode = ReadNodes(view, header.mNodes, header.mMeshes.mCount);
+    pScene->mMetaData = ReadMetadata(view, header.mMetadata);
+
+    ReadList<aiMesh, Mesh>(view, header.mMeshes, pScene->mMeshes, pScene->mNumMeshes, ReadMesh);
+    ReadList<aiMaterial, Array>(view, header.mMaterials, pScene->mMaterials, pScene->mNumMaterials, ReadMaterial);
+    ReadList<aiAnimation, Animation>(view, header.mAnimations, pScene->mAnimations, pScene->mNumAnimations, ReadAnimation);
+    ReadList<aiTexture, Texture>(view, header.mTextures, pScene->mTextures, pScene->mNumTextures, ReadTexture);
+    ReadList<aiLight, Light>(view, header.mLights, pScene->mLights, pScene->mNumLights, ReadLight);
+    ReadList<aiCamera, Camera>(view, header.mCameras, pScene->mCameras, pScene->mNumCameras, ReadCamera);
+
+    // the cache is loaded without validation, so references are checked here. Without
+    // materials only index 0 is valid, it is the default material added afterwards
+    const unsigned int numMaterials = std::max(pScene->mNumMaterials, 1u);
+    for (unsigned int i = 0; i < pScene->mNumMeshes; ++i) {
+        if (pScene->mMeshes[i]->mMaterialIndex >= numMaterials) {
+            throw DeadlyImportError("Scene cache: mesh ", i, " references material ", pScene->mMeshes[i]->mMaterialIndex, " out of range");
+        }
+    }
+}
+
+#endif // !! ASSIMP_BUILD_NO_SCENECACHE_IMPORTER
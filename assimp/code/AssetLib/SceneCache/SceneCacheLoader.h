@@ -0,0 +1,80 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2022, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file  SceneCacheLoader.h
+ *  @brief Declares the importer of the scene cache format.
+ */
+#pragma once
+#ifndef AI_SCENECACHELOADER_H_INC
+#define AI_SCENECACHELOADER_H_INC
+
+#include <assimp/BaseImporter.h>
+
+#ifndef ASSIMP_BUILD_NO_SCENECACHE_IMPORTER
+
+namespace Assimp {
+
+namespace SceneCache {
+class SceneCacheView;
+}
+
+// ---------------------------------------------------------------------------------
+/** Importer for scene caches written by the "aicache" exporter.
+ *
+ *  The file is read with a single call and the scene is rebuilt by copying
+ *  its contiguous arrays, nothing is parsed. A cache is only readable by
+ *  builds with the same byte order and ai_real size as the writer.
+ */
+class SceneCacheImporter : public BaseImporter {
+public:
+    bool CanRead(const std::string &pFile, IOSystem *pIOHandler, bool checkSig) const override;
+    const aiImporterDesc *GetInfo() const override;
+    void InternReadFile(const std::string &pFile, aiScene *pScene, IOSystem *pIOHandler) override;
+
+    //! Rebuilds a scene from a cache that is already in memory
+    static void ReadScene(const SceneCache::SceneCacheView &view, aiScene *pScene);
+};
+
+} // end of namespace Assimp
+
+#endif // !! ASSIMP_BUILD_NO_SCENECACHE_IMPORTER
+
+#endif // AI_SCENECACHELOADER_H_INC
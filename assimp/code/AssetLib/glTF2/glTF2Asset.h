@@ -51,6 +51,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  *   KHR_materials_transmission full
  *   KHR_materials_volume full
  *   KHR_materials_ior full
+ *   KHR_draco_mesh_compression full (when built with ASSIMP_BUILD_DRACO)
+ *   EXT_meshopt_compression full
  */
 #ifndef GLTF2ASSET_H_INC
 #define GLTF2ASSET_H_INC
@@ -544,8 +546,13 @@ struct BufferView : public Object {
 
     BufferViewTarget target; //! The target that the WebGL buffer should be bound to.
 
+    std::shared_ptr<uint8_t> decodedData; //!< EXT_meshopt_compression decoded data, returned instead of the buffer if present
+
     void Read(Value &obj, Asset &r);
     uint8_t *GetPointer(size_t accOffset);
+
+private:
+    void DecodeMeshopt(Value &ext, Asset &r);
 };
 
 //! A typed view into a BufferView. A BufferView contains raw binary data.
@@ -1109,6 +1116,7 @@ public:
         bool KHR_draco_mesh_compression;
         bool FB_ngon_encoding;
         bool KHR_texture_basisu;
+        bool EXT_meshopt_compression;
 
         Extensions() :
                 KHR_materials_pbrSpecularGlossiness(false), 
@@ -1122,7 +1130,8 @@ public:
                 KHR_materials_ior(false),
                 KHR_draco_mesh_compression(false),
                 FB_ngon_encoding(false),
-                KHR_texture_basisu(false) {
+                KHR_texture_basisu(false),
+                EXT_meshopt_compression(false) {
             // empty
         }
     } extensionsUsed;
@@ -1131,8 +1140,9 @@ public:
     struct RequiredExtensions {
         bool KHR_draco_mesh_compression;
         bool KHR_texture_basisu;
+        bool EXT_meshopt_compression;
 
-        RequiredExtensions() : KHR_draco_mesh_compression(false), KHR_texture_basisu(false) {
+        RequiredExtensions() : KHR_draco_mesh_compression(false), KHR_texture_basisu(false), EXT_meshopt_compression(false) {
             // empty
         }
     } extensionsRequired;
@@ -1199,6 +1209,20 @@ public:
 
     Ref<Buffer> GetBodyBuffer() { return mBodyBuffer; }
 
+#ifdef ASSIMP_ENABLE_DRACO
+    //! A Draco compressed primitive found while reading the meshes. The decoding itself
+    //! is deferred so that all primitives of the asset can be decoded concurrently.
+    struct DracoPrimitive {
+        Mesh *mesh; //!< The mesh owning the primitive
+        unsigned int primitiveIndex; //!< Index into mesh->primitives
+        Ref<BufferView> bufferView; //!< The compressed data
+        std::vector<std::pair<uint32_t, Ref<Accessor>>> attributes; //!< Draco attribute id and the accessor it replaces
+    };
+
+    //! Queues a primitive for DecodeDracoPrimitives(), called by Mesh::Read
+    void AddDracoPrimitive(DracoPrimitive &&prim) { mDracoPrimitives.push_back(std::move(prim)); }
+#endif
+
     Asset(Asset &) = delete;
     Asset &operator=(const Asset &) = delete;
 
@@ -1213,6 +1237,11 @@ private:
     void ReadExtensionsUsed(Document &doc);
     void ReadExtensionsRequired(Document &doc);
 
+#ifdef ASSIMP_ENABLE_DRACO
+    //! Decodes all queued Draco primitives on worker threads and redirects their accessors
+    void DecodeDracoPrimitives();
+#endif
+
     IOStream *OpenFile(const std::string &path, const char *mode, bool absolute = false);
 
 private:
@@ -1224,6 +1253,9 @@ private:
     size_t mBodyLength;
     IdMap mUsedIds;
     Ref<Buffer> mBodyBuffer;
+#ifdef ASSIMP_ENABLE_DRACO
+    std::vector<DracoPrimitive> mDracoPrimitives;
+#endif
 };
 
 inline std::string getContextForErrorMessages(const std::string &id, const std::string &name) {
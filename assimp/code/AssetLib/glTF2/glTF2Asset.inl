@@ -46,6 +46,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/DefaultLogger.hpp>
 #include <assimp/Base64.hpp>
 
+#include <cmath>
+
 // clang-format off
 #ifdef ASSIMP_ENABLE_DRACO
 
@@ -67,6 +69,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "draco/compression/decode.h"
 #include "draco/core/decoder_buffer.h"
+#include "Common/ParallelFor.h"
 
 #if _MSC_VER
 #   pragma warning(pop)
@@ -214,6 +217,338 @@ inline bool GetAttribTargetVector(Mesh::Primitive &p, const int targetIndex, con
     return true;
 }
 
+//
+// EXT_meshopt_compression decoding, following the bitstream specification of the extension
+//
+namespace meshopt {
+
+const size_t kByteGroupSize = 16;
+const size_t kByteGroupDecodeLimit = 24;
+const size_t kVertexBlockSizeBytes = 8192;
+const size_t kVertexBlockMaxSize = 256;
+const size_t kTailMinSize = 32;
+
+inline const uint8_t *DecodeBytesGroup(const uint8_t *data, uint8_t *buffer, int bitslog2) {
+    if (bitslog2 == 0) {
+        memset(buffer, 0, kByteGroupSize);
+        return data;
+    }
+    if (bitslog2 == 3) {
+        memcpy(buffer, data, kByteGroupSize);
+        return data + kByteGroupSize;
+    }
+
+    // 2 or 4 bit values, the all-ones value means the byte follows the packed values
+    const int bits = bitslog2 == 1 ? 2 : 4;
+    const unsigned int sentinel = (1u << bits) - 1;
+    const uint8_t *packed = data;
+    const uint8_t *escaped = data + kByteGroupSize * bits / 8;
+    for (size_t i = 0; i < kByteGroupSize; i += 8 / bits) {
+        uint8_t byte = *packed++;
+        for (int k = 0; k < 8 / bits; ++k) {
+            const unsigned int enc = byte >> (8 - bits);
+            byte = uint8_t(byte << bits);
+            *buffer++ = enc == sentinel ? *escaped++ : uint8_t(enc);
+        }
+    }
+    return escaped;
+}
+
+inline const uint8_t *DecodeBytes(const uint8_t *data, const uint8_t *dataEnd, uint8_t *buffer, size_t bufferSize) {
+    const uint8_t *header = data;
+    const size_t headerSize = (bufferSize / kByteGroupSize + 3) / 4;
+    if (size_t(dataEnd - data) < headerSize) {
+        return nullptr;
+    }
+    data += headerSize;
+
+    for (size_t i = 0; i < bufferSize; i += kByteGroupSize) {
+        // a group reads at most 24 bytes, which the tail of the stream guarantees
+        if (size_t(dataEnd - data) < kByteGroupDecodeLimit) {
+            return nullptr;
+        }
+        const size_t group = i / kByteGroupSize;
+        const int bitslog2 = (header[group / 4] >> ((group % 4) * 2)) & 3;
+        data = DecodeBytesGroup(data, buffer + i, bitslog2);
+    }
+    return data;
+}
+
+inline void DecodeVertexBuffer(uint8_t *dst, size_t count, size_t stride, const uint8_t *src, size_t srcSize) {
+    if (stride == 0 || stride > 256 || stride % 4 != 0) {
+        throw DeadlyImportError("GLTF: EXT_meshopt_compression attribute stride ", stride, " is invalid.");
+    }
+    const uint8_t *data = src;
+    const uint8_t *dataEnd = src + srcSize;
+    const size_t tailSize = std::max(stride, kTailMinSize);
+    if (srcSize < 1 + tailSize || data[0] != 0xa0) {
+        throw DeadlyImportError("GLTF: EXT_meshopt_compression attribute stream has an invalid header.");
+    }
+    ++data;
+
+    // the tail of the stream holds the baseline the first vertex is delta encoded against
+    uint8_t lastVertex[256];
+    memcpy(lastVertex, dataEnd - stride, stride);
+
+    size_t blockSize = (kVertexBlockSizeBytes / stride) & ~(kByteGroupSize - 1);
+    blockSize = std::min(blockSize, kVertexBlockMaxSize);
+
+    uint8_t buffer[kVertexBlockMaxSize];
+    for (size_t offset = 0; offset < count; offset += blockSize) {
+        const size_t blockCount = std::min(blockSize, count - offset);
+        const size_t alignedCount = (blockCount + kByteGroupSize - 1) & ~(kByteGroupSize - 1);
+        uint8_t *block = dst + offset * stride;
+
+        for (size_t k = 0; k < stride; ++k) {
+            data = DecodeBytes(data, dataEnd, buffer, alignedCount);
+            if (!data) {
+                throw DeadlyImportError("GLTF: EXT_meshopt_compression attribute stream is truncated.");
+            }
+
+            uint8_t p = lastVertex[k];
+            for (size_t i = 0; i < blockCount; ++i) {
+                const uint8_t v = buffer[i];
+                p = uint8_t(p + ((v >> 1) ^ (0u - (v & 1))));
+                block[i * stride + k] = p;
+            }
+            lastVertex[k] = p;
+        }
+    }
+
+    if (size_t(dataEnd - data) != tailSize) {
+        throw DeadlyImportError("GLTF: EXT_meshopt_compression attribute stream has trailing data.");
+    }
+}
+
+inline unsigned int DecodeVByte(const uint8_t *&data) {
+    uint8_t lead = *data++;
+    if (lead < 128) {
+        return lead;
+    }
+
+    unsigned int result = lead & 127;
+    unsigned int shift = 7;
+    for (int i = 0; i < 4; ++i) {
+        uint8_t group = *data++;
+        result |= unsigned(group & 127) << shift;
+        shift += 7;
+        if (group < 128) {
+            break;
+        }
+    }
+    return result;
+}
+
+inline unsigned int DecodeIndex(const uint8_t *&data, unsigned int last) {
+    const unsigned int v = DecodeVByte(data);
+    return last + ((v >> 1) ^ (0u - (v & 1)));
+}
+
+inline void WriteIndex(uint8_t *dst, size_t i, size_t indexSize, unsigned int value) {
+    if (indexSize == 2) {
+        const uint16_t v = uint16_t(value);
+        memcpy(dst + i * 2, &v, 2);
+    } else {
+        memcpy(dst + i * 4, &value, 4);
+    }
+}
+
+inline void DecodeIndexBuffer(uint8_t *dst, size_t count, size_t indexSize, const uint8_t *src, size_t srcSize) {
+    if (count % 3 != 0 || (indexSize != 2 && indexSize != 4)) {
+        throw DeadlyImportError("GLTF: EXT_meshopt_compression triangle stream with count ", count, " and stride ", indexSize, " is invalid.");
+    }
+    if (srcSize < 1 + count / 3 + 16 || (src[0] & 0xf0) != 0xe0 || (src[0] & 0x0f) > 1) {
+        throw DeadlyImportError("GLTF: EXT_meshopt_compression triangle stream has an invalid header.");
+    }
+    static const uint8_t codeAuxTable[16] = {
+        0x00, 0x76, 0x87, 0x56, 0x67, 0x78, 0xa9, 0x86, 0x65, 0x89, 0x68, 0x98, 0x01, 0x69, 0, 0
+    };
+    const int version = src[0] & 0x0f;
+    const unsigned int fecMax = version >= 1 ? 13 : 15;
+
+    unsigned int edgeFifo[16][2];
+    unsigned int vertexFifo[16];
+    memset(edgeFifo, -1, sizeof(edgeFifo));
+    memset(vertexFifo, -1, sizeof(vertexFifo));
+    size_t edgeOffset = 0, vertexOffset = 0;
+    unsigned int next = 0, last = 0;
+
+    auto pushEdge = [&](unsigned int a, unsigned int b) {
+        edgeFifo[edgeOffset][0] = a;
+        edgeFifo[edgeOffset][1] = b;
+        edgeOffset = (edgeOffset + 1) & 15;
+    };
+    auto pushVertex = [&](unsigned int v, bool cond = true) {
+        vertexFifo[vertexOffset] = v;
+        vertexOffset = (vertexOffset + (cond ? 1 : 0)) & 15;
+    };
+
+    // the 16 byte code table at the end bounds the data, a triangle reads at most 16 bytes
+    const uint8_t *code = src + 1;
+    const uint8_t *data = code + count / 3;
+    const uint8_t *dataSafeEnd = src + srcSize - 16;
+
+    for (size_t i = 0; i < count; i += 3) {
+        if (data > dataSafeEnd) {
+            throw DeadlyImportError("GLTF: EXT_meshopt_compression triangle stream is truncated.");
+        }
+        unsigned int a, b, c;
+        const uint8_t codeTri = *code++;
+
+        if (codeTri < 0xf0) {
+            // triangle sharing an edge from the edge fifo
+            const unsigned int fe = codeTri >> 4;
+            a = edgeFifo[(edgeOffset - 1 - fe) & 15][0];
+            b = edgeFifo[(edgeOffset - 1 - fe) & 15][1];
+            const unsigned int fec = codeTri & 15;
+            if (fec < fecMax) {
+                c = fec == 0 ? next++ : vertexFifo[(vertexOffset - 1 - fec) & 15];
+                pushVertex(c, fec == 0);
+            } else {
+                // 13 and 14 are -1 and +1 deltas from the last free index
+                last = c = fec != 15 ? last + (fec - (fec ^ 3)) : DecodeIndex(data, last);
+                pushVertex(c);
+            }
+            pushEdge(c, b);
+            pushEdge(a, c);
+        } else {
+            unsigned int feb, fec;
+            bool freeA = false;
+            if (codeTri < 0xfe) {
+                const uint8_t codeAux = codeAuxTable[codeTri & 15];
+                feb = codeAux >> 4;
+                fec = codeAux & 15;
+            } else {
+                const uint8_t codeAux = *data++;
+                feb = codeAux >> 4;
+                fec = codeAux & 15;
+                freeA = codeTri == 0xff;
+                if (codeAux == 0) {
+                    next = 0;
+                }
+            }
+
+            a = freeA ? 0 : next++;
+            b = feb == 0 ? next++ : vertexFifo[(vertexOffset - feb) & 15];
+            c = fec == 0 ? next++ : vertexFifo[(vertexOffset - fec) & 15];
+            if (freeA) {
+                last = a = DecodeIndex(data, last);
+            }
+            if (feb == 15) {
+                last = b = DecodeIndex(data, last);
+            }
+            if (fec == 15) {
+                last = c = DecodeIndex(data, last);
+            }
+
+            pushVertex(a);
+            pushVertex(b, feb == 0 || feb == 15);
+            pushVertex(c, fec == 0 || fec == 15);
+            pushEdge(b, a);
+            pushEdge(c, b);
+            pushEdge(a, c);
+        }
+
+        WriteIndex(dst, i + 0, indexSize, a);
+        WriteIndex(dst, i + 1, indexSize, b);
+        WriteIndex(dst, i + 2, indexSize, c);
+    }
+
+    if (data != dataSafeEnd) {
+        throw DeadlyImportError("GLTF: EXT_meshopt_compression triangle stream has trailing data.");
+    }
+}
+
+inline void DecodeIndexSequence(uint8_t *dst, size_t count, size_t indexSize, const uint8_t *src, size_t srcSize) {
+    if (indexSize != 2 && indexSize != 4) {
+        throw DeadlyImportError("GLTF: EXT_meshopt_compression index stream with stride ", indexSize, " is invalid.");
+    }
+    if (srcSize < 1 + count + 4 || (src[0] & 0xf0) != 0xd0 || (src[0] & 0x0f) > 1) {
+        throw DeadlyImportError("GLTF: EXT_meshopt_compression index stream has an invalid header.");
+    }
+
+    // each index reads at most 5 bytes, the 4 byte tail bounds the data
+    const uint8_t *data = src + 1;
+    const uint8_t *dataSafeEnd = src + srcSize - 4;
+    unsigned int last[2] = { 0, 0 };
+    for (size_t i = 0; i < count; ++i) {
+        if (data >= dataSafeEnd) {
+            throw DeadlyImportError("GLTF: EXT_meshopt_compression index stream is truncated.");
+        }
+        unsigned int v = DecodeVByte(data);
+        // the low bit selects which of the two baselines the delta is relative to
+        const unsigned int current = v & 1;
+        v >>= 1;
+        last[current] += (v >> 1) ^ (0u - (v & 1));
+        WriteIndex(dst, i, indexSize, last[current]);
+    }
+
+    if (data != dataSafeEnd) {
+        throw DeadlyImportError("GLTF: EXT_meshopt_compression index stream has trailing data.");
+    }
+}
+
+template <typename T>
+inline void FilterOctahedral(uint8_t *data, size_t count) {
+    const float max = float((1 << (sizeof(T) * 8 - 1)) - 1);
+    for (size_t i = 0; i < count; ++i) {
+        T v[4];
+        memcpy(v, data + i * sizeof(v), sizeof(v));
+
+        // the third component holds the scale the octahedral x and y are quantized to
+        float x = float(v[0]);
+        float y = float(v[1]);
+        float z = float(v[2]) - std::fabs(x) - std::fabs(y);
+        const float t = z < 0.f ? z : 0.f;
+        x += x >= 0.f ? t : -t;
+        y += y >= 0.f ? t : -t;
+
+        const float s = max / std::sqrt(x * x + y * y + z * z);
+        v[0] = T(int(x * s + (x >= 0.f ? 0.5f : -0.5f)));
+        v[1] = T(int(y * s + (y >= 0.f ? 0.5f : -0.5f)));
+        v[2] = T(int(z * s + (z >= 0.f ? 0.5f : -0.5f)));
+        memcpy(data + i * sizeof(v), v, sizeof(v));
+    }
+}
+
+inline void FilterQuaternion(uint8_t *data, size_t count) {
+    const float scale = 1.f / std::sqrt(2.f);
+    for (size_t i = 0; i < count; ++i) {
+        int16_t v[4];
+        memcpy(v, data + i * sizeof(v), sizeof(v));
+
+        // the fourth component holds the scale and the index of the omitted largest component
+        const float ss = scale / float(v[3] | 3);
+        const float x = float(v[0]) * ss;
+        const float y = float(v[1]) * ss;
+        const float z = float(v[2]) * ss;
+        const float ww = 1.f - x * x - y * y - z * z;
+        const float w = std::sqrt(ww >= 0.f ? ww : 0.f);
+
+        const int qc = v[3] & 3;
+        v[(qc + 1) & 3] = int16_t(int(x * 32767.f + (x >= 0.f ? 0.5f : -0.5f)));
+        v[(qc + 2) & 3] = int16_t(int(y * 32767.f + (y >= 0.f ? 0.5f : -0.5f)));
+        v[(qc + 3) & 3] = int16_t(int(z * 32767.f + (z >= 0.f ? 0.5f : -0.5f)));
+        v[(qc + 0) & 3] = int16_t(int(w * 32767.f + 0.5f));
+        memcpy(data + i * sizeof(v), v, sizeof(v));
+    }
+}
+
+inline void FilterExponential(uint8_t *data, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        uint32_t v;
+        memcpy(&v, data + i * 4, 4);
+
+        // 24 bit signed mantissa and 8 bit signed exponent
+        const int m = int32_t(v << 8) >> 8;
+        const int e = int32_t(v) >> 24;
+        const float f = std::ldexp(float(m), e);
+        memcpy(data + i * 4, &f, 4);
+    }
+}
+
+} // namespace meshopt
+
 } // namespace
 
 inline Value *Object::FindString(Value &val, const char *memberId) {
@@ -279,6 +614,7 @@ inline void SetDecodedIndexBuffer_Draco(const draco::Mesh &dracoMesh, Mesh::Prim
     // Usually uint32_t but shouldn't assume
     if (sizeof(dracoMesh.face(draco::FaceIndex(0))[0]) == componentBytes) {
         memcpy(decodedIndexBuffer->GetPointer(), &dracoMesh.face(draco::FaceIndex(0))[0], decodedIndexBuffer->byteLength);
+        prim.indices->decodedBuffer.swap(decodedIndexBuffer);
         return;
     }
 
@@ -564,6 +900,12 @@ inline void Buffer::Read(Value &obj, Asset &r) {
 
     Value *it = FindString(obj, "uri");
     if (!it) {
+        // EXT_meshopt_compression fallback buffers may omit their data, only decoded views refer to them
+        if (Value *meshoptExt = FindExtension(obj, "EXT_meshopt_compression")) {
+            if (MemberOrDefault(*meshoptExt, "fallback", false)) {
+                return;
+            }
+        }
         if (statedLength > 0) {
             throw DeadlyImportError("GLTF: buffer with non-zero length missing the \"uri\" attribute");
         }
@@ -768,9 +1110,72 @@ inline void BufferView::Read(Value &obj, Asset &r) {
     if ((byteOffset + byteLength) > buffer->byteLength) {
         throw DeadlyImportError("GLTF: Buffer view with offset/length (", byteOffset, "/", byteLength, ") is out of range.");
     }
+
+    if (r.extensionsUsed.EXT_meshopt_compression) {
+        if (Value *meshoptExt = FindExtension(obj, "EXT_meshopt_compression")) {
+            DecodeMeshopt(*meshoptExt, r);
+        }
+    }
+}
+
+inline void BufferView::DecodeMeshopt(Value &ext, Asset &r) {
+    Ref<Buffer> source;
+    if (Value *bufferVal = FindUInt(ext, "buffer")) {
+        source = r.buffers.Retrieve(bufferVal->GetUint());
+    }
+    if (!source || !source->GetPointer()) {
+        throw DeadlyImportError("GLTF: EXT_meshopt_compression in ", id, " without valid buffer.");
+    }
+
+    const size_t srcOffset = MemberOrDefault(ext, "byteOffset", size_t(0));
+    const size_t srcLength = MemberOrDefault(ext, "byteLength", size_t(0));
+    const size_t stride = MemberOrDefault(ext, "byteStride", size_t(0));
+    const size_t count = MemberOrDefault(ext, "count", size_t(0));
+    if (srcOffset + srcLength > source->byteLength || srcOffset + srcLength < srcOffset) {
+        throw DeadlyImportError("GLTF: EXT_meshopt_compression in ", id, " with offset/length (", srcOffset, "/", srcLength, ") is out of range.");
+    }
+    if (stride == 0 || stride > 256 || count > std::numeric_limits<size_t>::max() / stride || count * stride < byteLength) {
+        throw DeadlyImportError("GLTF: EXT_meshopt_compression in ", id, " with stride/count (", stride, "/", count, ") does not cover the buffer view.");
+    }
+
+    const size_t decodedLength = count * stride;
+    decodedData.reset(new uint8_t[decodedLength], std::default_delete<uint8_t[]>());
+    uint8_t *dst = decodedData.get();
+    const uint8_t *src = source->GetPointer() + srcOffset;
+
+    const char *mode = "";
+    ReadMember(ext, "mode", mode);
+    if (strcmp(mode, "ATTRIBUTES") == 0) {
+        meshopt::DecodeVertexBuffer(dst, count, stride, src, srcLength);
+    } else if (strcmp(mode, "TRIANGLES") == 0) {
+        meshopt::DecodeIndexBuffer(dst, count, stride, src, srcLength);
+    } else if (strcmp(mode, "INDICES") == 0) {
+        meshopt::DecodeIndexSequence(dst, count, stride, src, srcLength);
+    } else {
+        throw DeadlyImportError("GLTF: EXT_meshopt_compression in ", id, " has unknown mode \"", mode, "\".");
+    }
+
+    const char *filter = "NONE";
+    ReadMember(ext, "filter", filter);
+    if (strcmp(filter, "OCTAHEDRAL") == 0 && (stride == 4 || stride == 8)) {
+        if (stride == 4) {
+            meshopt::FilterOctahedral<int8_t>(dst, count);
+        } else {
+            meshopt::FilterOctahedral<int16_t>(dst, count);
+        }
+    } else if (strcmp(filter, "QUATERNION") == 0 && stride == 8) {
+        meshopt::FilterQuaternion(dst, count);
+    } else if (strcmp(filter, "EXPONENTIAL") == 0 && stride % 4 == 0) {
+        meshopt::FilterExponential(dst, count * stride / 4);
+    } else if (strcmp(filter, "NONE") != 0) {
+        throw DeadlyImportError("GLTF: EXT_meshopt_compression in ", id, " has invalid filter \"", filter, "\" for stride ", stride, ".");
+    }
 }
 
 inline uint8_t *BufferView::GetPointer(size_t accOffset) {
+    if (decodedData) {
+        return decodedData.get() + accOffset;
+    }
     if (!buffer) {
         return nullptr;
     }
@@ -927,6 +1332,9 @@ inline uint8_t *Accessor::GetPointer() {
     if (sparse)
         return sparse->data.data();
 
+    if (bufferView && bufferView->decodedData)
+        return bufferView->GetPointer(byteOffset);
+
     if (!bufferView || !bufferView->buffer) return nullptr;
     uint8_t *basePtr = bufferView->buffer->GetPointer();
     if (!basePtr) return nullptr;
@@ -1090,13 +1498,11 @@ inline void Image::Read(Value &obj, Asset &r) {
                 throw DeadlyImportError("GLTF2: ", getContextForErrorMessages(id, name), " does not have a URI, so it must have a valid bufferView and mimetype");
             }
 
-            Ref<Buffer> buffer = this->bufferView->buffer;
-
             this->mDataLength = this->bufferView->byteLength;
             // maybe this memcpy could be avoided if aiTexture does not delete[] pcData at destruction.
 
             this->mData.reset(new uint8_t[this->mDataLength]);
-            memcpy(this->mData.get(), buffer->GetPointer() + this->bufferView->byteOffset, this->mDataLength);
+            memcpy(this->mData.get(), this->bufferView->GetPointer(0), this->mDataLength);
         } else {
             throw DeadlyImportError("GLTF2: ", getContextForErrorMessages(id, name), " should have either a URI of a bufferView and mimetype");
         }
@@ -1407,26 +1813,12 @@ inline void Mesh::Read(Value &pJSON_Object, Asset &pAsset_Root) {
                 // Skip if any missing
                 if (Value *dracoExt = FindExtension(primitive, "KHR_draco_mesh_compression")) {
                     if (Value *bufView = FindUInt(*dracoExt, "bufferView")) {
-                        // Attempt to load indices and attributes using draco compression
-                        auto bufferView = pAsset_Root.bufferViews.Retrieve(bufView->GetUint());
-                        // Attempt to perform the draco decode on the buffer data
-                        const char *bufferViewData = reinterpret_cast<const char *>(bufferView->buffer->GetPointer() + bufferView->byteOffset);
-                        draco::DecoderBuffer decoderBuffer;
-                        decoderBuffer.Init(bufferViewData, bufferView->byteLength);
-                        draco::Decoder decoder;
-                        auto decodeResult = decoder.DecodeMeshFromBuffer(&decoderBuffer);
-                        if (!decodeResult.ok()) {
-                            // A corrupt Draco isn't actually fatal if the primitive data is also provided in a standard buffer, but does anyone do that?
-                            throw DeadlyImportError("GLTF: Invalid Draco mesh compression in mesh: ", name, " primitive: ", i, ": ", decodeResult.status().error_msg_string());
-                        }
-
-                        // Now we have a draco mesh
-                        const std::unique_ptr<draco::Mesh> &pDracoMesh = decodeResult.value();
-
-                        // Redirect the accessors to the decoded data
-
-                        // Indices
-                        SetDecodedIndexBuffer_Draco(*pDracoMesh, prim);
+                        // Queue the primitive, the decoding of all Draco primitives of the asset
+                        // happens at once in Asset::DecodeDracoPrimitives()
+                        Asset::DracoPrimitive dracoPrim;
+                        dracoPrim.mesh = this;
+                        dracoPrim.primitiveIndex = i;
+                        dracoPrim.bufferView = pAsset_Root.bufferViews.Retrieve(bufView->GetUint());
 
                         // Vertex attributes
                         if (Value *attrs = FindObject(*dracoExt, "attributes")) {
@@ -1448,16 +1840,16 @@ inline void Mesh::Read(Value &pJSON_Object, Asset &pAsset_Root) {
                                                 ". All draco-encoded attributes must also define an accessor.");
                                     }
 
-                                    Accessor &attribAccessor = *(*vec)[idx];
-                                    if (attribAccessor.count == 0)
+                                    if ((*vec)[idx]->count == 0)
                                         throw DeadlyImportError("GLTF: Invalid draco attribute in mesh: ", name, " primitive: ", i, " attrib: ", attr);
 
-                                    // Redirect this accessor to the appropriate Draco vertex attribute data
-                                    const uint32_t dracoAttribId = it->value.GetUint();
-                                    SetDecodedAttributeBuffer_Draco(*pDracoMesh, dracoAttribId, attribAccessor);
+                                    // This accessor will be redirected to the appropriate Draco vertex attribute data
+                                    dracoPrim.attributes.emplace_back(it->value.GetUint(), (*vec)[idx]);
                                 }
                             }
                         }
+
+                        pAsset_Root.AddDracoPrimitive(std::move(dracoPrim));
                     }
                 }
             }
@@ -1954,6 +2346,11 @@ inline void Asset::Load(const std::string &pFile, bool isBinary)
         }
     }
 
+#ifdef ASSIMP_ENABLE_DRACO
+    // All meshes are read now, decode their compressed primitives
+    DecodeDracoPrimitives();
+#endif
+
     // Clean up
     for (size_t i = 0; i < mDicts.size(); ++i) {
         mDicts[i]->DetachFromDocument();
@@ -1975,6 +2372,61 @@ inline bool Asset::CanRead(const std::string &pFile, bool isBinary) {
     return true;
 }
 
+#ifdef ASSIMP_ENABLE_DRACO
+inline void Asset::DecodeDracoPrimitives() {
+    if (mDracoPrimitives.empty()) {
+        return;
+    }
+
+    // The accessors are redirected by the workers, so a shared accessor forces serial decoding
+    bool sharedAccessors = false;
+    std::set<const Accessor *> accessorSet;
+    for (DracoPrimitive &dracoPrim : mDracoPrimitives) {
+        Ref<Accessor> &indices = dracoPrim.mesh->primitives[dracoPrim.primitiveIndex].indices;
+        if (indices && !accessorSet.insert(&*indices).second) {
+            sharedAccessors = true;
+        }
+        for (auto &attrib : dracoPrim.attributes) {
+            if (!accessorSet.insert(&*attrib.second).second) {
+                sharedAccessors = true;
+            }
+        }
+    }
+
+    auto decodeRange = [this](size_t begin, size_t end) {
+        for (size_t p = begin; p < end; ++p) {
+            DracoPrimitive &dracoPrim = mDracoPrimitives[p];
+            Mesh::Primitive &prim = dracoPrim.mesh->primitives[dracoPrim.primitiveIndex];
+
+            // Attempt to perform the draco decode on the buffer data
+            const char *bufferViewData = reinterpret_cast<const char *>(dracoPrim.bufferView->GetPointer(0));
+            draco::DecoderBuffer decoderBuffer;
+            decoderBuffer.Init(bufferViewData, dracoPrim.bufferView->byteLength);
+            draco::Decoder decoder;
+            auto decodeResult = decoder.DecodeMeshFromBuffer(&decoderBuffer);
+            if (!decodeResult.ok()) {
+                // A corrupt Draco isn't actually fatal if the primitive data is also provided in a standard buffer, but does anyone do that?
+                throw DeadlyImportError("GLTF: Invalid Draco mesh compression in mesh: ", dracoPrim.mesh->name, " primitive: ", dracoPrim.primitiveIndex, ": ", decodeResult.status().error_msg_string());
+            }
+
+            // Now we have a draco mesh, redirect the accessors to the decoded data
+            const std::unique_ptr<draco::Mesh> &pDracoMesh = decodeResult.value();
+            SetDecodedIndexBuffer_Draco(*pDracoMesh, prim);
+            for (auto &attrib : dracoPrim.attributes) {
+                SetDecodedAttributeBuffer_Draco(*pDracoMesh, attrib.first, *attrib.second);
+            }
+        }
+    };
+
+    if (sharedAccessors) {
+        decodeRange(0, mDracoPrimitives.size());
+    } else {
+        Assimp::ParallelFor(mDracoPrimitives.size(), 1, decodeRange);
+    }
+    mDracoPrimitives.clear();
+}
+#endif // ASSIMP_ENABLE_DRACO
+
 inline void Asset::SetAsBinary() {
     if (!mBodyBuffer) {
         mBodyBuffer = buffers.Create("binary_glTF");
@@ -2001,6 +2453,7 @@ inline void Asset::ReadExtensionsRequired(Document &doc) {
     }
 
     CHECK_REQUIRED_EXT(KHR_draco_mesh_compression);
+    CHECK_REQUIRED_EXT(EXT_meshopt_compression);
 
 #undef CHECK_REQUIRED_EXT
 }
@@ -2028,6 +2481,7 @@ inline void Asset::ReadExtensionsUsed(Document &doc) {
     CHECK_EXT(KHR_materials_ior);
     CHECK_EXT(KHR_draco_mesh_compression);
     CHECK_EXT(KHR_texture_basisu);
+    CHECK_EXT(EXT_meshopt_compression);
 
 #undef CHECK_EXT
 }
@@ -59,6 +59,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/scene.h>
 #include <assimp/DefaultLogger.hpp>
 #include <assimp/Importer.hpp>
+#include <assimp/Profiler.h>
 
 #include <memory>
 #include <unordered_map>
@@ -1624,12 +1625,16 @@ void glTF2Importer::InternReadFile(const std::string &pFile, aiScene *pScene, IO
 
     // read the asset file
     glTF2::Asset asset(pIOHandler, static_cast<rapidjson::IRemoteSchemaDocumentProvider *>(mSchemaDocumentProvider));
-    asset.Load(pFile, GetExtension(pFile) == "glb");
+    {
+        Profiling::ProfileScope profile(m_profiler, "parse");
+        asset.Load(pFile, GetExtension(pFile) == "glb");
+    }
     if (asset.scene) {
         pScene->mName = asset.scene->name;
     }
 
     // Copy the data out
+    Profiling::ProfileScope profile(m_profiler, "convert", pScene);
     ImportEmbeddedTextures(asset);
     ImportMaterials(asset);
 
@@ -106,6 +106,19 @@ static std::string gLastErrorString;
 /** Verbose logging active or not? */
 static aiBool gVerboseLogging = false;
 
+/** Importers kept alive by #aiReleaseImport for the next imports */
+struct ImporterPool {
+    std::vector<Importer *> importers;
+    size_t capacity = 0;
+
+    ~ImporterPool() {
+        for (Importer *imp : importers) {
+            delete imp;
+        }
+    }
+};
+static ImporterPool gImporterPool;
+
 /** will return all registered importers. */
 void GetImporterInstanceList(std::vector<BaseImporter *> &out);
 
@@ -116,6 +129,9 @@ void DeleteImporterInstanceList(std::vector<BaseImporter *> &out);
 #ifndef ASSIMP_BUILD_SINGLETHREADED
 /** Global mutex to manage the access to the log-stream map */
 static std::mutex gLogStreamMutex;
+
+/** Global mutex to manage the access to the importer pool */
+static std::mutex gImporterPoolMutex;
 #endif
 
 // ------------------------------------------------------------------------------------------------
@@ -162,6 +178,52 @@ void ReportSceneNotFoundError() {
     ai_assert(false);
 }
 
+// ------------------------------------------------------------------------------------------------
+// Take an importer from the pool, or create one, and copy the properties into it
+static Importer *AcquireImporter(const aiPropertyStore *props) {
+    Importer *imp = nullptr;
+    {
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+        std::lock_guard<std::mutex> lock(gImporterPoolMutex);
+#endif
+        if (!gImporterPool.importers.empty()) {
+            imp = gImporterPool.importers.back();
+            gImporterPool.importers.pop_back();
+        }
+    }
+    if (nullptr == imp) {
+        imp = new Importer();
+    }
+
+    // copy properties
+    if (props) {
+        const PropertyMap *pp = reinterpret_cast<const PropertyMap *>(props);
+        ImporterPimpl *pimpl = imp->Pimpl();
+        pimpl->mIntProperties = pp->ints;
+        pimpl->mFloatProperties = pp->floats;
+        pimpl->mStringProperties = pp->strings;
+        pimpl->mMatrixProperties = pp->matrices;
+    }
+    return imp;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Put an importer back into the pool, or destroy it if the pool is full
+static void ReleaseImporter(Importer *imp) {
+    // this also deletes the scene
+    imp->Reset();
+    {
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+        std::lock_guard<std::mutex> lock(gImporterPoolMutex);
+#endif
+        if (gImporterPool.importers.size() < gImporterPool.capacity) {
+            gImporterPool.importers.push_back(imp);
+            return;
+        }
+    }
+    delete imp;
+}
+
 // ------------------------------------------------------------------------------------------------
 // Reads the given file and returns its content.
 const aiScene *aiImportFile(const char *pFile, unsigned int pFlags) {
@@ -182,17 +244,7 @@ const aiScene *aiImportFileExWithProperties(const char *pFile, unsigned int pFla
     ASSIMP_BEGIN_EXCEPTION_REGION();
 
     // create an Importer for this file
-    Assimp::Importer *imp = new Assimp::Importer();
-
-    // copy properties
-    if (props) {
-        const PropertyMap *pp = reinterpret_cast<const PropertyMap *>(props);
-        ImporterPimpl *pimpl = imp->Pimpl();
-        pimpl->mIntProperties = pp->ints;
-        pimpl->mFloatProperties = pp->floats;
-        pimpl->mStringProperties = pp->strings;
-        pimpl->mMatrixProperties = pp->matrices;
-    }
+    Assimp::Importer *imp = AcquireImporter(props);
     // setup a custom IO system if necessary
     if (pFS) {
         imp->SetIOHandler(new CIOSystemWrapper(pFS));
@@ -208,7 +260,7 @@ const aiScene *aiImportFileExWithProperties(const char *pFile, unsigned int pFla
     } else {
         // if failed, extract error code and destroy the import
         gLastErrorString = imp->GetErrorString();
-        delete imp;
+        ReleaseImporter(imp);
     }
 
     // return imported data. If the import failed the pointer is nullptr anyways
@@ -240,17 +292,7 @@ const aiScene *aiImportFileFromMemoryWithProperties(
     ASSIMP_BEGIN_EXCEPTION_REGION();
 
     // create an Importer for this file
-    Assimp::Importer *imp = new Assimp::Importer();
-
-    // copy properties
-    if (props) {
-        const PropertyMap *pp = reinterpret_cast<const PropertyMap *>(props);
-        ImporterPimpl *pimpl = imp->Pimpl();
-        pimpl->mIntProperties = pp->ints;
-        pimpl->mFloatProperties = pp->floats;
-        pimpl->mStringProperties = pp->strings;
-        pimpl->mMatrixProperties = pp->matrices;
-    }
+    Assimp::Importer *imp = AcquireImporter(props);
 
     // and have it read the file from the memory buffer
     scene = imp->ReadFileFromMemory(pBuffer, pLength, pFlags, pHint);
@@ -262,7 +304,41 @@ const aiScene *aiImportFileFromMemoryWithProperties(
     } else {
         // if failed, extract error code and destroy the import
         gLastErrorString = imp->GetErrorString();
-        delete imp;
+        ReleaseImporter(imp);
+    }
+    // return imported data. If the import failed the pointer is nullptr anyways
+    ASSIMP_END_EXCEPTION_REGION(const aiScene *);
+    return scene;
+}
+
+// ------------------------------------------------------------------------------------------------
+const aiScene *aiImportFileFromMemoryWithImporter(
+        const char *pBuffer,
+        unsigned int pLength,
+        unsigned int pFlags,
+        size_t pImporterIndex,
+        const char *pHint,
+        const aiPropertyStore *props) {
+    ai_assert(nullptr != pBuffer);
+    ai_assert(0 != pLength);
+
+    const aiScene *scene = nullptr;
+    ASSIMP_BEGIN_EXCEPTION_REGION();
+
+    // create an Importer for this file
+    Assimp::Importer *imp = AcquireImporter(props);
+
+    // and have the given importer read the file from the memory buffer
+    scene = imp->ReadFileFromMemoryWithImporter(pBuffer, pLength, pFlags, pImporterIndex, pHint);
+
+    // if succeeded, store the importer in the scene and keep it alive
+    if (scene) {
+        ScenePrivateData *priv = const_cast<ScenePrivateData *>(ScenePriv(scene));
+        priv->mOrigImporter = imp;
+    } else {
+        // if failed, extract error code and destroy the import
+        gLastErrorString = imp->GetErrorString();
+        ReleaseImporter(imp);
     }
     // return imported data. If the import failed the pointer is nullptr anyways
     ASSIMP_END_EXCEPTION_REGION(const aiScene *);
@@ -283,16 +359,32 @@ void aiReleaseImport(const aiScene *pScene) {
     if (!priv || !priv->mOrigImporter) {
         delete pScene;
     } else {
-        // deleting the Importer also deletes the scene
-        // Note: the reason that this is not written as 'delete priv->mOrigImporter'
-        // is a suspected bug in gcc 4.4+ (http://gcc.gnu.org/bugzilla/show_bug.cgi?id=52339)
-        Importer *importer = priv->mOrigImporter;
-        delete importer;
+        // releasing the Importer also deletes the scene
+        ReleaseImporter(priv->mOrigImporter);
     }
 
     ASSIMP_END_EXCEPTION_REGION(void);
 }
 
+// ------------------------------------------------------------------------------------------------
+// Sets the number of importers kept alive for the next imports
+void aiSetImporterPoolSize(unsigned int pSize) {
+    std::vector<Importer *> surplus;
+    {
+#ifndef ASSIMP_BUILD_SINGLETHREADED
+        std::lock_guard<std::mutex> lock(gImporterPoolMutex);
+#endif
+        gImporterPool.capacity = pSize;
+        if (gImporterPool.importers.size() > pSize) {
+            surplus.assign(gImporterPool.importers.begin() + pSize, gImporterPool.importers.end());
+            gImporterPool.importers.resize(pSize);
+        }
+    }
+    for (Importer *imp : surplus) {
+        delete imp;
+    }
+}
+
 // ------------------------------------------------------------------------------------------------
 ASSIMP_API const aiScene *aiApplyPostProcessing(const aiScene *pScene,
         unsigned int pFlags) {
@@ -462,6 +554,13 @@ size_t aiGetImportFormatCount(void) {
     return Importer().GetImporterCount();
 }
 
+// -----------------------------------------------------------------------------------------------
+// Return the index of the importer for a file extension
+size_t aiGetImportFormatIndex(const char *szExtension) {
+    ai_assert(nullptr != szExtension);
+    return Importer().GetImporterIndex(szExtension);
+}
+
 // ------------------------------------------------------------------------------------------------
 // Returns the error text of the last failed import process.
 aiBool aiIsExtensionSupported(const char *szExtension) {
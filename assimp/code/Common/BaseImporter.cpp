@@ -64,7 +64,8 @@ using namespace Assimp;
 // ------------------------------------------------------------------------------------------------
 // Constructor to be privately used by Importer
 BaseImporter::BaseImporter() AI_NO_EXCEPT
-        : m_progress() {
+        : m_progress(),
+          m_profiler() {
     // empty
 }
 
@@ -95,6 +96,7 @@ aiScene *BaseImporter::ReadFile(Importer *pImp, const std::string &pFile, IOSyst
     }
 
     ai_assert(m_progress);
+    m_profiler = pImp->GetProfiler();
 
     // Gather configuration properties for this run
     SetupProperties(pImp);
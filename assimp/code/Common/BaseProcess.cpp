@@ -43,6 +43,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "BaseProcess.h"
 #include "Importer.h"
+#include "ScenePrivate.h"
 #include <assimp/BaseImporter.h>
 #include <assimp/scene.h>
 #include <assimp/DefaultLogger.hpp>
@@ -81,9 +82,16 @@ void BaseProcess::ExecuteOnScene(Importer *pImp) {
 
     SetupProperties(pImp);
 
+    // the node name index must not outlive changes to the graph, neither the
+    // ones made by the user before the step nor the ones of the step itself
+    InvalidateNodeIndex(pImp->Pimpl()->mScene);
+
     // catch exceptions thrown inside the PostProcess-Step
     try {
         Execute(pImp->Pimpl()->mScene);
+        if (pImp->Pimpl()->mScene) {
+            InvalidateNodeIndex(pImp->Pimpl()->mScene);
+        }
     } catch (const std::exception &err) {
 
         // extract error description
@@ -118,6 +118,9 @@ void ExportSceneGLB2(const char*, IOSystem*, const aiScene*, const ExportPropert
 #ifndef ASSIMP_BUILD_NO_ASSBIN_EXPORTER
 void ExportSceneAssbin(const char*, IOSystem*, const aiScene*, const ExportProperties*);
 #endif
+#ifndef ASSIMP_BUILD_NO_SCENECACHE_EXPORTER
+void ExportSceneCache(const char*, IOSystem*, const aiScene*, const ExportProperties*);
+#endif
 #ifndef ASSIMP_BUILD_NO_ASSXML_EXPORTER
 void ExportSceneAssxml(const char*, IOSystem*, const aiScene*, const ExportProperties*);
 #endif
@@ -202,6 +205,10 @@ static void setupExporterArray(std::vector<Exporter::ExportFormatEntry> &exporte
 	exporters.emplace_back("assbin", "Assimp Binary File", "assbin", &ExportSceneAssbin, 0);
 #endif
 
+#ifndef ASSIMP_BUILD_NO_SCENECACHE_EXPORTER
+	exporters.emplace_back("aicache", "Assimp Scene Cache", "aicache", &ExportSceneCache, 0);
+#endif
+
 #ifndef ASSIMP_BUILD_NO_ASSXML_EXPORTER
 	exporters.emplace_back("assxml", "Assimp XML Document", "assxml", &ExportSceneAssxml, 0);
 #endif
@@ -492,6 +499,7 @@ aiReturn Exporter::Export( const aiScene* pScene, const char* pFormatId, const c
                 ExportProperties emptyProperties;  // Never pass nullptr ExportProperties so Exporters don't have to worry.
                 ExportProperties* pProp = pProperties ? (ExportProperties*)pProperties : &emptyProperties;
         		pProp->SetPropertyBool("bJoinIdenticalVertices", pp & aiProcess_JoinIdenticalVertices);
+                InvalidateNodeIndex(scenecopy.get());
                 exp.mExportFunction(pPath,pimpl->mIOSystem.get(),scenecopy.get(), pProp);
 
                 pimpl->mProgressHandler->UpdateFileWrite(4, 4);
@@ -78,10 +78,17 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/Profiler.h>
 #include <assimp/commonMetaData.h>
 
+#include <algorithm>
+#include <chrono>
 #include <exception>
 #include <set>
 #include <memory>
 #include <cctype>
+#include <cstdlib>
+#include <typeinfo>
+#if defined(__GNUC__) || defined(__clang__)
+#   include <cxxabi.h>
+#endif
 
 #include <assimp/DefaultIOStream.h>
 #include <assimp/DefaultIOSystem.h>
@@ -144,6 +151,23 @@ void AllocateFromAssimpHeap::operator delete[] ( void* data)    {
     return ::operator delete[](data);
 }
 
+// ------------------------------------------------------------------------------------------------
+// Collect the importer indices for all extensions, so a lookup needs no GetExtensionList() calls.
+static void BuildExtensionLookup(const std::vector<BaseImporter*> &importers, ImporterPimpl::ExtensionLookupMap &lookup) {
+    lookup.clear();
+    std::set<std::string> extensions;
+    for (unsigned int a = 0; a < importers.size(); ++a) {
+        extensions.clear();
+        importers[a]->GetExtensionList(extensions);
+        for (std::set<std::string>::const_iterator it = extensions.begin(); it != extensions.end(); ++it) {
+            std::vector<unsigned int> &indices = lookup[ai_tolower(*it)];
+            if (indices.empty() || indices.back() != a) {
+                indices.push_back(a);
+            }
+        }
+    }
+}
+
 // ------------------------------------------------------------------------------------------------
 // Importer constructor.
 Importer::Importer()
@@ -159,7 +183,11 @@ Importer::Importer()
     pimpl->mProgressHandler = new DefaultProgressHandler();
     pimpl->mIsDefaultProgressHandler = true;
 
+    const std::chrono::steady_clock::time_point startupBegin = std::chrono::steady_clock::now();
     GetImporterInstanceList(pimpl->mImporter);
+    BuildExtensionLookup(pimpl->mImporter, pimpl->mExtensionLookup);
+    pimpl->mStartupTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - startupBegin).count();
+
     GetPostProcessingStepInstanceList(pimpl->mPostProcessingSteps);
 
     // Allocate a SharedPostProcessInfo object and store pointers to it in all post-process steps in the list.
@@ -193,6 +221,8 @@ Importer::~Importer() {
     // Delete shared post-processing data
     delete pimpl->mPPShared;
 
+    delete pimpl->mProfiler;
+
     // and finally the pimpl itself
     delete pimpl;
 }
@@ -240,6 +270,7 @@ aiReturn Importer::RegisterLoader(BaseImporter* pImp) {
 
     // add the loader
     pimpl->mImporter.push_back(pImp);
+    BuildExtensionLookup(pimpl->mImporter, pimpl->mExtensionLookup);
     ASSIMP_LOG_INFO("Registering custom importer for these file extensions: ", baked);
     ASSIMP_END_EXCEPTION_REGION(aiReturn);
 
@@ -260,6 +291,7 @@ aiReturn Importer::UnregisterLoader(BaseImporter* pImp) {
 
     if (it != pimpl->mImporter.end())   {
         pimpl->mImporter.erase(it);
+        BuildExtensionLookup(pimpl->mImporter, pimpl->mExtensionLookup);
         ASSIMP_LOG_INFO("Unregistering custom importer: ");
         return AI_SUCCESS;
     }
@@ -392,6 +424,82 @@ void Importer::FreeScene( ) {
     ASSIMP_END_EXCEPTION_REGION(void);
 }
 
+// ------------------------------------------------------------------------------------------------
+// Drop all per-import state but keep the importer and post-processing step instances
+void Importer::Reset() {
+    ai_assert(nullptr != pimpl);
+
+    FreeScene();
+
+    ASSIMP_BEGIN_EXCEPTION_REGION();
+    pimpl->mIntProperties.clear();
+    pimpl->mFloatProperties.clear();
+    pimpl->mStringProperties.clear();
+    pimpl->mMatrixProperties.clear();
+    pimpl->mPointerProperties.clear();
+
+    if (!pimpl->mIsDefaultHandler) {
+        delete pimpl->mIOHandler;
+        pimpl->mIOHandler = new DefaultIOSystem;
+        pimpl->mIsDefaultHandler = true;
+    }
+    if (!pimpl->mIsDefaultProgressHandler) {
+        delete pimpl->mProgressHandler;
+        pimpl->mProgressHandler = new DefaultProgressHandler();
+        pimpl->mIsDefaultProgressHandler = true;
+    }
+
+    pimpl->bExtraVerbose = false;
+    pimpl->mPPShared->Clean();
+
+    delete pimpl->mProfiler;
+    pimpl->mProfiler = nullptr;
+    ASSIMP_END_EXCEPTION_REGION(void);
+}
+
+// ------------------------------------------------------------------------------------------------
+// Get the timings of the last import
+Profiler* Importer::GetProfiler() const {
+    ai_assert(nullptr != pimpl);
+
+    return pimpl->mProfiler;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Get the profiler of the current import, a new one is created if time measurement has been enabled
+static Profiler* GetActiveProfiler(const Importer &importer, ImporterPimpl *pimpl) {
+    if (!importer.GetPropertyInteger(AI_CONFIG_GLOB_MEASURE_TIME, 0)) {
+        return nullptr;
+    }
+    if (nullptr == pimpl->mProfiler) {
+        pimpl->mProfiler = new Profiler();
+        pimpl->mProfiler->SetAllocationCounters(static_cast<const AllocationCounters*>(
+                importer.GetPropertyPointer(AI_CONFIG_GLOB_MEASURE_ALLOCATIONS, nullptr)));
+    }
+    return pimpl->mProfiler;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Readable class name of a post-processing step, used as region name by the profiler
+static std::string GetStepName(const BaseProcess &process) {
+    std::string name = typeid(process).name();
+#if defined(__GNUC__) || defined(__clang__)
+    int status = 0;
+    char *demangled = abi::__cxa_demangle(name.c_str(), nullptr, nullptr, &status);
+    if (0 == status && nullptr != demangled) {
+        name = demangled;
+    }
+    std::free(demangled);
+#endif
+    for (const char *prefix : { "class ", "struct ", "Assimp::" }) {
+        const std::string::size_type pos = name.find(prefix);
+        if (std::string::npos != pos) {
+            name.erase(pos, strlen(prefix));
+        }
+    }
+    return name;
+}
+
 // ------------------------------------------------------------------------------------------------
 // Get the current error string, if any
 const char* Importer::GetErrorString() const {
@@ -486,6 +594,40 @@ const aiScene* Importer::ReadFileFromMemory( const void* pBuffer,
     size_t pLength,
     unsigned int pFlags,
     const char* pHint /*= ""*/) {
+    return ReadFileFromMemoryInternal(pBuffer, pLength, pFlags, pHint, static_cast<size_t>(-1));
+}
+
+// ------------------------------------------------------------------------------------------------
+const aiScene* Importer::ReadFileFromMemoryWithImporter( const void* pBuffer,
+    size_t pLength,
+    unsigned int pFlags,
+    size_t pImporterIndex,
+    const char* pHint /*= ""*/) {
+    ai_assert(nullptr != pimpl);
+
+    if (pImporterIndex >= pimpl->mImporter.size()) {
+        pimpl->mErrorString = "Invalid importer index passed to ReadFileFromMemoryWithImporter()";
+        return nullptr;
+    }
+
+    // name the buffer after the first extension of the importer unless told otherwise
+    std::string hint(pHint ? pHint : "");
+    if (hint.empty()) {
+        std::set<std::string> extensions;
+        pimpl->mImporter[pImporterIndex]->GetExtensionList(extensions);
+        if (!extensions.empty()) {
+            hint = *extensions.begin();
+        }
+    }
+    return ReadFileFromMemoryInternal(pBuffer, pLength, pFlags, hint.c_str(), pImporterIndex);
+}
+
+// ------------------------------------------------------------------------------------------------
+const aiScene* Importer::ReadFileFromMemoryInternal( const void* pBuffer,
+    size_t pLength,
+    unsigned int pFlags,
+    const char* pHint,
+    size_t pImporterIndex) {
     ai_assert(nullptr != pimpl);
 
     ASSIMP_BEGIN_EXCEPTION_REGION();
@@ -509,7 +651,7 @@ const aiScene* Importer::ReadFileFromMemory( const void* pBuffer,
     char fbuff[BufSize];
     ai_snprintf(fbuff, BufSize, "%s.%s",AI_MEMORYIO_MAGIC_FILENAME,pHint);
 
-    ReadFile(fbuff,pFlags);
+    ReadFileInternal(fbuff,pFlags,pImporterIndex);
     SetIOHandler(io);
 
     ASSIMP_END_EXCEPTION_REGION_WITH_ERROR_STRING(const aiScene*, pimpl->mErrorString, pimpl->mException);
@@ -576,9 +718,78 @@ void WriteLogOpening(const std::string& file) {
     ASSIMP_LOG_DEBUG(stream.str());
 }
 
+// ------------------------------------------------------------------------------------------------
+// Find a worker class which can handle the file, by extension first, by signature second.
+BaseImporter* Importer::FindImporter(const std::string& pFile) {
+    // Multiple importers may be able to handle the same extension (.xml!); gather them all.
+    // CAUTION: Do not just search for the extension!
+    // GetExtension() returns the part after the *last* dot, but some extensions have dots
+    // inside them, e.g. ogre.mesh.xml. Look up every suffix behind a dot of the file name.
+    SetPropertyInteger("importerIndex", -1);
+    std::vector<unsigned int> possibleImporters;
+    const std::string::size_type nameBegin = pFile.find_last_of("\\/");
+    for (std::string::size_type dot = pFile.find('.', nameBegin == std::string::npos ? 0 : nameBegin);
+            dot != std::string::npos; dot = pFile.find('.', dot + 1)) {
+        ImporterPimpl::ExtensionLookupMap::const_iterator it = pimpl->mExtensionLookup.find(ai_tolower(pFile.substr(dot + 1)));
+        if (it != pimpl->mExtensionLookup.end()) {
+            possibleImporters.insert(possibleImporters.end(), it->second.begin(), it->second.end());
+        }
+    }
+    // keep the registration order, it decides between importers claiming the same file
+    std::sort(possibleImporters.begin(), possibleImporters.end());
+    possibleImporters.erase(std::unique(possibleImporters.begin(), possibleImporters.end()), possibleImporters.end());
+
+    // If just one importer supports this extension, pick it and close the case.
+    if (1 == possibleImporters.size()) {
+        SetPropertyInteger("importerIndex", possibleImporters[0]);
+        return pimpl->mImporter[possibleImporters[0]];
+    }
+
+    // If multiple importers claim this file extension, ask them to look at the actual file data to decide.
+    // This can happen e.g. with XML (COLLADA vs. Irrlicht).
+    for (std::vector<unsigned int>::const_iterator it = possibleImporters.begin(); it < possibleImporters.end(); ++it) {
+        BaseImporter & importer = *pimpl->mImporter[*it];
+
+        ASSIMP_LOG_INFO("Found a possible importer: " + std::string(importer.GetInfo()->mName) + "; trying signature-based detection");
+        if (importer.CanRead( pFile, pimpl->mIOHandler, true)) {
+            SetPropertyInteger("importerIndex", *it);
+            return &importer;
+        }
+    }
+
+    // not so bad yet ... try format auto detection.
+    ASSIMP_LOG_INFO("File extension not known, trying signature-based detection");
+    for( unsigned int a = 0; a < pimpl->mImporter.size(); a++)  {
+        if( pimpl->mImporter[a]->CanRead( pFile, pimpl->mIOHandler, true)) {
+            SetPropertyInteger("importerIndex", a);
+            return pimpl->mImporter[a];
+        }
+    }
+
+    return nullptr;
+}
+
 // ------------------------------------------------------------------------------------------------
 // Reads the given file and returns its contents if successful.
 const aiScene* Importer::ReadFile( const char* _pFile, unsigned int pFlags) {
+    return ReadFileInternal(_pFile, pFlags, static_cast<size_t>(-1));
+}
+
+// ------------------------------------------------------------------------------------------------
+// Reads the given file with a known importer, no format detection is done.
+const aiScene* Importer::ReadFileWithImporter( const char* _pFile, unsigned int pFlags, size_t pImporterIndex) {
+    ai_assert(nullptr != pimpl);
+
+    if (pImporterIndex >= pimpl->mImporter.size()) {
+        pimpl->mErrorString = "Invalid importer index passed to ReadFileWithImporter()";
+        return nullptr;
+    }
+    return ReadFileInternal(_pFile, pFlags, pImporterIndex);
+}
+
+// ------------------------------------------------------------------------------------------------
+// Find the importer for the file unless the caller already knows it, then read the file.
+const aiScene* Importer::ReadFileInternal( const char* _pFile, unsigned int pFlags, size_t pImporterIndex) {
     ai_assert(nullptr != pimpl);
 
     ASSIMP_BEGIN_EXCEPTION_REGION();
@@ -612,84 +823,35 @@ const aiScene* Importer::ReadFile( const char* _pFile, unsigned int pFlags) {
             return nullptr;
         }
 
-        std::unique_ptr<Profiler> profiler(GetPropertyInteger(AI_CONFIG_GLOB_MEASURE_TIME, 0) ? new Profiler() : nullptr);
+        // each file gets its own profile
+        delete pimpl->mProfiler;
+        pimpl->mProfiler = nullptr;
+        Profiler *profiler = GetActiveProfiler(*this, pimpl);
         if (profiler) {
             profiler->BeginRegion("total");
+            ASSIMP_LOG_DEBUG("Importer startup took ", pimpl->mStartupTime, " s for ", pimpl->mImporter.size(),
+                " importers and ", pimpl->mExtensionLookup.size(), " extensions");
+            profiler->BeginRegion("probe");
         }
 
-        // Find an worker class which can handle the file extension.
-        // Multiple importers may be able to handle the same extension (.xml!); gather them all.
-        SetPropertyInteger("importerIndex", -1);
-        struct ImporterAndIndex {
-            BaseImporter * importer;
-            unsigned int   index;
-        };
-        std::vector<ImporterAndIndex> possibleImporters;
-        for (unsigned int a = 0; a < pimpl->mImporter.size(); a++)  {
-
-            // Every importer has a list of supported extensions.
-            std::set<std::string> extensions;
-            pimpl->mImporter[a]->GetExtensionList(extensions);
-
-            // CAUTION: Do not just search for the extension!
-            // GetExtension() returns the part after the *last* dot, but some extensions have dots
-            // inside them, e.g. ogre.mesh.xml. Compare the entire end of the string.
-            for (std::set<std::string>::const_iterator it = extensions.cbegin(); it != extensions.cend(); ++it) {
-
-                // Yay for C++<20 not having std::string::ends_with()
-                std::string extension = "." + *it;
-                if (extension.length() <= pFile.length()) {
-                    // Possible optimization: Fetch the lowercase filename!
-                    if (0 == ASSIMP_stricmp(pFile.c_str() + pFile.length() - extension.length(), extension.c_str())) {
-                        ImporterAndIndex candidate = { pimpl->mImporter[a], a };
-                        possibleImporters.push_back(candidate);
-                        break;
-                    }
-                }
-
-            }
-
-        }
-
-        // If just one importer supports this extension, pick it and close the case.
         BaseImporter* imp = nullptr;
-        if (1 == possibleImporters.size()) {
-            imp = possibleImporters[0].importer;
-            SetPropertyInteger("importerIndex", possibleImporters[0].index);
+        if (pImporterIndex < pimpl->mImporter.size()) {
+            // The caller knows the format, skip the detection.
+            imp = pimpl->mImporter[pImporterIndex];
+            SetPropertyInteger("importerIndex", static_cast<int>(pImporterIndex));
+        } else {
+            imp = FindImporter(pFile);
         }
-        // If multiple importers claim this file extension, ask them to look at the actual file data to decide.
-        // This can happen e.g. with XML (COLLADA vs. Irrlicht).
-        else {
-            for (std::vector<ImporterAndIndex>::const_iterator it = possibleImporters.begin(); it < possibleImporters.end(); ++it) {
-                BaseImporter & importer = *it->importer;
-
-                ASSIMP_LOG_INFO("Found a possible importer: " + std::string(importer.GetInfo()->mName) + "; trying signature-based detection");
-                if (importer.CanRead( pFile, pimpl->mIOHandler, true)) {
-                    imp = &importer;
-                    SetPropertyInteger("importerIndex", it->index);
-                    break;
-                }
-
-            }
 
+        if (profiler) {
+            profiler->EndRegion("probe");
         }
 
-        if (!imp)   {
-            // not so bad yet ... try format auto detection.
-            ASSIMP_LOG_INFO("File extension not known, trying signature-based detection");
-            for( unsigned int a = 0; a < pimpl->mImporter.size(); a++)  {
-                if( pimpl->mImporter[a]->CanRead( pFile, pimpl->mIOHandler, true)) {
-                    imp = pimpl->mImporter[a];
-                    SetPropertyInteger("importerIndex", a);
-                    break;
-                }
-            }
-            // Put a proper error message if no suitable importer was found
-            if( !imp)   {
-                pimpl->mErrorString = "No suitable reader found for the file format of file \"" + pFile + "\".";
-                ASSIMP_LOG_ERROR(pimpl->mErrorString);
-                return nullptr;
-            }
+        // Put a proper error message if no suitable importer was found
+        if( !imp)   {
+            pimpl->mErrorString = "No suitable reader found for the file format of file \"" + pFile + "\".";
+            ASSIMP_LOG_ERROR(pimpl->mErrorString);
+            return nullptr;
         }
 
         // Get file size for progress handler
@@ -718,7 +880,7 @@ const aiScene* Importer::ReadFile( const char* _pFile, unsigned int pFlags) {
         pimpl->mProgressHandler->UpdateFileRead( fileSize, fileSize );
 
         if (profiler) {
-            profiler->EndRegion("import");
+            profiler->EndRegion("import", pimpl->mScene);
         }
 
         SetPropertyString("sourceFilePath", pFile);
@@ -745,14 +907,14 @@ const aiScene* Importer::ReadFile( const char* _pFile, unsigned int pFlags) {
 
             // Preprocess the scene and prepare it for post-processing
             if (profiler) {
-                profiler->BeginRegion("preprocess");
+                profiler->BeginRegion("preprocess", pimpl->mScene);
             }
 
             ScenePreprocessor pre(pimpl->mScene);
             pre.ProcessScene();
 
             if (profiler) {
-                profiler->EndRegion("preprocess");
+                profiler->EndRegion("preprocess", pimpl->mScene);
             }
 
             // Ensure that the validation process won't be called twice
@@ -768,7 +930,7 @@ const aiScene* Importer::ReadFile( const char* _pFile, unsigned int pFlags) {
         pimpl->mPPShared->Clean();
 
         if (profiler) {
-            profiler->EndRegion("total");
+            profiler->EndRegion("total", pimpl->mScene);
         }
     }
 #ifdef ASSIMP_CATCH_GLOBAL_EXCEPTIONS
@@ -837,19 +999,24 @@ const aiScene* Importer::ApplyPostProcessing(unsigned int pFlags) {
     }
 #endif // ! DEBUG
 
-    std::unique_ptr<Profiler> profiler(GetPropertyInteger(AI_CONFIG_GLOB_MEASURE_TIME, 0) ? new Profiler() : nullptr);
+    Profiler *profiler = GetActiveProfiler(*this, pimpl);
+    if (profiler) {
+        profiler->BeginRegion("postprocess", pimpl->mScene);
+    }
     for( unsigned int a = 0; a < pimpl->mPostProcessingSteps.size(); a++)   {
         BaseProcess* process = pimpl->mPostProcessingSteps[a];
         pimpl->mProgressHandler->UpdatePostProcess(static_cast<int>(a), static_cast<int>(pimpl->mPostProcessingSteps.size()) );
         if( process->IsActive( pFlags)) {
+            std::string stepName;
             if (profiler) {
-                profiler->BeginRegion("postprocess");
+                stepName = GetStepName(*process);
+                profiler->BeginRegion(stepName, pimpl->mScene);
             }
 
             process->ExecuteOnScene ( this );
 
             if (profiler) {
-                profiler->EndRegion("postprocess");
+                profiler->EndRegion(stepName, pimpl->mScene);
             }
         }
         if( !pimpl->mScene) {
@@ -876,6 +1043,9 @@ const aiScene* Importer::ApplyPostProcessing(unsigned int pFlags) {
     }
     pimpl->mProgressHandler->UpdatePostProcess( static_cast<int>(pimpl->mPostProcessingSteps.size()),
         static_cast<int>(pimpl->mPostProcessingSteps.size()) );
+    if (profiler) {
+        profiler->EndRegion("postprocess", pimpl->mScene);
+    }
 
     // update private scene flags
     if( pimpl->mScene ) {
@@ -935,16 +1105,16 @@ const aiScene* Importer::ApplyCustomizedPostProcessing( BaseProcess *rootProcess
     }
 #endif // ! DEBUG
 
-    std::unique_ptr<Profiler> profiler(GetPropertyInteger(AI_CONFIG_GLOB_MEASURE_TIME, 0) ? new Profiler() : nullptr);
+    Profiler *profiler = GetActiveProfiler(*this, pimpl);
 
     if ( profiler ) {
-        profiler->BeginRegion( "postprocess" );
+        profiler->BeginRegion( "postprocess", pimpl->mScene );
     }
 
     rootProcess->ExecuteOnScene( this );
 
     if ( profiler ) {
-        profiler->EndRegion( "postprocess" );
+        profiler->EndRegion( "postprocess", pimpl->mScene );
     }
 
     // If the extra verbose mode is active, execute the ValidateDataStructureStep again - after each step
@@ -1025,16 +1195,9 @@ size_t Importer::GetImporterIndex (const char* szExtension) const {
         return static_cast<size_t>(-1);
     }
     ext = ai_tolower(ext);
-    std::set<std::string> str;
-    for (std::vector<BaseImporter*>::const_iterator i =  pimpl->mImporter.begin();i != pimpl->mImporter.end();++i)  {
-        str.clear();
-
-        (*i)->GetExtensionList(str);
-        for (std::set<std::string>::const_iterator it = str.begin(); it != str.end(); ++it) {
-            if (ext == *it) {
-                return std::distance(static_cast< std::vector<BaseImporter*>::const_iterator >(pimpl->mImporter.begin()), i);
-            }
-        }
+    ImporterPimpl::ExtensionLookupMap::const_iterator it = pimpl->mExtensionLookup.find(ext);
+    if (it != pimpl->mExtensionLookup.end()) {
+        return it->second.front();
     }
     ASSIMP_END_EXCEPTION_REGION(size_t);
     return static_cast<size_t>(-1);
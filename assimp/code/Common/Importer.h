@@ -58,6 +58,9 @@ namespace Assimp    {
     class BaseImporter;
     class BaseProcess;
     class SharedPostProcessInfo;
+    namespace Profiling {
+        class Profiler;
+    }
 
 
 //! @cond never
@@ -80,6 +83,9 @@ public:
     typedef std::map<KeyType, aiMatrix4x4> MatrixPropertyMap;
     typedef std::map<KeyType, void*> PointerPropertyMap;
 
+    // Maps a lower-case file extension to the indices of all importers claiming it
+    typedef std::map<std::string, std::vector<unsigned int>> ExtensionLookupMap;
+
     /** IO handler to use for all file accesses. */
     IOSystem* mIOHandler;
     bool mIsDefaultHandler;
@@ -91,6 +97,13 @@ public:
     /** Format-specific importer worker objects - one for each format we can read.*/
     std::vector< BaseImporter* > mImporter;
 
+    /** Extension lookup table for mImporter, rebuilt whenever a loader is
+     *  registered or unregistered. */
+    ExtensionLookupMap mExtensionLookup;
+
+    /** Time needed to set up the importer list and its lookup table, in seconds. */
+    double mStartupTime;
+
     /** Post processing steps we can apply at the imported data. */
     std::vector< BaseProcess* > mPostProcessingSteps;
 
@@ -126,6 +139,9 @@ public:
     /** Used by post-process steps to share data */
     SharedPostProcessInfo* mPPShared;
 
+    /** Timings of the last import if #AI_CONFIG_GLOB_MEASURE_TIME is set, nullptr otherwise */
+    Profiling::Profiler* mProfiler;
+
     /// The default class constructor.
     ImporterPimpl() AI_NO_EXCEPT;
 };
@@ -137,6 +153,8 @@ ImporterPimpl::ImporterPimpl() AI_NO_EXCEPT :
         mProgressHandler( nullptr ),
         mIsDefaultProgressHandler( false ),
         mImporter(),
+        mExtensionLookup(),
+        mStartupTime( 0.0 ),
         mPostProcessingSteps(),
         mScene( nullptr ),
         mErrorString(),
@@ -147,7 +165,8 @@ ImporterPimpl::ImporterPimpl() AI_NO_EXCEPT :
         mMatrixProperties(),
         mPointerProperties(),
         bExtraVerbose( false ),
-        mPPShared( nullptr ) {
+        mPPShared( nullptr ),
+        mProfiler( nullptr ) {
     // empty
 }
 //! @endcond
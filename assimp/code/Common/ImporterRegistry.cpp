@@ -181,6 +181,9 @@ corresponding preprocessor flag to selectively disable formats.
 #ifndef ASSIMP_BUILD_NO_ASSBIN_IMPORTER
 #include "AssetLib/Assbin/AssbinLoader.h"
 #endif
+#ifndef ASSIMP_BUILD_NO_SCENECACHE_IMPORTER
+#include "AssetLib/SceneCache/SceneCacheLoader.h"
+#endif
 #if !defined(ASSIMP_BUILD_NO_GLTF_IMPORTER) && !defined(ASSIMP_BUILD_NO_GLTF1_IMPORTER)
 #include "AssetLib/glTF/glTFImporter.h"
 #endif
@@ -356,6 +359,9 @@ void GetImporterInstanceList(std::vector<BaseImporter *> &out) {
 #if (!defined ASSIMP_BUILD_NO_ASSBIN_IMPORTER)
     out.push_back(new AssbinImporter());
 #endif
+#if (!defined ASSIMP_BUILD_NO_SCENECACHE_IMPORTER)
+    out.push_back(new SceneCacheImporter());
+#endif
 #if (!defined ASSIMP_BUILD_NO_GLTF_IMPORTER && !defined ASSIMP_BUILD_NO_GLTF1_IMPORTER)
     out.push_back(new glTFImporter());
 #endif
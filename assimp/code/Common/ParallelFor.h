@@ -0,0 +1,121 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2022, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file ParallelFor.h
+ *  @brief Minimal helper to split an index range over a few worker threads.
+ */
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <thread>
+#include <vector>
+
+namespace Assimp {
+
+// ------------------------------------------------------------------------------------------------
+/// @brief  Returns the number of worker threads used by ParallelFor.
+/// @return At least one.
+inline unsigned int GetNumWorkerThreads() {
+    const unsigned int numThreads = std::thread::hardware_concurrency();
+    return numThreads == 0 ? 1u : numThreads;
+}
+
+// ------------------------------------------------------------------------------------------------
+/// @brief  Calls func(begin, end) for contiguous sub-ranges of [0, count).
+///
+/// The range is split into at most GetNumWorkerThreads() chunks of at least minChunkSize
+/// elements. The calling thread processes the first chunk itself. If only one chunk is
+/// needed no thread is spawned at all. The first exception thrown by a chunk is
+/// re-thrown on the calling thread once all chunks are done.
+/// @param  count           The number of elements.
+/// @param  minChunkSize    The smallest range worth handing to a thread.
+/// @param  func            Callable with the signature void(size_t begin, size_t end).
+template <typename Func>
+inline void ParallelFor(size_t count, size_t minChunkSize, Func func) {
+    if (count == 0) {
+        return;
+    }
+    minChunkSize = std::max<size_t>(minChunkSize, 1);
+    const size_t maxChunks = (count + minChunkSize - 1) / minChunkSize;
+    const size_t numChunks = std::min<size_t>(GetNumWorkerThreads(), maxChunks);
+    if (numChunks <= 1) {
+        func(size_t(0), count);
+        return;
+    }
+
+    const size_t chunkSize = (count + numChunks - 1) / numChunks;
+    std::vector<std::exception_ptr> errors(numChunks);
+    std::vector<std::thread> workers;
+    workers.reserve(numChunks - 1);
+    for (size_t c = 1; c < numChunks; ++c) {
+        const size_t begin = c * chunkSize;
+        const size_t end = std::min(count, begin + chunkSize);
+        if (begin >= end) {
+            break;
+        }
+        workers.emplace_back([&func, &errors, c, begin, end]() {
+            try {
+                func(begin, end);
+            } catch (...) {
+                errors[c] = std::current_exception();
+            }
+        });
+    }
+
+    try {
+        func(size_t(0), std::min(count, chunkSize));
+    } catch (...) {
+        errors[0] = std::current_exception();
+    }
+
+    for (std::thread &worker : workers) {
+        worker.join();
+    }
+    for (const std::exception_ptr &error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+}
+
+} // namespace Assimp
@@ -101,6 +101,9 @@ corresponding preprocessor flag to selectively disable steps.
 #ifndef ASSIMP_BUILD_NO_FINDINVALIDDATA_PROCESS
 #   include "PostProcessing/FindInvalidDataProcess.h"
 #endif
+#ifndef ASSIMP_BUILD_NO_REDUCEANIMATIONKEYS_PROCESS
+#   include "PostProcessing/ReduceAnimationKeysProcess.h"
+#endif
 #ifndef ASSIMP_BUILD_NO_FINDDEGENERATES_PROCESS
 #   include "PostProcessing/FindDegenerates.h"
 #endif
@@ -205,6 +208,9 @@ void GetPostProcessingStepInstanceList(std::vector< BaseProcess* >& out)
 #if (!defined ASSIMP_BUILD_NO_FINDINVALIDDATA_PROCESS)
     out.push_back( new FindInvalidDataProcess());
 #endif
+#if (!defined ASSIMP_BUILD_NO_REDUCEANIMATIONKEYS_PROCESS)
+    out.push_back( new ReduceAnimationKeysProcess());
+#endif
 #if (!defined ASSIMP_BUILD_NO_OPTIMIZEMESHES_PROCESS)
     out.push_back( new OptimizeMeshesProcess());
 #endif
@@ -1109,6 +1109,19 @@ void SceneCombiner::Copy(aiMesh **_dest, const aiMesh *src) {
             Copy(&dest->mTextureCoordsNames[i], src->mTextureCoordsNames[i]);
         }
     }
+
+    // make a deep copy of the packed bone influences
+    if (src->mSkinInfluences != nullptr) {
+        const aiSkinInfluences *srcInfluences = src->mSkinInfluences;
+        aiSkinInfluences *influences = dest->mSkinInfluences = new aiSkinInfluences();
+        const size_t numSlots = static_cast<size_t>(src->mNumVertices) * srcInfluences->mNumInfluences;
+        influences->mNumInfluences = srcInfluences->mNumInfluences;
+        influences->mIndexSize = srcInfluences->mIndexSize;
+        influences->mBoneIndices = new unsigned char[numSlots * srcInfluences->mIndexSize];
+        ::memcpy(influences->mBoneIndices, srcInfluences->mBoneIndices, numSlots * srcInfluences->mIndexSize);
+        influences->mWeights = new unsigned short[numSlots];
+        ::memcpy(influences->mWeights, srcInfluences->mWeights, numSlots * sizeof(unsigned short));
+    }
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -49,6 +49,10 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/ai_assert.h>
 #include <assimp/scene.h>
 
+#include <mutex>
+#include <string_view>
+#include <unordered_map>
+
 namespace Assimp {
 
 // Forward declarations
@@ -71,13 +75,27 @@ struct ScenePrivateData {
     // and mOrigImporter are no longer safe to rely on and only
     // serve informative purposes.
     bool mIsCopy;
+
+    // Name to node lookup of the scene graph, built on demand by
+    // FindNodeByName(). The keys point into the names of the nodes, so
+    // the index must be dropped with InvalidateNodeIndex() whenever nodes
+    // are removed or renamed. This happens after every post-processing step.
+    typedef std::unordered_map<std::string_view, aiNode*> NodeIndex;
+    mutable NodeIndex mNodeIndex;
+
+    // Root node the index was built for, nullptr if there is no index
+    mutable const aiNode* mNodeIndexRoot;
+    mutable std::mutex mNodeIndexMutex;
 };
 
 inline
 ScenePrivateData::ScenePrivateData() AI_NO_EXCEPT
 : mOrigImporter( nullptr )
 , mPPStepsApplied( 0 )
-, mIsCopy( false ) {
+, mIsCopy( false )
+, mNodeIndex()
+, mNodeIndexRoot( nullptr )
+, mNodeIndexMutex() {
     // empty
 }
 
@@ -100,6 +118,58 @@ const ScenePrivateData* ScenePriv(const aiScene* in) {
     return static_cast<const ScenePrivateData*>(in->mPrivate);
 }
 
+// Adds a node and its children to the name index, the first node with a
+// name wins as with aiNode::FindNode()
+inline
+void AddToNodeIndex(ScenePrivateData::NodeIndex& index, aiNode* node) {
+    index.emplace(std::string_view(node->mName.data), node);
+    for (unsigned int i = 0; i < node->mNumChildren; ++i) {
+        AddToNodeIndex(index, node->mChildren[i]);
+    }
+}
+
+// Looks a node of the scene graph up by name, same result as
+// scene->mRootNode->FindNode(name) but without walking the graph each time
+inline
+aiNode* FindNodeByName(const aiScene* scene, const char* name) {
+    ai_assert( nullptr != scene );
+    if ( nullptr == scene || nullptr == scene->mRootNode || nullptr == name ) {
+        return nullptr;
+    }
+
+    const ScenePrivateData* priv = ScenePriv(scene);
+    if ( nullptr == priv ) {
+        // user-allocated scene
+        return scene->mRootNode->FindNode(name);
+    }
+
+    std::lock_guard<std::mutex> lock(priv->mNodeIndexMutex);
+    if ( priv->mNodeIndexRoot != scene->mRootNode ) {
+        priv->mNodeIndex.clear();
+        AddToNodeIndex(priv->mNodeIndex, scene->mRootNode);
+        priv->mNodeIndexRoot = scene->mRootNode;
+    }
+    ScenePrivateData::NodeIndex::const_iterator it = priv->mNodeIndex.find(std::string_view(name));
+    return it == priv->mNodeIndex.end() ? nullptr : it->second;
+}
+
+inline
+aiNode* FindNodeByName(const aiScene* scene, const aiString& name) {
+    return FindNodeByName(scene, name.data);
+}
+
+// Drops the name index, call after adding, removing or renaming nodes
+inline
+void InvalidateNodeIndex(const aiScene* scene) {
+    const ScenePrivateData* priv = ScenePriv(scene);
+    if ( nullptr == priv ) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(priv->mNodeIndexMutex);
+    priv->mNodeIndex.clear();
+    priv->mNodeIndexRoot = nullptr;
+}
+
 } // Namespace Assimp
 
 #endif // AI_SCENEPRIVATE_H_INCLUDED
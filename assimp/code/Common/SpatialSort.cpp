@@ -43,6 +43,12 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <assimp/SpatialSort.h>
 #include <assimp/ai_assert.h>
+#include "ParallelFor.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
 
 using namespace Assimp;
 
@@ -53,6 +59,54 @@ using namespace Assimp;
 
 const aiVector3D PlaneInit(0.8523f, 0.34321f, 0.5736f);
 
+namespace {
+
+// Unsigned integer type with the size of ai_real, used as radix sort key
+using RadixKey = std::conditional<sizeof(ai_real) == sizeof(uint64_t), uint64_t, uint32_t>::type;
+
+// --------------------------------------------------------------------------------------------
+// Maps a floating-point value to an unsigned integer with the same ordering.
+inline RadixKey ToRadixKey(ai_real value) {
+    static_assert(sizeof(RadixKey) == sizeof(ai_real), "sizeof(RadixKey) == sizeof(ai_real)");
+    RadixKey bits;
+    ::memcpy(&bits, &value, sizeof(value));
+    const RadixKey signBit = RadixKey(1) << (sizeof(RadixKey) * 8 - 1);
+    return (bits & signBit) ? ~bits : (bits | signBit);
+}
+
+// --------------------------------------------------------------------------------------------
+// Stable LSD radix sort of a permutation by 8-bit digits. Digits all keys agree on are skipped.
+void RadixSort(std::vector<RadixKey> &keys, std::vector<unsigned int> &order) {
+    const size_t count = keys.size();
+    std::vector<RadixKey> tmpKeys(count);
+    std::vector<unsigned int> tmpOrder(count);
+    for (unsigned int shift = 0; shift < sizeof(RadixKey) * 8; shift += 8) {
+        size_t histogram[256] = {};
+        for (size_t i = 0; i < count; ++i) {
+            ++histogram[(keys[i] >> shift) & 0xff];
+        }
+        if (histogram[(keys[0] >> shift) & 0xff] == count) {
+            continue;
+        }
+
+        size_t sum = 0;
+        for (size_t &bucket : histogram) {
+            const size_t n = bucket;
+            bucket = sum;
+            sum += n;
+        }
+        for (size_t i = 0; i < count; ++i) {
+            const size_t dest = histogram[(keys[i] >> shift) & 0xff]++;
+            tmpKeys[dest] = keys[i];
+            tmpOrder[dest] = order[i];
+        }
+        keys.swap(tmpKeys);
+        order.swap(tmpOrder);
+    }
+}
+
+} // namespace
+
 // ------------------------------------------------------------------------------------------------
 // Constructs a spatially sorted representation from the given position array.
 // define the reference plane. We choose some arbitrary vector away from all basic axes
@@ -93,13 +147,33 @@ ai_real SpatialSort::CalculateDistance(const aiVector3D &pPosition) const {
 // ------------------------------------------------------------------------------------------------
 void SpatialSort::Finalize() {
     const ai_real scale = 1.0f / mPositions.size();
+    mCentroid = aiVector3D();
     for (unsigned int i = 0; i < mPositions.size(); i++) {
         mCentroid += scale * mPositions[i].mPosition; 
     }
     for (unsigned int i = 0; i < mPositions.size(); i++) {
         mPositions[i].mDistance = CalculateDistance(mPositions[i].mPosition);
     }
-    std::sort(mPositions.begin(), mPositions.end());
+
+    // Small sets are not worth the histogram passes of the radix sort. Both sorts are
+    // stable, so they yield the same order.
+    if (mPositions.size() < 256) {
+        std::stable_sort(mPositions.begin(), mPositions.end());
+    } else {
+        std::vector<RadixKey> keys(mPositions.size());
+        std::vector<unsigned int> order(mPositions.size());
+        for (unsigned int i = 0; i < mPositions.size(); i++) {
+            keys[i] = ToRadixKey(mPositions[i].mDistance);
+            order[i] = i;
+        }
+        RadixSort(keys, order);
+
+        std::vector<Entry> sorted(mPositions.size());
+        for (size_t i = 0; i < order.size(); ++i) {
+            sorted[i] = mPositions[order[i]];
+        }
+        mPositions.swap(sorted);
+    }
     mFinalized = true;
 }
 
@@ -143,39 +217,89 @@ void SpatialSort::FindPositions(const aiVector3D &pPosition,
         return;
 
     // do a binary search for the minimal distance to start the iteration there
-    unsigned int index = (unsigned int)mPositions.size() / 2;
-    unsigned int binaryStepSize = (unsigned int)mPositions.size() / 4;
-    while (binaryStepSize > 1) {
-        if (mPositions[index].mDistance < minDist)
-            index += binaryStepSize;
-        else
-            index -= binaryStepSize;
-
-        binaryStepSize /= 2;
-    }
-
-    // depending on the direction of the last step we need to single step a bit back or forth
-    // to find the actual beginning element of the range
-    while (index > 0 && mPositions[index].mDistance > minDist)
-        index--;
-    while (index < (mPositions.size() - 1) && mPositions[index].mDistance < minDist)
-        index++;
+    std::vector<Entry>::const_iterator it = std::lower_bound(mPositions.begin(), mPositions.end(), minDist,
+            [](const Entry &e, ai_real d) { return e.mDistance < d; });
 
-    // Mow start iterating from there until the first position lays outside of the distance range.
+    // Now start iterating from there until the first position lays outside of the distance range.
     // Add all positions inside the distance range within the given radius to the result array
-    std::vector<Entry>::const_iterator it = mPositions.begin() + index;
     const ai_real pSquared = pRadius * pRadius;
-    while (it->mDistance < maxDist) {
+    for (; it != mPositions.end() && it->mDistance <= maxDist; ++it) {
         if ((it->mPosition - pPosition).SquareLength() < pSquared)
             poResults.push_back(it->mIndex);
-        ++it;
-        if (it == mPositions.end())
-            break;
     }
 
     // that's it
 }
 
+// ------------------------------------------------------------------------------------------------
+// Finds the positions close to each of the stored positions at once.
+void SpatialSort::FindAllNeighbors(ai_real pRadius, std::vector<unsigned int> &poOffsets,
+        std::vector<unsigned int> &poIndices) const {
+    ai_assert(mFinalized && "The SpatialSort object must be finalized before FindAllNeighbors can be called.");
+    const size_t numPositions = mPositions.size();
+    poOffsets.assign(numPositions + 1, 0);
+    poIndices.clear();
+    if (numPositions == 0) {
+        return;
+    }
+
+    // Split the sorted positions into chunks. Within a chunk the start of the search window
+    // only moves forward, as the positions are sorted by their distance to the plane.
+    const size_t minChunkSize = 4096;
+    const size_t numChunks = std::max<size_t>(1, std::min<size_t>(GetNumWorkerThreads(), numPositions / minChunkSize));
+    const size_t chunkSize = (numPositions + numChunks - 1) / numChunks;
+    const ai_real pSquared = pRadius * pRadius;
+
+    std::vector<std::vector<unsigned int>> parts(numChunks);
+    ParallelFor(numChunks, 1, [&](size_t begin, size_t end) {
+        for (size_t c = begin; c < end; ++c) {
+            const size_t first = c * chunkSize, last = std::min(numPositions, first + chunkSize);
+            std::vector<unsigned int> &part = parts[c];
+            if (first >= last) {
+                continue;
+            }
+
+            size_t window = std::lower_bound(mPositions.begin(), mPositions.begin() + first, mPositions[first].mDistance - pRadius,
+                                    [](const Entry &e, ai_real d) { return e.mDistance < d; }) -
+                            mPositions.begin();
+            for (size_t k = first; k < last; ++k) {
+                const Entry &entry = mPositions[k];
+                const ai_real minDist = entry.mDistance - pRadius, maxDist = entry.mDistance + pRadius;
+                while (window < numPositions && mPositions[window].mDistance < minDist) {
+                    ++window;
+                }
+
+                const size_t prev = part.size();
+                for (size_t j = window; j < numPositions && mPositions[j].mDistance <= maxDist; ++j) {
+                    if ((mPositions[j].mPosition - entry.mPosition).SquareLength() < pSquared) {
+                        part.push_back(mPositions[j].mIndex);
+                    }
+                }
+                poOffsets[entry.mIndex + 1] = static_cast<unsigned int>(part.size() - prev);
+            }
+        }
+    });
+
+    for (size_t i = 0; i < numPositions; ++i) {
+        poOffsets[i + 1] += poOffsets[i];
+    }
+
+    // The chunks were filled in sorted order; scatter them to the rows of their positions
+    poIndices.resize(poOffsets[numPositions]);
+    ParallelFor(numChunks, 1, [&](size_t begin, size_t end) {
+        for (size_t c = begin; c < end; ++c) {
+            const size_t first = c * chunkSize, last = std::min(numPositions, first + chunkSize);
+            const unsigned int *src = parts[c].data();
+            for (size_t k = first; k < last; ++k) {
+                const unsigned int index = mPositions[k].mIndex;
+                const unsigned int n = poOffsets[index + 1] - poOffsets[index];
+                std::copy(src, src + n, poIndices.begin() + poOffsets[index]);
+                src += n;
+            }
+        }
+    });
+}
+
 namespace {
 
 // Binary, signed-integer representation of a single-precision floating-point value.
@@ -314,17 +438,16 @@ void SpatialSort::FindIdenticalPositions(const aiVector3D &pPosition, std::vecto
 unsigned int SpatialSort::GenerateMappingTable(std::vector<unsigned int> &fill, ai_real pRadius) const {
     ai_assert(mFinalized && "The SpatialSort object must be finalized before GenerateMappingTable can be called.");
     fill.resize(mPositions.size(), UINT_MAX);
-    ai_real dist, maxDist;
 
+    // The positions are sorted, so a single pass assigns every run of close positions the same id
     unsigned int t = 0;
     const ai_real pSquared = pRadius * pRadius;
     for (size_t i = 0; i < mPositions.size();) {
-        dist = (mPositions[i].mPosition - mCentroid) * mPlaneNormal;
-        maxDist = dist + pRadius;
+        const ai_real maxDist = mPositions[i].mDistance + pRadius;
 
         fill[mPositions[i].mIndex] = t;
         const aiVector3D &oldpos = mPositions[i].mPosition;
-        for (++i; i < fill.size() && mPositions[i].mDistance < maxDist && (mPositions[i].mPosition - oldpos).SquareLength() < pSquared; ++i) {
+        for (++i; i < fill.size() && mPositions[i].mDistance <= maxDist && (mPositions[i].mPosition - oldpos).SquareLength() < pSquared; ++i) {
             fill[mPositions[i].mIndex] = t;
         }
         ++t;
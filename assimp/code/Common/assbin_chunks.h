@@ -82,9 +82,17 @@ short       0 for normal files, 1 for shortened dumps for regression tests
                 these should have the file extension assbin.regress
 
 short       1 if the data after the header is compressed with the DEFLATE algorithm,
+            2 if it is compressed in independent DEFLATE blocks,
             0 for uncompressed files.
                    For compressed files, the first integer after the header is
                    always the uncompressed data size
+                   Block compressed files instead continue with:
+                       uint64  uncompressed data size
+                       integer uncompressed size of a block, the last one may be smaller
+                       integer number of blocks
+                       [number of blocks times]
+                           integer compressed size n of the block
+                           byte[n] the DEFLATE stream of the block
 
 byte[256]   Zero-terminated source file name, UTF-8
 byte[128]   Zero-terminated command line parameters passed to assimp_cmd, UTF-8
@@ -170,6 +178,18 @@ The general 'rule' to get from Assimp headers to the serialized layout is:
 
 #define ASSBIN_HEADER_LENGTH 512
 
+#define ASSBIN_COMPRESSION_NONE                 0
+#define ASSBIN_COMPRESSION_DEFLATE              1
+#define ASSBIN_COMPRESSION_DEFLATE_BLOCKS       2
+
+// Uncompressed size of a block written by ASSBIN_COMPRESSION_DEFLATE_BLOCKS. The
+// body starts with the block size, then every block follows as compressed size,
+// uncompressed size and data, all sizes uint32. A compressed size of 0 ends it.
+#define ASSBIN_COMPRESSION_BLOCK_SIZE           0x100000
+
+// Largest block size the loader accepts
+#define ASSBIN_COMPRESSION_MAX_BLOCK_SIZE       0x4000000
+
 // these are the magic chunk identifiers for the binary ASS file format
 #define ASSBIN_CHUNK_AICAMERA                   0x1234
 #define ASSBIN_CHUNK_AILIGHT                    0x1235
@@ -52,8 +52,144 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/types.h>
 #include <assimp/DefaultLogger.hpp>
 
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+#include <vector>
+
 using namespace Assimp;
 
+// ------------------------------------------------------------------------------------------------
+// Open addressing table over the property list of a material. Slots hold the position of the
+// property plus one, zero marks an empty slot.
+struct aiMaterialPropertyIndex {
+    // State of the property list the index was built for
+    const aiMaterialProperty *const *mProperties;
+    unsigned int mNumProperties;
+
+    std::vector<unsigned int> mSlots;
+};
+
+// Materials with fewer properties are searched linearly, that's faster than hashing the key.
+static std::atomic<unsigned int> MinIndexedProperties(16);
+
+// ------------------------------------------------------------------------------------------------
+unsigned int Assimp::SetMinIndexedMaterialProperties(unsigned int numProperties) {
+    return MinIndexedProperties.exchange(numProperties);
+}
+
+// ------------------------------------------------------------------------------------------------
+// The indices live beside the materials, so aiMaterial keeps the layout C code sees. Lookups
+// probe under the shared lock, a rebuild or an invalidation takes it exclusively.
+namespace {
+struct PropertyIndexTable {
+    std::shared_mutex mMutex;
+    std::unordered_map<const aiMaterial *, std::unique_ptr<aiMaterialPropertyIndex>> mIndices;
+};
+
+PropertyIndexTable &GetPropertyIndexTable() {
+    // Never destroyed, materials may outlive static destruction
+    static PropertyIndexTable *table = new PropertyIndexTable();
+    return *table;
+}
+} // namespace
+
+// ------------------------------------------------------------------------------------------------
+static uint32_t HashPropertyKey(const char *pKey, unsigned int type, unsigned int index) {
+    // FNV-1a over the key, semantic and index
+    uint32_t hash = 2166136261u;
+    for (; *pKey; ++pKey) {
+        hash = (hash ^ static_cast<uint8_t>(*pKey)) * 16777619u;
+    }
+    hash = (hash ^ type) * 16777619u;
+    hash = (hash ^ index) * 16777619u;
+    return hash ^ (hash >> 16);
+}
+
+// ------------------------------------------------------------------------------------------------
+static bool IsProperty(const aiMaterialProperty *prop, const char *pKey, unsigned int type, unsigned int index) {
+    return prop->mSemantic == type && prop->mIndex == index && 0 == strcmp(prop->mKey.data, pKey);
+}
+
+// ------------------------------------------------------------------------------------------------
+static aiMaterialPropertyIndex *BuildPropertyIndex(const aiMaterial *pMat) {
+    aiMaterialPropertyIndex *idx = new aiMaterialPropertyIndex();
+    idx->mProperties = pMat->mProperties;
+    idx->mNumProperties = pMat->mNumProperties;
+
+    size_t size = 16;
+    while (size < 2 * static_cast<size_t>(pMat->mNumProperties)) {
+        size <<= 1;
+    }
+    idx->mSlots.assign(size, 0);
+
+    const size_t mask = size - 1;
+    for (unsigned int i = 0; i < pMat->mNumProperties; ++i) {
+        const aiMaterialProperty *prop = pMat->mProperties[i];
+        if (!prop) {
+            continue;
+        }
+
+        // Only the first of several equal properties is indexed, a lookup returns it as well
+        size_t pos = HashPropertyKey(prop->mKey.data, prop->mSemantic, prop->mIndex) & mask;
+        bool duplicate = false;
+        for (; idx->mSlots[pos]; pos = (pos + 1) & mask) {
+            if (IsProperty(pMat->mProperties[idx->mSlots[pos] - 1], prop->mKey.data, prop->mSemantic, prop->mIndex)) {
+                duplicate = true;
+                break;
+            }
+        }
+        if (!duplicate) {
+            idx->mSlots[pos] = i + 1;
+        }
+    }
+    return idx;
+}
+
+// ------------------------------------------------------------------------------------------------
+// The member functions drop the index on every change. Code writing the list directly is caught
+// as long as it reallocates the list or changes its size, see aiMaterial::InvalidatePropertyIndex().
+static bool IsPropertyIndexCurrent(const aiMaterialPropertyIndex *idx, const aiMaterial *pMat) {
+    return idx && idx->mProperties == pMat->mProperties && idx->mNumProperties == pMat->mNumProperties;
+}
+
+// ------------------------------------------------------------------------------------------------
+static const aiMaterialProperty *ProbePropertyIndex(const aiMaterialPropertyIndex *idx, const aiMaterial *pMat,
+        const char *pKey, unsigned int type, unsigned int index) {
+    const size_t mask = idx->mSlots.size() - 1;
+    for (size_t pos = HashPropertyKey(pKey, type, index) & mask; idx->mSlots[pos]; pos = (pos + 1) & mask) {
+        const aiMaterialProperty *prop = pMat->mProperties[idx->mSlots[pos] - 1];
+        if (IsProperty(prop, pKey, type, index)) {
+            return prop;
+        }
+    }
+    return nullptr;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Looks the property up through the index of the material, (re)building it if the property
+// list has changed behind the back of the member functions.
+static const aiMaterialProperty *FindIndexedProperty(const aiMaterial *pMat, const char *pKey, unsigned int type, unsigned int index) {
+    PropertyIndexTable &table = GetPropertyIndexTable();
+    {
+        std::shared_lock<std::shared_mutex> lock(table.mMutex);
+        auto it = table.mIndices.find(pMat);
+        if (it != table.mIndices.end() && IsPropertyIndexCurrent(it->second.get(), pMat)) {
+            return ProbePropertyIndex(it->second.get(), pMat, pKey, type, index);
+        }
+    }
+
+    std::unique_lock<std::shared_mutex> lock(table.mMutex);
+    std::unique_ptr<aiMaterialPropertyIndex> &idx = table.mIndices[pMat];
+    if (!IsPropertyIndexCurrent(idx.get(), pMat)) {
+        // another thread might have been faster
+        idx.reset(BuildPropertyIndex(pMat));
+    }
+    return ProbePropertyIndex(idx.get(), pMat, pKey, type, index);
+}
+
 // ------------------------------------------------------------------------------------------------
 // Get a specific property from a material
 aiReturn aiGetMaterialProperty(const aiMaterial *pMat,
@@ -65,10 +201,13 @@ aiReturn aiGetMaterialProperty(const aiMaterial *pMat,
     ai_assert(pKey != nullptr);
     ai_assert(pPropOut != nullptr);
 
-    /*  Just search for a property with exactly this name ..
-     *  could be improved by hashing, but it's possibly
-     *  no worth the effort (we're bound to C structures,
-     *  thus std::map or derivates are not applicable. */
+    // Wild-card lookups and small materials go through the list
+    if (UINT_MAX != type && UINT_MAX != index && pMat->mNumProperties >= MinIndexedProperties.load(std::memory_order_relaxed)) {
+        *pPropOut = FindIndexedProperty(pMat, pKey, type, index);
+        return *pPropOut ? AI_SUCCESS : AI_FAILURE;
+    }
+
+    /*  Just search for a property with exactly this name .. */
     for (unsigned int i = 0; i < pMat->mNumProperties; ++i) {
         aiMaterialProperty *prop = pMat->mProperties[i];
 
@@ -395,11 +534,19 @@ aiMaterial::aiMaterial() :
 
 // ------------------------------------------------------------------------------------------------
 aiMaterial::~aiMaterial() {
+    // Clear() drops the index as well, a later material at the same address must not find it
     Clear();
 
     delete[] mProperties;
 }
 
+// ------------------------------------------------------------------------------------------------
+void aiMaterial::InvalidatePropertyIndex() {
+    PropertyIndexTable &table = GetPropertyIndexTable();
+    std::unique_lock<std::shared_mutex> lock(table.mMutex);
+    table.mIndices.erase(this);
+}
+
 // ------------------------------------------------------------------------------------------------
 aiString aiMaterial::GetName() const {
     aiString name;
@@ -416,6 +563,7 @@ void aiMaterial::Clear() {
         AI_DEBUG_INVALIDATE_PTR(mProperties[i]);
     }
     mNumProperties = 0;
+    InvalidatePropertyIndex();
 
     // The array remains allocated, we just invalidated its contents
 }
@@ -437,6 +585,7 @@ aiReturn aiMaterial::RemoveProperty(const char *pKey, unsigned int type, unsigne
             for (unsigned int a = i; a < mNumProperties; ++a) {
                 mProperties[a] = mProperties[a + 1];
             }
+            InvalidatePropertyIndex();
             return AI_SUCCESS;
         }
     }
@@ -488,6 +637,7 @@ aiReturn aiMaterial::AddBinaryProperty(const void *pInput,
     ai_assert(MAXLEN > pcNew->mKey.length);
     strcpy(pcNew->mKey.data, pKey);
 
+    InvalidatePropertyIndex();
     if (UINT_MAX != iOutIndex) {
         mProperties[iOutIndex] = pcNew;
         return AI_SUCCESS;
@@ -562,6 +712,8 @@ void aiMaterial::CopyPropertyList(aiMaterial *const pcDest,
     ai_assert(pcDest->mNumProperties <= pcDest->mNumAllocated);
     ai_assert(pcSrc->mNumProperties <= pcSrc->mNumAllocated);
 
+    pcDest->InvalidatePropertyIndex();
+
     const unsigned int iOldNum = pcDest->mNumProperties;
     pcDest->mNumAllocated += pcSrc->mNumAllocated;
     pcDest->mNumProperties += pcSrc->mNumProperties;
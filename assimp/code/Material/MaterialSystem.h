@@ -47,6 +47,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifndef AI_MATERIALSYSTEM_H_INC
 #define AI_MATERIALSYSTEM_H_INC
 
+#include <assimp/defs.h>
 #include <stdint.h>
 
 struct aiMaterial;
@@ -66,6 +67,15 @@ namespace Assimp    {
  */
 uint32_t ComputeMaterialHash(const aiMaterial* mat, bool includeMatName = false);
 
+// ------------------------------------------------------------------------------
+/** Sets the number of properties from which on aiGetMaterialProperty() looks
+ *  exact keys up through a hashed index instead of scanning the list.
+ *
+ *  @param  numProperties The new threshold, UINT_MAX disables the index.
+ *  @return The previous threshold, 16 by default
+ */
+ASSIMP_API unsigned int SetMinIndexedMaterialProperties(unsigned int numProperties);
+
 
 } // ! namespace Assimp
 
@@ -83,6 +83,7 @@ Other:
 #include <sstream>
 #include <string>
 
+#include "Common/ScenePrivate.h"
 #include "Common/StbCommon.h"
 
 using namespace Assimp;
@@ -249,7 +250,7 @@ void PbrtExporter::WriteCameras() {
 
 aiMatrix4x4 PbrtExporter::GetNodeTransform(const aiString &name) const {
     aiMatrix4x4 m;
-    auto node = mScene->mRootNode->FindNode(name);
+    auto node = FindNodeByName(mScene, name);
     if (!node) {
         std::cerr << '"' << name.C_Str() << "\": node not found in scene tree.\n";
         throw DeadlyExportError("Could not find node");
@@ -65,11 +65,16 @@ void ArmaturePopulate::Execute(aiScene *out) {
 
     // Now convert all bone positions to the correct mOffsetMatrix
     std::vector<aiBone *> bones;
-    std::vector<aiNode *> nodes;
+    NodeStack nodes;
     std::map<aiBone *, aiNode *> bone_stack;
     BuildBoneList(out->mRootNode, out->mRootNode, out, bones);
     BuildNodeList(out->mRootNode, nodes);
 
+    BoneNameSet bone_names;
+    for (const aiBone *bone : bones) {
+        bone_names.emplace(bone->mName.C_Str());
+    }
+
     BuildBoneStack(out->mRootNode, out->mRootNode, out, bones, bone_stack, nodes);
 
     ASSIMP_LOG_DEBUG("Bone stack size: ", bone_stack.size());
@@ -81,7 +86,7 @@ void ArmaturePopulate::Execute(aiScene *out) {
         // lcl transform grab - done in generate_nodes :)
 
         // bone->mOffsetMatrix = bone_node->mTransformation;
-        aiNode *armature = GetArmatureRoot(bone_node, bones);
+        aiNode *armature = GetArmatureRoot(bone_node, bone_names);
 
         ai_assert(armature);
 
@@ -139,9 +144,9 @@ void ArmaturePopulate::BuildBoneList(aiNode *current_node,
     }
 }
 
-// Prepare flat node list which can be used for non recursive lookups later
+// Prepare node lookup which can be used for non recursive lookups later
 void ArmaturePopulate::BuildNodeList(const aiNode *current_node,
-                                     std::vector<aiNode *> &nodes) {
+                                     NodeStack &nodes) {
     ai_assert(nullptr != current_node);
 
     for (unsigned int nodeId = 0; nodeId < current_node->mNumChildren; ++nodeId) {
@@ -149,7 +154,7 @@ void ArmaturePopulate::BuildNodeList(const aiNode *current_node,
         ai_assert(child);
 
         if (child->mNumMeshes == 0) {
-            nodes.emplace_back(child);
+            nodes[child->mName.C_Str()].emplace_back(child);
         }
 
         BuildNodeList(child, nodes);
@@ -164,7 +169,7 @@ void ArmaturePopulate::BuildBoneStack(aiNode *,
                                       const aiScene*,
                                       const std::vector<aiBone *> &bones,
                                       std::map<aiBone *, aiNode *> &bone_stack,
-                                  std::vector<aiNode *> &node_stack) {
+                                      NodeStack &node_stack) {
     if (node_stack.empty()) {
         return;
     }
@@ -197,9 +202,9 @@ void ArmaturePopulate::BuildBoneStack(aiNode *,
 // until it cannot find another bone and return the node No known failure
 // points. (yet)
 aiNode *ArmaturePopulate::GetArmatureRoot(aiNode *bone_node,
-                                          std::vector<aiBone *> &bone_list) {
+                                          const BoneNameSet &bone_names) {
     while (nullptr != bone_node) {
-        if (!IsBoneNode(bone_node->mName, bone_list)) {
+        if (!IsBoneNode(bone_node->mName, bone_names)) {
             ASSIMP_LOG_VERBOSE_DEBUG("GetArmatureRoot() Found valid armature: ", bone_node->mName.C_Str());
             return bone_node;
         }
@@ -214,14 +219,8 @@ aiNode *ArmaturePopulate::GetArmatureRoot(aiNode *bone_node,
 
 // Simple IsBoneNode check if this could be a bone
 bool ArmaturePopulate::IsBoneNode(const aiString &bone_name,
-                                  std::vector<aiBone *> &bones) {
-    for (aiBone *bone : bones) {
-        if (bone->mName == bone_name) {
-            return true;
-        }
-    }
-
-    return false;
+                                  const BoneNameSet &bone_names) {
+    return bone_names.find(bone_name.C_Str()) != bone_names.end();
 }
 
 // Pop this node by name from the stack if found
@@ -230,23 +229,14 @@ bool ArmaturePopulate::IsBoneNode(const aiString &bone_name,
 // (serious to be fixed) Known flaw: nodes which have more than one bone could
 // be prematurely dropped from stack
 aiNode *ArmaturePopulate::GetNodeFromStack(const aiString &node_name,
-                                           std::vector<aiNode *> &nodes) {
-    std::vector<aiNode *>::iterator iter;
-    aiNode *found = nullptr;
-    for (iter = nodes.begin(); iter < nodes.end(); ++iter) {
-        aiNode *element = *iter;
-        ai_assert(nullptr != element);
-        // node valid and node name matches
-        if (element->mName == node_name) {
-            found = element;
-            break;
-        }
-    }
-
-    if (found != nullptr) {
+                                           NodeStack &nodes) {
+    NodeStack::iterator iter = nodes.find(node_name.C_Str());
+    if (iter != nodes.end() && !iter->second.empty()) {
+        aiNode *found = iter->second.front();
+        ai_assert(nullptr != found);
         ASSIMP_LOG_INFO("Removed node from stack: ", found->mName.C_Str());
         // now pop the element from the node list
-        nodes.erase(iter);
+        iter->second.pop_front();
 
         return found;
     }
@@ -44,8 +44,12 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "Common/BaseProcess.h"
 #include <assimp/BaseImporter.h>
-#include <vector>
+#include <deque>
 #include <map>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 
 struct aiNode;
@@ -83,17 +87,23 @@ public:
     /// Overwritten, @see BaseProcess
     virtual void Execute( aiScene* pScene );
 
+    /// Nodes without meshes by name, the nodes of a name in graph order
+    typedef std::unordered_map<std::string, std::deque<aiNode *>> NodeStack;
+
+    /// Names of all bones
+    typedef std::unordered_set<std::string> BoneNameSet;
+
     static aiNode *GetArmatureRoot(aiNode *bone_node,
-                                      std::vector<aiBone *> &bone_list);
+                                      const BoneNameSet &bone_names);
 
     static bool IsBoneNode(const aiString &bone_name,
-                              std::vector<aiBone *> &bones);
+                              const BoneNameSet &bone_names);
 
     static aiNode *GetNodeFromStack(const aiString &node_name,
-                                       std::vector<aiNode *> &nodes);
+                                       NodeStack &nodes);
 
     static void BuildNodeList(const aiNode *current_node,
-                                 std::vector<aiNode *> &nodes);
+                                 NodeStack &nodes);
 
     static void BuildBoneList(aiNode *current_node, const aiNode *root_node,
                                  const aiScene *scene,
@@ -103,7 +113,7 @@ public:
                                   const aiScene *scene,
                                   const std::vector<aiBone *> &bones,
                                   std::map<aiBone *, aiNode *> &bone_stack,
-                                  std::vector<aiNode *> &node_stack);
+                                  NodeStack &node_stack);
 };
 
 } // Namespace Assimp
@@ -48,6 +48,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 // internal headers
 #include "CalcTangentsProcess.h"
 #include "ProcessHelper.h"
+#include "Common/ParallelFor.h"
 #include <assimp/TinyFormatter.h>
 #include <assimp/qnan.h>
 
@@ -133,7 +134,7 @@ bool CalcTangentsProcess::ProcessMesh(aiMesh *pMesh, unsigned int meshIndex) {
 
     const float angleEpsilon = 0.9999f;
 
-    std::vector<bool> vertexDone(pMesh->mNumVertices, false);
+    std::vector<unsigned char> vertexDone(pMesh->mNumVertices, 0);
     const float qnan = get_qnan();
 
     // create space for the tangents and bitangents
@@ -147,80 +148,104 @@ bool CalcTangentsProcess::ProcessMesh(aiMesh *pMesh, unsigned int meshIndex) {
     aiVector3D *meshBitang = pMesh->mBitangents;
 
     // calculate the tangent and bitangent for every face
-    for (unsigned int a = 0; a < pMesh->mNumFaces; a++) {
-        const aiFace &face = pMesh->mFaces[a];
-        if (face.mNumIndices < 3) {
-            // There are less than three indices, thus the tangent vector
-            // is not defined. We are finished with these vertices now,
-            // their tangent vectors are set to qnan.
-            for (unsigned int i = 0; i < face.mNumIndices; ++i) {
-                unsigned int idx = face.mIndices[i];
-                vertexDone[idx] = true;
-                meshTang[idx] = aiVector3D(qnan);
-                meshBitang[idx] = aiVector3D(qnan);
+    auto processFaces = [&](size_t begin, size_t end) {
+        for (size_t a = begin; a < end; a++) {
+            const aiFace &face = pMesh->mFaces[a];
+            if (face.mNumIndices < 3) {
+                // There are less than three indices, thus the tangent vector
+                // is not defined. We are finished with these vertices now,
+                // their tangent vectors are set to qnan.
+                for (unsigned int i = 0; i < face.mNumIndices; ++i) {
+                    unsigned int idx = face.mIndices[i];
+                    vertexDone[idx] = 1;
+                    meshTang[idx] = aiVector3D(qnan);
+                    meshBitang[idx] = aiVector3D(qnan);
+                }
+
+                continue;
             }
 
-            continue;
-        }
+            // triangle or polygon... we always use only the first three indices. A polygon
+            // is supposed to be planar anyways....
+            // FIXME: (thom) create correct calculation for multi-vertex polygons maybe?
+            const unsigned int p0 = face.mIndices[0], p1 = face.mIndices[1], p2 = face.mIndices[2];
+
+            // position differences p1->p2 and p1->p3
+            aiVector3D v = meshPos[p1] - meshPos[p0], w = meshPos[p2] - meshPos[p0];
+
+            // texture offset p1->p2 and p1->p3
+            float sx = meshTex[p1].x - meshTex[p0].x, sy = meshTex[p1].y - meshTex[p0].y;
+            float tx = meshTex[p2].x - meshTex[p0].x, ty = meshTex[p2].y - meshTex[p0].y;
+            float dirCorrection = (tx * sy - ty * sx) < 0.0f ? -1.0f : 1.0f;
+            // when t1, t2, t3 in same position in UV space, just use default UV direction.
+            if (sx * ty == sy * tx) {
+                sx = 0.0;
+                sy = 1.0;
+                tx = 1.0;
+                ty = 0.0;
+            }
 
-        // triangle or polygon... we always use only the first three indices. A polygon
-        // is supposed to be planar anyways....
-        // FIXME: (thom) create correct calculation for multi-vertex polygons maybe?
-        const unsigned int p0 = face.mIndices[0], p1 = face.mIndices[1], p2 = face.mIndices[2];
-
-        // position differences p1->p2 and p1->p3
-        aiVector3D v = meshPos[p1] - meshPos[p0], w = meshPos[p2] - meshPos[p0];
-
-        // texture offset p1->p2 and p1->p3
-        float sx = meshTex[p1].x - meshTex[p0].x, sy = meshTex[p1].y - meshTex[p0].y;
-        float tx = meshTex[p2].x - meshTex[p0].x, ty = meshTex[p2].y - meshTex[p0].y;
-        float dirCorrection = (tx * sy - ty * sx) < 0.0f ? -1.0f : 1.0f;
-        // when t1, t2, t3 in same position in UV space, just use default UV direction.
-        if (sx * ty == sy * tx) {
-            sx = 0.0;
-            sy = 1.0;
-            tx = 1.0;
-            ty = 0.0;
-        }
+            // tangent points in the direction where to positive X axis of the texture coord's would point in model space
+            // bitangent's points along the positive Y axis of the texture coord's, respectively
+            aiVector3D tangent, bitangent;
+            tangent.x = (w.x * sy - v.x * ty) * dirCorrection;
+            tangent.y = (w.y * sy - v.y * ty) * dirCorrection;
+            tangent.z = (w.z * sy - v.z * ty) * dirCorrection;
+            bitangent.x = (- w.x * sx + v.x * tx) * dirCorrection;
+            bitangent.y = (- w.y * sx + v.y * tx) * dirCorrection;
+            bitangent.z = (- w.z * sx + v.z * tx) * dirCorrection;
+
+            // store for every vertex of that face
+            for (unsigned int b = 0; b < face.mNumIndices; ++b) {
+                unsigned int p = face.mIndices[b];
+
+                // project tangent and bitangent into the plane formed by the vertex' normal
+                aiVector3D localTangent = tangent - meshNorm[p] * (tangent * meshNorm[p]);
+                aiVector3D localBitangent = bitangent - meshNorm[p] * (bitangent * meshNorm[p]) - localTangent * (bitangent * localTangent);
+                localTangent.NormalizeSafe();
+                localBitangent.NormalizeSafe();
+
+                // reconstruct tangent/bitangent according to normal and bitangent/tangent when it's infinite or NaN.
+                bool invalid_tangent = is_special_float(localTangent.x) || is_special_float(localTangent.y) || is_special_float(localTangent.z);
+                bool invalid_bitangent = is_special_float(localBitangent.x) || is_special_float(localBitangent.y) || is_special_float(localBitangent.z);
+                if (invalid_tangent != invalid_bitangent) {
+                    if (invalid_tangent) {
+                        localTangent = meshNorm[p] ^ localBitangent;
+                        localTangent.NormalizeSafe();
+                    } else {
+                        localBitangent = localTangent ^ meshNorm[p];
+                        localBitangent.NormalizeSafe();
+                    }
+                }
 
-        // tangent points in the direction where to positive X axis of the texture coord's would point in model space
-        // bitangent's points along the positive Y axis of the texture coord's, respectively
-        aiVector3D tangent, bitangent;
-        tangent.x = (w.x * sy - v.x * ty) * dirCorrection;
-        tangent.y = (w.y * sy - v.y * ty) * dirCorrection;
-        tangent.z = (w.z * sy - v.z * ty) * dirCorrection;
-        bitangent.x = (- w.x * sx + v.x * tx) * dirCorrection;
-        bitangent.y = (- w.y * sx + v.y * tx) * dirCorrection;
-        bitangent.z = (- w.z * sx + v.z * tx) * dirCorrection;
-
-        // store for every vertex of that face
-        for (unsigned int b = 0; b < face.mNumIndices; ++b) {
-            unsigned int p = face.mIndices[b];
-
-            // project tangent and bitangent into the plane formed by the vertex' normal
-            aiVector3D localTangent = tangent - meshNorm[p] * (tangent * meshNorm[p]);
-            aiVector3D localBitangent = bitangent - meshNorm[p] * (bitangent * meshNorm[p]) - localTangent * (bitangent * localTangent);
-            localTangent.NormalizeSafe();
-            localBitangent.NormalizeSafe();
-
-            // reconstruct tangent/bitangent according to normal and bitangent/tangent when it's infinite or NaN.
-            bool invalid_tangent = is_special_float(localTangent.x) || is_special_float(localTangent.y) || is_special_float(localTangent.z);
-            bool invalid_bitangent = is_special_float(localBitangent.x) || is_special_float(localBitangent.y) || is_special_float(localBitangent.z);
-            if (invalid_tangent != invalid_bitangent) {
-                if (invalid_tangent) {
-                    localTangent = meshNorm[p] ^ localBitangent;
-                    localTangent.NormalizeSafe();
-                } else {
-                    localBitangent = localTangent ^ meshNorm[p];
-                    localBitangent.NormalizeSafe();
+                // and write it into the mesh.
+                meshTang[p] = localTangent;
+                meshBitang[p] = localBitangent;
+            }
+        }
+    };
+
+    // In the verbose format no two faces share a vertex, so the faces can be split over
+    // several threads. Otherwise the last face referencing a vertex has to win, as before.
+    bool sharedVertices = false;
+    {
+        std::vector<bool> referenced(pMesh->mNumVertices, false);
+        for (unsigned int a = 0; a < pMesh->mNumFaces && !sharedVertices; a++) {
+            const aiFace &face = pMesh->mFaces[a];
+            for (unsigned int i = 0; i < face.mNumIndices; ++i) {
+                if (referenced[face.mIndices[i]]) {
+                    sharedVertices = true;
+                    break;
                 }
+                referenced[face.mIndices[i]] = true;
             }
-
-            // and write it into the mesh.
-            meshTang[p] = localTangent;
-            meshBitang[p] = localBitangent;
         }
     }
+    if (sharedVertices) {
+        processFaces(0, pMesh->mNumFaces);
+    } else {
+        ParallelFor(pMesh->mNumFaces, 2048, processFaces);
+    }
 
     // create a helper to quickly find locally close vertices among the vertex array
     // FIX: check whether we can reuse the SpatialSort of a previous step
@@ -242,7 +267,10 @@ bool CalcTangentsProcess::ProcessMesh(aiMesh *pMesh, unsigned int meshIndex) {
         vertexFinder = &_vertexFinder;
         posEpsilon = ComputePositionEpsilon(pMesh);
     }
-    std::vector<unsigned int> verticesFound;
+
+    // find the vertices close to each vertex in one batch
+    std::vector<unsigned int> neighborOffsets, neighborIndices;
+    vertexFinder->FindAllNeighbors(posEpsilon, neighborOffsets, neighborIndices);
 
     const float fLimit = std::cos(configMaxAngle);
     std::vector<unsigned int> closeVertices;
@@ -253,21 +281,20 @@ bool CalcTangentsProcess::ProcessMesh(aiMesh *pMesh, unsigned int meshIndex) {
         if (vertexDone[a])
             continue;
 
-        const aiVector3D &origPos = pMesh->mVertices[a];
         const aiVector3D &origNorm = pMesh->mNormals[a];
         const aiVector3D &origTang = pMesh->mTangents[a];
         const aiVector3D &origBitang = pMesh->mBitangents[a];
         closeVertices.resize(0);
 
-        // find all vertices close to that position
-        vertexFinder->FindPositions(origPos, posEpsilon, verticesFound);
+        // all vertices close to that position
+        const unsigned int firstFound = neighborOffsets[a], lastFound = neighborOffsets[a + 1];
 
-        closeVertices.reserve(verticesFound.size() + 5);
+        closeVertices.reserve(lastFound - firstFound + 5);
         closeVertices.push_back(a);
 
         // look among them for other vertices sharing the same normal and a close-enough tangent/bitangent
-        for (unsigned int b = 0; b < verticesFound.size(); b++) {
-            unsigned int idx = verticesFound[b];
+        for (unsigned int b = firstFound; b < lastFound; b++) {
+            unsigned int idx = neighborIndices[b];
             if (vertexDone[idx])
                 continue;
             if (meshNorm[idx] * origNorm < angleEpsilon)
@@ -279,7 +306,7 @@ bool CalcTangentsProcess::ProcessMesh(aiMesh *pMesh, unsigned int meshIndex) {
 
             // it's similar enough -> add it to the smoothing group
             closeVertices.push_back(idx);
-            vertexDone[idx] = true;
+            vertexDone[idx] = 1;
         }
 
         // smooth the tangents and bitangents of all vertices that were found to be close enough
@@ -48,6 +48,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 // internal headers of the post-processing framework
 #include "ProcessHelper.h"
 #include "DeboneProcess.h"
+#include "Common/ScenePrivate.h"
 #include <stdio.h>
 
 
@@ -135,7 +136,7 @@ void DeboneProcess::Execute( aiScene* pScene)
                 for(unsigned int b=0;b<newMeshes.size();b++)    {
                     const aiString *find = newMeshes[b].second?&newMeshes[b].second->mName:0;
 
-                    aiNode *theNode = find?pScene->mRootNode->FindNode(*find):0;
+                    aiNode *theNode = find?FindNodeByName(pScene, *find):0;
                     std::pair<unsigned int,aiNode*> push_pair(static_cast<unsigned int>(meshes.size()),theNode);
 
                     mSubMeshIndices[a].push_back(push_pair);
@@ -47,7 +47,10 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 
 #include "FindInstancesProcess.h"
+#include "Common/ParallelFor.h"
 #include <memory>
+#include <unordered_map>
+#include <vector>
 #include <stdio.h>
 
 using namespace Assimp;
@@ -114,6 +117,88 @@ void UpdateMeshIndices(aiNode* node, unsigned int* lookup)
         UpdateMeshIndices(node->mChildren[n],lookup);
 }
 
+// ------------------------------------------------------------------------------------------------
+// Checks whether 'inst' is an instance of 'orig'
+bool FindInstancesProcess::IsInstance(const aiMesh* orig, const aiMesh* inst, float epsilon) const
+{
+    // check for hash collision .. we needn't check
+    // the vertex format, it *must* match due to the
+    // (brilliant) construction of the hash
+    if (orig->mNumBones       != inst->mNumBones      ||
+        orig->mNumFaces       != inst->mNumFaces      ||
+        orig->mNumVertices    != inst->mNumVertices   ||
+        orig->mMaterialIndex  != inst->mMaterialIndex ||
+        orig->mPrimitiveTypes != inst->mPrimitiveTypes)
+        return false;
+
+    // up to now the meshes are equal. Now compare vertex positions, normals,
+    // tangents and bitangents using this epsilon.
+    if (orig->HasPositions()) {
+        if(!CompareArrays(orig->mVertices,inst->mVertices,orig->mNumVertices,epsilon))
+            return false;
+    }
+    if (orig->HasNormals()) {
+        if(!CompareArrays(orig->mNormals,inst->mNormals,orig->mNumVertices,epsilon))
+            return false;
+    }
+    if (orig->HasTangentsAndBitangents()) {
+        if (!CompareArrays(orig->mTangents,inst->mTangents,orig->mNumVertices,epsilon) ||
+            !CompareArrays(orig->mBitangents,inst->mBitangents,orig->mNumVertices,epsilon))
+            return false;
+    }
+
+    // use a constant epsilon for colors and UV coordinates
+    static const float uvEpsilon = 10e-4f;
+    for (unsigned int j = 0, end = orig->GetNumUVChannels(); j < end; ++j) {
+        if (!orig->mTextureCoords[j]) {
+            continue;
+        }
+        if(!CompareArrays(orig->mTextureCoords[j],inst->mTextureCoords[j],orig->mNumVertices,uvEpsilon)) {
+            return false;
+        }
+    }
+    for (unsigned int j = 0, end = orig->GetNumColorChannels(); j < end; ++j) {
+        if (!orig->mColors[j]) {
+            continue;
+        }
+        if(!CompareArrays(orig->mColors[j],inst->mColors[j],orig->mNumVertices,uvEpsilon)) {
+            return false;
+        }
+    }
+
+    // These two checks are actually quite expensive and almost *never* required.
+    // Almost. That's why they're still here. But there's no reason to do them
+    // in speed-targeted imports.
+    if (!configSpeedFlag) {
+
+        // It seems to be strange, but we really need to check whether the
+        // bones are identical too. Although it's extremely unprobable
+        // that they're not if control reaches here, we need to deal
+        // with unprobable cases, too. It could still be that there are
+        // equal shapes which are deformed differently.
+        if (!CompareBones(orig,inst))
+            return false;
+
+        // For completeness ... compare even the index buffers for equality
+        // face order & winding order doesn't care. Input data is in verbose format.
+        std::unique_ptr<unsigned int[]> ftbl_orig(new unsigned int[orig->mNumVertices]);
+        std::unique_ptr<unsigned int[]> ftbl_inst(new unsigned int[orig->mNumVertices]);
+
+        for (unsigned int tt = 0; tt < orig->mNumFaces;++tt) {
+            aiFace& f = orig->mFaces[tt];
+            for (unsigned int nn = 0; nn < f.mNumIndices;++nn)
+                ftbl_orig[f.mIndices[nn]] = tt;
+
+            aiFace& f2 = inst->mFaces[tt];
+            for (unsigned int nn = 0; nn < f2.mNumIndices;++nn)
+                ftbl_inst[f2.mIndices[nn]] = tt;
+        }
+        if (0 != ::memcmp(ftbl_inst.get(),ftbl_orig.get(),orig->mNumVertices*sizeof(unsigned int)))
+            return false;
+    }
+    return true;
+}
+
 // ------------------------------------------------------------------------------------------------
 // Executes the post processing step on the given imported data.
 void FindInstancesProcess::Execute( aiScene* pScene)
@@ -126,130 +211,63 @@ void FindInstancesProcess::Execute( aiScene* pScene)
         // in the pipeline, so we could, depending on the file format,
         // have several thousand small meshes. That's too much for a brute
         // everyone-against-everyone check involving up to 10 comparisons
-        // each.
-        std::unique_ptr<uint64_t[]> hashes (new uint64_t[pScene->mNumMeshes]);
-        std::unique_ptr<unsigned int[]> remapping (new unsigned int[pScene->mNumMeshes]);
+        // each, so only meshes with the same hash are compared.
+        const unsigned int numMeshes = pScene->mNumMeshes;
+        std::unordered_map<uint64_t, std::vector<unsigned int>> buckets;
+        buckets.reserve(numMeshes);
+        for (unsigned int i = 0; i < numMeshes; ++i) {
+            buckets[GetMeshHash(pScene->mMeshes[i])].push_back(i);
+        }
 
-        unsigned int numMeshesOut = 0;
-        for (unsigned int i = 0; i < pScene->mNumMeshes; ++i) {
-
-            aiMesh* inst = pScene->mMeshes[i];
-            hashes[i] = GetMeshHash(inst);
-
-            // Find an appropriate epsilon
-            // to compare position differences against
-            float epsilon = ComputePositionEpsilon(inst);
-            epsilon *= epsilon;
-
-            for (int a = i-1; a >= 0; --a) {
-                if (hashes[i] == hashes[a])
-                {
-                    aiMesh* orig = pScene->mMeshes[a];
-                    if (!orig)
-                        continue;
-
-                    // check for hash collision .. we needn't check
-                    // the vertex format, it *must* match due to the
-                    // (brilliant) construction of the hash
-                    if (orig->mNumBones       != inst->mNumBones      ||
-                        orig->mNumFaces       != inst->mNumFaces      ||
-                        orig->mNumVertices    != inst->mNumVertices   ||
-                        orig->mMaterialIndex  != inst->mMaterialIndex ||
-                        orig->mPrimitiveTypes != inst->mPrimitiveTypes)
-                        continue;
-
-                    // up to now the meshes are equal. Now compare vertex positions, normals,
-                    // tangents and bitangents using this epsilon.
-                    if (orig->HasPositions()) {
-                        if(!CompareArrays(orig->mVertices,inst->mVertices,orig->mNumVertices,epsilon))
-                            continue;
-                    }
-                    if (orig->HasNormals()) {
-                        if(!CompareArrays(orig->mNormals,inst->mNormals,orig->mNumVertices,epsilon))
-                            continue;
-                    }
-                    if (orig->HasTangentsAndBitangents()) {
-                        if (!CompareArrays(orig->mTangents,inst->mTangents,orig->mNumVertices,epsilon) ||
-                            !CompareArrays(orig->mBitangents,inst->mBitangents,orig->mNumVertices,epsilon))
-                            continue;
-                    }
+        std::vector<const std::vector<unsigned int>*> candidates;
+        for (const auto& bucket : buckets) {
+            if (bucket.second.size() > 1) {
+                candidates.push_back(&bucket.second);
+            }
+        }
 
-                    // use a constant epsilon for colors and UV coordinates
-                    static const float uvEpsilon = 10e-4f;
-                    {
-                        unsigned int j, end = orig->GetNumUVChannels();
-                        for(j = 0; j < end; ++j) {
-                            if (!orig->mTextureCoords[j]) {
-                                continue;
-                            }
-                            if(!CompareArrays(orig->mTextureCoords[j],inst->mTextureCoords[j],orig->mNumVertices,uvEpsilon)) {
-                                break;
-                            }
-                        }
-                        if (j != end) {
-                            continue;
+        // The buckets don't share any meshes, so they are checked in parallel. Within
+        // a bucket a mesh is an instance of the closest preceding mesh which is not an
+        // instance itself, as with the old backward scan over all meshes.
+        std::vector<int> instanceOf(numMeshes, -1);
+        ParallelFor(candidates.size(), 1, [&](size_t begin, size_t end) {
+            for (size_t b = begin; b < end; ++b) {
+                const std::vector<unsigned int>& bucket = *candidates[b];
+                std::vector<unsigned int> originals;
+                for (unsigned int i : bucket) {
+                    const aiMesh* inst = pScene->mMeshes[i];
+
+                    // Find an appropriate epsilon
+                    // to compare position differences against
+                    float epsilon = originals.empty() ? 0.f : ComputePositionEpsilon(inst);
+                    epsilon *= epsilon;
+
+                    for (std::vector<unsigned int>::const_reverse_iterator it = originals.rbegin(); it != originals.rend(); ++it) {
+                        if (IsInstance(pScene->mMeshes[*it], inst, epsilon)) {
+                            instanceOf[i] = static_cast<int>(*it);
+                            break;
                         }
                     }
-                    {
-                        unsigned int j, end = orig->GetNumColorChannels();
-                        for(j = 0; j < end; ++j) {
-                            if (!orig->mColors[j]) {
-                                continue;
-                            }
-                            if(!CompareArrays(orig->mColors[j],inst->mColors[j],orig->mNumVertices,uvEpsilon)) {
-                                break;
-                            }
-                        }
-                        if (j != end) {
-                            continue;
-                        }
+                    if (instanceOf[i] < 0) {
+                        originals.push_back(i);
                     }
-
-                    // These two checks are actually quite expensive and almost *never* required.
-                    // Almost. That's why they're still here. But there's no reason to do them
-                    // in speed-targeted imports.
-                    if (!configSpeedFlag) {
-
-                        // It seems to be strange, but we really need to check whether the
-                        // bones are identical too. Although it's extremely unprobable
-                        // that they're not if control reaches here, we need to deal
-                        // with unprobable cases, too. It could still be that there are
-                        // equal shapes which are deformed differently.
-                        if (!CompareBones(orig,inst))
-                            continue;
-
-                        // For completeness ... compare even the index buffers for equality
-                        // face order & winding order doesn't care. Input data is in verbose format.
-                        std::unique_ptr<unsigned int[]> ftbl_orig(new unsigned int[orig->mNumVertices]);
-                        std::unique_ptr<unsigned int[]> ftbl_inst(new unsigned int[orig->mNumVertices]);
-
-                        for (unsigned int tt = 0; tt < orig->mNumFaces;++tt) {
-                            aiFace& f = orig->mFaces[tt];
-                            for (unsigned int nn = 0; nn < f.mNumIndices;++nn)
-                                ftbl_orig[f.mIndices[nn]] = tt;
-
-                            aiFace& f2 = inst->mFaces[tt];
-                            for (unsigned int nn = 0; nn < f2.mNumIndices;++nn)
-                                ftbl_inst[f2.mIndices[nn]] = tt;
-                        }
-                        if (0 != ::memcmp(ftbl_inst.get(),ftbl_orig.get(),orig->mNumVertices*sizeof(unsigned int)))
-                            continue;
-                    }
-
-                    // We're still here. Or in other words: 'inst' is an instance of 'orig'.
-                    // Place a marker in our list that we can easily update mesh indices.
-                    remapping[i] = remapping[a];
-
-                    // Delete the instanced mesh, we don't need it anymore
-                    delete inst;
-                    pScene->mMeshes[i] = nullptr;
-                    break;
                 }
             }
+        });
 
-            // If we didn't find a match for the current mesh: keep it
-            if (pScene->mMeshes[i]) {
+        std::unique_ptr<unsigned int[]> remapping (new unsigned int[numMeshes]);
+        unsigned int numMeshesOut = 0;
+        for (unsigned int i = 0; i < numMeshes; ++i) {
+            if (instanceOf[i] < 0) {
+                // If we didn't find a match for the current mesh: keep it
                 remapping[i] = numMeshesOut++;
+            } else {
+                // 'inst' is an instance of 'orig'. Place a marker in our list that
+                // we can easily update mesh indices and delete the instanced mesh,
+                // we don't need it anymore
+                remapping[i] = remapping[instanceOf[i]];
+                delete pScene->mMeshes[i];
+                pScene->mMeshes[i] = nullptr;
             }
         }
         ai_assert(0 != numMeshesOut);
@@ -86,6 +86,9 @@ uint64_t GetMeshHash(aiMesh* in) {
 inline
 bool CompareArrays(const aiVector3D* first, const aiVector3D* second,
         unsigned int size, float e) {
+    // real instances are mostly bit-identical copies
+    if (e > 0.f && 0 == ::memcmp(first, second, size * sizeof(aiVector3D)))
+        return true;
     for (const aiVector3D* end = first+size; first != end; ++first,++second) {
         if ( (*first - *second).SquareLength() >= e)
             return false;
@@ -97,6 +100,8 @@ bool CompareArrays(const aiVector3D* first, const aiVector3D* second,
 inline bool CompareArrays(const aiColor4D* first, const aiColor4D* second,
     unsigned int size, float e)
 {
+    if (e > 0.f && 0 == ::memcmp(first, second, size * sizeof(aiColor4D)))
+        return true;
     for (const aiColor4D* end = first+size; first != end; ++first,++second) {
         if ( GetColorDifference(*first,*second) >= e)
             return false;
@@ -107,7 +112,7 @@ inline bool CompareArrays(const aiColor4D* first, const aiColor4D* second,
 // ---------------------------------------------------------------------------
 /** @brief A post-processing steps to search for instanced meshes
 */
-class FindInstancesProcess : public BaseProcess
+class ASSIMP_API FindInstancesProcess : public BaseProcess
 {
 public:
 
@@ -129,6 +134,10 @@ public:
 
 private:
 
+    // -------------------------------------------------------------------
+    // Deep comparison of two meshes with the same hash
+    bool IsInstance(const aiMesh* orig, const aiMesh* inst, float epsilon) const;
+
     bool configSpeedFlag;
 
 }; // ! end class FindInstancesProcess
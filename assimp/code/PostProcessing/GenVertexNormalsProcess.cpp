@@ -48,6 +48,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 // internal headers
 #include "GenVertexNormalsProcess.h"
 #include "ProcessHelper.h"
+#include "Common/ParallelFor.h"
 #include <assimp/Exceptional.h>
 #include <assimp/qnan.h>
 
@@ -169,59 +170,76 @@ bool GenVertexNormalsProcess::GenMeshVertexNormals(aiMesh *pMesh, unsigned int m
         vertexFinder = &_vertexFinder;
         posEpsilon = ComputePositionEpsilon(pMesh);
     }
-    std::vector<unsigned int> verticesFound;
+    // Look up the neighbours of all vertices in one batch, then smooth the normals
+    // in parallel over vertex ranges. Every vertex only writes its own output.
+    std::vector<unsigned int> neighborOffsets, neighborIndices;
+    vertexFinder->FindAllNeighbors(posEpsilon, neighborOffsets, neighborIndices);
+    const unsigned int *offsets = neighborOffsets.data();
+    const unsigned int *indices = neighborIndices.data();
+    const aiVector3D *normals = pMesh->mNormals;
     aiVector3D *pcNew = new aiVector3D[pMesh->mNumVertices];
+    const size_t minChunkSize = 4096;
 
     if (configMaxAngle >= AI_DEG_TO_RAD(175.f)) {
         // There is no angle limit. Thus all vertices with positions close
         // to each other will receive the same vertex normal. This allows us
         // to optimize the whole algorithm a little bit ...
-        std::vector<bool> abHad(pMesh->mNumVertices, false);
+        // Each vertex takes the normal of the last group it was found in; a group is
+        // started by every vertex that isn't part of a previous group yet.
+        std::vector<unsigned int> group(pMesh->mNumVertices, UINT_MAX);
+        std::vector<bool> isLeader(pMesh->mNumVertices, false);
         for (unsigned int i = 0; i < pMesh->mNumVertices; ++i) {
-            if (abHad[i]) {
+            if (group[i] != UINT_MAX) {
                 continue;
             }
-
-            // Get all vertices that share this one ...
-            vertexFinder->FindPositions(pMesh->mVertices[i], posEpsilon, verticesFound);
-
-            aiVector3D pcNor;
-            for (unsigned int a = 0; a < verticesFound.size(); ++a) {
-                const aiVector3D &v = pMesh->mNormals[verticesFound[a]];
-                if (is_not_qnan(v.x)) pcNor += v;
+            isLeader[i] = true;
+            for (unsigned int a = offsets[i]; a < offsets[i + 1]; ++a) {
+                group[indices[a]] = i;
             }
-            pcNor.NormalizeSafe();
+        }
 
-            // Write the smoothed normal back to all affected normals
-            for (unsigned int a = 0; a < verticesFound.size(); ++a) {
-                unsigned int vidx = verticesFound[a];
-                pcNew[vidx] = pcNor;
-                abHad[vidx] = true;
+        std::vector<aiVector3D> groupNormals(pMesh->mNumVertices);
+        ParallelFor(pMesh->mNumVertices, minChunkSize, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                if (!isLeader[i]) {
+                    continue;
+                }
+                aiVector3D pcNor;
+                for (unsigned int a = offsets[i]; a < offsets[i + 1]; ++a) {
+                    const aiVector3D &v = normals[indices[a]];
+                    if (is_not_qnan(v.x)) pcNor += v;
+                }
+                groupNormals[i] = pcNor.NormalizeSafe();
             }
-        }
+        });
+        ParallelFor(pMesh->mNumVertices, minChunkSize, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                // a vertex with an invalid position doesn't even find itself
+                pcNew[i] = group[i] != UINT_MAX ? groupNormals[group[i]] : aiVector3D();
+            }
+        });
     }
     // Slower code path if a smooth angle is set. There are many ways to achieve
     // the effect, this one is the most straightforward one.
     else {
         const ai_real fLimit = std::cos(configMaxAngle);
-        for (unsigned int i = 0; i < pMesh->mNumVertices; ++i) {
-            // Get all vertices that share this one ...
-            vertexFinder->FindPositions(pMesh->mVertices[i], posEpsilon, verticesFound);
-
-            aiVector3D vr = pMesh->mNormals[i];
-
-            aiVector3D pcNor;
-            for (unsigned int a = 0; a < verticesFound.size(); ++a) {
-                aiVector3D v = pMesh->mNormals[verticesFound[a]];
-
-                // Check whether the angle between the two normals is not too large.
-                // Skip the angle check on our own normal to avoid false negatives
-                // (v*v is not guaranteed to be 1.0 for all unit vectors v)
-                if (is_not_qnan(v.x) && (verticesFound[a] == i || (v * vr >= fLimit)))
-                    pcNor += v;
+        ParallelFor(pMesh->mNumVertices, minChunkSize, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                const aiVector3D &vr = normals[i];
+
+                aiVector3D pcNor;
+                for (unsigned int a = offsets[i]; a < offsets[i + 1]; ++a) {
+                    const aiVector3D &v = normals[indices[a]];
+
+                    // Check whether the angle between the two normals is not too large.
+                    // Skip the angle check on our own normal to avoid false negatives
+                    // (v*v is not guaranteed to be 1.0 for all unit vectors v)
+                    if (is_not_qnan(v.x) && (indices[a] == i || (v * vr >= fLimit)))
+                        pcNor += v;
+                }
+                pcNew[i] = pcNor.NormalizeSafe();
             }
-            pcNew[i] = pcNor.NormalizeSafe();
-        }
+        });
     }
 
     delete[] pMesh->mNormals;
@@ -279,31 +279,6 @@ int JoinVerticesProcess::ProcessMesh( aiMesh* pMesh, unsigned int meshIndex) {
     static_assert(AI_MAX_VERTICES == 0x7fffffff, "AI_MAX_VERTICES == 0x7fffffff");
     std::vector<unsigned int> replaceIndex( pMesh->mNumVertices, 0xffffffff);
 
-    // float posEpsilonSqr;
-    SpatialSort *vertexFinder = nullptr;
-    SpatialSort _vertexFinder;
-
-    typedef std::pair<SpatialSort,float> SpatPair;
-    if (shared) {
-        std::vector<SpatPair >* avf;
-        shared->GetProperty(AI_SPP_SPATIAL_SORT,avf);
-        if (avf)    {
-            SpatPair& blubb = (*avf)[meshIndex];
-            vertexFinder  = &blubb.first;
-            // posEpsilonSqr = blubb.second;
-        }
-    }
-    if (!vertexFinder)  {
-        // bad, need to compute it.
-        _vertexFinder.Fill(pMesh->mVertices, pMesh->mNumVertices, sizeof( aiVector3D));
-        vertexFinder = &_vertexFinder;
-        // posEpsilonSqr = ComputePositionEpsilon(pMesh);
-    }
-
-    // Again, better waste some bytes than a realloc ...
-    std::vector<unsigned int> verticesFound;
-    verticesFound.reserve(10);
-
     // Run an optimized code path if we don't have multiple UVs or vertex colors.
     // This should yield false in more than 99% of all imports ...
     const bool hasAnimMeshes = pMesh->mNumAnimMeshes > 0;
@@ -364,6 +339,17 @@ int JoinVerticesProcess::ProcessMesh( aiMesh* pMesh, unsigned int meshIndex) {
         );
     }
 
+    // the packed influences follow the first vertex each unique vertex was made of
+    if (nullptr != pMesh->mSkinInfluences) {
+        std::vector<unsigned int> sourceVertices(uniqueVertices.size());
+        for (unsigned int a = pMesh->mNumVertices; a-- > 0;) {
+            if (replaceIndex[a] != 0xffffffff) {
+                sourceVertices[replaceIndex[a]] = a;
+            }
+        }
+        GatherSkinInfluences(pMesh, sourceVertices);
+    }
+
     updateXMeshVertices(pMesh, uniqueVertices);
     if (hasAnimMeshes) {
         for (unsigned int animMeshIndex = 0; animMeshIndex < pMesh->mNumAnimMeshes; animMeshIndex++) {
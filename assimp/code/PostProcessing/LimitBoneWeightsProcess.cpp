@@ -44,12 +44,13 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 
 #include "LimitBoneWeightsProcess.h"
-#include <assimp/SmallVector.h>
 #include <assimp/StringUtils.h>
 #include <assimp/postprocess.h>
 #include <assimp/DefaultLogger.hpp>
 #include <assimp/scene.h>
 #include <stdio.h>
+#include <cmath>
+#include <vector>
 
 using namespace Assimp;
 
@@ -58,6 +59,7 @@ using namespace Assimp;
 LimitBoneWeightsProcess::LimitBoneWeightsProcess()
 {
     mMaxWeights = AI_LMW_MAX_WEIGHTS;
+    mPackInfluences = 0;
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -90,6 +92,35 @@ void LimitBoneWeightsProcess::SetupProperties(const Importer* pImp)
 {
     // get the current value of the property
     this->mMaxWeights = pImp->GetPropertyInteger(AI_CONFIG_PP_LBW_MAX_WEIGHTS,AI_LMW_MAX_WEIGHTS);
+    this->mPackInfluences = pImp->GetPropertyInteger(AI_CONFIG_PP_LBW_PACK_INFLUENCES,0);
+    if (mPackInfluences != 0 && mPackInfluences != 4 && mPackInfluences != 8) {
+        ASSIMP_LOG_WARN("LimitBoneWeightsProcess: AI_CONFIG_PP_LBW_PACK_INFLUENCES must be 0, 4 or 8, not ", mPackInfluences);
+        mPackInfluences = mPackInfluences < 4 ? 4 : 8;
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+// Moves the n heaviest of count weights to the front of the range, sorted by descending weight.
+// This is an insertion into a sorted prefix of at most n elements, which is cheaper than sorting
+// for the few weights of a vertex. It is stable, so of two equal weights the first one is kept.
+static void SelectHeaviestWeights(LimitBoneWeightsProcess::Weight* begin, unsigned int count, unsigned int n)
+{
+    unsigned int kept = 0;
+    for (unsigned int i = 0; i < count; ++i) {
+        const LimitBoneWeightsProcess::Weight w = begin[i];
+        unsigned int j;
+        if (kept < n) {
+            j = kept++;
+        } else if (w < begin[n - 1]) {
+            j = n - 1;
+        } else {
+            continue;
+        }
+        for (; j > 0 && w < begin[j - 1]; --j) {
+            begin[j] = begin[j - 1];
+        }
+        begin[j] = w;
+    }
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -99,56 +130,79 @@ void LimitBoneWeightsProcess::ProcessMesh(aiMesh* pMesh)
     if (!pMesh->HasBones())
         return;
 
-    // collect all bone weights per vertex
-    typedef SmallVector<Weight,8> VertexWeightArray;
-    typedef std::vector<VertexWeightArray> WeightsPerVertex;
-    WeightsPerVertex vertexWeights(pMesh->mNumVertices);
-    size_t maxVertexWeights = 0;
+    // the weight limit, lowered to the slot count of the packed influences
+    const unsigned int maxWeights = (mPackInfluences && mPackInfluences < mMaxWeights) ? mPackInfluences : mMaxWeights;
 
+    // collect all bone weights per vertex in one flat array, the weights of vertex v
+    // are at firstWeight[v] in bone order
+    const unsigned int numVertices = pMesh->mNumVertices;
+    std::vector<unsigned int> firstWeight(numVertices + 1, 0);
     for (unsigned int b = 0; b < pMesh->mNumBones; ++b)
     {
         const aiBone* bone = pMesh->mBones[b];
         for (unsigned int w = 0; w < bone->mNumWeights; ++w)
         {
-            const aiVertexWeight& vw = bone->mWeights[w];
-
-            if (vertexWeights.size() <= vw.mVertexId)
-                continue;
+            if (bone->mWeights[w].mVertexId < numVertices)
+                ++firstWeight[bone->mWeights[w].mVertexId + 1];
+        }
+    }
+    unsigned int maxVertexWeights = 0;
+    for (unsigned int v = 0; v < numVertices; ++v)
+    {
+        maxVertexWeights = std::max(maxVertexWeights, firstWeight[v + 1]);
+        firstWeight[v + 1] += firstWeight[v];
+    }
 
-            vertexWeights[vw.mVertexId].push_back(Weight(b, vw.mWeight));
-            maxVertexWeights = std::max(maxVertexWeights, vertexWeights[vw.mVertexId].size());
+    std::vector<Weight> weights(firstWeight[numVertices]);
+    std::vector<unsigned int> numWeights(numVertices, 0);
+    for (unsigned int b = 0; b < pMesh->mNumBones; ++b)
+    {
+        const aiBone* bone = pMesh->mBones[b];
+        for (unsigned int w = 0; w < bone->mNumWeights; ++w)
+        {
+            const aiVertexWeight& vw = bone->mWeights[w];
+            if (vw.mVertexId < numVertices)
+                weights[firstWeight[vw.mVertexId] + numWeights[vw.mVertexId]++] = Weight(b, vw.mWeight);
         }
     }
 
-    if (maxVertexWeights <= mMaxWeights)
+    if (maxVertexWeights <= maxWeights)
+    {
+        if (mPackInfluences)
+            PackInfluences(pMesh, weights, firstWeight, numWeights);
         return;
+    }
 
     unsigned int removed = 0, old_bones = pMesh->mNumBones;
 
+    // the weights and bones change below, packed influences of an earlier run would be stale
+    if (!mPackInfluences)
+    {
+        delete pMesh->mSkinInfluences;
+        pMesh->mSkinInfluences = nullptr;
+    }
+
     // now cut the weight count if it exceeds the maximum
-    for (WeightsPerVertex::iterator vit = vertexWeights.begin(); vit != vertexWeights.end(); ++vit)
+    for (unsigned int v = 0; v < numVertices; ++v)
     {
-        if (vit->size() <= mMaxWeights)
+        if (numWeights[v] <= maxWeights)
             continue;
 
-        // more than the defined maximum -> first sort by weight in descending order. That's
-        // why we defined the < operator in such a weird way.
-        std::sort(vit->begin(), vit->end());
-
-        // now kill everything beyond the maximum count
-        unsigned int m = static_cast<unsigned int>(vit->size());
-        vit->resize(mMaxWeights);
-        removed += static_cast<unsigned int>(m - vit->size());
+        // more than the defined maximum -> keep the heaviest ones, the rest is dropped
+        Weight* vw = &weights[firstWeight[v]];
+        SelectHeaviestWeights(vw, numWeights[v], maxWeights);
+        removed += numWeights[v] - maxWeights;
+        numWeights[v] = maxWeights;
 
         // and renormalize the weights
         float sum = 0.0f;
-        for(const Weight* it = vit->begin(); it != vit->end(); ++it) {
-            sum += it->mWeight;
+        for (unsigned int i = 0; i < maxWeights; ++i) {
+            sum += vw[i].mWeight;
         }
         if (0.0f != sum) {
             const float invSum = 1.0f / sum;
-            for(Weight* it = vit->begin(); it != vit->end(); ++it) {
-                it->mWeight *= invSum;
+            for (unsigned int i = 0; i < maxWeights; ++i) {
+                vw[i].mWeight *= invSum;
             }
         }
     }
@@ -160,24 +214,26 @@ void LimitBoneWeightsProcess::ProcessMesh(aiMesh* pMesh)
     }
 
     // rebuild the vertex weight array for all bones
-    for (unsigned int a = 0; a < vertexWeights.size(); ++a)
+    for (unsigned int v = 0; v < numVertices; ++v)
     {
-        const VertexWeightArray& vw = vertexWeights[a];
-        for (const Weight* it = vw.begin(); it != vw.end(); ++it)
+        const Weight* vw = &weights[firstWeight[v]];
+        for (unsigned int i = 0; i < numWeights[v]; ++i)
         {
-            aiBone* bone = pMesh->mBones[it->mBone];
-            bone->mWeights[bone->mNumWeights++] = aiVertexWeight(a, it->mWeight);
+            aiBone* bone = pMesh->mBones[vw[i].mBone];
+            bone->mWeights[bone->mNumWeights++] = aiVertexWeight(v, vw[i].mWeight);
         }
     }
 
     // remove empty bones
     unsigned int writeBone = 0;
+    std::vector<unsigned int> boneRemap(pMesh->mNumBones);
 
     for (unsigned int readBone = 0; readBone< pMesh->mNumBones; ++readBone)
     {
         aiBone* bone = pMesh->mBones[readBone];
         if (bone->mNumWeights > 0)
         {
+            boneRemap[readBone] = writeBone;
             pMesh->mBones[writeBone++] = bone;
         }
         else
@@ -187,7 +243,65 @@ void LimitBoneWeightsProcess::ProcessMesh(aiMesh* pMesh)
     }
     pMesh->mNumBones = writeBone;
 
+    if (mPackInfluences)
+    {
+        for (unsigned int v = 0; v < numVertices; ++v)
+        {
+            Weight* vw = &weights[firstWeight[v]];
+            for (unsigned int i = 0; i < numWeights[v]; ++i)
+                vw[i].mBone = boneRemap[vw[i].mBone];
+        }
+        PackInfluences(pMesh, weights, firstWeight, numWeights);
+    }
+
     if (!DefaultLogger::isNullLogger()) {
         ASSIMP_LOG_INFO("Removed ", removed, " weights. Input bones: ", old_bones, ". Output bones: ", pMesh->mNumBones);
     }
 }
+
+// ------------------------------------------------------------------------------------------------
+// Stores the given weights per vertex as fixed-width influences in the mesh
+void LimitBoneWeightsProcess::PackInfluences(aiMesh* pMesh, std::vector<Weight>& weights,
+        const std::vector<unsigned int>& firstWeight, const std::vector<unsigned int>& numWeights) const
+{
+    const unsigned int numSlots = mPackInfluences;
+    const size_t numValues = static_cast<size_t>(pMesh->mNumVertices) * numSlots;
+
+    delete pMesh->mSkinInfluences;
+    aiSkinInfluences* influences = pMesh->mSkinInfluences = new aiSkinInfluences();
+    influences->mNumInfluences = numSlots;
+    influences->mIndexSize = pMesh->mNumBones <= 256 ? 1 : 2;
+    influences->mBoneIndices = new unsigned char[numValues * influences->mIndexSize]();
+    influences->mWeights = new unsigned short[numValues]();
+    unsigned short* indices16 = reinterpret_cast<unsigned short*>(influences->mBoneIndices);
+
+    for (unsigned int v = 0; v < pMesh->mNumVertices; ++v)
+    {
+        Weight* vw = &weights[firstWeight[v]];
+        const unsigned int count = std::min(numWeights[v], numSlots);
+        SelectHeaviestWeights(vw, numWeights[v], count);
+
+        float sum = 0.0f;
+        for (unsigned int i = 0; i < count; ++i) {
+            sum += vw[i].mWeight;
+        }
+        if (sum <= 0.0f) {
+            continue;
+        }
+
+        // quantize, the rounding error goes to the heaviest weight so that the sum is exact
+        const size_t base = static_cast<size_t>(v) * numSlots;
+        int total = 0;
+        for (unsigned int i = 0; i < count; ++i) {
+            const int q = static_cast<int>(std::lround(vw[i].mWeight / sum * 65535.0f));
+            influences->mWeights[base + i] = static_cast<unsigned short>(q);
+            total += q;
+            if (influences->mIndexSize == 1) {
+                influences->mBoneIndices[base + i] = static_cast<unsigned char>(vw[i].mBone);
+            } else {
+                indices16[base + i] = static_cast<unsigned short>(vw[i].mBone);
+            }
+        }
+        influences->mWeights[base] = static_cast<unsigned short>(influences->mWeights[base] + 65535 - total);
+    }
+}
@@ -46,6 +46,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "Common/BaseProcess.h"
 
+#include <vector>
+
 // Forward declarations
 struct aiMesh;
 
@@ -131,6 +133,16 @@ public:
 
     /** Maximum number of bones influencing any single vertex. */
     unsigned int mMaxWeights;
+
+    /** Number of slots of the packed influences, 0 if none are stored. */
+    unsigned int mPackInfluences;
+
+private:
+    // -------------------------------------------------------------------
+    /** Stores the weights per vertex in aiMesh::mSkinInfluences. */
+    void PackInfluences(aiMesh* pMesh, std::vector<Weight>& weights,
+            const std::vector<unsigned int>& firstWeight,
+            const std::vector<unsigned int>& numWeights) const;
 };
 
 } // end of namespace Assimp
@@ -44,6 +44,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 
 #include "MakeVerboseFormat.h"
+#include "ProcessHelper.h"
 #include <assimp/scene.h>
 #include <assimp/DefaultLogger.hpp>
 
@@ -110,6 +111,12 @@ bool MakeVerboseFormatProcess::MakeVerboseFormat(aiMesh *pcMesh) {
         newWeights[i].reserve(pcMesh->mBones[i]->mNumWeights * 3);
     }
 
+    // the source vertex of every output vertex, to gather the packed influences
+    std::vector<unsigned int> sourceVertices;
+    if (nullptr != pcMesh->mSkinInfluences) {
+        sourceVertices.reserve(iNumVerts);
+    }
+
     // iterate through all faces and build a clean list
     unsigned int iIndex = 0;
     for (unsigned int a = 0; a < pcMesh->mNumFaces; ++a) {
@@ -129,6 +136,9 @@ bool MakeVerboseFormatProcess::MakeVerboseFormat(aiMesh *pcMesh) {
             }
 
             pvPositions[iIndex] = pcMesh->mVertices[pcFace->mIndices[q]];
+            if (nullptr != pcMesh->mSkinInfluences) {
+                sourceVertices.push_back(pcFace->mIndices[q]);
+            }
 
             if (pcMesh->HasNormals()) {
                 pvNormals[iIndex] = pcMesh->mNormals[pcFace->mIndices[q]];
@@ -184,6 +194,7 @@ bool MakeVerboseFormatProcess::MakeVerboseFormat(aiMesh *pcMesh) {
         ++p;
     }
     pcMesh->mNumVertices = iNumVerts;
+    GatherSkinInfluences(pcMesh, sourceVertices);
 
     if (pcMesh->HasNormals()) {
         delete[] pcMesh->mNormals;
@@ -97,52 +97,78 @@ void OptimizeGraphProcess::SetupProperties(const Importer *pImp) {
 }
 
 // ------------------------------------------------------------------------------------------------
-// Collect new children
-void OptimizeGraphProcess::CollectNewChildren(aiNode *nd, std::list<aiNode *> &nodes) {
-	nodes_in += nd->mNumChildren;
+// Check whether a node is locked and must stay where it is
+bool OptimizeGraphProcess::IsLocked(const aiNode *nd) const {
+	return locked.find(AI_OG_GETKEY(nd->mName)) != locked.end();
+}
+
+// ------------------------------------------------------------------------------------------------
+// Collect new children. The graph is walked in post-order with an explicit stack, so deep
+// hierarchies don't exhaust the call stack. Each processed node appends its output to 'nodes';
+// the entries above a node's start offset are therefore exactly its newly collected children.
+void OptimizeGraphProcess::CollectNewChildren(aiNode *root, std::vector<NodeEntry> &nodes) {
+	struct Frame {
+		aiNode *node;
+		unsigned int next;
+		size_t first;
+		bool locked;
+	};
+
+	std::vector<Frame> stack;
+	stack.push_back({ root, 0, nodes.size(), IsLocked(root) });
+	while (!stack.empty()) {
+		Frame &top = stack.back();
+		if (top.next < top.node->mNumChildren) {
+			aiNode *child = top.node->mChildren[top.next++];
+			stack.push_back({ child, 0, nodes.size(), IsLocked(child) });
+			continue;
+		}
+		const Frame frame = top;
+		stack.pop_back();
+		CollapseNode(frame.node, frame.locked, nodes, frame.first);
+	}
+}
 
-	// Process children
-	std::list<aiNode *> child_nodes;
+// ------------------------------------------------------------------------------------------------
+// Process a node whose new children have all been collected in nodes[first, end). On return
+// these entries have been replaced by the nodes that take the place of 'nd' in its parent.
+void OptimizeGraphProcess::CollapseNode(aiNode *nd, bool isLocked, std::vector<NodeEntry> &nodes, size_t first) {
+	nodes_in += nd->mNumChildren;
 	for (unsigned int i = 0; i < nd->mNumChildren; ++i) {
-		CollectNewChildren(nd->mChildren[i], child_nodes);
 		nd->mChildren[i] = nullptr;
 	}
 
-	// Check whether we need this node; if not we can replace it by our own children (warn, danger of incest).
-	if (locked.find(AI_OG_GETKEY(nd->mName)) == locked.end()) {
-		for (std::list<aiNode *>::iterator it = child_nodes.begin(); it != child_nodes.end();) {
-
-			if (locked.find(AI_OG_GETKEY((*it)->mName)) == locked.end()) {
-				(*it)->mTransformation = nd->mTransformation * (*it)->mTransformation;
-				nodes.push_back(*it);
+	// Children we keep are compacted in place to nodes[first, last)
+	size_t last = first;
+	bool keep = true;
+	hoisted.clear();
 
-				it = child_nodes.erase(it);
-				continue;
+	// Check whether we need this node; if not we can replace it by our own children (warn, danger of incest).
+	if (!isLocked) {
+		for (size_t i = first; i < nodes.size(); ++i) {
+			const NodeEntry child = nodes[i];
+			if (!child.mLocked) {
+				child.mNode->mTransformation = nd->mTransformation * child.mNode->mTransformation;
+				hoisted.push_back(child);
+			} else {
+				nodes[last++] = child;
 			}
-			++it;
 		}
 
-		if (nd->mNumMeshes || !child_nodes.empty()) {
-			nodes.push_back(nd);
-		} else {
+		if (!nd->mNumMeshes && last == first) {
 			delete nd; /* bye, node */
-			return;
+			keep = false;
 		}
 	} else {
-
-		// Retain our current position in the hierarchy
-		nodes.push_back(nd);
-
 		// Now check for possible optimizations in our list of child nodes. join as many as possible
 		aiNode *join_master = nullptr;
 		aiMatrix4x4 inv;
 
-		const LockedSetType::const_iterator end = locked.end();
-
-		std::list<aiNode *> join;
-		for (std::list<aiNode *>::iterator it = child_nodes.begin(); it != child_nodes.end();) {
-			aiNode *child = *it;
-			if (child->mNumChildren == 0 && locked.find(AI_OG_GETKEY(child->mName)) == end) {
+		join.clear();
+		for (size_t i = first; i < nodes.size(); ++i) {
+			const NodeEntry entry = nodes[i];
+			aiNode *child = entry.mNode;
+			if (child->mNumChildren == 0 && !entry.mLocked) {
 
 				// There may be no instanced meshes
 				unsigned int n = 0;
@@ -160,19 +186,18 @@ void OptimizeGraphProcess::CollectNewChildren(aiNode *nd, std::list<aiNode *> &n
 						child->mTransformation = inv * child->mTransformation;
 
 						join.push_back(child);
-						it = child_nodes.erase(it);
 						continue;
 					}
 				}
 			}
-			++it;
+			nodes[last++] = entry;
 		}
 		if (join_master && !join.empty()) {
 			join_master->mName.length = ::ai_snprintf(join_master->mName.data, MAXLEN, "$MergedNode_%u", count_merged++);
 
 			unsigned int out_meshes = 0;
-			for (std::list<aiNode *>::const_iterator it = join.cbegin(); it != join.cend(); ++it) {
-				out_meshes += (*it)->mNumMeshes;
+			for (const aiNode *join_node : join) {
+				out_meshes += join_node->mNumMeshes;
 			}
 
 			// copy all mesh references in one array
@@ -220,28 +245,36 @@ void OptimizeGraphProcess::CollectNewChildren(aiNode *nd, std::list<aiNode *> &n
 			}
 		}
 	}
-	// reassign children if something changed
-	if (child_nodes.empty() || child_nodes.size() > nd->mNumChildren) {
 
-		delete[] nd->mChildren;
+	if (keep) {
+		const unsigned int numChildren = static_cast<unsigned int>(last - first);
 
-		if (!child_nodes.empty()) {
-			nd->mChildren = new aiNode *[child_nodes.size()];
-		} else
-			nd->mChildren = nullptr;
-	}
+		// reassign children if something changed
+		if (numChildren == 0 || numChildren > nd->mNumChildren) {
+
+			delete[] nd->mChildren;
 
-	nd->mNumChildren = static_cast<unsigned int>(child_nodes.size());
+			if (numChildren) {
+				nd->mChildren = new aiNode *[numChildren];
+			} else
+				nd->mChildren = nullptr;
+		}
 
-	if (nd->mChildren) {
-		aiNode **tmp = nd->mChildren;
-		for (std::list<aiNode *>::iterator it = child_nodes.begin(); it != child_nodes.end(); ++it) {
-			aiNode *node = *tmp++ = *it;
+		nd->mNumChildren = numChildren;
+		for (unsigned int i = 0; i < numChildren; ++i) {
+			aiNode *node = nd->mChildren[i] = nodes[first + i].mNode;
 			node->mParent = nd;
 		}
+
+		nodes_out += numChildren;
 	}
 
-	nodes_out += static_cast<unsigned int>(child_nodes.size());
+	// Replace our children by what takes our place in the parent. Hoisted children go before us.
+	nodes.resize(first);
+	nodes.insert(nodes.end(), hoisted.begin(), hoisted.end());
+	if (keep) {
+		nodes.push_back({ nd, isLocked });
+	}
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -306,7 +339,7 @@ void OptimizeGraphProcess::Execute(aiScene *pScene) {
 	// Do our recursive processing of scenegraph nodes. For each node collect
 	// a fully new list of children and allow their children to place themselves
 	// on the same hierarchy layer as their parents.
-	std::list<aiNode *> nodes;
+	std::vector<NodeEntry> nodes;
 	CollectNewChildren(dummy_root, nodes);
 
 	ai_assert(nodes.size() == 1);
@@ -340,17 +373,23 @@ void OptimizeGraphProcess::Execute(aiScene *pScene) {
 	}
 	meshes.clear();
 	locked.clear();
+	hoisted.clear();
+	join.clear();
 }
 
 // ------------------------------------------------------------------------------------------------
 // Build a LUT of all instanced meshes
 void OptimizeGraphProcess::FindInstancedMeshes(aiNode *pNode) {
-	for (unsigned int i = 0; i < pNode->mNumMeshes; ++i) {
-		++meshes[pNode->mMeshes[i]];
-	}
+	std::vector<const aiNode *> stack(1, pNode);
+	while (!stack.empty()) {
+		const aiNode *nd = stack.back();
+		stack.pop_back();
 
-	for (unsigned int i = 0; i < pNode->mNumChildren; ++i)
-		FindInstancedMeshes(pNode->mChildren[i]);
+		for (unsigned int i = 0; i < nd->mNumMeshes; ++i) {
+			++meshes[nd->mMeshes[i]];
+		}
+		stack.insert(stack.end(), nd->mChildren, nd->mChildren + nd->mNumChildren);
+	}
 }
 
 #endif // !! ASSIMP_BUILD_NO_OPTIMIZEGRAPH_PROCESS
@@ -51,7 +51,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <assimp/types.h>
 
-#include <set>
+#include <unordered_set>
+#include <vector>
 
 // Forward declarations
 struct aiMesh;
@@ -69,7 +70,7 @@ namespace Assimp    {
  *  @see aiProcess_OptimizeGraph for a detailed description of the
  *  algorithm being applied.
  */
-class OptimizeGraphProcess : public BaseProcess {
+class ASSIMP_API OptimizeGraphProcess : public BaseProcess {
 public:
     OptimizeGraphProcess();
     ~OptimizeGraphProcess();
@@ -109,14 +110,22 @@ public:
     }
 
 protected:
-    void CollectNewChildren(aiNode* nd, std::list<aiNode*>& nodes);
+    //! A node on the scratch stack, together with its cached lock state
+    struct NodeEntry {
+        aiNode* mNode;
+        bool mLocked;
+    };
+
+    void CollectNewChildren(aiNode* root, std::vector<NodeEntry>& nodes);
+    void CollapseNode(aiNode* nd, bool isLocked, std::vector<NodeEntry>& nodes, size_t first);
     void FindInstancedMeshes (aiNode* pNode);
+    bool IsLocked(const aiNode* nd) const;
 
 private:
 #ifdef AI_OG_USE_HASHING
-    typedef std::set<unsigned int> LockedSetType;
+    typedef std::unordered_set<unsigned int> LockedSetType;
 #else
-    typedef std::set<std::string> LockedSetType;
+    typedef std::unordered_set<std::string> LockedSetType;
 #endif
 
     //! Scene we're working with
@@ -133,6 +142,10 @@ private:
 
     //! Reference counters for meshes
     std::vector<unsigned int> meshes;
+
+    //! Scratch buffers reused for every node
+    std::vector<NodeEntry> hoisted;
+    std::vector<aiNode*> join;
 };
 
 } // end of namespace Assimp
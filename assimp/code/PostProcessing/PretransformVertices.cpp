@@ -48,9 +48,12 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "PretransformVertices.h"
 #include "ConvertToLHProcess.h"
 #include "ProcessHelper.h"
+#include "Common/ScenePrivate.h"
 #include <assimp/Exceptional.h>
 #include <assimp/SceneCombiner.h>
 
+#include <algorithm>
+
 using namespace Assimp;
 
 // some array offsets
@@ -95,9 +98,13 @@ void PretransformVertices::SetupProperties(const Importer *pImp) {
 // ------------------------------------------------------------------------------------------------
 // Count the number of nodes
 unsigned int PretransformVertices::CountNodes(const aiNode *pcNode) const {
-	unsigned int iRet = 1;
-	for (unsigned int i = 0; i < pcNode->mNumChildren; ++i) {
-		iRet += CountNodes(pcNode->mChildren[i]);
+	unsigned int iRet = 0;
+	std::vector<const aiNode *> stack(1, pcNode);
+	while (!stack.empty()) {
+		const aiNode *nd = stack.back();
+		stack.pop_back();
+		++iRet;
+		stack.insert(stack.end(), nd->mChildren, nd->mChildren + nd->mNumChildren);
 	}
 	return iRet;
 }
@@ -120,184 +127,193 @@ unsigned int PretransformVertices::GetMeshVFormat(aiMesh *pcMesh) const {
 }
 
 // ------------------------------------------------------------------------------------------------
-// Count the number of vertices in the whole scene and a given
-// material index
-void PretransformVertices::CountVerticesAndFaces(const aiScene *pcScene, const aiNode *pcNode, unsigned int iMat,
-		unsigned int iVFormat, unsigned int *piFaces, unsigned int *piVertices) const {
-	for (unsigned int i = 0; i < pcNode->mNumMeshes; ++i) {
-		aiMesh *pcMesh = pcScene->mMeshes[pcNode->mMeshes[i]];
-		if (iMat == pcMesh->mMaterialIndex && iVFormat == GetMeshVFormat(pcMesh)) {
-			*piVertices += pcMesh->mNumVertices;
-			*piFaces += pcMesh->mNumFaces;
+// Flatten the node graph into contiguous arrays. All later passes run over these arrays
+// instead of walking the tree again, which also keeps deep hierarchies off the call stack.
+void PretransformVertices::FlattenNodeGraph(aiNode *root) {
+	mNodes.clear();
+	mParents.clear();
+	mInstances.clear();
+
+	std::vector<std::pair<aiNode *, unsigned int>> stack;
+	stack.emplace_back(root, UINT_MAX);
+	while (!stack.empty()) {
+		aiNode *nd = stack.back().first;
+		const unsigned int parent = stack.back().second;
+		stack.pop_back();
+
+		const unsigned int index = static_cast<unsigned int>(mNodes.size());
+		mNodes.push_back(nd);
+		mParents.push_back(parent);
+		for (unsigned int i = 0; i < nd->mNumMeshes; ++i) {
+			mInstances.push_back({ nd->mMeshes[i], index, 0, 0 });
+		}
+
+		// push in reverse order so the children are visited in their original order
+		for (unsigned int i = nd->mNumChildren; i > 0; --i) {
+			stack.emplace_back(nd->mChildren[i - 1], index);
 		}
 	}
-	for (unsigned int i = 0; i < pcNode->mNumChildren; ++i) {
-		CountVerticesAndFaces(pcScene, pcNode->mChildren[i], iMat,
-				iVFormat, piFaces, piVertices);
+}
+
+// ------------------------------------------------------------------------------------------------
+// Count the number of vertices and faces of a range of mesh instances
+void PretransformVertices::CountVerticesAndFaces(const aiScene *pcScene, const MeshInstance *begin,
+		const MeshInstance *end, unsigned int *piFaces, unsigned int *piVertices) const {
+	for (const MeshInstance *it = begin; it != end; ++it) {
+		const aiMesh *pcMesh = pcScene->mMeshes[it->mMesh];
+		*piVertices += pcMesh->mNumVertices;
+		*piFaces += pcMesh->mNumFaces;
 	}
 }
 
 // ------------------------------------------------------------------------------------------------
-// Collect vertex/face data
-void PretransformVertices::CollectData(const aiScene *pcScene, const aiNode *pcNode, unsigned int iMat,
-		unsigned int iVFormat, aiMesh *pcMeshOut,
+// Collect vertex/face data of a range of mesh instances
+void PretransformVertices::CollectData(const aiScene *pcScene, const MeshInstance *begin,
+		const MeshInstance *end, unsigned int iVFormat, aiMesh *pcMeshOut,
 		unsigned int aiCurrent[2], unsigned int *num_refs) const {
-	// No need to multiply if there's no transformation
-	const bool identity = pcNode->mTransformation.IsIdentity();
-	for (unsigned int i = 0; i < pcNode->mNumMeshes; ++i) {
-		aiMesh *pcMesh = pcScene->mMeshes[pcNode->mMeshes[i]];
-		if (iMat == pcMesh->mMaterialIndex && iVFormat == GetMeshVFormat(pcMesh)) {
-			// Decrement mesh reference counter
-			unsigned int &num_ref = num_refs[pcNode->mMeshes[i]];
-			ai_assert(0 != num_ref);
-			--num_ref;
-			// Save the name of the last mesh
-			if (num_ref == 0) {
-				pcMeshOut->mName = pcMesh->mName;
-			}
-
-			if (identity) {
-				// copy positions without modifying them
-				::memcpy(pcMeshOut->mVertices + aiCurrent[AI_PTVS_VERTEX],
-						pcMesh->mVertices,
-						pcMesh->mNumVertices * sizeof(aiVector3D));
-
-				if (iVFormat & 0x2) {
-					// copy normals without modifying them
-					::memcpy(pcMeshOut->mNormals + aiCurrent[AI_PTVS_VERTEX],
-							pcMesh->mNormals,
-							pcMesh->mNumVertices * sizeof(aiVector3D));
-				}
-				if (iVFormat & 0x4) {
-					// copy tangents without modifying them
-					::memcpy(pcMeshOut->mTangents + aiCurrent[AI_PTVS_VERTEX],
-							pcMesh->mTangents,
-							pcMesh->mNumVertices * sizeof(aiVector3D));
-					// copy bitangents without modifying them
-					::memcpy(pcMeshOut->mBitangents + aiCurrent[AI_PTVS_VERTEX],
-							pcMesh->mBitangents,
-							pcMesh->mNumVertices * sizeof(aiVector3D));
-				}
-			} else {
-				// copy positions, transform them to worldspace
-				for (unsigned int n = 0; n < pcMesh->mNumVertices; ++n) {
-					pcMeshOut->mVertices[aiCurrent[AI_PTVS_VERTEX] + n] = pcNode->mTransformation * pcMesh->mVertices[n];
-				}
-				aiMatrix4x4 mWorldIT = pcNode->mTransformation;
-				mWorldIT.Inverse().Transpose();
+	for (const MeshInstance *it = begin; it != end; ++it) {
+		const aiMatrix4x4 &transform = mWorld[it->mNode];
+		// No need to multiply if there's no transformation
+		const bool identity = transform.IsIdentity();
+		aiMesh *pcMesh = pcScene->mMeshes[it->mMesh];
+		// Decrement mesh reference counter
+		unsigned int &num_ref = num_refs[it->mMesh];
+		ai_assert(0 != num_ref);
+		--num_ref;
+		// Save the name of the last mesh
+		if (num_ref == 0) {
+			pcMeshOut->mName = pcMesh->mName;
+		}
 
-				// TODO: implement Inverse() for aiMatrix3x3
-				aiMatrix3x3 m = aiMatrix3x3(mWorldIT);
+		if (identity) {
+			// copy positions without modifying them
+			::memcpy(pcMeshOut->mVertices + aiCurrent[AI_PTVS_VERTEX],
+					pcMesh->mVertices,
+					pcMesh->mNumVertices * sizeof(aiVector3D));
 
-				if (iVFormat & 0x2) {
-					// copy normals, transform them to worldspace
-					for (unsigned int n = 0; n < pcMesh->mNumVertices; ++n) {
-						pcMeshOut->mNormals[aiCurrent[AI_PTVS_VERTEX] + n] =
-								(m * pcMesh->mNormals[n]).Normalize();
-					}
-				}
-				if (iVFormat & 0x4) {
-					// copy tangents and bitangents, transform them to worldspace
-					for (unsigned int n = 0; n < pcMesh->mNumVertices; ++n) {
-						pcMeshOut->mTangents[aiCurrent[AI_PTVS_VERTEX] + n] = (m * pcMesh->mTangents[n]).Normalize();
-						pcMeshOut->mBitangents[aiCurrent[AI_PTVS_VERTEX] + n] = (m * pcMesh->mBitangents[n]).Normalize();
-					}
-				}
+			if (iVFormat & 0x2) {
+				// copy normals without modifying them
+				::memcpy(pcMeshOut->mNormals + aiCurrent[AI_PTVS_VERTEX],
+						pcMesh->mNormals,
+						pcMesh->mNumVertices * sizeof(aiVector3D));
 			}
-			unsigned int p = 0;
-			while (iVFormat & (0x100 << p)) {
-				// copy texture coordinates
-				memcpy(pcMeshOut->mTextureCoords[p] + aiCurrent[AI_PTVS_VERTEX],
-						pcMesh->mTextureCoords[p],
+			if (iVFormat & 0x4) {
+				// copy tangents without modifying them
+				::memcpy(pcMeshOut->mTangents + aiCurrent[AI_PTVS_VERTEX],
+						pcMesh->mTangents,
+						pcMesh->mNumVertices * sizeof(aiVector3D));
+				// copy bitangents without modifying them
+				::memcpy(pcMeshOut->mBitangents + aiCurrent[AI_PTVS_VERTEX],
+						pcMesh->mBitangents,
 						pcMesh->mNumVertices * sizeof(aiVector3D));
-				++p;
 			}
-			p = 0;
-			while (iVFormat & (0x1000000 << p)) {
-				// copy vertex colors
-				memcpy(pcMeshOut->mColors[p] + aiCurrent[AI_PTVS_VERTEX],
-						pcMesh->mColors[p],
-						pcMesh->mNumVertices * sizeof(aiColor4D));
-				++p;
+		} else {
+			// copy positions, transform them to worldspace
+			for (unsigned int n = 0; n < pcMesh->mNumVertices; ++n) {
+				pcMeshOut->mVertices[aiCurrent[AI_PTVS_VERTEX] + n] = transform * pcMesh->mVertices[n];
 			}
-			// now we need to copy all faces. since we will delete the source mesh afterwards,
-			// we don't need to reallocate the array of indices except if this mesh is
-			// referenced multiple times.
-			for (unsigned int planck = 0; planck < pcMesh->mNumFaces; ++planck) {
-				aiFace &f_src = pcMesh->mFaces[planck];
-				aiFace &f_dst = pcMeshOut->mFaces[aiCurrent[AI_PTVS_FACE] + planck];
+			aiMatrix4x4 mWorldIT = transform;
+			mWorldIT.Inverse().Transpose();
 
-				const unsigned int num_idx = f_src.mNumIndices;
+			// TODO: implement Inverse() for aiMatrix3x3
+			aiMatrix3x3 m = aiMatrix3x3(mWorldIT);
 
-				f_dst.mNumIndices = num_idx;
+			if (iVFormat & 0x2) {
+				// copy normals, transform them to worldspace
+				for (unsigned int n = 0; n < pcMesh->mNumVertices; ++n) {
+					pcMeshOut->mNormals[aiCurrent[AI_PTVS_VERTEX] + n] =
+							(m * pcMesh->mNormals[n]).Normalize();
+				}
+			}
+			if (iVFormat & 0x4) {
+				// copy tangents and bitangents, transform them to worldspace
+				for (unsigned int n = 0; n < pcMesh->mNumVertices; ++n) {
+					pcMeshOut->mTangents[aiCurrent[AI_PTVS_VERTEX] + n] = (m * pcMesh->mTangents[n]).Normalize();
+					pcMeshOut->mBitangents[aiCurrent[AI_PTVS_VERTEX] + n] = (m * pcMesh->mBitangents[n]).Normalize();
+				}
+			}
+		}
+		unsigned int p = 0;
+		while (iVFormat & (0x100 << p)) {
+			// copy texture coordinates
+			memcpy(pcMeshOut->mTextureCoords[p] + aiCurrent[AI_PTVS_VERTEX],
+					pcMesh->mTextureCoords[p],
+					pcMesh->mNumVertices * sizeof(aiVector3D));
+			++p;
+		}
+		p = 0;
+		while (iVFormat & (0x1000000 << p)) {
+			// copy vertex colors
+			memcpy(pcMeshOut->mColors[p] + aiCurrent[AI_PTVS_VERTEX],
+					pcMesh->mColors[p],
+					pcMesh->mNumVertices * sizeof(aiColor4D));
+			++p;
+		}
+		// now we need to copy all faces. since we will delete the source mesh afterwards,
+		// we don't need to reallocate the array of indices except if this mesh is
+		// referenced multiple times.
+		for (unsigned int planck = 0; planck < pcMesh->mNumFaces; ++planck) {
+			aiFace &f_src = pcMesh->mFaces[planck];
+			aiFace &f_dst = pcMeshOut->mFaces[aiCurrent[AI_PTVS_FACE] + planck];
 
-				unsigned int *pi;
-				if (!num_ref) { /* if last time the mesh is referenced -> no reallocation */
-					pi = f_dst.mIndices = f_src.mIndices;
+			const unsigned int num_idx = f_src.mNumIndices;
 
-					// offset all vertex indices
-					for (unsigned int hahn = 0; hahn < num_idx; ++hahn) {
-						pi[hahn] += aiCurrent[AI_PTVS_VERTEX];
-					}
-				} else {
-					pi = f_dst.mIndices = new unsigned int[num_idx];
+			f_dst.mNumIndices = num_idx;
 
-					// copy and offset all vertex indices
-					for (unsigned int hahn = 0; hahn < num_idx; ++hahn) {
-						pi[hahn] = f_src.mIndices[hahn] + aiCurrent[AI_PTVS_VERTEX];
-					}
+			unsigned int *pi;
+			if (!num_ref) { /* if last time the mesh is referenced -> no reallocation */
+				pi = f_dst.mIndices = f_src.mIndices;
+
+				// offset all vertex indices
+				for (unsigned int hahn = 0; hahn < num_idx; ++hahn) {
+					pi[hahn] += aiCurrent[AI_PTVS_VERTEX];
 				}
+			} else {
+				pi = f_dst.mIndices = new unsigned int[num_idx];
 
-				// Update the mPrimitiveTypes member of the mesh
-				switch (pcMesh->mFaces[planck].mNumIndices) {
-					case 0x1:
-						pcMeshOut->mPrimitiveTypes |= aiPrimitiveType_POINT;
-						break;
-					case 0x2:
-						pcMeshOut->mPrimitiveTypes |= aiPrimitiveType_LINE;
-						break;
-					case 0x3:
-						pcMeshOut->mPrimitiveTypes |= aiPrimitiveType_TRIANGLE;
-						break;
-					default:
-						pcMeshOut->mPrimitiveTypes |= aiPrimitiveType_POLYGON;
-						break;
-				};
+				// copy and offset all vertex indices
+				for (unsigned int hahn = 0; hahn < num_idx; ++hahn) {
+					pi[hahn] = f_src.mIndices[hahn] + aiCurrent[AI_PTVS_VERTEX];
+				}
 			}
-			aiCurrent[AI_PTVS_VERTEX] += pcMesh->mNumVertices;
-			aiCurrent[AI_PTVS_FACE] += pcMesh->mNumFaces;
-		}
-	}
 
-	// append all children of us
-	for (unsigned int i = 0; i < pcNode->mNumChildren; ++i) {
-		CollectData(pcScene, pcNode->mChildren[i], iMat,
-				iVFormat, pcMeshOut, aiCurrent, num_refs);
-	}
-}
-
-// ------------------------------------------------------------------------------------------------
-// Get a list of all vertex formats that occur for a given material index
-// The output list contains duplicate elements
-void PretransformVertices::GetVFormatList(const aiScene *pcScene, unsigned int iMat,
-		std::list<unsigned int> &aiOut) const {
-	for (unsigned int i = 0; i < pcScene->mNumMeshes; ++i) {
-		aiMesh *pcMesh = pcScene->mMeshes[i];
-		if (iMat == pcMesh->mMaterialIndex) {
-			aiOut.push_back(GetMeshVFormat(pcMesh));
+			// Update the mPrimitiveTypes member of the mesh
+			switch (pcMesh->mFaces[planck].mNumIndices) {
+				case 0x1:
+					pcMeshOut->mPrimitiveTypes |= aiPrimitiveType_POINT;
+					break;
+				case 0x2:
+					pcMeshOut->mPrimitiveTypes |= aiPrimitiveType_LINE;
+					break;
+				case 0x3:
+					pcMeshOut->mPrimitiveTypes |= aiPrimitiveType_TRIANGLE;
+					break;
+				default:
+					pcMeshOut->mPrimitiveTypes |= aiPrimitiveType_POLYGON;
+					break;
+			};
 		}
+		aiCurrent[AI_PTVS_VERTEX] += pcMesh->mNumVertices;
+		aiCurrent[AI_PTVS_FACE] += pcMesh->mNumFaces;
 	}
 }
 
 // ------------------------------------------------------------------------------------------------
 // Compute the absolute transformation matrices of each node
-void PretransformVertices::ComputeAbsoluteTransform(aiNode *pcNode) {
-	if (pcNode->mParent) {
-		pcNode->mTransformation = pcNode->mParent->mTransformation * pcNode->mTransformation;
+void PretransformVertices::ComputeAbsoluteTransform() {
+	// Parents precede their children in mNodes, so a single linear pass over the
+	// contiguous matrix array suffices.
+	mWorld.resize(mNodes.size());
+	for (size_t i = 0; i < mNodes.size(); ++i) {
+		const unsigned int parent = mParents[i];
+		if (parent == UINT_MAX) {
+			mWorld[i] = mNodes[i]->mTransformation;
+		} else {
+			mWorld[i] = mWorld[parent] * mNodes[i]->mTransformation;
+		}
 	}
-
-	for (unsigned int i = 0; i < pcNode->mNumChildren; ++i) {
-		ComputeAbsoluteTransform(pcNode->mChildren[i]);
+	for (size_t i = 0; i < mNodes.size(); ++i) {
+		mNodes[i]->mTransformation = mWorld[i];
 	}
 }
 
@@ -342,75 +358,68 @@ void PretransformVertices::ApplyTransform(aiMesh *mesh, const aiMatrix4x4 &mat)
 // ------------------------------------------------------------------------------------------------
 // Simple routine to build meshes in worldspace, no further optimization
 void PretransformVertices::BuildWCSMeshes(std::vector<aiMesh *> &out, aiMesh **in,
-		unsigned int numIn, aiNode *node) const {
+		unsigned int numIn) const {
 	// NOTE:
 	//  aiMesh::mNumBones store original source mesh, or UINT_MAX if not a copy
 	//  aiMesh::mBones store reference to abs. transform we multiplied with
 
 	// process meshes
-	for (unsigned int i = 0; i < node->mNumMeshes; ++i) {
-		aiMesh *mesh = in[node->mMeshes[i]];
-
-		// check whether we can operate on this mesh
-		if (!mesh->mBones || *reinterpret_cast<aiMatrix4x4 *>(mesh->mBones) == node->mTransformation) {
-			// yes, we can.
-			mesh->mBones = reinterpret_cast<aiBone **>(&node->mTransformation);
-			mesh->mNumBones = UINT_MAX;
-		} else {
+	for (aiNode *node : mNodes) {
+		for (unsigned int i = 0; i < node->mNumMeshes; ++i) {
+			aiMesh *mesh = in[node->mMeshes[i]];
+
+			// check whether we can operate on this mesh
+			if (!mesh->mBones || *reinterpret_cast<aiMatrix4x4 *>(mesh->mBones) == node->mTransformation) {
+				// yes, we can.
+				mesh->mBones = reinterpret_cast<aiBone **>(&node->mTransformation);
+				mesh->mNumBones = UINT_MAX;
+			} else {
 
-			// try to find us in the list of newly created meshes
-			for (unsigned int n = 0; n < out.size(); ++n) {
-				aiMesh *ctz = out[n];
-				if (ctz->mNumBones == node->mMeshes[i] && *reinterpret_cast<aiMatrix4x4 *>(ctz->mBones) == node->mTransformation) {
+				// try to find us in the list of newly created meshes
+				for (unsigned int n = 0; n < out.size(); ++n) {
+					aiMesh *ctz = out[n];
+					if (ctz->mNumBones == node->mMeshes[i] && *reinterpret_cast<aiMatrix4x4 *>(ctz->mBones) == node->mTransformation) {
 
-					// ok, use this one. Update node mesh index
-					node->mMeshes[i] = numIn + n;
+						// ok, use this one. Update node mesh index
+						node->mMeshes[i] = numIn + n;
+					}
 				}
-			}
-			if (node->mMeshes[i] < numIn) {
-				// Worst case. Need to operate on a full copy of the mesh
-				ASSIMP_LOG_INFO("PretransformVertices: Copying mesh due to mismatching transforms");
-				aiMesh *ntz;
+				if (node->mMeshes[i] < numIn) {
+					// Worst case. Need to operate on a full copy of the mesh
+					ASSIMP_LOG_INFO("PretransformVertices: Copying mesh due to mismatching transforms");
+					aiMesh *ntz;
 
-				const unsigned int tmp = mesh->mNumBones; //
-				mesh->mNumBones = 0;
-				SceneCombiner::Copy(&ntz, mesh);
-				mesh->mNumBones = tmp;
+					const unsigned int tmp = mesh->mNumBones; //
+					mesh->mNumBones = 0;
+					SceneCombiner::Copy(&ntz, mesh);
+					mesh->mNumBones = tmp;
 
-				ntz->mNumBones = node->mMeshes[i];
-				ntz->mBones = reinterpret_cast<aiBone **>(&node->mTransformation);
+					ntz->mNumBones = node->mMeshes[i];
+					ntz->mBones = reinterpret_cast<aiBone **>(&node->mTransformation);
 
-				out.push_back(ntz);
+					out.push_back(ntz);
 
-				node->mMeshes[i] = static_cast<unsigned int>(numIn + out.size() - 1);
+					node->mMeshes[i] = static_cast<unsigned int>(numIn + out.size() - 1);
+				}
 			}
 		}
 	}
-
-	// call children
-	for (unsigned int i = 0; i < node->mNumChildren; ++i)
-		BuildWCSMeshes(out, in, numIn, node->mChildren[i]);
 }
 
 // ------------------------------------------------------------------------------------------------
 // Reset transformation matrices to identity
-void PretransformVertices::MakeIdentityTransform(aiNode *nd) const {
-	nd->mTransformation = aiMatrix4x4();
-
-	// call children
-	for (unsigned int i = 0; i < nd->mNumChildren; ++i)
-		MakeIdentityTransform(nd->mChildren[i]);
+void PretransformVertices::MakeIdentityTransform() const {
+	for (aiNode *nd : mNodes) {
+		nd->mTransformation = aiMatrix4x4();
+	}
 }
 
 // ------------------------------------------------------------------------------------------------
 // Build reference counters for all meshes
-void PretransformVertices::BuildMeshRefCountArray(const aiNode *nd, unsigned int *refs) const {
-	for (unsigned int i = 0; i < nd->mNumMeshes; ++i)
-		refs[nd->mMeshes[i]]++;
-
-	// call children
-	for (unsigned int i = 0; i < nd->mNumChildren; ++i)
-		BuildMeshRefCountArray(nd->mChildren[i], refs);
+void PretransformVertices::BuildMeshRefCountArray(unsigned int *refs) const {
+	for (const MeshInstance &inst : mInstances) {
+		refs[inst.mMesh]++;
+	}
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -424,14 +433,15 @@ void PretransformVertices::Execute(aiScene *pScene) {
 
 	const unsigned int iOldMeshes = pScene->mNumMeshes;
 	const unsigned int iOldAnimationChannels = pScene->mNumAnimations;
-	const unsigned int iOldNodes = CountNodes(pScene->mRootNode);
-
 	if (configTransform) {
 		pScene->mRootNode->mTransformation = configTransformation * pScene->mRootNode->mTransformation;
 	}
 
 	// first compute absolute transformation matrices for all nodes
-	ComputeAbsoluteTransform(pScene->mRootNode);
+	FlattenNodeGraph(pScene->mRootNode);
+	ComputeAbsoluteTransform();
+
+	const unsigned int iOldNodes = static_cast<unsigned int>(mNodes.size());
 
 	// Delete aiMesh::mBones for all meshes. The bones are
 	// removed during this step and we need the pointer as
@@ -456,7 +466,7 @@ void PretransformVertices::Execute(aiScene *pScene) {
 	if (configKeepHierarchy) {
 
 		// Hack: store the matrix we're transforming a mesh with in aiMesh::mBones
-		BuildWCSMeshes(apcOutMeshes, pScene->mMeshes, pScene->mNumMeshes, pScene->mRootNode);
+		BuildWCSMeshes(apcOutMeshes, pScene->mMeshes, pScene->mNumMeshes);
 
 		// ... if new meshes have been generated, append them to the end of the scene
 		if (apcOutMeshes.size() > 0) {
@@ -480,51 +490,65 @@ void PretransformVertices::Execute(aiScene *pScene) {
 		}
 	} else {
 		apcOutMeshes.reserve(static_cast<size_t>(pScene->mNumMaterials) << 1u);
-		std::list<unsigned int> aiVFormats;
 
 		std::vector<unsigned int> s(pScene->mNumMeshes, 0);
-		BuildMeshRefCountArray(pScene->mRootNode, &s[0]);
-
-		for (unsigned int i = 0; i < pScene->mNumMaterials; ++i) {
-			// get the list of all vertex formats for this material
-			aiVFormats.clear();
-			GetVFormatList(pScene, i, aiVFormats);
-			aiVFormats.sort();
-			aiVFormats.unique();
-			for (std::list<unsigned int>::const_iterator j = aiVFormats.begin(); j != aiVFormats.end(); ++j) {
-				unsigned int iVertices = 0;
-				unsigned int iFaces = 0;
-				CountVerticesAndFaces(pScene, pScene->mRootNode, i, *j, &iFaces, &iVertices);
-				if (0 != iFaces && 0 != iVertices) {
-					apcOutMeshes.push_back(new aiMesh());
-					aiMesh *pcMesh = apcOutMeshes.back();
-					pcMesh->mNumFaces = iFaces;
-					pcMesh->mNumVertices = iVertices;
-					pcMesh->mFaces = new aiFace[iFaces];
-					pcMesh->mVertices = new aiVector3D[iVertices];
-					pcMesh->mMaterialIndex = i;
-					if ((*j) & 0x2) pcMesh->mNormals = new aiVector3D[iVertices];
-					if ((*j) & 0x4) {
-						pcMesh->mTangents = new aiVector3D[iVertices];
-						pcMesh->mBitangents = new aiVector3D[iVertices];
-					}
-					iFaces = 0;
-					while ((*j) & (0x100 << iFaces)) {
-						pcMesh->mTextureCoords[iFaces] = new aiVector3D[iVertices];
-						if ((*j) & (0x10000 << iFaces))
-							pcMesh->mNumUVComponents[iFaces] = 3;
-						else
-							pcMesh->mNumUVComponents[iFaces] = 2;
-						iFaces++;
-					}
-					iFaces = 0;
-					while ((*j) & (0x1000000 << iFaces))
-						pcMesh->mColors[iFaces++] = new aiColor4D[iVertices];
-
-					// fill the mesh ...
-					unsigned int aiTemp[2] = { 0, 0 };
-					CollectData(pScene, pScene->mRootNode, i, *j, pcMesh, aiTemp, &s[0]);
+		BuildMeshRefCountArray(&s[0]);
+
+		// Group all mesh instances by material and vertex format. The sort is stable,
+		// so the instances of each group keep their depth-first order.
+		for (MeshInstance &inst : mInstances) {
+			aiMesh *mesh = pScene->mMeshes[inst.mMesh];
+			inst.mMaterial = mesh->mMaterialIndex;
+			inst.mVFormat = GetMeshVFormat(mesh);
+		}
+		std::stable_sort(mInstances.begin(), mInstances.end(), [](const MeshInstance &a, const MeshInstance &b) {
+			return a.mMaterial != b.mMaterial ? a.mMaterial < b.mMaterial : a.mVFormat < b.mVFormat;
+		});
+
+		for (size_t first = 0, last = 0; first < mInstances.size(); first = last) {
+			const unsigned int i = mInstances[first].mMaterial;
+			const unsigned int vformat = mInstances[first].mVFormat;
+			for (last = first + 1; last < mInstances.size(); ++last) {
+				if (mInstances[last].mMaterial != i || mInstances[last].mVFormat != vformat) {
+					break;
+				}
+			}
+			if (i >= pScene->mNumMaterials) {
+				continue;
+			}
+			const MeshInstance *begin = mInstances.data() + first, *end = mInstances.data() + last;
+			unsigned int iVertices = 0;
+			unsigned int iFaces = 0;
+			CountVerticesAndFaces(pScene, begin, end, &iFaces, &iVertices);
+			if (0 != iFaces && 0 != iVertices) {
+				apcOutMeshes.push_back(new aiMesh());
+				aiMesh *pcMesh = apcOutMeshes.back();
+				pcMesh->mNumFaces = iFaces;
+				pcMesh->mNumVertices = iVertices;
+				pcMesh->mFaces = new aiFace[iFaces];
+				pcMesh->mVertices = new aiVector3D[iVertices];
+				pcMesh->mMaterialIndex = i;
+				if (vformat & 0x2) pcMesh->mNormals = new aiVector3D[iVertices];
+				if (vformat & 0x4) {
+					pcMesh->mTangents = new aiVector3D[iVertices];
+					pcMesh->mBitangents = new aiVector3D[iVertices];
 				}
+				iFaces = 0;
+				while (vformat & (0x100 << iFaces)) {
+					pcMesh->mTextureCoords[iFaces] = new aiVector3D[iVertices];
+					if (vformat & (0x10000 << iFaces))
+						pcMesh->mNumUVComponents[iFaces] = 3;
+					else
+						pcMesh->mNumUVComponents[iFaces] = 2;
+					iFaces++;
+				}
+				iFaces = 0;
+				while (vformat & (0x1000000 << iFaces))
+					pcMesh->mColors[iFaces++] = new aiColor4D[iVertices];
+
+				// fill the mesh ...
+				unsigned int aiTemp[2] = { 0, 0 };
+				CollectData(pScene, begin, end, vformat, pcMesh, aiTemp, &s[0]);
 			}
 		}
 
@@ -575,7 +599,7 @@ void PretransformVertices::Execute(aiScene *pScene) {
 	// --- we need to keep all cameras and lights
 	for (unsigned int i = 0; i < pScene->mNumCameras; ++i) {
 		aiCamera *cam = pScene->mCameras[i];
-		const aiNode *nd = pScene->mRootNode->FindNode(cam->mName);
+		const aiNode *nd = FindNodeByName(pScene, cam->mName);
         ai_assert(nullptr != nd);
 
 		// multiply all properties of the camera with the absolute
@@ -587,7 +611,7 @@ void PretransformVertices::Execute(aiScene *pScene) {
 
 	for (unsigned int i = 0; i < pScene->mNumLights; ++i) {
 		aiLight *l = pScene->mLights[i];
-		const aiNode *nd = pScene->mRootNode->FindNode(l->mName);
+		const aiNode *nd = FindNodeByName(pScene, l->mName);
         ai_assert(nullptr != nd);
 
 		// multiply all properties of the camera with the absolute
@@ -645,8 +669,12 @@ void PretransformVertices::Execute(aiScene *pScene) {
 		}
 	} else {
 		// ... and finally set the transformation matrix of all nodes to identity
-		MakeIdentityTransform(pScene->mRootNode);
+		MakeIdentityTransform();
 	}
+	mNodes.clear();
+	mParents.clear();
+	mWorld.clear();
+	mInstances.clear();
 
 	if (configNormalize) {
 		// compute the boundary of all meshes
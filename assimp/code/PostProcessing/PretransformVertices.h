@@ -51,7 +51,6 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <assimp/mesh.h>
 
-#include <list>
 #include <vector>
 
 // Forward declarations
@@ -108,38 +107,44 @@ private:
 	// Get a bitwise combination identifying the vertex format of a mesh
 	unsigned int GetMeshVFormat(aiMesh *pcMesh) const;
 
+	//! A reference from a node to one of the scene meshes
+	struct MeshInstance {
+		unsigned int mMesh; //!< Index into aiScene::mMeshes
+		unsigned int mNode; //!< Index into mNodes
+		unsigned int mMaterial; //!< Material index of the mesh
+		unsigned int mVFormat; //!< Vertex format of the mesh, see GetMeshVFormat()
+	};
+
 	// -------------------------------------------------------------------
-	// Count the number of vertices in the whole scene and a given
-	// material index
-	void CountVerticesAndFaces(const aiScene *pcScene, const aiNode *pcNode,
-			unsigned int iMat,
-			unsigned int iVFormat,
+	// Flatten the node graph into mNodes, mParents and mInstances
+	void FlattenNodeGraph(aiNode *root);
+
+	// -------------------------------------------------------------------
+	// Count the number of vertices and faces of a range of mesh instances
+	void CountVerticesAndFaces(const aiScene *pcScene,
+			const MeshInstance *begin,
+			const MeshInstance *end,
 			unsigned int *piFaces,
 			unsigned int *piVertices) const;
 
 	// -------------------------------------------------------------------
-	// Collect vertex/face data
-	void CollectData(const aiScene *pcScene, const aiNode *pcNode,
-			unsigned int iMat,
+	// Collect vertex/face data of a range of mesh instances
+	void CollectData(const aiScene *pcScene,
+			const MeshInstance *begin,
+			const MeshInstance *end,
 			unsigned int iVFormat,
 			aiMesh *pcMeshOut,
 			unsigned int aiCurrent[2],
 			unsigned int *num_refs) const;
 
-	// -------------------------------------------------------------------
-	// Get a list of all vertex formats that occur for a given material
-	// The output list contains duplicate elements
-	void GetVFormatList(const aiScene *pcScene, unsigned int iMat,
-			std::list<unsigned int> &aiOut) const;
-
 	// -------------------------------------------------------------------
 	// Compute the absolute transformation matrices of each node
-	void ComputeAbsoluteTransform(aiNode *pcNode);
+	void ComputeAbsoluteTransform();
 
 	// -------------------------------------------------------------------
 	// Simple routine to build meshes in worldspace, no further optimization
 	void BuildWCSMeshes(std::vector<aiMesh *> &out, aiMesh **in,
-			unsigned int numIn, aiNode *node) const;
+			unsigned int numIn) const;
 
 	// -------------------------------------------------------------------
 	// Apply the node transformation to a mesh
@@ -147,11 +152,11 @@ private:
 
 	// -------------------------------------------------------------------
 	// Reset transformation matrices to identity
-	void MakeIdentityTransform(aiNode *nd) const;
+	void MakeIdentityTransform() const;
 
 	// -------------------------------------------------------------------
 	// Build reference counters for all meshes
-	void BuildMeshRefCountArray(const aiNode *nd, unsigned int *refs) const;
+	void BuildMeshRefCountArray(unsigned int *refs) const;
 
 	//! Configuration option: keep scene hierarchy as long as possible
 	bool configKeepHierarchy;
@@ -159,6 +164,15 @@ private:
 	bool configTransform;
 	aiMatrix4x4 configTransformation;
 	bool mConfigPointCloud;
+
+	//! The node graph in depth-first order, parents precede their children
+	std::vector<aiNode *> mNodes;
+	//! Index of the parent of each node in mNodes, UINT_MAX for the root
+	std::vector<unsigned int> mParents;
+	//! Absolute transformation of each node in mNodes
+	std::vector<aiMatrix4x4> mWorld;
+	//! All mesh references of the node graph in depth-first order
+	std::vector<MeshInstance> mInstances;
 };
 
 } // end of namespace Assimp
@@ -380,4 +380,28 @@ aiMesh *MakeSubmesh(const aiMesh *pMesh, const std::vector<unsigned int> &subMes
     return oMesh;
 }
 
+// -------------------------------------------------------------------------------
+void GatherSkinInfluences(aiMesh *mesh, const std::vector<unsigned int> &sourceVertices) {
+    const aiSkinInfluences *src = mesh->mSkinInfluences;
+    if (nullptr == src) {
+        return;
+    }
+
+    const size_t numSlots = src->mNumInfluences;
+    const size_t indexSize = src->mIndexSize;
+    aiSkinInfluences *dest = new aiSkinInfluences();
+    dest->mNumInfluences = src->mNumInfluences;
+    dest->mIndexSize = src->mIndexSize;
+    dest->mBoneIndices = new unsigned char[sourceVertices.size() * numSlots * indexSize];
+    dest->mWeights = new unsigned short[sourceVertices.size() * numSlots];
+    for (size_t v = 0; v < sourceVertices.size(); ++v) {
+        const size_t from = sourceVertices[v] * numSlots;
+        memcpy(dest->mBoneIndices + v * numSlots * indexSize, src->mBoneIndices + from * indexSize, numSlots * indexSize);
+        memcpy(dest->mWeights + v * numSlots, src->mWeights + from, numSlots * sizeof(unsigned short));
+    }
+
+    delete mesh->mSkinInfluences;
+    mesh->mSkinInfluences = dest;
+}
+
 } // namespace Assimp
@@ -331,13 +331,18 @@ const char *MappingTypeToString(aiTextureMapping in);
 // Split a mesh given a list of faces to be contained in the sub mesh
 aiMesh *MakeSubmesh(const aiMesh *superMesh, const std::vector<unsigned int> &subMeshFaces, unsigned int subFlags);
 
+// -------------------------------------------------------------------------------
+// Replace the skin influences of a mesh with the ones of the given source vertices,
+// for steps which rebuild the vertex arrays. Vertex n of the result is the source
+// vertex sourceVertices[n]. Does nothing if the mesh has no packed influences.
+void GatherSkinInfluences(aiMesh *mesh, const std::vector<unsigned int> &sourceVertices);
+
 // -------------------------------------------------------------------------------
 // Utility post-process step to share the spatial sort tree between
 // all steps which use it to speedup its computations.
 class ComputeSpatialSortProcess : public BaseProcess {
     bool IsActive(unsigned int pFlags) const {
-        return nullptr != shared && 0 != (pFlags & (aiProcess_CalcTangentSpace |
-                                                           aiProcess_GenNormals | aiProcess_JoinIdenticalVertices));
+        return nullptr != shared && 0 != (pFlags & (aiProcess_CalcTangentSpace | aiProcess_GenNormals));
     }
 
     void Execute(aiScene *pScene) {
@@ -362,8 +367,7 @@ class ComputeSpatialSortProcess : public BaseProcess {
 // ... and the same again to cleanup the whole stuff
 class DestroySpatialSortProcess : public BaseProcess {
     bool IsActive(unsigned int pFlags) const {
-        return nullptr != shared && 0 != (pFlags & (aiProcess_CalcTangentSpace |
-                                                        aiProcess_GenNormals | aiProcess_JoinIdenticalVertices));
+        return nullptr != shared && 0 != (pFlags & (aiProcess_CalcTangentSpace | aiProcess_GenNormals));
     }
 
     void Execute(aiScene * /*pScene*/) {
@@ -0,0 +1,322 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2022, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file Implementation of the post processing step to remove redundant
+ *  animation keys
+ */
+
+#include "ReduceAnimationKeysProcess.h"
+#include "Common/ParallelFor.h"
+
+#include <assimp/DefaultLogger.hpp>
+#include <assimp/postprocess.h>
+#include <assimp/scene.h>
+
+#include <algorithm>
+#include <cmath>
+
+using namespace Assimp;
+
+namespace {
+
+// The three smaller components of a unit quaternion are within +-1/sqrt(2)
+const double SmallestThreeRange = 0.70710678118654752;
+const unsigned int SmallestThreeMax = 0x7fff;
+
+// ------------------------------------------------------------------------------------------------
+inline ai_real KeyError(const aiVector3D &a, const aiVector3D &b) {
+    return (a - b).Length();
+}
+
+// ------------------------------------------------------------------------------------------------
+// Angle of the rotation between two quaternions. q and -q describe the same rotation,
+// and the chord length stays precise for the tiny angles we compare against.
+inline ai_real KeyError(const aiQuaternion &a, const aiQuaternion &b) {
+    const double dot = double(a.x) * b.x + double(a.y) * b.y + double(a.z) * b.z + double(a.w) * b.w;
+    const double s = dot < 0.0 ? -1.0 : 1.0;
+    const double dx = a.x - s * b.x, dy = a.y - s * b.y, dz = a.z - s * b.z, dw = a.w - s * b.w;
+    const double chord = std::sqrt(dx * dx + dy * dy + dz * dz + dw * dw);
+    return static_cast<ai_real>(4.0 * std::asin(std::min(chord * 0.5, 1.0)));
+}
+
+// ------------------------------------------------------------------------------------------------
+inline double Factor(double start, double end, double time) {
+    return end == start ? 0.0 : (time - start) / (end - start);
+}
+
+// ------------------------------------------------------------------------------------------------
+inline aiVector3D Interpolate(const aiVectorKey &a, const aiVectorKey &b, double time) {
+    const ai_real f = static_cast<ai_real>(Factor(a.mTime, b.mTime, time));
+    return a.mValue + (b.mValue - a.mValue) * f;
+}
+
+// ------------------------------------------------------------------------------------------------
+inline aiQuaternion Interpolate(const aiQuatKey &a, const aiQuatKey &b, double time) {
+    aiQuaternion out;
+    aiQuaternion::Interpolate(out, a.mValue, b.mValue, static_cast<ai_real>(Factor(a.mTime, b.mTime, time)));
+    return out.Normalize();
+}
+
+// ------------------------------------------------------------------------------------------------
+// Reduce a track in place. The candidate keys are compared against the reference
+// values, which differ from them if the keys were quantized. Returns the maximum
+// error of the reduced track.
+template <typename KeyType>
+ai_real ReduceTrack(KeyType *&keys, unsigned int &numKeys, const KeyType *reference, ai_real tolerance) {
+    if (numKeys < 2) {
+        return numKeys ? KeyError(keys[0].mValue, reference[0].mValue) : ai_real(0.0);
+    }
+
+    // split segments at the key with the largest error until all
+    // dropped keys are close enough to the interpolation
+    std::vector<unsigned char> keep(numKeys, 0);
+    keep[0] = keep[numKeys - 1] = 1;
+
+    ai_real maxError = 0.0;
+    std::vector<std::pair<unsigned int, unsigned int>> segments;
+    segments.emplace_back(0, numKeys - 1);
+    while (!segments.empty()) {
+        const std::pair<unsigned int, unsigned int> segment = segments.back();
+        segments.pop_back();
+
+        unsigned int worst = segment.first;
+        ai_real worstError = -1.0;
+        for (unsigned int i = segment.first + 1; i < segment.second; ++i) {
+            const ai_real error = KeyError(Interpolate(keys[segment.first], keys[segment.second], reference[i].mTime),
+                    reference[i].mValue);
+            if (error > worstError) {
+                worst = i;
+                worstError = error;
+            }
+        }
+        if (worstError > tolerance) {
+            keep[worst] = 1;
+            segments.emplace_back(segment.first, worst);
+            segments.emplace_back(worst, segment.second);
+        } else {
+            maxError = std::max(maxError, worstError);
+        }
+    }
+
+    unsigned int numKept = 0;
+    for (unsigned int i = 0; i < numKeys; ++i) {
+        if (keep[i]) {
+            maxError = std::max(maxError, KeyError(keys[i].mValue, reference[i].mValue));
+            ++numKept;
+        }
+    }
+
+    // a track which stays within the tolerance of its first key is constant
+    if (numKept == 2) {
+        ai_real constError = 0.0;
+        for (unsigned int i = 0; i < numKeys && constError <= tolerance; ++i) {
+            constError = std::max(constError, KeyError(keys[0].mValue, reference[i].mValue));
+        }
+        if (constError <= tolerance) {
+            keep[numKeys - 1] = 0;
+            numKept = 1;
+            maxError = constError;
+        }
+    }
+
+    if (numKept != numKeys) {
+        KeyType *out = new KeyType[numKept];
+        for (unsigned int i = 0, n = 0; i < numKeys; ++i) {
+            if (keep[i]) {
+                out[n++] = keys[i];
+            }
+        }
+        delete[] keys;
+        keys = out;
+        numKeys = numKept;
+    }
+    return maxError;
+}
+
+} // namespace
+
+// ------------------------------------------------------------------------------------------------
+ReduceAnimationKeysProcess::ReduceAnimationKeysProcess() :
+        mEnabled(false),
+        mQuantizeRotations(false),
+        mPositionTolerance(AI_RAK_DEFAULT_POSITION_TOLERANCE),
+        mRotationTolerance(AI_RAK_DEFAULT_ROTATION_TOLERANCE),
+        mScalingTolerance(AI_RAK_DEFAULT_SCALING_TOLERANCE) {
+    // empty
+}
+
+// ------------------------------------------------------------------------------------------------
+ReduceAnimationKeysProcess::~ReduceAnimationKeysProcess() = default;
+
+// ------------------------------------------------------------------------------------------------
+// Returns whether the processing step is present in the given flag field.
+bool ReduceAnimationKeysProcess::IsActive(unsigned int pFlags) const {
+    return 0 != (pFlags & aiProcess_FindInvalidData);
+}
+
+// ------------------------------------------------------------------------------------------------
+// Setup import configuration
+void ReduceAnimationKeysProcess::SetupProperties(const Importer *pImp) {
+    mEnabled = pImp->GetPropertyBool(AI_CONFIG_PP_RAK_REDUCE_KEYS, false);
+    mQuantizeRotations = pImp->GetPropertyBool(AI_CONFIG_PP_RAK_QUANTIZE_ROTATIONS, false);
+    mPositionTolerance = pImp->GetPropertyFloat(AI_CONFIG_PP_RAK_POSITION_TOLERANCE, AI_RAK_DEFAULT_POSITION_TOLERANCE);
+    mRotationTolerance = pImp->GetPropertyFloat(AI_CONFIG_PP_RAK_ROTATION_TOLERANCE, AI_RAK_DEFAULT_ROTATION_TOLERANCE);
+    mScalingTolerance = pImp->GetPropertyFloat(AI_CONFIG_PP_RAK_SCALING_TOLERANCE, AI_RAK_DEFAULT_SCALING_TOLERANCE);
+}
+
+// ------------------------------------------------------------------------------------------------
+// Executes the post processing step on the given imported data.
+void ReduceAnimationKeysProcess::Execute(aiScene *pScene) {
+    mReport.clear();
+    if (!mEnabled) {
+        return;
+    }
+
+    ASSIMP_LOG_DEBUG("ReduceAnimationKeysProcess begin");
+
+    std::vector<aiNodeAnim *> channels;
+    for (unsigned int a = 0; a < pScene->mNumAnimations; ++a) {
+        const aiAnimation *anim = pScene->mAnimations[a];
+        channels.insert(channels.end(), anim->mChannels, anim->mChannels + anim->mNumChannels);
+    }
+
+    // the channels are independent of each other
+    mReport.resize(channels.size());
+    ParallelFor(channels.size(), 4, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            mReport[i] = ReduceChannel(channels[i]);
+        }
+    });
+
+    size_t numKeysIn = 0, numKeysOut = 0;
+    for (const ChannelReport &report : mReport) {
+        numKeysIn += report.mNumKeysIn;
+        numKeysOut += report.mNumKeysOut;
+        ASSIMP_LOG_VERBOSE_DEBUG("ReduceAnimationKeysProcess: ", report.mNodeName, " kept ", report.mNumKeysOut,
+                " of ", report.mNumKeysIn, " keys, max error position ", report.mMaxPositionError,
+                " rotation ", report.mMaxRotationError, " scaling ", report.mMaxScalingError);
+    }
+
+    if (numKeysOut != numKeysIn) {
+        ASSIMP_LOG_INFO("ReduceAnimationKeysProcess finished. Kept ", numKeysOut, " of ", numKeysIn,
+                " keys, compression ratio ", numKeysOut ? double(numKeysIn) / numKeysOut : 0.0);
+    } else {
+        ASSIMP_LOG_DEBUG("ReduceAnimationKeysProcess finished. There was nothing to do");
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+// Reduce the keys of a single channel
+ReduceAnimationKeysProcess::ChannelReport ReduceAnimationKeysProcess::ReduceChannel(aiNodeAnim *anim) const {
+    ai_assert(nullptr != anim);
+
+    ChannelReport report;
+    report.mNodeName = anim->mNodeName.C_Str();
+    report.mNumKeysIn = anim->mNumPositionKeys + anim->mNumRotationKeys + anim->mNumScalingKeys;
+
+    // without quantization the keys are their own reference
+    const std::vector<aiVectorKey> positions(anim->mPositionKeys, anim->mPositionKeys + anim->mNumPositionKeys);
+    report.mMaxPositionError = ReduceTrack(anim->mPositionKeys, anim->mNumPositionKeys, positions.data(), mPositionTolerance);
+
+    const std::vector<aiQuatKey> rotations(anim->mRotationKeys, anim->mRotationKeys + anim->mNumRotationKeys);
+    if (mQuantizeRotations) {
+        for (unsigned int i = 0; i < anim->mNumRotationKeys; ++i) {
+            anim->mRotationKeys[i].mValue = DecodeQuaternion48(EncodeQuaternion48(anim->mRotationKeys[i].mValue));
+        }
+    }
+    report.mMaxRotationError = ReduceTrack(anim->mRotationKeys, anim->mNumRotationKeys, rotations.data(), mRotationTolerance);
+
+    const std::vector<aiVectorKey> scalings(anim->mScalingKeys, anim->mScalingKeys + anim->mNumScalingKeys);
+    report.mMaxScalingError = ReduceTrack(anim->mScalingKeys, anim->mNumScalingKeys, scalings.data(), mScalingTolerance);
+
+    report.mNumKeysOut = anim->mNumPositionKeys + anim->mNumRotationKeys + anim->mNumScalingKeys;
+    return report;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Encode a rotation in the smallest-three format
+uint64_t ReduceAnimationKeysProcess::EncodeQuaternion48(const aiQuaternion &in) {
+    aiQuaternion q = in;
+    q.Normalize();
+
+    const double c[4] = { q.x, q.y, q.z, q.w };
+    unsigned int largest = 0;
+    for (unsigned int i = 1; i < 4; ++i) {
+        if (std::abs(c[i]) > std::abs(c[largest])) {
+            largest = i;
+        }
+    }
+
+    // q and -q are the same rotation, so the largest component is stored implicitly as positive
+    const double sign = c[largest] < 0.0 ? -1.0 : 1.0;
+    uint64_t bits = largest;
+    for (unsigned int i = 0; i < 4; ++i) {
+        if (i == largest) {
+            continue;
+        }
+        const double t = (c[i] * sign + SmallestThreeRange) / (2.0 * SmallestThreeRange) * SmallestThreeMax;
+        bits = (bits << 15) | static_cast<uint64_t>(std::lround(std::min(std::max(t, 0.0), double(SmallestThreeMax))));
+    }
+    return bits;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Decode a rotation in the smallest-three format
+aiQuaternion ReduceAnimationKeysProcess::DecodeQuaternion48(uint64_t bits) {
+    const unsigned int largest = static_cast<unsigned int>((bits >> 45) & 0x3);
+
+    double c[4];
+    double sum = 0.0;
+    unsigned int shift = 45;
+    for (unsigned int i = 0; i < 4; ++i) {
+        if (i == largest) {
+            continue;
+        }
+        shift -= 15;
+        const unsigned int u = static_cast<unsigned int>((bits >> shift) & SmallestThreeMax);
+        c[i] = double(u) / SmallestThreeMax * (2.0 * SmallestThreeRange) - SmallestThreeRange;
+        sum += c[i] * c[i];
+    }
+    c[largest] = std::sqrt(std::max(0.0, 1.0 - sum));
+
+    return aiQuaternion(static_cast<ai_real>(c[3]), static_cast<ai_real>(c[0]),
+            static_cast<ai_real>(c[1]), static_cast<ai_real>(c[2]));
+}
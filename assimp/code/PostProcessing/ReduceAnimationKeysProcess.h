@@ -0,0 +1,138 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2022, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file Defines a post processing step to remove redundant animation keys
+ */
+#ifndef AI_REDUCEANIMATIONKEYSPROCESS_H_INC
+#define AI_REDUCEANIMATIONKEYSPROCESS_H_INC
+
+#include "Common/BaseProcess.h"
+
+#include <assimp/anim.h>
+#include <assimp/types.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Assimp {
+
+// ---------------------------------------------------------------------------
+/** Removes animation keys which can be restored by interpolating between
+ *  their neighbours within a given tolerance.
+ *
+ *  Each track is reduced with a Douglas-Peucker style subdivision: a segment
+ *  between two kept keys is split at the key with the largest error until all
+ *  dropped keys are within the tolerance. Positions and scalings are compared
+ *  by distance, rotations by the angle between the slerp'ed and the original
+ *  quaternion. Rotations can optionally be snapped to a 48 bit smallest-three
+ *  encoding first, the reported error includes the quantization.
+ *
+ *  All post-processing flags are taken, so the step runs with
+ *  #aiProcess_FindInvalidData and is enabled by #AI_CONFIG_PP_RAK_REDUCE_KEYS. */
+class ASSIMP_API ReduceAnimationKeysProcess : public BaseProcess {
+public:
+    //! Result of the reduction of one channel
+    struct ChannelReport {
+        std::string mNodeName;
+        unsigned int mNumKeysIn;
+        unsigned int mNumKeysOut;
+        ai_real mMaxPositionError;
+        ai_real mMaxRotationError;
+        ai_real mMaxScalingError;
+    };
+
+    ReduceAnimationKeysProcess();
+    ~ReduceAnimationKeysProcess();
+
+    // -------------------------------------------------------------------
+    bool IsActive(unsigned int pFlags) const;
+
+    // -------------------------------------------------------------------
+    void SetupProperties(const Importer *pImp);
+
+    // -------------------------------------------------------------------
+    void Execute(aiScene *pScene);
+
+    // -------------------------------------------------------------------
+    /** Reduce the keys of a single channel with the current tolerances.
+     *  @param anim The channel to work on
+     *  @return Key counts and maximum errors of the channel */
+    ChannelReport ReduceChannel(aiNodeAnim *anim) const;
+
+    //! Set the tolerances - needed for unit testing
+    void SetTolerances(ai_real position, ai_real rotation, ai_real scaling) {
+        mPositionTolerance = position;
+        mRotationTolerance = rotation;
+        mScalingTolerance = scaling;
+    }
+
+    //! Enable the 48 bit rotation quantization
+    void SetQuantizeRotations(bool quantize) {
+        mQuantizeRotations = quantize;
+    }
+
+    //! Reports of all channels of the last run
+    const std::vector<ChannelReport> &GetReport() const {
+        return mReport;
+    }
+
+    // -------------------------------------------------------------------
+    /** Encode a rotation in 48 bits: 2 bits for the index of the largest
+     *  component, 15 bits for each of the other three. */
+    static uint64_t EncodeQuaternion48(const aiQuaternion &q);
+
+    // -------------------------------------------------------------------
+    //! Decode a rotation written by EncodeQuaternion48()
+    static aiQuaternion DecodeQuaternion48(uint64_t bits);
+
+private:
+    bool mEnabled;
+    bool mQuantizeRotations;
+    ai_real mPositionTolerance;
+    ai_real mRotationTolerance;
+    ai_real mScalingTolerance;
+    std::vector<ChannelReport> mReport;
+};
+
+} // end of namespace Assimp
+
+#endif // AI_REDUCEANIMATIONKEYSPROCESS_H_INC
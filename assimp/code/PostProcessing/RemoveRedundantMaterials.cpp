@@ -51,10 +51,72 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "ProcessHelper.h"
 #include "Material/MaterialSystem.h"
 #include <assimp/Exceptional.h>
+#include <assimp/Hash.h>
+#include <algorithm>
+#include <chrono>
+#include <unordered_map>
+#include <unordered_set>
 #include <stdio.h>
 
 using namespace Assimp;
 
+// ------------------------------------------------------------------------------------------------
+// The properties of a material which take part in the comparison, sorted by key, semantic
+// and index so the order in which an importer added them doesn't matter. Properties with '?'
+// as first character are skipped, as in ComputeMaterialHash().
+typedef std::vector<const aiMaterialProperty*> MaterialFingerprint;
+
+static MaterialFingerprint GetFingerprint(const aiMaterial* mat) {
+    MaterialFingerprint fingerprint;
+    fingerprint.reserve(mat->mNumProperties);
+    for (unsigned int i = 0; i < mat->mNumProperties; ++i) {
+        const aiMaterialProperty* prop = mat->mProperties[i];
+        if (nullptr != prop && prop->mKey.data[0] != '?') {
+            fingerprint.push_back(prop);
+        }
+    }
+    std::sort(fingerprint.begin(), fingerprint.end(), [](const aiMaterialProperty* a, const aiMaterialProperty* b) {
+        const int cmp = ::strcmp(a->mKey.data, b->mKey.data);
+        if (cmp != 0) {
+            return cmp < 0;
+        }
+        if (a->mSemantic != b->mSemantic) {
+            return a->mSemantic < b->mSemantic;
+        }
+        return a->mIndex < b->mIndex;
+    });
+    return fingerprint;
+}
+
+// ------------------------------------------------------------------------------------------------
+static uint32_t HashFingerprint(const MaterialFingerprint& fingerprint) {
+    uint32_t hash = 1503;
+    for (const aiMaterialProperty* prop : fingerprint) {
+        hash = SuperFastHash(prop->mKey.data, (unsigned int)prop->mKey.length, hash);
+        hash = SuperFastHash(prop->mData, prop->mDataLength, hash);
+        hash = SuperFastHash((const char*)&prop->mSemantic, sizeof(unsigned int), hash);
+        hash = SuperFastHash((const char*)&prop->mIndex, sizeof(unsigned int), hash);
+    }
+    return hash;
+}
+
+// ------------------------------------------------------------------------------------------------
+static bool IsSameFingerprint(const MaterialFingerprint& a, const MaterialFingerprint& b) {
+    if (a.size() != b.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < a.size(); ++i) {
+        const aiMaterialProperty* pa = a[i];
+        const aiMaterialProperty* pb = b[i];
+        if (pa->mSemantic != pb->mSemantic || pa->mIndex != pb->mIndex || pa->mType != pb->mType ||
+                pa->mDataLength != pb->mDataLength || pa->mKey != pb->mKey ||
+                0 != ::memcmp(pa->mData, pb->mData, pa->mDataLength)) {
+            return false;
+        }
+    }
+    return true;
+}
+
 // ------------------------------------------------------------------------------------------------
 // Constructor to be privately used by Importer
 RemoveRedundantMatsProcess::RemoveRedundantMatsProcess()
@@ -86,6 +148,7 @@ void RemoveRedundantMatsProcess::SetupProperties(const Importer* pImp)
 void RemoveRedundantMatsProcess::Execute( aiScene* pScene)
 {
     ASSIMP_LOG_DEBUG("RemoveRedundantMatsProcess begin");
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
 
     unsigned int redundantRemoved = 0, unreferencedRemoved = 0;
     if (pScene->mNumMaterials)
@@ -102,6 +165,7 @@ void RemoveRedundantMatsProcess::Execute( aiScene* pScene)
 
             std::list<std::string> strings;
             ConvertListToStrings(mConfigFixedMaterials,strings);
+            const std::unordered_set<std::string> fixed(strings.begin(), strings.end());
 
             for (unsigned int i = 0; i < pScene->mNumMaterials;++i) {
                 aiMaterial* mat = pScene->mMaterials[i];
@@ -110,8 +174,7 @@ void RemoveRedundantMatsProcess::Execute( aiScene* pScene)
                 mat->Get(AI_MATKEY_NAME,name);
 
                 if (name.length) {
-                    std::list<std::string>::const_iterator it = std::find(strings.begin(), strings.end(), name.data);
-                    if (it != strings.end()) {
+                    if (fixed.find(name.data) != fixed.end()) {
 
                         // Our brilliant 'salt': A single material property with ~ as first
                         // character to mark it as internal and temporary.
@@ -133,11 +196,11 @@ void RemoveRedundantMatsProcess::Execute( aiScene* pScene)
         }
         unsigned int iNewNum = 0;
 
-        // Iterate through all materials and calculate a hash for them
-        // store all hashes in a list and so a quick search whether
-        // we do already have a specific hash. This allows us to
-        // determine which materials are identical.
-        uint32_t *aiHashes = new uint32_t[ pScene->mNumMaterials ];;
+        // Iterate through all materials and calculate a fingerprint for them.
+        // The hashes of the fingerprints map to the materials which are kept,
+        // so every material is only compared with the few which might be equal.
+        std::vector<MaterialFingerprint> fingerprints(pScene->mNumMaterials);
+        std::unordered_map<uint32_t, std::vector<unsigned int>> representatives;
         for (unsigned int i = 0; i < pScene->mNumMaterials;++i)
         {
             // No mesh is referencing this material, remove it.
@@ -148,22 +211,25 @@ void RemoveRedundantMatsProcess::Execute( aiScene* pScene)
                 continue;
             }
 
-            // Check all previously mapped materials for a matching hash.
+            // Check the kept materials with the same hash for a matching fingerprint.
             // On a match we can delete this material and just make it ref to the same index.
-            uint32_t me = aiHashes[i] = ComputeMaterialHash(pScene->mMaterials[i]);
-            for (unsigned int a = 0; a < i;++a)
-            {
-                if (abReferenced[a] && me == aiHashes[a]) {
+            fingerprints[i] = GetFingerprint(pScene->mMaterials[i]);
+            std::vector<unsigned int>& candidates = representatives[HashFingerprint(fingerprints[i])];
+            bool redundant = false;
+            for (unsigned int a : candidates) {
+                if (IsSameFingerprint(fingerprints[a], fingerprints[i])) {
                     ++redundantRemoved;
-                    me = 0;
+                    redundant = true;
                     aiMappingTable[i] = aiMappingTable[a];
+                    fingerprints[i].clear();
                     delete pScene->mMaterials[i];
                     pScene->mMaterials[i] = nullptr;
                     break;
                 }
             }
             // This is a new material that is referenced, add to the map.
-            if (me) {
+            if (!redundant) {
+                candidates.push_back(i);
                 aiMappingTable[i] = iNewNum++;
             }
         }
@@ -206,16 +272,16 @@ void RemoveRedundantMatsProcess::Execute( aiScene* pScene)
             pScene->mNumMaterials = iNewNum;
         }
         // delete temporary storage
-        delete[] aiHashes;
         delete[] aiMappingTable;
     }
+    const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
     if (redundantRemoved == 0 && unreferencedRemoved == 0)
     {
-        ASSIMP_LOG_DEBUG("RemoveRedundantMatsProcess finished ");
+        ASSIMP_LOG_DEBUG("RemoveRedundantMatsProcess finished in ", ms, " ms");
     }
     else
     {
-        ASSIMP_LOG_INFO("RemoveRedundantMatsProcess finished. Removed ", redundantRemoved, " redundant and ",
-            unreferencedRemoved, " unused materials.");
+        ASSIMP_LOG_INFO("RemoveRedundantMatsProcess finished in ", ms, " ms. Merged ", redundantRemoved,
+            " redundant and removed ", unreferencedRemoved, " unused materials.");
     }
 }
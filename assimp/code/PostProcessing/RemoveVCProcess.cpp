@@ -301,6 +301,8 @@ bool RemoveVCProcess::ProcessMesh(aiMesh *pMesh) {
     // handle bones
     if (configDeleteFlags & aiComponent_BONEWEIGHTS && pMesh->mBones) {
         ArrayDelete(pMesh->mBones, pMesh->mNumBones);
+        delete pMesh->mSkinInfluences;
+        pMesh->mSkinInfluences = nullptr;
         ret = true;
     }
     return ret;
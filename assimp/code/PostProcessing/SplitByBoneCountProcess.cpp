@@ -52,7 +52,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <limits>
 #include <assimp/TinyFormatter.h>
 #include <assimp/Exceptional.h>
-#include <set>
+#include <algorithm>
+#include <numeric>
 
 using namespace Assimp;
 using namespace Assimp::Formatter;
@@ -63,6 +64,7 @@ SplitByBoneCountProcess::SplitByBoneCountProcess()
 {
     // set default, might be overridden by importer config
     mMaxBoneCount = AI_SBBC_DEFAULT_MAX_BONES;
+    mBoneLocality = false;
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -81,6 +83,7 @@ bool SplitByBoneCountProcess::IsActive( unsigned int pFlags) const
 void SplitByBoneCountProcess::SetupProperties(const Importer* pImp)
 {
     mMaxBoneCount = pImp->GetPropertyInteger(AI_CONFIG_PP_SBBC_MAX_BONES,AI_SBBC_DEFAULT_MAX_BONES);
+    mBoneLocality = pImp->GetPropertyInteger(AI_CONFIG_PP_SBBC_BONE_LOCALITY,0) != 0;
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -182,30 +185,60 @@ void SplitByBoneCountProcess::SplitMesh( const aiMesh* pMesh, std::vector<aiMesh
         }
     }
 
-    unsigned int numFacesHandled = 0;
-    std::vector<bool> isFaceHandled( pMesh->mNumFaces, false);
-    while( numFacesHandled < pMesh->mNumFaces )
+    // faces which are not stored in a submesh yet, in the order they are visited
+    std::vector<unsigned int> remainingFaces( pMesh->mNumFaces);
+    std::iota( remainingFaces.begin(), remainingFaces.end(), 0u);
+    if( mBoneLocality )
+    {
+        // visit the faces grouped by their most influential bone. Faces sharing bones
+        // then end up in the same submesh, which gives fewer submeshes.
+        std::vector<unsigned int> mainBone( pMesh->mNumFaces, std::numeric_limits<unsigned int>::max());
+        for( unsigned int a = 0; a < pMesh->mNumFaces; ++a )
+        {
+            const aiFace& face = pMesh->mFaces[a];
+            float maxWeight = 0.0f;
+            for( unsigned int b = 0; b < face.mNumIndices; ++b )
+            {
+                for( const BoneWeight& bw : vertexBones[face.mIndices[b]] )
+                {
+                    if( bw.second > maxWeight || (bw.second == maxWeight && bw.first < mainBone[a]) )
+                    {
+                        maxWeight = bw.second;
+                        mainBone[a] = bw.first;
+                    }
+                }
+            }
+        }
+        std::stable_sort( remainingFaces.begin(), remainingFaces.end(), [&mainBone]( unsigned int x, unsigned int y ) {
+            return mainBone[x] < mainBone[y];
+        });
+    }
+
+    // per bone: the last face visit which listed it as new bone, so each face lists a bone once
+    std::vector<size_t> boneVisit( pMesh->mNumBones, 0);
+    size_t visit = 0;
+    std::vector<unsigned int> newBonesAtCurrentFace;
+    std::vector<unsigned int> skippedFaces;
+    std::vector<unsigned int> subMeshFaces;
+    std::vector<bool> isBoneUsed;
+    while( !remainingFaces.empty() )
     {
         // which bones are used in the current submesh
         unsigned int numBones = 0;
-        std::vector<bool> isBoneUsed( pMesh->mNumBones, false);
+        isBoneUsed.assign( pMesh->mNumBones, false);
         // indices of the faces which are going to go into this submesh
-        std::vector<unsigned int> subMeshFaces;
-        subMeshFaces.reserve( pMesh->mNumFaces);
+        subMeshFaces.clear();
+        skippedFaces.clear();
         // accumulated vertex count of all the faces in this submesh
         unsigned int numSubMeshVertices = 0;
 
         // add faces to the new submesh as long as all bones affecting the faces' vertices fit in the limit
-        for( unsigned int a = 0; a < pMesh->mNumFaces; ++a)
+        for( unsigned int a : remainingFaces )
         {
-            // skip if the face is already stored in a submesh
-            if( isFaceHandled[a] )
-            {
-                continue;
-            }
-            // a small local set of new bones for the current face. State of all used bones for that face
+            // the new bones for the current face. State of all used bones for that face
             // can only be updated AFTER the face is completely analysed. Thanks to imre for the fix.
-            std::set<unsigned int> newBonesAtCurrentFace;
+            newBonesAtCurrentFace.clear();
+            ++visit;
 
             const aiFace& face = pMesh->mFaces[a];
             // check every vertex if its bones would still fit into the current submesh
@@ -215,9 +248,10 @@ void SplitByBoneCountProcess::SplitMesh( const aiMesh* pMesh, std::vector<aiMesh
               for( unsigned int c = 0; c < vb.size(); ++c)
               {
                 unsigned int boneIndex = vb[c].first;
-                if( !isBoneUsed[boneIndex] )
+                if( !isBoneUsed[boneIndex] && boneVisit[boneIndex] != visit )
                 {
-                  newBonesAtCurrentFace.insert(boneIndex);
+                  boneVisit[boneIndex] = visit;
+                  newBonesAtCurrentFace.push_back(boneIndex);
                 }
               }
             }
@@ -225,27 +259,28 @@ void SplitByBoneCountProcess::SplitMesh( const aiMesh* pMesh, std::vector<aiMesh
             // leave out the face if the new bones required for this face don't fit the bone count limit anymore
             if( numBones + newBonesAtCurrentFace.size() > mMaxBoneCount )
             {
+                skippedFaces.push_back( a);
                 continue;
             }
 
             // mark all new bones as necessary
-            for (std::set<unsigned int>::iterator it = newBonesAtCurrentFace.begin(); it != newBonesAtCurrentFace.end(); ++it)
+            for( unsigned int boneIndex : newBonesAtCurrentFace )
             {
-              if (!isBoneUsed[*it])
-              {
-                isBoneUsed[*it] = true;
-                numBones++;
-              }
+                isBoneUsed[boneIndex] = true;
             }
+            numBones += static_cast<unsigned int>(newBonesAtCurrentFace.size());
 
             // store the face index and the vertex count
             subMeshFaces.push_back( a);
             numSubMeshVertices += face.mNumIndices;
+        }
 
-            // remember that this face is handled
-            isFaceHandled[a] = true;
-            numFacesHandled++;
+        if( subMeshFaces.empty() )
+        {
+            throw DeadlyImportError("SplitByBoneCountProcess: Single face requires more bones than specified max bone count!");
         }
+        // the faces left out are the ones to visit for the next submesh
+        remainingFaces.swap( skippedFaces);
 
         // create a new mesh to hold this subset of the source mesh
         aiMesh* newMesh = new aiMesh;
@@ -286,7 +321,32 @@ void SplitByBoneCountProcess::SplitMesh( const aiMesh* pMesh, std::vector<aiMesh
             }
         }
 
-        // and copy over the data, generating faces with linear indices along the way
+        // Create the bones for the new submesh: first create the bone array
+        newMesh->mNumBones = 0;
+        newMesh->mBones = new aiBone*[numBones];
+
+        std::vector<unsigned int> mappedBoneIndex( pMesh->mNumBones, std::numeric_limits<unsigned int>::max());
+        for( unsigned int a = 0; a < pMesh->mNumBones; ++a )
+        {
+            if( !isBoneUsed[a] )
+            {
+                continue;
+            }
+
+            // create the new bone
+            const aiBone* srcBone = pMesh->mBones[a];
+            aiBone* dstBone = new aiBone;
+            mappedBoneIndex[a] = newMesh->mNumBones;
+            newMesh->mBones[newMesh->mNumBones++] = dstBone;
+            dstBone->mName = srcBone->mName;
+            dstBone->mOffsetMatrix = srcBone->mOffsetMatrix;
+            dstBone->mNumWeights = 0;
+        }
+
+        ai_assert( newMesh->mNumBones == numBones );
+
+        // and copy over the data, generating faces with linear indices along the way.
+        // The weights per new bone are counted in the same pass.
         newMesh->mFaces = new aiFace[subMeshFaces.size()];
         unsigned int nvi = 0; // next vertex index
         std::vector<unsigned int> previousVertexIndices( numSubMeshVertices, std::numeric_limits<unsigned int>::max()); // per new vertex: its index in the source mesh
@@ -328,6 +388,10 @@ void SplitByBoneCountProcess::SplitMesh( const aiMesh* pMesh, std::vector<aiMesh
                         newMesh->mColors[c][nvi] = pMesh->mColors[c][srcIndex];
                     }
                 }
+                for( const BoneWeight& bw : vertexBones[srcIndex] )
+                {
+                    newMesh->mBones[mappedBoneIndex[bw.first]]->mNumWeights++;
+                }
 
                 nvi++;
             }
@@ -335,46 +399,6 @@ void SplitByBoneCountProcess::SplitMesh( const aiMesh* pMesh, std::vector<aiMesh
 
         ai_assert( nvi == numSubMeshVertices );
 
-        // Create the bones for the new submesh: first create the bone array
-        newMesh->mNumBones = 0;
-        newMesh->mBones = new aiBone*[numBones];
-
-        std::vector<unsigned int> mappedBoneIndex( pMesh->mNumBones, std::numeric_limits<unsigned int>::max());
-        for( unsigned int a = 0; a < pMesh->mNumBones; ++a )
-        {
-            if( !isBoneUsed[a] )
-            {
-                continue;
-            }
-
-            // create the new bone
-            const aiBone* srcBone = pMesh->mBones[a];
-            aiBone* dstBone = new aiBone;
-            mappedBoneIndex[a] = newMesh->mNumBones;
-            newMesh->mBones[newMesh->mNumBones++] = dstBone;
-            dstBone->mName = srcBone->mName;
-            dstBone->mOffsetMatrix = srcBone->mOffsetMatrix;
-            dstBone->mNumWeights = 0;
-        }
-
-        ai_assert( newMesh->mNumBones == numBones );
-
-        // iterate over all new vertices and count which bones affected its old vertex in the source mesh
-        for( unsigned int a = 0; a < numSubMeshVertices; ++a )
-        {
-            unsigned int oldIndex = previousVertexIndices[a];
-            const std::vector<BoneWeight>& bonesOnThisVertex = vertexBones[oldIndex];
-
-            for( unsigned int b = 0; b < bonesOnThisVertex.size(); ++b )
-            {
-                unsigned int newBoneIndex = mappedBoneIndex[ bonesOnThisVertex[b].first ];
-                if( newBoneIndex != std::numeric_limits<unsigned int>::max() )
-                {
-                    newMesh->mBones[newBoneIndex]->mNumWeights++;
-                }
-            }
-        }
-
         // allocate all bone weight arrays accordingly
         for( unsigned int a = 0; a < newMesh->mNumBones; ++a )
         {
@@ -61,7 +61,7 @@ namespace Assimp
  * Applied BEFORE the JoinVertices-Step occurs.
  * Returns NON-UNIQUE vertices, splits by bone count.
 */
-class SplitByBoneCountProcess : public BaseProcess
+class ASSIMP_API SplitByBoneCountProcess : public BaseProcess
 {
 public:
 
@@ -102,6 +102,9 @@ public:
     /// Max bone count. Splitting occurs if a mesh has more than that number of bones.
     size_t mMaxBoneCount;
 
+    /// Visit the faces grouped by their main bone when filling the submeshes.
+    bool mBoneLocality;
+
     /// Per mesh index: Array of indices of the new submeshes.
     std::vector< std::vector<unsigned int> > mSubMeshIndices;
 };
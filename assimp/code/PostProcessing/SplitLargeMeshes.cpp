@@ -47,12 +47,207 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 // internal headers of the post-processing framework
 #include "SplitLargeMeshes.h"
 #include "ProcessHelper.h"
+#include "Common/ParallelFor.h"
+
+#include <algorithm>
 
 using namespace Assimp;
 
+namespace {
+
+typedef std::vector<std::pair<unsigned int, float>> VertexWeightTable;
+
+// ------------------------------------------------------------------------------------------------
+// Spread the lower 10 bits of a value to every third bit
+inline uint32_t SpreadBits(uint32_t v) {
+    v = (v | (v << 16)) & 0x030000FF;
+    v = (v | (v << 8)) & 0x0300F00F;
+    v = (v | (v << 4)) & 0x030C30C3;
+    v = (v | (v << 2)) & 0x09249249;
+    return v;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Position of a point on a 30 bit Morton curve through the cube of the given size
+inline uint32_t MortonCode(const aiVector3D &p, const aiVector3D &min, ai_real size) {
+    auto quantize = [size](ai_real v, ai_real lo) -> uint32_t {
+        const ai_real t = (v - lo) / size * ai_real(1023.0);
+        return static_cast<uint32_t>(std::min(std::max(t, ai_real(0.0)), ai_real(1023.0)));
+    };
+    return SpreadBits(quantize(p.x, min.x)) |
+           (SpreadBits(quantize(p.y, min.y)) << 1) |
+           (SpreadBits(quantize(p.z, min.z)) << 2);
+}
+
+// ------------------------------------------------------------------------------------------------
+// Compute the order in which the faces are distributed to the submeshes. In spatial mode the
+// faces are sorted along a Morton curve through their centers, so every submesh covers a
+// compact region of the mesh instead of a run of the face list.
+void ComputeFaceOrder(const aiMesh *pMesh, bool spatial, std::vector<unsigned int> &order) {
+    order.resize(pMesh->mNumFaces);
+    for (unsigned int i = 0; i < pMesh->mNumFaces; ++i) {
+        order[i] = i;
+    }
+    if (!spatial || !pMesh->HasPositions()) {
+        return;
+    }
+
+    aiVector3D min, max;
+    ArrayBounds(pMesh->mVertices, pMesh->mNumVertices, min, max);
+    // quantize all axes alike, so the curve stays local on flat or elongated meshes
+    const aiVector3D extent = max - min;
+    const ai_real size = std::max(std::max(extent.x, extent.y), extent.z);
+    if (!(size > 0)) {
+        return;
+    }
+
+    std::vector<uint32_t> codes(pMesh->mNumFaces);
+    ParallelFor(pMesh->mNumFaces, 4096, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            const aiFace &face = pMesh->mFaces[i];
+            aiVector3D center;
+            for (unsigned int n = 0; n < face.mNumIndices; ++n) {
+                center += pMesh->mVertices[face.mIndices[n]];
+            }
+            if (face.mNumIndices) {
+                center /= static_cast<ai_real>(face.mNumIndices);
+            }
+            codes[i] = MortonCode(center, min, size);
+        }
+    });
+    std::stable_sort(order.begin(), order.end(), [&codes](unsigned int a, unsigned int b) {
+        return codes[a] < codes[b];
+    });
+}
+
+// ------------------------------------------------------------------------------------------------
+// Gather a vertex attribute into an array of exactly the output size
+template <typename T>
+T *GatherVertices(const T *src, const unsigned int *vertices, unsigned int numVertices) {
+    if (nullptr == src) {
+        return nullptr;
+    }
+    T *out = new T[numVertices];
+    for (unsigned int i = 0; i < numVertices; ++i) {
+        out[i] = src[vertices[i]];
+    }
+    return out;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Copy the bones referenced by the vertices of a submesh. The weight table is indexed by
+// source vertex.
+void CopyBones(const aiMesh *pMesh, aiMesh *pcMesh, const VertexWeightTable *weights,
+        const unsigned int *vertices, unsigned int numVertices) {
+    // count the weights of every bone first, so each weight array is allocated once
+    std::vector<unsigned int> counts(pMesh->mNumBones, 0);
+    for (unsigned int i = 0; i < numVertices; ++i) {
+        for (const auto &weight : weights[vertices[i]]) {
+            ++counts[weight.first];
+        }
+    }
+
+    std::vector<aiBone *> bones(pMesh->mNumBones, nullptr);
+    for (unsigned int k = 0; k < pMesh->mNumBones; ++k) {
+        if (counts[k]) {
+            ++pcMesh->mNumBones;
+        }
+    }
+    if (0 == pcMesh->mNumBones) {
+        return;
+    }
+    pcMesh->mBones = new aiBone *[pcMesh->mNumBones];
+
+    unsigned int out = 0;
+    for (unsigned int k = 0; k < pMesh->mNumBones; ++k) {
+        if (counts[k]) {
+            const aiBone *pcOldBone = pMesh->mBones[k];
+            aiBone *pcOut = bones[k] = pcMesh->mBones[out++] = new aiBone();
+            pcOut->mName = pcOldBone->mName;
+            pcOut->mOffsetMatrix = pcOldBone->mOffsetMatrix;
+            pcOut->mWeights = new aiVertexWeight[counts[k]];
+        }
+    }
+
+    for (unsigned int i = 0; i < numVertices; ++i) {
+        for (const auto &weight : weights[vertices[i]]) {
+            aiBone *pcOut = bones[weight.first];
+            pcOut->mWeights[pcOut->mNumWeights++] = aiVertexWeight(i, weight.second);
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+// Build a submesh from a range of faces and the list of source vertices it references.
+// The index arrays of the source faces are taken over and rewritten in place. If no
+// remapped indices are given, the n-th index of the submesh refers to its n-th vertex.
+aiMesh *BuildSubMesh(aiMesh *pMesh, const unsigned int *faces, unsigned int numFaces,
+        const unsigned int *vertices, unsigned int numVertices,
+        const unsigned int *indices, const VertexWeightTable *weights) {
+    aiMesh *pcMesh = new aiMesh;
+    pcMesh->mMaterialIndex = pMesh->mMaterialIndex;
+
+    // the name carries the adjacency information between the meshes
+    pcMesh->mName = pMesh->mName;
+
+    pcMesh->mNumVertices = numVertices;
+    pcMesh->mVertices = GatherVertices(pMesh->mVertices, vertices, numVertices);
+    pcMesh->mNormals = GatherVertices(pMesh->mNormals, vertices, numVertices);
+    if (pMesh->HasTangentsAndBitangents()) {
+        pcMesh->mTangents = GatherVertices(pMesh->mTangents, vertices, numVertices);
+        pcMesh->mBitangents = GatherVertices(pMesh->mBitangents, vertices, numVertices);
+    }
+    for (unsigned int c = 0; c < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++c) {
+        pcMesh->mNumUVComponents[c] = pMesh->mNumUVComponents[c];
+        pcMesh->mTextureCoords[c] = GatherVertices(pMesh->mTextureCoords[c], vertices, numVertices);
+    }
+    for (unsigned int c = 0; c < AI_MAX_NUMBER_OF_COLOR_SETS; ++c) {
+        pcMesh->mColors[c] = GatherVertices(pMesh->mColors[c], vertices, numVertices);
+    }
+
+    pcMesh->mNumFaces = numFaces;
+    pcMesh->mFaces = new aiFace[numFaces];
+    unsigned int iCurrent = 0;
+    for (unsigned int p = 0; p < numFaces; ++p) {
+        aiFace &rSrc = pMesh->mFaces[faces[p]];
+        aiFace &rFace = pcMesh->mFaces[p];
+        rFace.mNumIndices = rSrc.mNumIndices;
+        rFace.mIndices = rSrc.mIndices;
+        rSrc.mNumIndices = 0;
+        rSrc.mIndices = nullptr;
+
+        // need to update the output primitive types
+        switch (rFace.mNumIndices) {
+        case 1:
+            pcMesh->mPrimitiveTypes |= aiPrimitiveType_POINT;
+            break;
+        case 2:
+            pcMesh->mPrimitiveTypes |= aiPrimitiveType_LINE;
+            break;
+        case 3:
+            pcMesh->mPrimitiveTypes |= aiPrimitiveType_TRIANGLE;
+            break;
+        default:
+            pcMesh->mPrimitiveTypes |= aiPrimitiveType_POLYGON;
+        }
+
+        for (unsigned int v = 0; v < rFace.mNumIndices; ++v, ++iCurrent) {
+            rFace.mIndices[v] = indices ? indices[iCurrent] : iCurrent;
+        }
+    }
+
+    if (weights) {
+        CopyBones(pMesh, pcMesh, weights, vertices, numVertices);
+    }
+    return pcMesh;
+}
+
+} // namespace
+
 // ------------------------------------------------------------------------------------------------
 SplitLargeMeshesProcess_Triangle::SplitLargeMeshesProcess_Triangle() {
     LIMIT = AI_SLM_DEFAULT_MAX_TRIANGLES;
+    SPATIAL = false;
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -101,6 +296,7 @@ void SplitLargeMeshesProcess_Triangle::Execute( aiScene* pScene) {
 void SplitLargeMeshesProcess_Triangle::SetupProperties( const Importer* pImp) {
     // get the current value of the split property
     this->LIMIT = pImp->GetPropertyInteger(AI_CONFIG_PP_SLM_TRIANGLE_LIMIT,AI_SLM_DEFAULT_MAX_TRIANGLES);
+    this->SPATIAL = pImp->GetPropertyBool(AI_CONFIG_PP_SLM_SPATIAL_SPLIT,false);
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -145,176 +341,53 @@ void SplitLargeMeshesProcess_Triangle::SplitMesh(
         // we need to split this mesh into sub meshes
         // determine the size of a submesh
         const unsigned int iSubMeshes = (pMesh->mNumFaces / LIMIT) + 1;
-
         const unsigned int iOutFaceNum = pMesh->mNumFaces / iSubMeshes;
-        const unsigned int iOutVertexNum = iOutFaceNum * 3;
-
-        // now generate all submeshes
-        for (unsigned int i = 0; i < iSubMeshes;++i) {
-            aiMesh* pcMesh          = new aiMesh;
-            pcMesh->mNumFaces       = iOutFaceNum;
-            pcMesh->mMaterialIndex  = pMesh->mMaterialIndex;
-
-            // the name carries the adjacency information between the meshes
-            pcMesh->mName = pMesh->mName;
-
-            if (i == iSubMeshes-1) {
-                pcMesh->mNumFaces = iOutFaceNum + (
-                    pMesh->mNumFaces - iOutFaceNum * iSubMeshes);
-            }
-            // copy the list of faces
-            pcMesh->mFaces = new aiFace[pcMesh->mNumFaces];
-
-            const unsigned int iBase = iOutFaceNum * i;
-
-            // get the total number of indices
-            unsigned int iCnt = 0;
-            for (unsigned int p = iBase; p < pcMesh->mNumFaces + iBase;++p) {
-                iCnt += pMesh->mFaces[p].mNumIndices;
-            }
-            pcMesh->mNumVertices = iCnt;
 
-            // allocate storage
-            if (pMesh->mVertices != nullptr) {
-                pcMesh->mVertices = new aiVector3D[iCnt];
-            }
-
-            if (pMesh->HasNormals()) {
-                pcMesh->mNormals = new aiVector3D[iCnt];
-            }
+        std::vector<unsigned int> order;
+        ComputeFaceOrder(pMesh, SPATIAL, order);
 
-            if (pMesh->HasTangentsAndBitangents()) {
-                pcMesh->mTangents = new aiVector3D[iCnt];
-                pcMesh->mBitangents = new aiVector3D[iCnt];
-            }
-
-            // texture coordinates
-            for (unsigned int c = 0;  c < AI_MAX_NUMBER_OF_TEXTURECOORDS;++c) {
-                pcMesh->mNumUVComponents[c] = pMesh->mNumUVComponents[c];
-                if (pMesh->HasTextureCoords( c)) {
-                    pcMesh->mTextureCoords[c] = new aiVector3D[iCnt];
-                }
-            }
-
-            // vertex colors
-            for (unsigned int c = 0;  c < AI_MAX_NUMBER_OF_COLOR_SETS;++c) {
-                if (pMesh->HasVertexColors( c)) {
-                    pcMesh->mColors[c] = new aiColor4D[iCnt];
-                }
-            }
+        // counting pass: every index of a face becomes a vertex of its own, so the
+        // size of each submesh follows from the faces it gets
+        std::vector<unsigned int> firstFace(iSubMeshes + 1), firstVertex(iSubMeshes + 1, 0);
+        for (unsigned int i = 0; i < iSubMeshes; ++i) {
+            firstFace[i] = iOutFaceNum * i;
+        }
+        firstFace[iSubMeshes] = pMesh->mNumFaces;
 
-            if (pMesh->HasBones()) {
-                // assume the number of bones won't change in most cases
-                pcMesh->mBones = new aiBone*[pMesh->mNumBones];
-
-                // iterate through all bones of the mesh and find those which
-                // need to be copied to the split mesh
-                std::vector<aiVertexWeight> avTempWeights;
-                for (unsigned int p = 0; p < pcMesh->mNumBones;++p) {
-                    aiBone* const bone = pcMesh->mBones[p];
-                    avTempWeights.clear();
-                    avTempWeights.reserve(bone->mNumWeights / iSubMeshes);
-
-                    for (unsigned int q = 0; q < bone->mNumWeights;++q) {
-                        aiVertexWeight& weight = bone->mWeights[q];
-                        if(weight.mVertexId >= iBase && weight.mVertexId < iBase + iOutVertexNum) {
-                            avTempWeights.push_back(weight);
-                            weight = avTempWeights.back();
-                            weight.mVertexId -= iBase;
-                        }
-                    }
-
-                    if (!avTempWeights.empty()) {
-                        // we'll need this bone. Copy it ...
-                        aiBone* pc = new aiBone();
-                        pcMesh->mBones[pcMesh->mNumBones++] = pc;
-                        pc->mName = aiString(bone->mName);
-                        pc->mNumWeights = (unsigned int)avTempWeights.size();
-                        pc->mOffsetMatrix = bone->mOffsetMatrix;
-
-                        // no need to reallocate the array for the last submesh.
-                        // Here we can reuse the (large) source array, although
-                        // we'll waste some memory
-                        if (iSubMeshes-1 == i) {
-                            pc->mWeights = bone->mWeights;
-                            bone->mWeights = nullptr;
-                        } else {
-                            pc->mWeights = new aiVertexWeight[pc->mNumWeights];
-                        }
-
-                        // copy the weights
-                        ::memcpy(pc->mWeights,&avTempWeights[0],sizeof(aiVertexWeight)*pc->mNumWeights);
-                    }
+        ParallelFor(iSubMeshes, 1, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                unsigned int iCnt = 0;
+                for (unsigned int p = firstFace[i]; p < firstFace[i + 1]; ++p) {
+                    iCnt += pMesh->mFaces[order[p]].mNumIndices;
                 }
+                firstVertex[i + 1] = iCnt;
             }
+        });
+        for (unsigned int i = 0; i < iSubMeshes; ++i) {
+            firstVertex[i + 1] += firstVertex[i];
+        }
 
-            // (we will also need to copy the array of indices)
-            unsigned int iCurrent = 0;
-            for (unsigned int p = 0; p < pcMesh->mNumFaces;++p) {
-                pcMesh->mFaces[p].mNumIndices = 3;
-                // allocate a new array
-                const unsigned int iTemp = p + iBase;
-                const unsigned int iNumIndices = pMesh->mFaces[iTemp].mNumIndices;
-
-                // setup face type and number of indices
-                pcMesh->mFaces[p].mNumIndices = iNumIndices;
-                unsigned int* pi = pMesh->mFaces[iTemp].mIndices;
-                unsigned int* piOut = pcMesh->mFaces[p].mIndices = new unsigned int[iNumIndices];
-
-                // need to update the output primitive types
-                switch (iNumIndices) {
-                case 1:
-                    pcMesh->mPrimitiveTypes |= aiPrimitiveType_POINT;
-                    break;
-                case 2:
-                    pcMesh->mPrimitiveTypes |= aiPrimitiveType_LINE;
-                    break;
-                case 3:
-                    pcMesh->mPrimitiveTypes |= aiPrimitiveType_TRIANGLE;
-                    break;
-                default:
-                    pcMesh->mPrimitiveTypes |= aiPrimitiveType_POLYGON;
-                }
-
-                // and copy the contents of the old array, offset by current base
-                for (unsigned int v = 0; v < iNumIndices;++v) {
-                    unsigned int iIndex = pi[v];
-                    unsigned int iIndexOut = iCurrent++;
-                    piOut[v] = iIndexOut;
-
-                    // copy positions
-                    if (pMesh->mVertices != nullptr) {
-                        pcMesh->mVertices[iIndexOut] = pMesh->mVertices[iIndex];
-                    }
-
-                    // copy normals
-                    if (pMesh->HasNormals()) {
-                        pcMesh->mNormals[iIndexOut] = pMesh->mNormals[iIndex];
-                    }
-
-                    // copy tangents/bitangents
-                    if (pMesh->HasTangentsAndBitangents()) {
-                        pcMesh->mTangents[iIndexOut] = pMesh->mTangents[iIndex];
-                        pcMesh->mBitangents[iIndexOut] = pMesh->mBitangents[iIndex];
-                    }
-
-                    // texture coordinates
-                    for (unsigned int c = 0;  c < AI_MAX_NUMBER_OF_TEXTURECOORDS;++c) {
-                        if (pMesh->HasTextureCoords( c ) ) {
-                            pcMesh->mTextureCoords[c][iIndexOut] = pMesh->mTextureCoords[c][iIndex];
-                        }
-                    }
-                    // vertex colors
-                    for (unsigned int c = 0;  c < AI_MAX_NUMBER_OF_COLOR_SETS;++c) {
-                        if (pMesh->HasVertexColors( c)) {
-                            pcMesh->mColors[c][iIndexOut] = pMesh->mColors[c][iIndex];
-                        }
-                    }
+        // fill pass: the submeshes are independent of each other
+        VertexWeightTable *avPerVertexWeights = ComputeVertexBoneWeightTable(pMesh);
+        std::vector<unsigned int> vertices(firstVertex[iSubMeshes]);
+        std::vector<aiMesh *> subMeshes(iSubMeshes);
+        ParallelFor(iSubMeshes, 1, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                unsigned int *pi = vertices.data() + firstVertex[i];
+                for (unsigned int p = firstFace[i]; p < firstFace[i + 1]; ++p) {
+                    const aiFace &face = pMesh->mFaces[order[p]];
+                    pi = std::copy(face.mIndices, face.mIndices + face.mNumIndices, pi);
                 }
+                subMeshes[i] = BuildSubMesh(pMesh, order.data() + firstFace[i], firstFace[i + 1] - firstFace[i],
+                        vertices.data() + firstVertex[i], firstVertex[i + 1] - firstVertex[i],
+                        nullptr, avPerVertexWeights);
             }
+        });
+        delete[] avPerVertexWeights;
 
-            // add the newly created mesh to the list
-            avList.emplace_back(pcMesh,a);
+        // add the newly created meshes to the list
+        for (aiMesh *pcMesh : subMeshes) {
+            avList.emplace_back(pcMesh, a);
         }
 
         // now delete the old mesh data
@@ -327,6 +400,7 @@ void SplitLargeMeshesProcess_Triangle::SplitMesh(
 // ------------------------------------------------------------------------------------------------
 SplitLargeMeshesProcess_Vertex::SplitLargeMeshesProcess_Vertex() {
     LIMIT = AI_SLM_DEFAULT_MAX_VERTICES;
+    SPATIAL = false;
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -383,6 +457,7 @@ void SplitLargeMeshesProcess_Vertex::Execute( aiScene* pScene) {
 // Setup properties
 void SplitLargeMeshesProcess_Vertex::SetupProperties( const Importer* pImp) {
     this->LIMIT = pImp->GetPropertyInteger(AI_CONFIG_PP_SLM_VERTEX_LIMIT,AI_SLM_DEFAULT_MAX_VERTICES);
+    this->SPATIAL = pImp->GetPropertyBool(AI_CONFIG_PP_SLM_SPATIAL_SPLIT,false);
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -392,226 +467,83 @@ void SplitLargeMeshesProcess_Vertex::SplitMesh(
         aiMesh* pMesh,
         std::vector<std::pair<aiMesh*, unsigned int> >& avList) {
     if (pMesh->mNumVertices > SplitLargeMeshesProcess_Vertex::LIMIT) {
-        typedef std::vector< std::pair<unsigned int,float> > VertexWeightTable;
-
-        // build a per-vertex weight list if necessary
-        VertexWeightTable* avPerVertexWeights = ComputeVertexBoneWeightTable(pMesh);
-
-        // we need to split this mesh into sub meshes
-        // determine the estimated size of a submesh
-        // (this could be too large. Max waste is a single digit percentage)
-        const unsigned int iSubMeshes = (pMesh->mNumVertices / SplitLargeMeshesProcess_Vertex::LIMIT) + 1;
-
-        // create a std::vector<unsigned int> to indicate which vertices
-        // have already been copied
-        std::vector<unsigned int> avWasCopied;
-        avWasCopied.resize(pMesh->mNumVertices,0xFFFFFFFF);
-
-        // try to find a good estimate for the number of output faces
-        // per mesh. Add 12.5% as buffer
-        unsigned int iEstimatedSize = pMesh->mNumFaces / iSubMeshes;
-        iEstimatedSize += iEstimatedSize >> 3;
-
-        // now generate all submeshes
-        unsigned int iBase( 0 );
-        while (true) {
-            const unsigned int iOutVertexNum = SplitLargeMeshesProcess_Vertex::LIMIT;
-            aiMesh* pcMesh          = new aiMesh;
-            pcMesh->mNumVertices    = 0;
-            pcMesh->mMaterialIndex  = pMesh->mMaterialIndex;
-
-            // the name carries the adjacency information between the meshes
-            pcMesh->mName = pMesh->mName;
-
-            typedef std::vector<aiVertexWeight> BoneWeightList;
-            if (pMesh->HasBones()) {
-                pcMesh->mBones = new aiBone*[pMesh->mNumBones];
-                ::memset(pcMesh->mBones,0,sizeof(void*)*pMesh->mNumBones);
-            }
-
-            // clear the temporary helper array
-            if (iBase) {
-                // we can't use memset here we unsigned int needn' be 32 bits
-                for (auto &elem : avWasCopied) {
-                    elem = 0xffffffff;
+        std::vector<unsigned int> order;
+        ComputeFaceOrder(pMesh, SPATIAL, order);
+
+        // counting pass: assign the faces to the submeshes and number the vertices of each
+        // submesh. Every vertex remembers the submesh it was last copied to, so the helper
+        // arrays never need to be reset.
+        std::vector<unsigned int> firstFace(1, 0), firstVertex(1, 0), firstIndex(1, 0);
+        std::vector<unsigned int> vertices, indices;
+        vertices.reserve(pMesh->mNumVertices + (pMesh->mNumVertices >> 3));
+        indices.reserve(static_cast<size_t>(pMesh->mNumFaces) * 3);
+
+        std::vector<unsigned int> avOwner(pMesh->mNumVertices, 0xFFFFFFFF);
+        std::vector<unsigned int> avNewIndex(pMesh->mNumVertices);
+        unsigned int iSubMesh = 0, iNumVertices = 0;
+        auto startSubMesh = [&](unsigned int iFace) {
+            firstFace.push_back(iFace);
+            firstVertex.push_back(static_cast<unsigned int>(vertices.size()));
+            firstIndex.push_back(static_cast<unsigned int>(indices.size()));
+            ++iSubMesh;
+            iNumVertices = 0;
+        };
+
+        for (unsigned int iBase = 0; iBase < pMesh->mNumFaces;) {
+            const aiFace &face = pMesh->mFaces[order[iBase]];
+
+            // doesn't catch degenerates but is quite fast
+            unsigned int iNeed = 0;
+            for (unsigned int v = 0; v < face.mNumIndices; ++v) {
+                if (avOwner[face.mIndices[v]] != iSubMesh) {
+                    iNeed++;
                 }
             }
-
-            // output vectors
-            std::vector<aiFace> vFaces;
-
-            // reserve enough storage for most cases
-            if (pMesh->HasPositions()) {
-                pcMesh->mVertices = new aiVector3D[iOutVertexNum];
-            }
-            if (pMesh->HasNormals()) {
-                pcMesh->mNormals = new aiVector3D[iOutVertexNum];
-            }
-            if (pMesh->HasTangentsAndBitangents()) {
-                pcMesh->mTangents = new aiVector3D[iOutVertexNum];
-                pcMesh->mBitangents = new aiVector3D[iOutVertexNum];
-            }
-            for (unsigned int c = 0; pMesh->HasVertexColors(c);++c) {
-                pcMesh->mColors[c] = new aiColor4D[iOutVertexNum];
-            }
-            for (unsigned int c = 0; pMesh->HasTextureCoords(c);++c) {
-                pcMesh->mNumUVComponents[c] = pMesh->mNumUVComponents[c];
-                pcMesh->mTextureCoords[c] = new aiVector3D[iOutVertexNum];
-            }
-            vFaces.reserve(iEstimatedSize);
-
-            // (we will also need to copy the array of indices)
-            while (iBase < pMesh->mNumFaces) {
-                // allocate a new array
-                const unsigned int iNumIndices = pMesh->mFaces[iBase].mNumIndices;
-
-                // doesn't catch degenerates but is quite fast
-                unsigned int iNeed = 0;
-                for (unsigned int v = 0; v < iNumIndices;++v) {
-                    unsigned int iIndex = pMesh->mFaces[iBase].mIndices[v];
-
-                    // check whether we do already have this vertex
-                    if (0xFFFFFFFF == avWasCopied[iIndex]) {
-                        iNeed++;
-                    }
-                }
-                if (pcMesh->mNumVertices + iNeed > iOutVertexNum) {
-                    // don't use this face
-                    break;
-                }
-
-                vFaces.emplace_back();
-                aiFace& rFace = vFaces.back();
-
-                // setup face type and number of indices
-                rFace.mNumIndices = iNumIndices;
-                rFace.mIndices = new unsigned int[iNumIndices];
-
-                // need to update the output primitive types
-                switch (rFace.mNumIndices) {
-                case 1:
-                    pcMesh->mPrimitiveTypes |= aiPrimitiveType_POINT;
-                    break;
-                case 2:
-                    pcMesh->mPrimitiveTypes |= aiPrimitiveType_LINE;
-                    break;
-                case 3:
-                    pcMesh->mPrimitiveTypes |= aiPrimitiveType_TRIANGLE;
-                    break;
-                default:
-                    pcMesh->mPrimitiveTypes |= aiPrimitiveType_POLYGON;
-                }
-
-                // and copy the contents of the old array, offset by current base
-                for (unsigned int v = 0; v < iNumIndices;++v) {
-                    unsigned int iIndex = pMesh->mFaces[iBase].mIndices[v];
-
-                    // check whether we do already have this vertex
-                    if (0xFFFFFFFF != avWasCopied[iIndex]) {
-                        rFace.mIndices[v] = avWasCopied[iIndex];
-                        continue;
-                    }
-
-                    // copy positions
-                    pcMesh->mVertices[pcMesh->mNumVertices] = (pMesh->mVertices[iIndex]);
-
-                    // copy normals
-                    if (pMesh->HasNormals()) {
-                        pcMesh->mNormals[pcMesh->mNumVertices] = (pMesh->mNormals[iIndex]);
-                    }
-
-                    // copy tangents/bitangents
-                    if (pMesh->HasTangentsAndBitangents()) {
-                        pcMesh->mTangents[pcMesh->mNumVertices] = (pMesh->mTangents[iIndex]);
-                        pcMesh->mBitangents[pcMesh->mNumVertices] = (pMesh->mBitangents[iIndex]);
-                    }
-
-                    // texture coordinates
-                    for (unsigned int c = 0;  c < AI_MAX_NUMBER_OF_TEXTURECOORDS;++c) {
-                        if (pMesh->HasTextureCoords( c)) {
-                            pcMesh->mTextureCoords[c][pcMesh->mNumVertices] = pMesh->mTextureCoords[c][iIndex];
-                        }
-                    }
-                    // vertex colors
-                    for (unsigned int c = 0;  c < AI_MAX_NUMBER_OF_COLOR_SETS;++c) {
-                        if (pMesh->HasVertexColors( c)) {
-                            pcMesh->mColors[c][pcMesh->mNumVertices] = pMesh->mColors[c][iIndex];
-                        }
-                    }
-                    // check whether we have bone weights assigned to this vertex
-                    rFace.mIndices[v] = pcMesh->mNumVertices;
-                    if (avPerVertexWeights) {
-                        VertexWeightTable& table = avPerVertexWeights[ pcMesh->mNumVertices ];
-                        if( !table.empty() ) {
-                            for (VertexWeightTable::const_iterator iter =  table.begin();
-                                    iter != table.end();++iter) {
-                                // allocate the bone weight array if necessary
-                                BoneWeightList* pcWeightList = (BoneWeightList*)pcMesh->mBones[(*iter).first];
-                                if (nullptr == pcWeightList) {
-                                    pcMesh->mBones[(*iter).first] = (aiBone*)(pcWeightList = new BoneWeightList());
-                                }
-                                pcWeightList->push_back(aiVertexWeight(pcMesh->mNumVertices,(*iter).second));
-                            }
-                        }
-                    }
-
-                    avWasCopied[iIndex] = pcMesh->mNumVertices;
-                    pcMesh->mNumVertices++;
-                }
-                ++iBase;
-                if(pcMesh->mNumVertices == iOutVertexNum) {
-                    // break here. The face is only added if it was complete
-                    break;
-                }
+            if (iNumVertices + iNeed > LIMIT && iBase > firstFace.back()) {
+                // don't use this face, it starts the next submesh
+                startSubMesh(iBase);
+                continue;
             }
 
-            // check which bones we'll need to create for this submesh
-            if (pMesh->HasBones()) {
-                aiBone** ppCurrent = pcMesh->mBones;
-                for (unsigned int k = 0; k < pMesh->mNumBones;++k) {
-                    // check whether the bone is existing
-                    BoneWeightList* pcWeightList;
-                    pcWeightList = (BoneWeightList *)pcMesh->mBones[k];
-                    if (nullptr != pcWeightList) {
-                        aiBone *pcOldBone = pMesh->mBones[k];
-                        aiBone* pcOut( nullptr );
-                        *ppCurrent++ = pcOut = new aiBone();
-                        pcOut->mName = aiString(pcOldBone->mName);
-                        pcOut->mOffsetMatrix = pcOldBone->mOffsetMatrix;
-                        pcOut->mNumWeights = (unsigned int)pcWeightList->size();
-                        pcOut->mWeights = new aiVertexWeight[pcOut->mNumWeights];
-
-                        // copy the vertex weights
-                        ::memcpy(pcOut->mWeights,&pcWeightList->operator[](0),
-                            pcOut->mNumWeights * sizeof(aiVertexWeight));
-
-                        // delete the temporary bone weight list
-                        delete pcWeightList;
-                        pcMesh->mNumBones++;
-                    }
+            for (unsigned int v = 0; v < face.mNumIndices; ++v) {
+                const unsigned int iIndex = face.mIndices[v];
+                if (avOwner[iIndex] != iSubMesh) {
+                    avOwner[iIndex] = iSubMesh;
+                    avNewIndex[iIndex] = iNumVertices++;
+                    vertices.push_back(iIndex);
                 }
+                indices.push_back(avNewIndex[iIndex]);
             }
-
-            // copy the face list to the mesh
-            pcMesh->mFaces = new aiFace[vFaces.size()];
-            pcMesh->mNumFaces = (unsigned int)vFaces.size();
-
-            for (unsigned int p = 0; p < pcMesh->mNumFaces;++p) {
-                pcMesh->mFaces[p] = vFaces[p];
-            }
-
-            // add the newly created mesh to the list
-            avList.emplace_back(pcMesh,a);
-
-            if (iBase == pMesh->mNumFaces) {
-                // have all faces ... finish the outer loop, too
-                break;
+            ++iBase;
+            if (iNumVertices >= LIMIT && iBase < pMesh->mNumFaces) {
+                // break here. The face is only added if it was complete
+                startSubMesh(iBase);
             }
         }
+        firstFace.push_back(pMesh->mNumFaces);
+        firstVertex.push_back(static_cast<unsigned int>(vertices.size()));
+        firstIndex.push_back(static_cast<unsigned int>(indices.size()));
+
+        // fill pass: the sizes of all submeshes are known, build them in parallel
+        const unsigned int iSubMeshes = iSubMesh + 1;
+        VertexWeightTable *avPerVertexWeights = ComputeVertexBoneWeightTable(pMesh);
+        std::vector<aiMesh *> subMeshes(iSubMeshes);
+        ParallelFor(iSubMeshes, 1, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                subMeshes[i] = BuildSubMesh(pMesh, order.data() + firstFace[i], firstFace[i + 1] - firstFace[i],
+                        vertices.data() + firstVertex[i], firstVertex[i + 1] - firstVertex[i],
+                        indices.data() + firstIndex[i], avPerVertexWeights);
+            }
+        });
 
         // delete the per-vertex weight list again
         delete[] avPerVertexWeights;
 
+        // add the newly created meshes to the list
+        for (aiMesh *pcMesh : subMeshes) {
+            avList.emplace_back(pcMesh, a);
+        }
+
         // now delete the old mesh data
         delete pMesh;
         return;
@@ -119,6 +119,10 @@ public:
     inline unsigned int GetLimit() const
         {return LIMIT;}
 
+    //! Enable the spatially coherent split mode
+    inline void SetSpatialSplit(bool s)
+        {SPATIAL = s;}
+
 public:
 
     // -------------------------------------------------------------------
@@ -142,6 +146,9 @@ public:
 public:
     //! Triangle limit
     unsigned int LIMIT;
+
+    //! Order the faces spatially before splitting
+    bool SPATIAL;
 };
 
 
@@ -183,6 +190,10 @@ public:
     inline unsigned int GetLimit() const
         {return LIMIT;}
 
+    //! Enable the spatially coherent split mode
+    inline void SetSpatialSplit(bool s)
+        {SPATIAL = s;}
+
 public:
 
     // -------------------------------------------------------------------
@@ -202,6 +213,9 @@ public:
 public:
     //! Triangle limit
     unsigned int LIMIT;
+
+    //! Order the faces spatially before splitting
+    bool SPATIAL;
 };
 
 } // end of namespace Assimp
@@ -274,6 +274,7 @@ void TextureTransformStep::Execute( aiScene* pScene)
                         for (unsigned int a3 = a2; a3 < mat->mNumProperties;++a3) {
                             mat->mProperties[a3] = mat->mProperties[a3+1];
                         }
+                        mat->InvalidatePropertyIndex();
 
                         delete prop2;
 
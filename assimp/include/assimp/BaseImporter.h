@@ -68,6 +68,10 @@ class BaseProcess;
 class SharedPostProcessInfo;
 class IOStream;
 
+namespace Profiling {
+class Profiler;
+}
+
 // utility to do char4 to uint32 in a portable manner
 #define AI_MAKE_MAGIC(string) ((uint32_t)((string[0] << 24) + \
                                           (string[1] << 16) + (string[2] << 8) + string[3]))
@@ -389,6 +393,8 @@ protected:
     std::exception_ptr m_Exception;
     /// Currently set progress handler.
     ProgressHandler *m_progress;
+    /// Profiler of the current import, nullptr unless time measurement is enabled.
+    Profiling::Profiler *m_profiler;
 };
 
 } // end of namespace Assimp
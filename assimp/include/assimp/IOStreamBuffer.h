@@ -51,6 +51,13 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/types.h>
 #include <assimp/IOStream.hpp>
 
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <thread>
 #include <vector>
 
 namespace Assimp {
@@ -58,12 +65,20 @@ namespace Assimp {
 // ---------------------------------------------------------------------------
 /**
  *  Implementation of a cached stream buffer.
+ *
+ *  The stream is read in blocks of cacheSize() elements. With a prefetch depth
+ *  greater than zero a background thread reads up to that many blocks ahead of
+ *  the parser, so readNextBlock() only has to swap in an already filled block.
+ *  The stream must not be accessed by anybody else while it is opened.
  */
 template <class T>
 class IOStreamBuffer {
 public:
     /// @brief  The class constructor.
-    IOStreamBuffer(size_t cache = 4096 * 4096);
+    /// @param  cache           The block size in elements.
+    /// @param  prefetchDepth   The number of blocks read ahead on a background thread,
+    ///                         0 reads all blocks synchronously.
+    IOStreamBuffer(size_t cache = 4096 * 4096, size_t prefetchDepth = 0);
 
     /// @brief  The class destructor.
     ~IOStreamBuffer();
@@ -85,6 +100,10 @@ public:
     /// @return The cache size.
     size_t cacheSize() const;
 
+    /// @brief  Returns the number of blocks which are read ahead.
+    /// @return The prefetch depth.
+    size_t prefetchDepth() const;
+
     /// @brief  Will read the next block.
     /// @return true if successful.
     bool readNextBlock();
@@ -101,11 +120,25 @@ public:
     /// @return The current file pos.
     size_t getFilePos() const;
 
+    /// @brief  Will read the next line, lines ending with the continuation token are joined.
+    /// @param  line        Receives the line without its line end. The view is valid
+    ///                     until the next call to any of the getNext functions, the
+    ///                     character following it is always a line end.
+    /// @return true if successful.
+    bool getNextDataLine(std::basic_string_view<T> &line, T continuationToken);
+
     /// @brief  Will read the next line.
     /// @param  buffer      The buffer for the next line.
     /// @return true if successful.
     bool getNextDataLine(std::vector<T> &buffer, T continuationToken);
 
+    /// @brief  Will read the next line ascii or binary end line char.
+    /// @param  line        Receives the line without its line end. The view is valid
+    ///                     until the next call to any of the getNext functions, the
+    ///                     character following it is always a line end.
+    /// @return true if successful.
+    bool getNextLine(std::basic_string_view<T> &line);
+
     /// @brief  Will read the next line ascii or binary end line char.
     /// @param  buffer      The buffer for the next line.
     /// @return true if successful.
@@ -117,6 +150,23 @@ public:
     bool getNextBlock(std::vector<T> &buffer);
 
 private:
+    /// Reads blocks on a background thread into a bounded queue.
+    struct Prefetcher {
+        std::thread worker;
+        std::mutex mutex;
+        std::condition_variable cond;
+        std::deque<std::vector<T>> filled;
+        std::deque<size_t> filledLength;
+        std::vector<std::vector<T>> spare;
+        bool done = false;
+        bool stop = false;
+    };
+
+    void startPrefetch();
+    void stopPrefetch();
+    bool skipLineEnd();
+    void copyLine(const std::basic_string_view<T> &line, std::vector<T> &buffer) const;
+
     IOStream *m_stream;
     size_t m_filesize;
     size_t m_cacheSize;
@@ -125,24 +175,28 @@ private:
     std::vector<T> m_cache;
     size_t m_cachePos;
     size_t m_filePos;
+    size_t m_prefetchDepth;
+    std::unique_ptr<Prefetcher> m_prefetcher;
+    std::vector<T> m_line;
 };
 
 template <class T>
-AI_FORCE_INLINE IOStreamBuffer<T>::IOStreamBuffer(size_t cache) :
+AI_FORCE_INLINE IOStreamBuffer<T>::IOStreamBuffer(size_t cache, size_t prefetchDepth) :
         m_stream(nullptr),
         m_filesize(0),
         m_cacheSize(cache),
         m_numBlocks(0),
         m_blockIdx(0),
         m_cachePos(0),
-        m_filePos(0) {
+        m_filePos(0),
+        m_prefetchDepth(prefetchDepth) {
     m_cache.resize(cache);
     std::fill(m_cache.begin(), m_cache.end(), '\n');
 }
 
 template <class T>
 AI_FORCE_INLINE IOStreamBuffer<T>::~IOStreamBuffer() {
-    // empty
+    stopPrefetch();
 }
 
 template <class T>
@@ -171,6 +225,11 @@ AI_FORCE_INLINE bool IOStreamBuffer<T>::open(IOStream *stream) {
         m_numBlocks++;
     }
 
+    // A single block can't be read ahead of anything
+    if (m_prefetchDepth > 0 && m_numBlocks > 1) {
+        startPrefetch();
+    }
+
     return true;
 }
 
@@ -180,6 +239,8 @@ AI_FORCE_INLINE bool IOStreamBuffer<T>::close() {
         return false;
     }
 
+    stopPrefetch();
+
     // init counters and state vars
     m_stream = nullptr;
     m_filesize = 0;
@@ -205,12 +266,93 @@ AI_FORCE_INLINE
     return m_cacheSize;
 }
 
+template <class T>
+AI_FORCE_INLINE
+        size_t
+        IOStreamBuffer<T>::prefetchDepth() const {
+    return m_prefetchDepth;
+}
+
+template <class T>
+inline void IOStreamBuffer<T>::startPrefetch() {
+    m_prefetcher.reset(new Prefetcher);
+    Prefetcher *prefetcher = m_prefetcher.get();
+    for (size_t i = 0; i < m_prefetchDepth; ++i) {
+        prefetcher->spare.emplace_back(m_cache.size(), T('\n'));
+    }
+
+    // The worker owns the stream until stopPrefetch() returns
+    IOStream *stream = m_stream;
+    const size_t blockSize = m_cacheSize;
+    prefetcher->worker = std::thread([prefetcher, stream, blockSize]() {
+        size_t filePos = 0;
+        for (;;) {
+            std::vector<T> block;
+            {
+                std::unique_lock<std::mutex> lock(prefetcher->mutex);
+                prefetcher->cond.wait(lock, [prefetcher]() { return prefetcher->stop || !prefetcher->spare.empty(); });
+                if (prefetcher->stop) {
+                    break;
+                }
+                block.swap(prefetcher->spare.back());
+                prefetcher->spare.pop_back();
+            }
+
+            stream->Seek(filePos, aiOrigin_SET);
+            const size_t readLen = stream->Read(&block[0], sizeof(T), blockSize);
+            filePos += readLen;
+
+            std::lock_guard<std::mutex> lock(prefetcher->mutex);
+            if (readLen == 0) {
+                prefetcher->done = true;
+                prefetcher->cond.notify_all();
+                break;
+            }
+            prefetcher->filled.push_back(std::move(block));
+            prefetcher->filledLength.push_back(readLen);
+            prefetcher->cond.notify_all();
+        }
+    });
+}
+
+template <class T>
+inline void IOStreamBuffer<T>::stopPrefetch() {
+    if (!m_prefetcher) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_prefetcher->mutex);
+        m_prefetcher->stop = true;
+    }
+    m_prefetcher->cond.notify_all();
+    m_prefetcher->worker.join();
+    m_prefetcher.reset();
+}
+
 template <class T>
 AI_FORCE_INLINE bool IOStreamBuffer<T>::readNextBlock() {
-    m_stream->Seek(m_filePos, aiOrigin_SET);
-    size_t readLen = m_stream->Read(&m_cache[0], sizeof(T), m_cacheSize);
-    if (readLen == 0) {
-        return false;
+    size_t readLen = 0;
+    if (m_prefetcher) {
+        Prefetcher &prefetcher = *m_prefetcher;
+        std::unique_lock<std::mutex> lock(prefetcher.mutex);
+        prefetcher.cond.wait(lock, [&prefetcher]() { return prefetcher.done || !prefetcher.filled.empty(); });
+        if (prefetcher.filled.empty()) {
+            return false;
+        }
+
+        // Hand the consumed block back to the worker
+        m_cache.swap(prefetcher.filled.front());
+        prefetcher.spare.push_back(std::move(prefetcher.filled.front()));
+        prefetcher.filled.pop_front();
+        readLen = prefetcher.filledLength.front();
+        prefetcher.filledLength.pop_front();
+        prefetcher.cond.notify_all();
+    } else {
+        m_stream->Seek(m_filePos, aiOrigin_SET);
+        readLen = m_stream->Read(&m_cache[0], sizeof(T), m_cacheSize);
+        if (readLen == 0) {
+            return false;
+        }
     }
     if (readLen < m_cacheSize) {
         m_cacheSize = readLen;
@@ -238,57 +380,109 @@ AI_FORCE_INLINE size_t IOStreamBuffer<T>::getFilePos() const {
 }
 
 template <class T>
-AI_FORCE_INLINE bool IOStreamBuffer<T>::getNextDataLine(std::vector<T> &buffer, T continuationToken) {
-    buffer.resize(m_cacheSize);
+AI_FORCE_INLINE void IOStreamBuffer<T>::copyLine(const std::basic_string_view<T> &line, std::vector<T> &buffer) const {
+    if (buffer.size() <= line.size()) {
+        buffer.resize(std::max(m_cacheSize, line.size() + 1));
+    }
+    std::copy(line.begin(), line.end(), buffer.begin());
+    buffer[line.size()] = '\n';
+}
+
+template <class T>
+AI_FORCE_INLINE bool IOStreamBuffer<T>::skipLineEnd() {
+    while (m_cache[m_cachePos] != '\n') {
+        ++m_cachePos;
+        if (m_cachePos >= m_cacheSize && !readNextBlock()) {
+            return false;
+        }
+    }
+    ++m_cachePos;
+
+    return true;
+}
+
+template <class T>
+AI_FORCE_INLINE bool IOStreamBuffer<T>::getNextDataLine(std::basic_string_view<T> &line, T continuationToken) {
     if (m_cachePos >= m_cacheSize || 0 == m_filePos) {
         if (!readNextBlock()) {
             return false;
         }
     }
 
-    size_t i = 0;
+    // The line is viewed in place unless it is split by a continuation or a block border
+    bool joined = false;
+    const size_t start = m_cachePos;
+    auto join = [this, &joined, start]() {
+        if (!joined) {
+            m_line.assign(m_cache.begin() + start, m_cache.begin() + m_cachePos);
+            joined = true;
+        }
+    };
     for (;;) {
-        if (continuationToken == m_cache[m_cachePos] && IsLineEnd(m_cache[m_cachePos + 1])) {
-            ++m_cachePos;
-            while (m_cache[m_cachePos] != '\n') {
-                ++m_cachePos;
+        if (m_cachePos >= m_cacheSize) {
+            join();
+            if (!readNextBlock()) {
+                break;
             }
-            ++m_cachePos;
-        } else if (IsLineEnd(m_cache[m_cachePos])) {
-            break;
-        }
-
-        buffer[i] = m_cache[m_cachePos];
-        ++m_cachePos;
-        ++i;
-
-        if(i == buffer.size()) {
-            buffer.resize(buffer.size() * 2);
         }
 
-        if (m_cachePos >= size()) {
+        const T c = m_cache[m_cachePos];
+        if (IsLineEnd(c)) {
             break;
         }
-        if (m_cachePos >= m_cacheSize) {
-            if (!readNextBlock()) {
-                return false;
+        if (continuationToken == c) {
+            join();
+            ++m_cachePos;
+            if (m_cachePos >= m_cacheSize && !readNextBlock()) {
+                m_line.push_back(c);
+                break;
             }
+            if (IsLineEnd(m_cache[m_cachePos])) {
+                // the line continues after the line end
+                if (!skipLineEnd()) {
+                    break;
+                }
+            } else {
+                m_line.push_back(c);
+            }
+            continue;
+        }
+
+        if (joined) {
+            m_line.push_back(c);
         }
+        ++m_cachePos;
     }
 
-    buffer[i] = '\n';
+    if (joined) {
+        // terminate the joined line like the in place ones
+        m_line.push_back('\n');
+        line = std::basic_string_view<T>(m_line.data(), m_line.size() - 1);
+    } else {
+        line = std::basic_string_view<T>(&m_cache[start], m_cachePos - start);
+    }
     ++m_cachePos;
 
     return true;
 }
 
+template <class T>
+AI_FORCE_INLINE bool IOStreamBuffer<T>::getNextDataLine(std::vector<T> &buffer, T continuationToken) {
+    std::basic_string_view<T> line;
+    if (!getNextDataLine(line, continuationToken)) {
+        return false;
+    }
+    copyLine(line, buffer);
+
+    return true;
+}
+
 static AI_FORCE_INLINE bool isEndOfCache(size_t pos, size_t cacheSize) {
-    return (pos == cacheSize);
+    return (pos >= cacheSize);
 }
 
 template <class T>
-AI_FORCE_INLINE bool IOStreamBuffer<T>::getNextLine(std::vector<T> &buffer) {
-    buffer.resize(m_cacheSize);
+AI_FORCE_INLINE bool IOStreamBuffer<T>::getNextLine(std::basic_string_view<T> &line) {
     if (isEndOfCache(m_cachePos, m_cacheSize) || 0 == m_filePos) {
         if (!readNextBlock()) {
             return false;
@@ -297,10 +491,9 @@ AI_FORCE_INLINE bool IOStreamBuffer<T>::getNextLine(std::vector<T> &buffer) {
 
     if (IsLineEnd(m_cache[m_cachePos])) {
         // skip line end
-        while (m_cache[m_cachePos] != '\n') {
-            ++m_cachePos;
+        if (!skipLineEnd()) {
+            return false;
         }
-        ++m_cachePos;
         if (isEndOfCache(m_cachePos, m_cacheSize)) {
             if (!readNextBlock()) {
                 return false;
@@ -308,28 +501,53 @@ AI_FORCE_INLINE bool IOStreamBuffer<T>::getNextLine(std::vector<T> &buffer) {
         }
     }
 
-    size_t i(0);
-    while (!IsLineEnd(m_cache[m_cachePos])) {
-        buffer[i] = m_cache[m_cachePos];
-        ++m_cachePos;
-        ++i;
-
-        if(i == buffer.size()) {
-            buffer.resize(buffer.size() * 2);
-        }
-
-        if (m_cachePos >= m_cacheSize) {
+    // The line is viewed in place unless it crosses a block border
+    bool joined = false;
+    const size_t start = m_cachePos;
+    for (;;) {
+        if (isEndOfCache(m_cachePos, m_cacheSize)) {
+            if (!joined) {
+                m_line.assign(m_cache.begin() + start, m_cache.begin() + m_cachePos);
+                joined = true;
+            }
             if (!readNextBlock()) {
-                return false;
+                break;
             }
         }
+
+        const T c = m_cache[m_cachePos];
+        if (IsLineEnd(c)) {
+            break;
+        }
+        if (joined) {
+            m_line.push_back(c);
+        }
+        ++m_cachePos;
+    }
+
+    if (joined) {
+        // terminate the joined line like the in place ones
+        m_line.push_back('\n');
+        line = std::basic_string_view<T>(m_line.data(), m_line.size() - 1);
+    } else {
+        line = std::basic_string_view<T>(&m_cache[start], m_cachePos - start);
     }
-    buffer[i] = '\n';
     ++m_cachePos;
 
     return true;
 }
 
+template <class T>
+AI_FORCE_INLINE bool IOStreamBuffer<T>::getNextLine(std::vector<T> &buffer) {
+    std::basic_string_view<T> line;
+    if (!getNextLine(line)) {
+        return false;
+    }
+    copyLine(line, buffer);
+
+    return true;
+}
+
 template <class T>
 AI_FORCE_INLINE bool IOStreamBuffer<T>::getNextBlock(std::vector<T> &buffer) {
     // Return the last block-value if getNextLine was used before
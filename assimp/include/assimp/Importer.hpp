@@ -83,6 +83,10 @@ class BatchLoader;
 // =======================================================================
 // Holy stuff, only for members of the high council of the Jedi.
 class ImporterPimpl;
+
+namespace Profiling {
+class Profiler;
+} // namespace Profiling
 } // namespace Assimp
 
 #define AI_PROPERTY_WAS_NOT_EXISTING 0xffffffff
@@ -461,6 +465,49 @@ public:
             unsigned int pFlags,
             const char *pHint = "");
 
+    // -------------------------------------------------------------------
+    /** Reads the given file with a known importer.
+     *
+     * Behaves like ReadFile(), but skips the format detection: neither the
+     * file extension nor the file signature are checked, the file is passed
+     * straight to the importer at the given index. Use this if the format
+     * of the file is already known.
+     * @param pFile Path and filename to the file to be imported.
+     * @param pFlags Optional post processing steps to be executed after
+     *   a successful import.
+     * @param pImporterIndex Index of the importer, see GetImporterIndex()
+     *   and GetImporterCount().
+     * @return A pointer to the imported data, nullptr if the import failed.
+     */
+    const aiScene *ReadFileWithImporter(
+            const char *pFile,
+            unsigned int pFlags,
+            size_t pImporterIndex);
+
+    // -------------------------------------------------------------------
+    /** Reads the given file from a memory buffer with a known importer.
+     *
+     * Behaves like ReadFileFromMemory(), but skips the format detection
+     * and passes the buffer straight to the importer at the given index.
+     * @param pBuffer Pointer to the file data
+     * @param pLength Length of pBuffer, in bytes
+     * @param pFlags Optional post processing steps to be executed after
+     *   a successful import.
+     * @param pImporterIndex Index of the importer, see GetImporterIndex()
+     *   and GetImporterCount().
+     * @param pHint File extension the importer sees for the buffer. Some
+     *   importers support several flavours of a format (e.g. gltf and glb)
+     *   and decide by the extension. If empty, the first extension of the
+     *   importer is used.
+     * @return A pointer to the imported data, nullptr if the import failed.
+     */
+    const aiScene *ReadFileFromMemoryWithImporter(
+            const void *pBuffer,
+            size_t pLength,
+            unsigned int pFlags,
+            size_t pImporterIndex,
+            const char *pHint = "");
+
     // -------------------------------------------------------------------
     /** Apply post-processing to an already-imported scene.
      *
@@ -501,6 +548,29 @@ public:
      *  destructor and ReadFile() itself.  */
     void FreeScene();
 
+    // -------------------------------------------------------------------
+    /** Returns the timings of the last import.
+     *
+     *  Only available if #AI_CONFIG_GLOB_MEASURE_TIME was set for ReadFile().
+     *  The profiler holds nested regions for the format detection, the
+     *  import phases of the loader and each post-processing step, see
+     *  Profiling::Profiler::ExportJSON() and ExportChromeTrace().
+     *  @return The profiler, nullptr if no timings were measured. It is
+     *    valid until the next call to ReadFile(), Reset() or the destruction
+     *    of the importer. */
+    Profiling::Profiler *GetProfiler() const;
+
+    // -------------------------------------------------------------------
+    /** Resets the importer to the state of a newly constructed one.
+     *
+     *  Frees the current scene, clears all configuration properties and
+     *  the error state and restores the default IO and progress handlers.
+     *  The importer and post-processing step instances, including custom
+     *  ones registered via RegisterLoader() or RegisterPPStep(), are
+     *  kept. This is much cheaper than constructing a new Importer, so
+     *  use it to recycle an instance for many unrelated imports.  */
+    void Reset();
+
     // -------------------------------------------------------------------
     /** Returns an error description of an error that occurred in ReadFile().
      *
@@ -654,6 +724,15 @@ public:
     ImporterPimpl *Pimpl() { return pimpl; }
     const ImporterPimpl *Pimpl() const { return pimpl; }
 
+private:
+    // Find the importer for a file by its extension, or by its signature
+    BaseImporter *FindImporter(const std::string &pFile);
+
+    // Read a file, the importer is looked up if the index is invalid
+    const aiScene *ReadFileInternal(const char *pFile, unsigned int pFlags, size_t pImporterIndex);
+    const aiScene *ReadFileFromMemoryInternal(const void *pBuffer, size_t pLength, unsigned int pFlags,
+            const char *pHint, size_t pImporterIndex);
+
 protected:
     // Just because we don't want you to know how we're hacking around.
     ImporterPimpl *pimpl;
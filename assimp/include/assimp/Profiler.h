@@ -51,11 +51,17 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #   pragma GCC system_header
 #endif
 
-#include <chrono>
 #include <assimp/DefaultLogger.hpp>
 #include <assimp/TinyFormatter.h>
+#include <assimp/scene.h>
 
-#include <map>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <vector>
 
 namespace Assimp {
 namespace Profiling {
@@ -63,41 +69,207 @@ namespace Profiling {
 using namespace Formatter;
 
 // ------------------------------------------------------------------------------------------------
-/** Simple wrapper around boost::timer to simplify reporting. Timings are automatically
- *  dumped to the log file.
+/** Allocation statistics maintained by the application, e.g. by a counting global
+ *  operator new. Pass a pointer via #AI_CONFIG_GLOB_MEASURE_ALLOCATIONS to have the
+ *  profiler report the allocations of each region.
+ */
+struct AllocationCounters {
+    std::atomic<uint64_t> count{ 0 };
+    std::atomic<uint64_t> bytes{ 0 };
+};
+
+// ------------------------------------------------------------------------------------------------
+/** Measures named, possibly nested regions. Timings are dumped to the log file and kept
+ *  for export as JSON or as a Chrome trace (chrome://tracing, Perfetto).
  */
 class Profiler {
 public:
-    Profiler() {
+    /** A measured region */
+    struct Region {
+        std::string name;
+        /** Nesting depth, 0 for top level regions */
+        unsigned int depth;
+        /** Start and duration in seconds, relative to the creation of the profiler */
+        double start;
+        double duration;
+        /** Allocations while the region was open, 0 without allocation counters */
+        uint64_t allocations;
+        uint64_t allocatedBytes;
+        /** Size of the scene at the begin and the end, 0 if no scene was given */
+        unsigned int verticesBefore;
+        unsigned int facesBefore;
+        unsigned int verticesAfter;
+        unsigned int facesAfter;
+    };
+
+    Profiler() :
+            mEpoch(Clock::now()),
+            mCounters(nullptr) {
         // empty
     }
 
+    /** Use allocation counters of the application, nullptr to disable allocation counts */
+    void SetAllocationCounters(const AllocationCounters *counters) {
+        mCounters = counters;
+    }
+
+    /** Start a named timer, regions opened before it and not yet ended become its parents */
+    void BeginRegion(const std::string& region, const aiScene *scene = nullptr) {
+        Region r;
+        r.name = region;
+        r.depth = static_cast<unsigned int>(mOpen.size());
+        r.start = Seconds(Clock::now());
+        r.duration = 0.0;
+        r.allocations = mCounters ? mCounters->count.load() : 0;
+        r.allocatedBytes = mCounters ? mCounters->bytes.load() : 0;
+        CountScene(scene, r.verticesBefore, r.facesBefore);
+        r.verticesAfter = r.facesAfter = 0;
 
-    /** Start a named timer */
-    void BeginRegion(const std::string& region) {
-        regions[region] = std::chrono::system_clock::now();
+        mOpen.push_back(mRegions.size());
+        mRegions.push_back(r);
         ASSIMP_LOG_DEBUG("START `",region,"`");
     }
 
+    /** End the innermost open region of that name and write its duration to the log */
+    void EndRegion(const std::string& region, const aiScene *scene = nullptr) {
+        std::vector<size_t>::iterator it = mOpen.end();
+        while (it != mOpen.begin() && mRegions[*(it - 1)].name != region) {
+            --it;
+        }
+        if (it == mOpen.begin()) {
+            return;
+        }
+
+        // regions opened inside and not ended end here as well
+        const double end = Seconds(Clock::now());
+        const double start = mRegions[*(it - 1)].start;
+        for (std::vector<size_t>::iterator open = it - 1; open != mOpen.end(); ++open) {
+            Region &r = mRegions[*open];
+            r.duration = end - r.start;
+            r.allocations = mCounters ? mCounters->count.load() - r.allocations : 0;
+            r.allocatedBytes = mCounters ? mCounters->bytes.load() - r.allocatedBytes : 0;
+            CountScene(scene, r.verticesAfter, r.facesAfter);
+        }
+        mOpen.erase(it - 1, mOpen.end());
+
+        ASSIMP_LOG_DEBUG("END   `",region,"`, dt= ", end - start," s");
+    }
+
+    /** All regions in the order they were started */
+    const std::vector<Region> &GetRegions() const {
+        return mRegions;
+    }
+
+    /** Write the regions as a JSON array of objects */
+    void ExportJSON(std::ostream &out) const {
+        std::ostringstream json;
+        json << "{\"regions\":[";
+        for (size_t i = 0; i < mRegions.size(); ++i) {
+            const Region &r = mRegions[i];
+            json << (i ? ",\n" : "\n") << "{\"name\":\"" << Escape(r.name) << "\",\"depth\":" << r.depth
+                 << ",\"start_us\":" << Micros(r.start) << ",\"duration_us\":" << Micros(r.duration);
+            WriteCounters(json, r);
+            json << "}";
+        }
+        json << "\n]}\n";
+        out << json.str();
+    }
+
+    /** Write the regions in the Chrome trace event format */
+    void ExportChromeTrace(std::ostream &out) const {
+        std::ostringstream json;
+        json << "{\"traceEvents\":[";
+        for (size_t i = 0; i < mRegions.size(); ++i) {
+            const Region &r = mRegions[i];
+            json << (i ? ",\n" : "\n") << "{\"name\":\"" << Escape(r.name) << "\",\"cat\":\"assimp\",\"ph\":\"X\",\"pid\":0,\"tid\":0"
+                 << ",\"ts\":" << Micros(r.start) << ",\"dur\":" << Micros(r.duration) << ",\"args\":{\"depth\":" << r.depth;
+            WriteCounters(json, r);
+            json << "}}";
+        }
+        json << "\n],\"displayTimeUnit\":\"ms\"}\n";
+        out << json.str();
+    }
+
+private:
+    typedef std::chrono::steady_clock Clock;
+
+    double Seconds(Clock::time_point t) const {
+        return std::chrono::duration<double>(t - mEpoch).count();
+    }
+
+    static uint64_t Micros(double seconds) {
+        return static_cast<uint64_t>(seconds * 1e6 + 0.5);
+    }
 
-    /** End a specific named timer and write its end time to the log */
-    void EndRegion(const std::string& region) {
-        RegionMap::const_iterator it = regions.find(region);
-        if (it == regions.end()) {
+    static void CountScene(const aiScene *scene, unsigned int &vertices, unsigned int &faces) {
+        vertices = faces = 0;
+        if (nullptr == scene || nullptr == scene->mMeshes) {
             return;
         }
+        for (unsigned int i = 0; i < scene->mNumMeshes; ++i) {
+            if (nullptr != scene->mMeshes[i]) {
+                vertices += scene->mMeshes[i]->mNumVertices;
+                faces += scene->mMeshes[i]->mNumFaces;
+            }
+        }
+    }
+
+    static std::string Escape(const std::string &in) {
+        std::string out;
+        for (char c : in) {
+            if (c == '"' || c == '\\') {
+                out += '\\';
+            } else if (static_cast<unsigned char>(c) < 0x20) {
+                c = ' ';
+            }
+            out += c;
+        }
+        return out;
+    }
+
+    void WriteCounters(std::ostream &json, const Region &r) const {
+        if (mCounters) {
+            json << ",\"allocations\":" << r.allocations << ",\"allocated_bytes\":" << r.allocatedBytes;
+        }
+        json << ",\"vertices_before\":" << r.verticesBefore << ",\"faces_before\":" << r.facesBefore
+             << ",\"vertices_after\":" << r.verticesAfter << ",\"faces_after\":" << r.facesAfter;
+    }
+
+    Clock::time_point mEpoch;
+    const AllocationCounters *mCounters;
+    std::vector<Region> mRegions;
+    std::vector<size_t> mOpen;
+};
+
+// ------------------------------------------------------------------------------------------------
+/** Measures a region for the lifetime of the object, does nothing without a profiler */
+class ProfileScope {
+public:
+    ProfileScope(Profiler *profiler, const char *region, const aiScene *scene = nullptr) :
+            mProfiler(profiler),
+            mRegion(region),
+            mScene(scene) {
+        if (mProfiler) {
+            mProfiler->BeginRegion(mRegion, mScene);
+        }
+    }
 
-        std::chrono::duration<double> elapsedSeconds = std::chrono::system_clock::now() - regions[region];
-        ASSIMP_LOG_DEBUG("END   `",region,"`, dt= ", elapsedSeconds.count()," s");
+    ~ProfileScope() {
+        if (mProfiler) {
+            mProfiler->EndRegion(mRegion, mScene);
+        }
     }
 
+    ProfileScope(const ProfileScope &) = delete;
+    ProfileScope &operator=(const ProfileScope &) = delete;
+
 private:
-    typedef std::map<std::string,std::chrono::time_point<std::chrono::system_clock>> RegionMap;
-    RegionMap regions;
+    Profiler *mProfiler;
+    const char *mRegion;
+    const aiScene *mScene;
 };
 
 }
 }
 
 #endif // AI_INCLUDED_PROFILER_H
-
@@ -121,6 +121,18 @@ public:
     void FindPositions(const aiVector3D &pPosition, ai_real pRadius,
             std::vector<unsigned int> &poResults) const;
 
+    // ------------------------------------------------------------------------------------
+    /** Finds the positions close to each of the stored positions at once. This is the
+     *  same as calling #FindPositions() for every position, but the queries share a
+     *  sliding window over the sorted positions and run in parallel for large sets.
+     * @param pRadius Maximal distance from a position a vertex may have to be counted in.
+     * @param poOffsets Receives one entry per position plus one. The neighbours of the
+     *   position with index i are poIndices[poOffsets[i]] ... poIndices[poOffsets[i+1]-1],
+     *   in the order #FindPositions() would return them.
+     * @param poIndices Receives the neighbour indices of all positions. */
+    void FindAllNeighbors(ai_real pRadius, std::vector<unsigned int> &poOffsets,
+            std::vector<unsigned int> &poIndices) const;
+
     // ------------------------------------------------------------------------------------
     /** Fills an array with indices of all positions identical to the given position. In
      *  opposite to FindPositions(), not an epsilon is used but a (very low) tolerance of
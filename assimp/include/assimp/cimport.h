@@ -238,6 +238,31 @@ ASSIMP_API const C_STRUCT aiScene *aiImportFileFromMemoryWithProperties(
         const char *pHint,
         const C_STRUCT aiPropertyStore *pProps);
 
+// --------------------------------------------------------------------------------
+/** Same as #aiImportFileFromMemoryWithProperties, but passes the buffer straight
+ * to a known importer instead of detecting the file format.
+ *
+ * @param pBuffer Pointer to the file data
+ * @param pLength Length of pBuffer, in bytes
+ * @param pFlags Optional post processing steps to be executed after
+ *   a successful import.
+ * @param pImporterIndex Index of the importer, see #aiGetImportFormatIndex()
+ *   and #aiGetImportFormatDescription().
+ * @param pHint File extension the importer sees for the buffer, e.g. "glb" or
+ *   "gltf" for the glTF importers. If empty, the first extension of the importer
+ *   is used.
+ * @param pProps #aiPropertyStore instance containing import settings, may be NULL.
+ * @return A pointer to the imported data, NULL if the import failed.
+ * @see aiImportFileFromMemoryWithProperties
+ */
+ASSIMP_API const C_STRUCT aiScene *aiImportFileFromMemoryWithImporter(
+        const char *pBuffer,
+        unsigned int pLength,
+        unsigned int pFlags,
+        size_t pImporterIndex,
+        const char *pHint,
+        const C_STRUCT aiPropertyStore *pProps);
+
 // --------------------------------------------------------------------------------
 /** Apply post-processing to an already-imported scene.
  *
@@ -334,6 +359,20 @@ ASSIMP_API void aiDetachAllLogStreams(void);
 ASSIMP_API void aiReleaseImport(
         const C_STRUCT aiScene *pScene);
 
+// --------------------------------------------------------------------------------
+/** Keeps importers alive for reuse instead of destroying them.
+ *
+ * Every import through the C-API needs an Assimp::Importer, and setting one up
+ * creates all importer and post-processing step instances. With a pool size
+ * greater than zero, #aiReleaseImport() resets the importer of the released
+ * scene and keeps it for the next import, so a high rate of small imports
+ * does not pay that cost every time.
+ * @param pSize Maximum number of idle importers to keep. 0 (the default)
+ *   destroys importers right away.
+ */
+ASSIMP_API void aiSetImporterPoolSize(
+        unsigned int pSize);
+
 // --------------------------------------------------------------------------------
 /** Returns the error text of the last failed import process.
  *
@@ -560,6 +599,14 @@ ASSIMP_API size_t aiGetImportFormatCount(void);
  */
 ASSIMP_API const C_STRUCT aiImporterDesc *aiGetImportFormatDescription(size_t pIndex);
 
+// --------------------------------------------------------------------------------
+/** Returns the index of the first import file format supporting a file extension.
+ * Look the index up once and pass it to #aiImportFileFromMemoryWithImporter().
+ * @param szExtension Extension to look for, e.g. "obj", "*.obj" or ".obj".
+ * @return Index of the import format, (size_t)-1 if the extension is not supported.
+ */
+ASSIMP_API size_t aiGetImportFormatIndex(const char *szExtension);
+
 // --------------------------------------------------------------------------------
 /** Check if 2D vectors are equal.
  *  @param a First vector to compare
@@ -923,6 +923,14 @@ public:
     static void CopyPropertyList(aiMaterial *pcDest,
             const aiMaterial *pcSrc);
 
+    // ------------------------------------------------------------------------------
+    /** @brief Drops the lookup index of the property list.
+     *
+     *  The index is rebuilt on the next lookup. The member functions do this on
+     *  their own, code which writes to #mProperties directly should call it
+     *  afterwards. */
+    void InvalidatePropertyIndex();
+
 #endif
 
     /** List of all material properties loaded. */
@@ -583,6 +583,70 @@ enum aiMorphingMethod {
 #endif
 }; //! enum aiMorphingMethod
 
+// ---------------------------------------------------------------------------
+/** @brief Fixed-width bone influences of all vertices of a mesh.
+ *
+ *  This is the form GPU skinning consumes: every vertex has the same number
+ *  of bone index / weight slots. It is built by the #aiProcess_LimitBoneWeights
+ *  step if #AI_CONFIG_PP_LBW_PACK_INFLUENCES is set and describes the same
+ *  weights as the bones of the mesh. Steps which rebuild the vertices of the
+ *  mesh afterwards (#aiProcess_JoinIdenticalVertices) gather it along, steps
+ *  which remove bones drop it and meshes created by splitting steps
+ *  (#aiProcess_SplitLargeMeshes, #aiProcess_Debone, ...) start without one.
+ *  In the default step order the influences are built after all of these.
+ */
+struct aiSkinInfluences {
+    /** Number of influence slots per vertex, 4 or 8. */
+    unsigned int mNumInfluences;
+
+    /** Size of a bone index in bytes. 1 if the mesh has at most 256 bones,
+     *  2 otherwise. */
+    unsigned int mIndexSize;
+
+    /** aiMesh::mNumVertices * mNumInfluences indices into aiMesh::mBones,
+     *  mIndexSize bytes each in native byte order. The influences of a vertex
+     *  are sorted by descending weight, unused slots have index and weight 0. */
+    unsigned char *mBoneIndices;
+
+    /** aiMesh::mNumVertices * mNumInfluences weights as unsigned normalized
+     *  16 bit values. The weights of a vertex with bones add up to 65535. */
+    unsigned short *mWeights;
+
+#ifdef __cplusplus
+
+    aiSkinInfluences() AI_NO_EXCEPT
+            : mNumInfluences(0),
+              mIndexSize(0),
+              mBoneIndices(nullptr),
+              mWeights(nullptr) {
+        // empty
+    }
+
+    ~aiSkinInfluences() {
+        delete[] mBoneIndices;
+        delete[] mWeights;
+    }
+
+    aiSkinInfluences(const aiSkinInfluences &) = delete;
+    aiSkinInfluences &operator=(const aiSkinInfluences &) = delete;
+
+    //! Returns the bone index of an influence slot of a vertex
+    unsigned int GetBoneIndex(unsigned int pVertex, unsigned int pSlot) const {
+        const unsigned int i = pVertex * mNumInfluences + pSlot;
+        if (mIndexSize == 1) {
+            return mBoneIndices[i];
+        }
+        return reinterpret_cast<const unsigned short *>(mBoneIndices)[i];
+    }
+
+    //! Returns the weight of an influence slot of a vertex in [0, 1]
+    float GetWeight(unsigned int pVertex, unsigned int pSlot) const {
+        return mWeights[pVertex * mNumInfluences + pSlot] / 65535.0f;
+    }
+
+#endif // __cplusplus
+};
+
 // ---------------------------------------------------------------------------
 /** @brief A mesh represents a geometry or model with a single material.
 *
@@ -758,6 +822,11 @@ struct aiMesh {
      */
     C_STRUCT aiString **mTextureCoordsNames;
 
+    /** Packed bone influences per vertex, nullptr unless requested from the
+     *  #aiProcess_LimitBoneWeights step.
+     *  @see aiSkinInfluences */
+    C_STRUCT aiSkinInfluences *mSkinInfluences;
+
 #ifdef __cplusplus
 
     //! Default constructor. Initializes all members to 0
@@ -780,7 +849,8 @@ struct aiMesh {
               mAnimMeshes(nullptr),
               mMethod(0),
               mAABB(),
-              mTextureCoordsNames(nullptr) {
+              mTextureCoordsNames(nullptr),
+              mSkinInfluences(nullptr) {
         for (unsigned int a = 0; a < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++a) {
             mNumUVComponents[a] = 0;
             mTextureCoords[a] = nullptr;
@@ -829,6 +899,8 @@ struct aiMesh {
             delete[] mAnimMeshes;
         }
 
+        delete mSkinInfluences;
+
         delete[] mFaces;
     }
 
@@ -39,8 +39,14 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 ---------------------------------------------------------------------------
 */
 #include "UnitTestPCH.h"
+#include "Common/ScenePrivate.h"
+#include <assimp/Importer.hpp>
 #include <assimp/importerdesc.h>
 
+#include <chrono>
+#include <cstring>
+#include <iostream>
+
 using namespace Assimp;
 
 class AssimpAPITest : public ::testing::Test {
@@ -60,3 +66,46 @@ TEST_F( AssimpAPITest, aiGetLastErrorTest ) {
     const char *error = aiGetErrorString();
     EXPECT_NE(nullptr, error);
 }
+
+static const char SmallObj[] = "v 0 0 0\nv 1 0 0\nv 0 1 0\nf 1 2 3\n";
+
+TEST_F( AssimpAPITest, aiSetImporterPoolSizeTest ) {
+    aiSetImporterPoolSize(1);
+
+    aiPropertyStore *props = aiCreatePropertyStore();
+    aiSetImportPropertyInteger(props, "quakquak", 1503);
+    const aiScene *scene = aiImportFileFromMemoryWithProperties(SmallObj, static_cast<unsigned int>(strlen(SmallObj)), 0, "obj", props);
+    aiReleasePropertyStore(props);
+    ASSERT_NE(nullptr, scene);
+    const Importer *first = ScenePriv(scene)->mOrigImporter;
+    EXPECT_EQ(1503, first->GetPropertyInteger("quakquak", 0));
+    aiReleaseImport(scene);
+
+    // the released importer is reused, without the properties of the previous import
+    scene = aiImportFileFromMemory(SmallObj, static_cast<unsigned int>(strlen(SmallObj)), 0, "obj");
+    ASSERT_NE(nullptr, scene);
+    EXPECT_EQ(first, ScenePriv(scene)->mOrigImporter);
+    EXPECT_EQ(0, ScenePriv(scene)->mOrigImporter->GetPropertyInteger("quakquak", 0));
+    EXPECT_EQ(1U, scene->mNumMeshes);
+    aiReleaseImport(scene);
+
+    aiSetImporterPoolSize(0);
+}
+
+// Measures many small imports with and without importer pooling, run with --gtest_also_run_disabled_tests
+TEST_F( AssimpAPITest, DISABLED_importerPoolBenchmark ) {
+    const unsigned int numImports = 10000;
+    for (unsigned int poolSize : { 0u, 1u }) {
+        aiSetImporterPoolSize(poolSize);
+
+        const auto begin = std::chrono::steady_clock::now();
+        for (unsigned int i = 0; i < numImports; ++i) {
+            const aiScene *scene = aiImportFileFromMemory(SmallObj, static_cast<unsigned int>(strlen(SmallObj)), 0, "obj");
+            ASSERT_NE(nullptr, scene);
+            aiReleaseImport(scene);
+        }
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - begin;
+        std::cout << numImports << " imports with pool size " << poolSize << ": " << elapsed.count() << " s" << std::endl;
+    }
+    aiSetImporterPoolSize(0);
+}
@@ -7,3 +7,10 @@
 #include <assimp/config.h>
 #include <assimp/cimport.h>
 #include <assimp/cexport.h>
+
+/* Size of aiMaterial as C code sees it, checked against C++ in utMaterialSystem.cpp */
+size_t CCompilerTestSizeofMaterial(void);
+
+size_t CCompilerTestSizeofMaterial(void) {
+    return sizeof(struct aiMaterial);
+}
@@ -40,6 +40,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 
 #include "UnitTestPCH.h"
+#include "Common/ScenePrivate.h"
 
 #include <assimp/scene.h>
 #include <assimp/SceneCombiner.h>
@@ -70,6 +71,27 @@ TEST_F(utScene, findNodeTest) {
 	EXPECT_EQ(child, found);
 }
 
+TEST_F(utScene, findNodeByNameTest) {
+	scene->mRootNode = new aiNode("root");
+	aiNode *children[4];
+	for (unsigned int i = 0; i < 4; ++i) {
+		children[i] = new aiNode(i == 3 ? "node1" : "node" + std::to_string(i));
+	}
+	scene->mRootNode->addChildren(4, children);
+
+	// same result as the recursive search, including the first of two equal names
+	EXPECT_EQ(scene->mRootNode, FindNodeByName(scene, "root"));
+	EXPECT_EQ(children[1], FindNodeByName(scene, "node1"));
+	EXPECT_EQ(scene->mRootNode->FindNode("node2"), FindNodeByName(scene, aiString("node2")));
+	EXPECT_EQ(nullptr, FindNodeByName(scene, "node4"));
+
+	// renamed nodes are found once the index is dropped
+	children[0]->mName.Set("node4");
+	InvalidateNodeIndex(scene);
+	EXPECT_EQ(children[0], FindNodeByName(scene, "node4"));
+	EXPECT_EQ(nullptr, FindNodeByName(scene, "node0"));
+}
+
 TEST_F(utScene, sceneHasContentTest) {
     EXPECT_FALSE(scene->HasAnimations());
 	EXPECT_FALSE(scene->HasMaterials());
@@ -0,0 +1,88 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2022, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+#include "UnitTestPCH.h"
+#include "Common/ParallelFor.h"
+
+#include <atomic>
+#include <stdexcept>
+
+using namespace Assimp;
+
+class utParallelFor : public ::testing::Test {
+    // empty
+};
+
+TEST_F(utParallelFor, visitsEveryIndexOnceTest) {
+    std::vector<int> visited(10000, 0);
+    ParallelFor(visited.size(), 16, [&visited](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            ++visited[i];
+        }
+    });
+    for (int v : visited) {
+        EXPECT_EQ(1, v);
+    }
+}
+
+TEST_F(utParallelFor, emptyRangeTest) {
+    bool called = false;
+    ParallelFor(0, 1, [&called](size_t, size_t) { called = true; });
+    EXPECT_FALSE(called);
+}
+
+TEST_F(utParallelFor, smallRangeRunsInlineTest) {
+    std::atomic<unsigned int> calls(0);
+    ParallelFor(10, 100, [&calls](size_t begin, size_t end) {
+        EXPECT_EQ(0u, begin);
+        EXPECT_EQ(10u, end);
+        ++calls;
+    });
+    EXPECT_EQ(1u, calls.load());
+}
+
+TEST_F(utParallelFor, rethrowsExceptionTest) {
+    EXPECT_THROW(ParallelFor(1000, 1, [](size_t begin, size_t end) {
+        if (begin <= 999 && 999 < end) {
+            throw std::runtime_error("failed");
+        }
+    }), std::runtime_error);
+}
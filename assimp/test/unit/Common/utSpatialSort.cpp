@@ -118,3 +118,60 @@ TEST_F(utSpatialSort, highlyDisplacedPositionsTest) {
     }
     delete[] positions;
 }
+
+TEST_F(utSpatialSort, findAllNeighborsTest) {
+    // A grid with duplicated vertices, large enough to be radix sorted and split over threads
+    constexpr unsigned int verticesPerAxis = 24;
+    constexpr unsigned int copies = 2;
+    constexpr unsigned int totalNumPositions = verticesPerAxis * verticesPerAxis * verticesPerAxis * copies;
+    std::vector<aiVector3D> positions;
+    positions.reserve(totalNumPositions);
+    for (unsigned int c = 0; c < copies; ++c) {
+        for (unsigned int x = 0; x < verticesPerAxis; ++x) {
+            for (unsigned int y = 0; y < verticesPerAxis; ++y) {
+                for (unsigned int z = 0; z < verticesPerAxis; ++z) {
+                    positions.emplace_back(x * 0.5f - 3.f, y * 0.5f, z * -0.5f);
+                }
+            }
+        }
+    }
+
+    SpatialSort sSort;
+    sSort.Fill(positions.data(), totalNumPositions, sizeof(aiVector3D));
+
+    std::vector<unsigned int> offsets, neighbors;
+    sSort.FindAllNeighbors(0.6f, offsets, neighbors);
+    ASSERT_EQ(totalNumPositions + 1, offsets.size());
+    ASSERT_EQ(offsets.back(), neighbors.size());
+
+    // The batch query must return exactly what the single queries return, in the same order
+    std::vector<unsigned int> indices;
+    for (unsigned int i = 0; i < totalNumPositions; ++i) {
+        sSort.FindPositions(positions[i], 0.6f, indices);
+        ASSERT_EQ(indices.size(), offsets[i + 1] - offsets[i]);
+        EXPECT_TRUE(std::equal(indices.begin(), indices.end(), neighbors.begin() + offsets[i]));
+    }
+
+    // an interior vertex finds itself, its 6 direct neighbours and all their copies
+    const unsigned int interior = (verticesPerAxis + 1) * verticesPerAxis + 1;
+    EXPECT_EQ(7u * copies, offsets[interior + 1] - offsets[interior]);
+}
+
+TEST_F(utSpatialSort, generateMappingTableTest) {
+    // Every position is stored twice, the copies must be mapped to the same id
+    std::vector<aiVector3D> positions(vecs, vecs + 100);
+    positions.insert(positions.end(), vecs, vecs + 100);
+    for (int i = 0; i < 400; ++i) {
+        positions.emplace_back(static_cast<float>(i) * 10.f, 0.f, 0.f);
+    }
+
+    SpatialSort sSort;
+    sSort.Fill(positions.data(), static_cast<unsigned int>(positions.size()), sizeof(aiVector3D));
+
+    std::vector<unsigned int> mapping;
+    sSort.GenerateMappingTable(mapping, 1e-5f);
+    ASSERT_EQ(positions.size(), mapping.size());
+    for (unsigned int i = 0; i < 100; ++i) {
+        EXPECT_EQ(mapping[i], mapping[i + 100]);
+    }
+}
@@ -39,11 +39,17 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 ---------------------------------------------------------------------------
 */
 #include "AbstractImportExportBase.h"
+#include "SceneDiffer.h"
 #include "UnitTestPCH.h"
+#include "AssetLib/Assbin/AssbinFileWriter.h"
+#include "Common/assbin_chunks.h"
+#include <assimp/DefaultIOSystem.h>
 #include <assimp/postprocess.h>
 #include <assimp/Exporter.hpp>
 #include <assimp/Importer.hpp>
 
+#include <memory>
+
 using namespace Assimp;
 
 #ifndef ASSIMP_BUILD_NO_EXPORT
@@ -66,4 +72,24 @@ TEST_F(utAssbinImportExport, import3ExportAssbinDFromFileTest) {
     EXPECT_TRUE(importerTest());
 }
 
+TEST_F(utAssbinImportExport, compressedBlocksRoundTrip) {
+    Importer importer;
+    const aiScene *scene = importer.ReadFile(ASSIMP_TEST_MODELS_DIR "/PLY/pond.0.ply", 0);
+    ASSERT_NE(nullptr, scene);
+
+    // the uncompressed body is larger than one block
+    DefaultIOSystem io;
+    DumpSceneToAssbin(ASSIMP_TEST_MODELS_DIR "/PLY/pond.0_out.assbin", "", &io, scene, false, true);
+    DumpSceneToAssbin(ASSIMP_TEST_MODELS_DIR "/PLY/pond.0_out_raw.assbin", "", &io, scene, false, false);
+    std::unique_ptr<IOStream> raw(io.Open(ASSIMP_TEST_MODELS_DIR "/PLY/pond.0_out_raw.assbin"));
+    ASSERT_NE(nullptr, raw);
+    EXPECT_GT(raw->FileSize(), size_t(ASSBIN_COMPRESSION_BLOCK_SIZE));
+
+    Importer reader;
+    const aiScene *newScene = reader.ReadFile(ASSIMP_TEST_MODELS_DIR "/PLY/pond.0_out.assbin", 0);
+    ASSERT_NE(nullptr, newScene);
+    SceneDiffer differ;
+    EXPECT_TRUE(differ.isEqual(scene, newScene));
+}
+
 #endif // #ifndef ASSIMP_BUILD_NO_EXPORT
@@ -430,3 +430,28 @@ TEST_F(utFBXImporterExporter, importSkeletonTest) {
     ASSERT_NE(nullptr, scene);
     ASSERT_TRUE(scene->mRootNode);
 }
+
+TEST_F(utFBXImporterExporter, importAnimationKeysTest) {
+    Assimp::Importer importer;
+    const aiScene *scene = importer.ReadFile(ASSIMP_TEST_MODELS_DIR "/FBX/huesitos.fbx", aiProcess_ValidateDataStructure);
+    ASSERT_NE(nullptr, scene);
+    ASSERT_EQ(1u, scene->mNumAnimations);
+
+    const aiAnimation *anim = scene->mAnimations[0];
+    ASSERT_LT(0u, anim->mNumChannels);
+    for (unsigned int c = 0; c < anim->mNumChannels; ++c) {
+        // the merged key times are shared by all three tracks of a simple channel
+        const aiNodeAnim *channel = anim->mChannels[c];
+        ASSERT_LT(0u, channel->mNumPositionKeys);
+        EXPECT_EQ(channel->mNumPositionKeys, channel->mNumRotationKeys);
+        EXPECT_EQ(channel->mNumPositionKeys, channel->mNumScalingKeys);
+        for (unsigned int k = 0; k < channel->mNumPositionKeys; ++k) {
+            EXPECT_EQ(channel->mPositionKeys[k].mTime, channel->mRotationKeys[k].mTime);
+            EXPECT_EQ(channel->mPositionKeys[k].mTime, channel->mScalingKeys[k].mTime);
+            EXPECT_LE(channel->mPositionKeys[k].mTime, anim->mDuration);
+            if (k > 0) {
+                EXPECT_LT(channel->mPositionKeys[k - 1].mTime, channel->mPositionKeys[k].mTime);
+            }
+        }
+    }
+}
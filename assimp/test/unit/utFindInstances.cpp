@@ -0,0 +1,94 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2022, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+#include "UnitTestPCH.h"
+
+#include "PostProcessing/FindInstancesProcess.h"
+#include <assimp/scene.h>
+
+using namespace Assimp;
+
+class utFindInstancesProcess : public ::testing::Test {
+protected:
+    static aiMesh *createTriangle(float offset, unsigned int materialIndex) {
+        aiMesh *mesh = new aiMesh();
+        mesh->mPrimitiveTypes = aiPrimitiveType_TRIANGLE;
+        mesh->mMaterialIndex = materialIndex;
+        mesh->mNumVertices = 3;
+        mesh->mVertices = new aiVector3D[3];
+        mesh->mVertices[0] = aiVector3D(offset, 0.f, 0.f);
+        mesh->mVertices[1] = aiVector3D(offset + 1.f, 0.f, 0.f);
+        mesh->mVertices[2] = aiVector3D(offset, 1.f, 0.f);
+        mesh->mNumFaces = 1;
+        mesh->mFaces = new aiFace[1];
+        mesh->mFaces[0].mNumIndices = 3;
+        mesh->mFaces[0].mIndices = new unsigned int[3]{ 0, 1, 2 };
+        return mesh;
+    }
+};
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(utFindInstancesProcess, findInstancesTest) {
+    aiScene scene;
+    scene.mNumMeshes = 6;
+    scene.mMeshes = new aiMesh *[6];
+    scene.mMeshes[0] = createTriangle(0.f, 0);
+    scene.mMeshes[1] = createTriangle(5.f, 0); // same hash as 0, different shape
+    scene.mMeshes[2] = createTriangle(0.f, 0); // instance of 0
+    scene.mMeshes[3] = createTriangle(5.f, 0); // instance of 1
+    scene.mMeshes[4] = createTriangle(0.f, 1); // other material
+    scene.mMeshes[5] = createTriangle(0.f, 1); // instance of 4
+
+    scene.mRootNode = new aiNode();
+    scene.mRootNode->mNumMeshes = 6;
+    scene.mRootNode->mMeshes = new unsigned int[6]{ 0, 1, 2, 3, 4, 5 };
+
+    FindInstancesProcess process;
+    process.Execute(&scene);
+
+    EXPECT_EQ(3u, scene.mNumMeshes);
+    EXPECT_EQ(5.f, scene.mMeshes[1]->mVertices[0].x);
+    EXPECT_EQ(1u, scene.mMeshes[2]->mMaterialIndex);
+
+    const unsigned int expected[6] = { 0, 1, 0, 1, 2, 2 };
+    for (unsigned int i = 0; i < 6; ++i) {
+        EXPECT_EQ(expected[i], scene.mRootNode->mMeshes[i]);
+    }
+}
@@ -84,3 +84,72 @@ TEST_F(GenNormalsTest, testSimpleTriangle) {
     piProcess->GenMeshVertexNormals(pcMesh, 0);
     EXPECT_TRUE(pcMesh->mNormals != NULL);
 }
+
+// ------------------------------------------------------------------------------------------------
+// A verbose roof made of two planes meeting at a right angle, large enough to be split over threads
+static aiMesh *createRoofMesh(unsigned int size) {
+    aiMesh *mesh = new aiMesh();
+    mesh->mPrimitiveTypes = aiPrimitiveType_TRIANGLE;
+    mesh->mNumFaces = size * size * 2;
+    mesh->mFaces = new aiFace[mesh->mNumFaces];
+    mesh->mNumVertices = mesh->mNumFaces * 3;
+    mesh->mVertices = new aiVector3D[mesh->mNumVertices];
+
+    const float half = size * 0.5f;
+    auto corner = [half](unsigned int x, unsigned int y) {
+        return aiVector3D((float)x, (float)y, half - std::fabs(x - half));
+    };
+    unsigned int v = 0, f = 0;
+    for (unsigned int y = 0; y < size; ++y) {
+        for (unsigned int x = 0; x < size; ++x) {
+            const aiVector3D quad[6] = { corner(x, y), corner(x + 1, y), corner(x + 1, y + 1),
+                corner(x, y), corner(x + 1, y + 1), corner(x, y + 1) };
+            for (unsigned int t = 0; t < 2; ++t, ++f) {
+                aiFace &face = mesh->mFaces[f];
+                face.mIndices = new unsigned int[face.mNumIndices = 3];
+                for (unsigned int i = 0; i < 3; ++i, ++v) {
+                    face.mIndices[i] = v;
+                    mesh->mVertices[v] = quad[t * 3 + i];
+                }
+            }
+        }
+    }
+    return mesh;
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(GenNormalsTest, testSmoothLargeMesh) {
+    const unsigned int size = 64;
+    const aiVector3D left = aiVector3D(-1.f, 0.f, 1.f).Normalize(), right = aiVector3D(1.f, 0.f, 1.f).Normalize();
+
+    // without an angle limit all vertices at the same position share their normal
+    std::unique_ptr<aiMesh> mesh(createRoofMesh(size));
+    piProcess->GenMeshVertexNormals(mesh.get(), 0);
+    ASSERT_NE(nullptr, mesh->mNormals);
+    for (unsigned int i = 0; i < mesh->mNumVertices; ++i) {
+        const aiVector3D &pos = mesh->mVertices[i], &normal = mesh->mNormals[i];
+        EXPECT_NEAR(1.f, normal.Length(), 1e-4f);
+        EXPECT_NEAR(0.f, normal.y, 1e-4f);
+        if (pos.x < size * 0.5f - 0.5f) {
+            EXPECT_NEAR(left.x, normal.x, 1e-4f);
+        } else if (pos.x > size * 0.5f + 0.5f) {
+            EXPECT_NEAR(right.x, normal.x, 1e-4f);
+        } else if (pos.x == size * 0.5f) {
+            // the ridge is smoothed over both planes
+            EXPECT_GT(normal.z, left.z);
+        }
+    }
+
+    // with a small angle limit the two planes stay apart
+    mesh.reset(createRoofMesh(size));
+    piProcess->SetMaxSmoothAngle(AI_DEG_TO_RAD(10.f));
+    piProcess->GenMeshVertexNormals(mesh.get(), 0);
+    for (unsigned int f = 0; f < mesh->mNumFaces; ++f) {
+        const unsigned int *idx = mesh->mFaces[f].mIndices;
+        const aiVector3D &a = mesh->mVertices[idx[0]], &b = mesh->mVertices[idx[1]], &c = mesh->mVertices[idx[2]];
+        const aiVector3D faceNormal = ((b - a) ^ (c - a)).Normalize();
+        for (unsigned int i = 0; i < 3; ++i) {
+            EXPECT_NEAR(1.f, mesh->mNormals[idx[i]] * faceNormal, 1e-4f);
+        }
+    }
+}
@@ -144,3 +144,47 @@ TEST_F( IOStreamBufferTest, accessBlockIndexTest ) {
 
 }
 
+
+static const char lineData[]{"v 1 2 3\nv 4 5 6\r\nf 1 2 \\\n3\n\nvn 0 0 1\nf 3 2 1"};
+
+static std::vector<std::string> readDataLines(const char *fname, size_t cacheSize, size_t prefetchDepth) {
+    std::vector<std::string> lines;
+    auto *fs = std::fopen(fname, "rb");
+    if (nullptr == fs) {
+        return lines;
+    }
+
+    TestDefaultIOStream myStream(fs, fname);
+    IOStreamBuffer<char> myBuffer(cacheSize, prefetchDepth);
+    if (!myBuffer.open(&myStream)) {
+        return lines;
+    }
+    std::string_view line;
+    while (myBuffer.getNextDataLine(line, '\\')) {
+        // parsers rely on the line end behind the view
+        const char end = line.data()[line.size()];
+        EXPECT_TRUE(end == '\n' || end == '\r');
+        lines.emplace_back(line);
+    }
+    myBuffer.close();
+
+    return lines;
+}
+
+TEST_F( IOStreamBufferTest, readDataLineViewTest ) {
+    char fname[]={ "readdatalinetest.XXXXXX" };
+    auto* fs = MakeTmpFile(fname);
+    ASSERT_NE(nullptr, fs);
+    const auto written = std::fwrite( lineData, sizeof(*lineData), sizeof(lineData) - 1, fs );
+    EXPECT_EQ( sizeof(lineData) - 1, written );
+    std::fclose(fs);
+
+    const std::vector<std::string> expected{ "v 1 2 3", "v 4 5 6", "", "f 1 2 3", "", "vn 0 0 1", "f 3 2 1" };
+
+    // small caches force lines across block borders, the prefetcher must not change the result
+    for (size_t cacheSize : { 3u, 7u, 16u, 4096u }) {
+        EXPECT_EQ( expected, readDataLines( fname, cacheSize, 0 ) );
+        EXPECT_EQ( expected, readDataLines( fname, cacheSize, 2 ) );
+    }
+    remove(fname);
+}
@@ -181,6 +181,49 @@ TEST_F(ImporterTest, testMemoryRead) {
     EXPECT_EQ(12U, sc->mMeshes[0]->mNumFaces);
 }
 
+// ------------------------------------------------------------------------------------------------
+TEST_F(ImporterTest, testMemoryReadWithImporter) {
+    const size_t index = pImp->GetImporterIndex("3ds");
+    ASSERT_NE(static_cast<size_t>(-1), index);
+
+    const aiScene *sc = pImp->ReadFileFromMemoryWithImporter(InputData_abRawBlock, InputData_BLOCK_SIZE,
+            aiProcessPreset_TargetRealtime_Quality, index);
+    ASSERT_TRUE(sc != NULL);
+    EXPECT_EQ(index, static_cast<size_t>(pImp->GetPropertyInteger("importerIndex", -1)));
+    EXPECT_EQ(1U, sc->mNumMeshes);
+    EXPECT_EQ(24U, sc->mMeshes[0]->mNumVertices);
+
+    EXPECT_EQ(nullptr, pImp->ReadFileFromMemoryWithImporter(InputData_abRawBlock, InputData_BLOCK_SIZE,
+            0, pImp->GetImporterCount()));
+    EXPECT_STRNE("", pImp->GetErrorString());
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(ImporterTest, testReadFileWithImporter) {
+    const size_t index = pImp->GetImporterIndex(".X");
+    ASSERT_NE(static_cast<size_t>(-1), index);
+    EXPECT_TRUE(pImp->ReadFileWithImporter(ASSIMP_TEST_MODELS_DIR "/X/test.x", aiProcess_ValidateDataStructure, index));
+    EXPECT_EQ(nullptr, pImp->ReadFileWithImporter(ASSIMP_TEST_MODELS_DIR "/X/test.x", 0, static_cast<size_t>(-1)));
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(ImporterTest, testReset) {
+    pImp->SetPropertyInteger("quakquak", 1503);
+    pImp->SetIOHandler(new TestIOSystem);
+    ASSERT_TRUE(pImp->ReadFileFromMemory(InputData_abRawBlock, InputData_BLOCK_SIZE, 0, "3ds"));
+    const size_t importerCount = pImp->GetImporterCount();
+
+    pImp->Reset();
+    EXPECT_EQ(nullptr, pImp->GetScene());
+    EXPECT_EQ(314159, pImp->GetPropertyInteger("quakquak", 314159));
+    EXPECT_TRUE(pImp->IsDefaultIOHandler());
+    EXPECT_EQ(importerCount, pImp->GetImporterCount());
+
+    // a reset importer must import as well as a new one
+    ASSERT_TRUE(pImp->ReadFileFromMemory(InputData_abRawBlock, InputData_BLOCK_SIZE, 0, "3ds"));
+    EXPECT_EQ(1U, pImp->GetScene()->mNumMeshes);
+}
+
 // ------------------------------------------------------------------------------------------------
 TEST_F(ImporterTest, testIntProperty) {
     bool b = pImp->SetPropertyInteger("quakquak", 1503);
@@ -230,6 +273,7 @@ TEST_F(ImporterTest, testPluginInterface) {
         // unregister the plugin and delete it
         pImp->UnregisterLoader(p);
         delete p;
+        EXPECT_FALSE(pImp->IsExtensionSupported(".apple"));
 
         return;
     }
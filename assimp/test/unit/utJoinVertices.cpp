@@ -44,6 +44,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "PostProcessing/JoinVerticesProcess.h"
 
+#include <type_traits>
+
 using namespace std;
 using namespace Assimp;
 
@@ -140,3 +142,27 @@ TEST_F(utJoinVertices, testProcess) {
     }
     EXPECT_EQ(150.f * 299.f * 3.f, fSum); // gaussian sum equation
 }
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(utJoinVertices, testSkinInfluencesFollowVertices) {
+    static_assert(!std::is_copy_constructible<aiSkinInfluences>::value, "aiSkinInfluences owns its arrays");
+
+    // one slot per vertex, the bone index is the position of the vertex
+    aiSkinInfluences *influences = pcMesh->mSkinInfluences = new aiSkinInfluences();
+    influences->mNumInfluences = 1;
+    influences->mIndexSize = 2;
+    influences->mBoneIndices = new unsigned char[900 * 2];
+    influences->mWeights = new unsigned short[900];
+    for (unsigned int i = 0; i < 900; ++i) {
+        reinterpret_cast<unsigned short *>(influences->mBoneIndices)[i] = static_cast<unsigned short>(i % 300);
+        influences->mWeights[i] = 65535;
+    }
+
+    piProcess->ProcessMesh(pcMesh, 0);
+    ASSERT_EQ(300U, pcMesh->mNumVertices);
+    ASSERT_NE(nullptr, pcMesh->mSkinInfluences);
+    for (unsigned int i = 0; i < 300; ++i) {
+        EXPECT_EQ(static_cast<unsigned int>(pcMesh->mVertices[i].x), pcMesh->mSkinInfluences->GetBoneIndex(i, 0));
+        EXPECT_EQ(1.0f, pcMesh->mSkinInfluences->GetWeight(i, 0));
+    }
+}
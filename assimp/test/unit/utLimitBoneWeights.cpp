@@ -134,3 +134,44 @@ TEST_F(LimitBoneWeightsTest, testProcess) {
 
     // everything seems to be OK
 }
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(LimitBoneWeightsTest, testPackInfluences) {
+    // give every vertex distinct weights, so the heaviest ones are well defined
+    for (unsigned int i = 0; i < mMesh->mNumBones; ++i) {
+        aiBone *bone = mMesh->mBones[i];
+        for (unsigned int q = 0; q < bone->mNumWeights; ++q) {
+            bone->mWeights[q].mWeight = (float)(i + 1);
+        }
+    }
+    mProcess->mMaxWeights = 8;
+    mProcess->mPackInfluences = 4;
+    mProcess->ProcessMesh(mMesh);
+
+    const aiSkinInfluences *influences = mMesh->mSkinInfluences;
+    ASSERT_NE(nullptr, influences);
+    EXPECT_EQ(4u, influences->mNumInfluences);
+    EXPECT_EQ(1u, influences->mIndexSize);
+
+    for (unsigned int v = 0; v < mMesh->mNumVertices; ++v) {
+        unsigned int sum = 0;
+        for (unsigned int s = 0; s < 4; ++s) {
+            sum += influences->mWeights[v * 4 + s];
+            if (s > 0) {
+                EXPECT_LE(influences->GetWeight(v, s), influences->GetWeight(v, s - 1));
+            }
+
+            // the slot refers to a bone which still has the weight for this vertex
+            const aiBone *bone = mMesh->mBones[influences->GetBoneIndex(v, s)];
+            bool found = false;
+            for (unsigned int q = 0; q < bone->mNumWeights; ++q) {
+                if (bone->mWeights[q].mVertexId == v) {
+                    EXPECT_NEAR(bone->mWeights[q].mWeight, influences->GetWeight(v, s), 1e-4f);
+                    found = true;
+                }
+            }
+            EXPECT_TRUE(found);
+        }
+        EXPECT_EQ(65535u, sum);
+    }
+}
@@ -41,8 +41,16 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "UnitTestPCH.h"
 
 #include "Material/MaterialSystem.h"
+#include <assimp/Importer.hpp>
+#include <assimp/postprocess.h>
 #include <assimp/scene.h>
 
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
 using namespace ::std;
 using namespace ::Assimp;
 
@@ -217,6 +225,113 @@ TEST_F(MaterialSystemTest, testCastSmallFloatProperty) {
     EXPECT_EQ(false, valBool);
 }
 
+// ------------------------------------------------------------------------------------------------
+TEST_F(MaterialSystemTest, testIndexedPropertyLookup) {
+    // enough properties to have the lookups go through the hashed index
+    for (int i = 0; i < 64; ++i) {
+        EXPECT_EQ(AI_SUCCESS, pcMat->AddProperty(&i, 1, "$tex.uvwsrc", i % 8, i / 8));
+    }
+    const aiString name("name");
+    EXPECT_EQ(AI_SUCCESS, pcMat->AddProperty(&name, AI_MATKEY_NAME));
+
+    int value = -1;
+    for (int i = 0; i < 64; ++i) {
+        EXPECT_EQ(AI_SUCCESS, pcMat->Get("$tex.uvwsrc", i % 8, i / 8, value));
+        EXPECT_EQ(i, value);
+    }
+    EXPECT_EQ(AI_FAILURE, pcMat->Get("$tex.uvwsrc", 8, 0, value));
+    EXPECT_EQ(AI_FAILURE, pcMat->Get("$tex.file", 0, 0, value));
+
+    // the wild-cards still return the first match
+    const aiMaterialProperty *prop = nullptr;
+    EXPECT_EQ(AI_SUCCESS, aiGetMaterialProperty(pcMat, "$tex.uvwsrc", UINT_MAX, 3, &prop));
+    EXPECT_EQ(0u, prop->mSemantic);
+    EXPECT_EQ(3u, prop->mIndex);
+    EXPECT_EQ(AI_SUCCESS, aiGetMaterialProperty(pcMat, "$tex.uvwsrc", 5, UINT_MAX, &prop));
+    EXPECT_EQ(5u, prop->mSemantic);
+    EXPECT_EQ(0u, prop->mIndex);
+
+    // modifications are picked up
+    value = 100;
+    EXPECT_EQ(AI_SUCCESS, pcMat->AddProperty(&value, 1, "$tex.uvwsrc", 2, 2));
+    EXPECT_EQ(AI_SUCCESS, pcMat->Get("$tex.uvwsrc", 2, 2, value));
+    EXPECT_EQ(100, value);
+    EXPECT_EQ(AI_SUCCESS, pcMat->RemoveProperty("$tex.uvwsrc", 2, 2));
+    EXPECT_EQ(AI_FAILURE, pcMat->Get("$tex.uvwsrc", 2, 2, value));
+    EXPECT_EQ(AI_SUCCESS, pcMat->Get("$tex.uvwsrc", 3, 2, value));
+    EXPECT_EQ(19, value);
+
+    // .. also if the list is changed directly
+    delete pcMat->mProperties[--pcMat->mNumProperties];
+    EXPECT_EQ(pcMat->GetName(), aiString());
+    EXPECT_EQ(AI_SUCCESS, pcMat->Get("$tex.uvwsrc", 7, 7, value));
+    EXPECT_EQ(63, value);
+
+    // .. or after an in place change when the writer drops the index
+    std::swap(pcMat->mProperties[0], pcMat->mProperties[1]);
+    pcMat->mProperties[1]->mKey.Set("$tex.renamed");
+    pcMat->InvalidatePropertyIndex();
+    EXPECT_EQ(AI_FAILURE, pcMat->Get("$tex.uvwsrc", 0, 0, value));
+    EXPECT_EQ(AI_SUCCESS, pcMat->Get("$tex.renamed", 0, 0, value));
+    EXPECT_EQ(0, value);
+    EXPECT_EQ(AI_SUCCESS, pcMat->Get("$tex.uvwsrc", 1, 0, value));
+    EXPECT_EQ(1, value);
+
+    pcMat->Clear();
+    EXPECT_EQ(AI_FAILURE, pcMat->Get("$tex.uvwsrc", 7, 7, value));
+}
+
+// ------------------------------------------------------------------------------------------------
+// Measures exact lookups on a PBR sized material and material heavy FBX and glTF2 imports, once
+// with the index disabled and once with the default threshold, run with --gtest_also_run_disabled_tests
+TEST_F(MaterialSystemTest, DISABLED_propertyLookupBenchmark) {
+    const unsigned int numLookups = 1600000, numImports = 20;
+    const unsigned int defaultThreshold = SetMinIndexedMaterialProperties(UINT_MAX);
+    std::vector<std::string> keys;
+    for (unsigned int numProperties : { 8, 16, 32, 64, 128, 512 }) {
+        while (keys.size() < numProperties) {
+            keys.push_back("$bench.key" + std::to_string(keys.size()));
+            const float value = static_cast<float>(keys.size());
+            EXPECT_EQ(AI_SUCCESS, pcMat->AddProperty(&value, 1, keys.back().c_str(), 0, 0));
+        }
+        for (unsigned int threshold : { UINT_MAX, 0u }) {
+            SetMinIndexedMaterialProperties(threshold);
+            const aiMaterialProperty *found = nullptr;
+            const auto begin = std::chrono::steady_clock::now();
+            for (unsigned int i = 0; i < numLookups; ++i) {
+                ASSERT_EQ(AI_SUCCESS, aiGetMaterialProperty(pcMat, keys[i % numProperties].c_str(), 0, 0, &found));
+            }
+            const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - begin;
+            std::cout << numLookups << " lookups in " << pcMat->mNumProperties << " properties "
+                      << (threshold ? "without index" : "indexed") << ": " << elapsed.count() << " s" << std::endl;
+        }
+    }
+
+    for (unsigned int threshold : { UINT_MAX, defaultThreshold }) {
+        SetMinIndexedMaterialProperties(threshold);
+        for (const char *file : { ASSIMP_TEST_MODELS_DIR "/FBX/spider.fbx", ASSIMP_TEST_MODELS_DIR "/glTF2/2CylinderEngine-glTF-Binary/2CylinderEngine.glb" }) {
+            const auto begin = std::chrono::steady_clock::now();
+            for (unsigned int i = 0; i < numImports; ++i) {
+                Importer importer;
+                const aiScene *scene = importer.ReadFile(file, aiProcess_ValidateDataStructure | aiProcess_RemoveRedundantMaterials);
+                ASSERT_NE(nullptr, scene);
+            }
+            const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - begin;
+            std::cout << numImports << " imports of " << file << (threshold == UINT_MAX ? " without index" : " indexed")
+                      << ": " << elapsed.count() << " s" << std::endl;
+        }
+    }
+    SetMinIndexedMaterialProperties(defaultThreshold);
+}
+
+// ------------------------------------------------------------------------------------------------
+// C code sees aiMaterial without the member functions, the layout must be the same
+extern "C" size_t CCompilerTestSizeofMaterial(void);
+
+TEST_F(MaterialSystemTest, materialLayoutMatchesC) {
+    EXPECT_EQ(sizeof(aiMaterial), CCompilerTestSizeofMaterial());
+}
+
 // ------------------------------------------------------------------------------------------------
 #if defined(_MSC_VER)
 // Refuse to compile on Windows if any enum values are not explicitly handled in the switch
@@ -0,0 +1,202 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2022, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+#include "UnitTestPCH.h"
+
+#include "PostProcessing/OptimizeGraph.h"
+#include "PostProcessing/PretransformVertices.h"
+#include <assimp/scene.h>
+
+#include <chrono>
+#include <iostream>
+
+using namespace Assimp;
+
+class utOptimizeGraph : public ::testing::Test {
+protected:
+    static aiMesh *createPoint(const aiVector3D &pos) {
+        aiMesh *mesh = new aiMesh();
+        mesh->mPrimitiveTypes = aiPrimitiveType_POINT;
+        mesh->mVertices = new aiVector3D[mesh->mNumVertices = 1];
+        mesh->mVertices[0] = pos;
+        mesh->mFaces = new aiFace[mesh->mNumFaces = 1];
+        mesh->mFaces[0].mIndices = new unsigned int[mesh->mFaces[0].mNumIndices = 1];
+        mesh->mFaces[0].mIndices[0] = 0;
+        return mesh;
+    }
+
+    static aiNode *addChild(aiNode *parent, const char *name) {
+        aiNode *nd = new aiNode(name);
+        aiNode **children = new aiNode *[parent->mNumChildren + 1];
+        for (unsigned int i = 0; i < parent->mNumChildren; ++i) {
+            children[i] = parent->mChildren[i];
+        }
+        delete[] parent->mChildren;
+        parent->mChildren = children;
+        parent->mChildren[parent->mNumChildren++] = nd;
+        nd->mParent = parent;
+        return nd;
+    }
+
+    static void setMesh(aiNode *nd, unsigned int mesh) {
+        nd->mMeshes = new unsigned int[nd->mNumMeshes = 1];
+        nd->mMeshes[0] = mesh;
+    }
+
+    // Fills the scene with a full tree of translated nodes, every node references one of 16 meshes
+    static void createTree(aiScene &scene, unsigned int branching, unsigned int depth) {
+        scene.mMaterials = new aiMaterial *[scene.mNumMaterials = 1];
+        scene.mMaterials[0] = new aiMaterial();
+        scene.mMeshes = new aiMesh *[scene.mNumMeshes = 16];
+        for (unsigned int i = 0; i < scene.mNumMeshes; ++i) {
+            scene.mMeshes[i] = createPoint(aiVector3D(static_cast<float>(i), 0.f, 0.f));
+        }
+        scene.mRootNode = new aiNode("root");
+
+        std::vector<aiNode *> level(1, scene.mRootNode), next;
+        unsigned int numNodes = 0;
+        for (unsigned int d = 0; d < depth; ++d) {
+            next.clear();
+            for (aiNode *parent : level) {
+                parent->mChildren = new aiNode *[branching];
+                for (unsigned int c = 0; c < branching; ++c) {
+                    aiNode *nd = parent->mChildren[parent->mNumChildren++] = new aiNode("n");
+                    nd->mParent = parent;
+                    aiMatrix4x4::Translation(aiVector3D(0.f, 1.f, 0.f), nd->mTransformation);
+                    setMesh(nd, numNodes++ % scene.mNumMeshes);
+                    next.push_back(nd);
+                }
+            }
+            level.swap(next);
+        }
+    }
+};
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(utOptimizeGraph, collapseDeepHierarchy) {
+    const unsigned int depth = 10000;
+
+    aiScene scene;
+    scene.mMeshes = new aiMesh *[scene.mNumMeshes = 1];
+    scene.mMeshes[0] = createPoint(aiVector3D(0.f, 0.f, 0.f));
+    scene.mRootNode = new aiNode("root");
+
+    aiNode *nd = scene.mRootNode;
+    for (unsigned int i = 0; i < depth; ++i) {
+        nd = addChild(nd, "n");
+        aiMatrix4x4::Translation(aiVector3D(1.f, 0.f, 0.f), nd->mTransformation);
+    }
+    setMesh(nd, 0);
+
+    OptimizeGraphProcess process;
+    process.Execute(&scene);
+
+    // all transformations are folded into the only node that references a mesh
+    ASSERT_NE(nullptr, scene.mRootNode);
+    EXPECT_EQ(0u, scene.mRootNode->mNumChildren);
+    EXPECT_EQ(1u, scene.mRootNode->mNumMeshes);
+    EXPECT_FLOAT_EQ(static_cast<float>(depth), scene.mRootNode->mTransformation.a4);
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(utOptimizeGraph, joinSiblingsAndKeepLockedNodes) {
+    aiScene scene;
+    scene.mMeshes = new aiMesh *[scene.mNumMeshes = 3];
+    for (unsigned int i = 0; i < 3; ++i) {
+        scene.mMeshes[i] = createPoint(aiVector3D(0.f, 0.f, 0.f));
+    }
+    scene.mRootNode = new aiNode("root");
+
+    aiNode *a = addChild(scene.mRootNode, "a");
+    setMesh(a, 0);
+    aiNode *b = addChild(scene.mRootNode, "b");
+    setMesh(b, 1);
+    aiMatrix4x4::Translation(aiVector3D(0.f, 2.f, 0.f), b->mTransformation);
+    aiNode *locked = addChild(scene.mRootNode, "locked");
+    setMesh(locked, 2);
+
+    OptimizeGraphProcess process;
+    std::string name = "locked";
+    process.AddLockedNode(name);
+    process.Execute(&scene);
+
+    // the unlocked siblings are hoisted and merged into one node, the locked one stays in place
+    ASSERT_NE(nullptr, scene.mRootNode);
+    ASSERT_EQ(2u, scene.mRootNode->mNumChildren);
+    const aiNode *merged = scene.mRootNode->mChildren[0];
+    EXPECT_EQ(2u, merged->mNumMeshes);
+    EXPECT_EQ(0u, merged->mNumChildren);
+    EXPECT_EQ(scene.mRootNode, merged->mParent);
+
+    const aiNode *parent = scene.mRootNode->mChildren[1];
+    ASSERT_EQ(1u, parent->mNumChildren);
+    EXPECT_STREQ("locked", parent->mChildren[0]->mName.C_Str());
+    EXPECT_EQ(parent, parent->mChildren[0]->mParent);
+    EXPECT_EQ(1u, parent->mChildren[0]->mNumMeshes);
+
+    // the mesh of the joined node was moved into the coordinate system of the merged node
+    EXPECT_FLOAT_EQ(2.f, scene.mMeshes[1]->mVertices[0].y);
+}
+
+// Times both graph steps on a tree of 300k nodes, run with --gtest_also_run_disabled_tests
+TEST_F(utOptimizeGraph, DISABLED_graphStepsBenchmark) {
+    const unsigned int branching = 8, depth = 6;
+    {
+        aiScene scene;
+        createTree(scene, branching, depth);
+        OptimizeGraphProcess process;
+        const auto begin = std::chrono::steady_clock::now();
+        process.Execute(&scene);
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - begin;
+        ASSERT_NE(nullptr, scene.mRootNode);
+        std::cout << "OptimizeGraph: " << elapsed.count() << " s" << std::endl;
+    }
+    for (bool keepHierarchy : { false, true }) {
+        aiScene scene;
+        createTree(scene, branching, depth);
+        PretransformVertices process;
+        process.KeepHierarchy(keepHierarchy);
+        const auto begin = std::chrono::steady_clock::now();
+        process.Execute(&scene);
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - begin;
+        ASSERT_NE(nullptr, scene.mRootNode);
+        std::cout << "PretransformVertices" << (keepHierarchy ? " keeping the hierarchy: " : ": ") << elapsed.count() << " s" << std::endl;
+    }
+}
@@ -155,3 +155,34 @@ TEST_F(PretransformVerticesTest, testProcessKeepHierarchy) {
     EXPECT_EQ(5U, mScene->mNumMaterials);
     EXPECT_EQ(49U, mScene->mNumMeshes); // see note on mesh 12 above
 }
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(PretransformVerticesTest, testProcessDeepHierarchy) {
+    const unsigned int depth = 10000;
+
+    // replace the fixture graph by a long chain of translated nodes, each referencing mesh 0
+    delete mScene->mRootNode;
+    mScene->mRootNode = new aiNode();
+    aiNode *nd = mScene->mRootNode;
+    for (unsigned int i = 0; i < depth; ++i) {
+        aiNode *child = new aiNode();
+        nd->mChildren = new aiNode *[nd->mNumChildren = 1];
+        nd->mChildren[0] = child;
+        child->mParent = nd;
+        aiMatrix4x4::Translation(aiVector3D(1.f, 0.f, 0.f), child->mTransformation);
+        child->mMeshes = new unsigned int[child->mNumMeshes = 1];
+        child->mMeshes[0] = 0;
+        nd = child;
+    }
+
+    mProcess->KeepHierarchy(false);
+    mProcess->Execute(mScene);
+
+    // all instances end up in a single mesh, in depth-first order
+    ASSERT_EQ(1U, mScene->mNumMeshes);
+    const aiMesh *mesh = mScene->mMeshes[0];
+    ASSERT_EQ(depth * 10U, mesh->mNumVertices);
+    EXPECT_FLOAT_EQ(1.f, mesh->mVertices[0].x);
+    EXPECT_FLOAT_EQ(static_cast<float>(depth), mesh->mVertices[mesh->mNumVertices - 1].x);
+    EXPECT_FLOAT_EQ(9.f, mesh->mVertices[mesh->mNumVertices - 1].y);
+}
@@ -44,6 +44,11 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "UTLogStream.h"
 #include <assimp/Profiler.h>
 #include <assimp/DefaultLogger.hpp>
+#include <assimp/Importer.hpp>
+#include <assimp/postprocess.h>
+
+#include <set>
+#include <sstream>
 
 using namespace ::Assimp;
 using namespace ::Assimp::Profiling;
@@ -75,3 +80,73 @@ TEST_F( utProfiler, addRegion_success ) {
     //UTLogStream *stream( (UTLogStream*) m_stream );
     //EXPECT_FALSE( stream->m_messages.empty() );
 }
+
+TEST_F( utProfiler, nestedRegions_success ) {
+    Profiler myProfiler;
+    myProfiler.BeginRegion( "outer" );
+    myProfiler.BeginRegion( "inner" );
+    myProfiler.EndRegion( "inner" );
+    myProfiler.BeginRegion( "open" );
+    myProfiler.EndRegion( "outer" );
+    myProfiler.EndRegion( "unknown" );
+
+    const std::vector<Profiler::Region> &regions = myProfiler.GetRegions();
+    ASSERT_EQ( 3U, regions.size() );
+    EXPECT_EQ( "outer", regions[0].name );
+    EXPECT_EQ( 0U, regions[0].depth );
+    EXPECT_EQ( "inner", regions[1].name );
+    EXPECT_EQ( 1U, regions[1].depth );
+    EXPECT_LE( regions[0].start, regions[1].start );
+    EXPECT_LE( regions[1].start + regions[1].duration, regions[0].start + regions[0].duration );
+    // ending the outer region ends the nested one as well
+    EXPECT_EQ( "open", regions[2].name );
+    EXPECT_LE( regions[2].start + regions[2].duration, regions[0].start + regions[0].duration );
+}
+
+TEST_F( utProfiler, exportRegions_success ) {
+    AllocationCounters counters;
+    Profiler myProfiler;
+    myProfiler.SetAllocationCounters( &counters );
+    myProfiler.BeginRegion( "t\"1" );
+    counters.count += 2;
+    counters.bytes += 64;
+    myProfiler.EndRegion( "t\"1" );
+    EXPECT_EQ( 2U, myProfiler.GetRegions()[0].allocations );
+    EXPECT_EQ( 64U, myProfiler.GetRegions()[0].allocatedBytes );
+
+    std::ostringstream json;
+    myProfiler.ExportJSON( json );
+    EXPECT_NE( std::string::npos, json.str().find( "\"name\":\"t\\\"1\"" ) );
+    EXPECT_NE( std::string::npos, json.str().find( "\"allocated_bytes\":64" ) );
+
+    std::ostringstream trace;
+    myProfiler.ExportChromeTrace( trace );
+    EXPECT_NE( std::string::npos, trace.str().find( "\"traceEvents\"" ) );
+    EXPECT_NE( std::string::npos, trace.str().find( "\"ph\":\"X\"" ) );
+}
+
+TEST_F( utProfiler, importerProfile_success ) {
+    Importer importer;
+    EXPECT_EQ( nullptr, importer.GetProfiler() );
+
+    importer.SetPropertyInteger( AI_CONFIG_GLOB_MEASURE_TIME, 1 );
+    ASSERT_NE( nullptr, importer.ReadFile( ASSIMP_TEST_MODELS_DIR "/OBJ/spider.obj", aiProcess_Triangulate ) );
+    const Profiler *profiler = importer.GetProfiler();
+    ASSERT_NE( nullptr, profiler );
+
+    std::set<std::string> names;
+    for ( const Profiler::Region &region : profiler->GetRegions() ) {
+        names.insert( region.name );
+        if ( region.name == "TriangulateProcess" ) {
+            EXPECT_EQ( 2U, region.depth );
+            EXPECT_LT( 0U, region.verticesBefore );
+            EXPECT_LT( 0U, region.facesAfter );
+        }
+    }
+    for ( const char *name : { "total", "probe", "import", "parse", "convert", "preprocess", "postprocess", "TriangulateProcess" } ) {
+        EXPECT_EQ( 1U, names.count( name ) ) << name;
+    }
+
+    importer.Reset();
+    EXPECT_EQ( nullptr, importer.GetProfiler() );
+}
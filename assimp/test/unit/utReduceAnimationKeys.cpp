@@ -0,0 +1,163 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2022, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+#include "UnitTestPCH.h"
+
+#include "PostProcessing/ReduceAnimationKeysProcess.h"
+#include <assimp/anim.h>
+
+#include <cmath>
+
+using namespace Assimp;
+
+class utReduceAnimationKeys : public ::testing::Test {
+protected:
+    // A channel with one key per frame for all three tracks
+    static aiNodeAnim *CreateChannel(unsigned int numKeys) {
+        aiNodeAnim *anim = new aiNodeAnim();
+        anim->mNodeName.Set("bone");
+        anim->mNumPositionKeys = anim->mNumRotationKeys = anim->mNumScalingKeys = numKeys;
+        anim->mPositionKeys = new aiVectorKey[numKeys];
+        anim->mRotationKeys = new aiQuatKey[numKeys];
+        anim->mScalingKeys = new aiVectorKey[numKeys];
+        for (unsigned int i = 0; i < numKeys; ++i) {
+            anim->mPositionKeys[i].mTime = anim->mRotationKeys[i].mTime = anim->mScalingKeys[i].mTime = i;
+        }
+        return anim;
+    }
+
+    // Linear interpolation of a position track at the given time
+    static aiVector3D Sample(const aiNodeAnim *anim, double time) {
+        const aiVectorKey *keys = anim->mPositionKeys;
+        unsigned int i = 0;
+        while (i + 2 < anim->mNumPositionKeys && keys[i + 1].mTime <= time) {
+            ++i;
+        }
+        if (anim->mNumPositionKeys == 1) {
+            return keys[0].mValue;
+        }
+        const ai_real f = (ai_real)((time - keys[i].mTime) / (keys[i + 1].mTime - keys[i].mTime));
+        return keys[i].mValue + (keys[i + 1].mValue - keys[i].mValue) * f;
+    }
+
+    ReduceAnimationKeysProcess mProcess;
+};
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(utReduceAnimationKeys, reduceLinearTracks) {
+    aiNodeAnim *anim = CreateChannel(100);
+    for (unsigned int i = 0; i < 100; ++i) {
+        anim->mPositionKeys[i].mValue = aiVector3D(0.5f * i, 2.0f, -0.25f * i);
+        anim->mRotationKeys[i].mValue = aiQuaternion(aiVector3D(0.0f, 0.0f, 1.0f), AI_MATH_HALF_PI_F * i / 99.0f);
+        anim->mScalingKeys[i].mValue = aiVector3D(1.0f, 1.0f, 1.0f);
+    }
+
+    const ReduceAnimationKeysProcess::ChannelReport report = mProcess.ReduceChannel(anim);
+    EXPECT_EQ(300u, report.mNumKeysIn);
+    EXPECT_EQ(5u, report.mNumKeysOut);
+
+    ASSERT_EQ(2u, anim->mNumPositionKeys);
+    EXPECT_EQ(0.0, anim->mPositionKeys[0].mTime);
+    EXPECT_EQ(99.0, anim->mPositionKeys[1].mTime);
+    ASSERT_EQ(2u, anim->mNumRotationKeys);
+    ASSERT_EQ(1u, anim->mNumScalingKeys);
+
+    EXPECT_LE(report.mMaxPositionError, AI_RAK_DEFAULT_POSITION_TOLERANCE);
+    EXPECT_LE(report.mMaxRotationError, AI_RAK_DEFAULT_ROTATION_TOLERANCE);
+    EXPECT_EQ(0.0f, report.mMaxScalingError);
+    delete anim;
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(utReduceAnimationKeys, keepKeysWithinTolerance) {
+    const unsigned int numKeys = 500;
+    const ai_real tolerance = 0.01f;
+    aiNodeAnim *anim = CreateChannel(numKeys);
+    std::vector<aiVector3D> original(numKeys);
+    for (unsigned int i = 0; i < numKeys; ++i) {
+        original[i] = anim->mPositionKeys[i].mValue = aiVector3D(std::sin(i * 0.05f), std::cos(i * 0.02f), 0.0f);
+        anim->mScalingKeys[i].mValue = aiVector3D(1.0f, 1.0f, 1.0f);
+    }
+
+    mProcess.SetTolerances(tolerance, tolerance, tolerance);
+    const ReduceAnimationKeysProcess::ChannelReport report = mProcess.ReduceChannel(anim);
+    EXPECT_LT(anim->mNumPositionKeys, numKeys / 4);
+    EXPECT_LE(report.mMaxPositionError, tolerance);
+
+    ai_real maxError = 0.0f;
+    for (unsigned int i = 0; i < numKeys; ++i) {
+        maxError = std::max(maxError, (Sample(anim, i) - original[i]).Length());
+    }
+    EXPECT_LE(maxError, tolerance + 1e-5f);
+    EXPECT_NEAR(report.mMaxPositionError, maxError, 1e-5f);
+    delete anim;
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(utReduceAnimationKeys, quantizeRotations) {
+    for (unsigned int i = 0; i < 1000; ++i) {
+        aiVector3D axis(std::sin(i * 0.7f), std::cos(i * 1.3f), std::sin(i * 0.31f) + 0.1f);
+        const aiQuaternion q(axis.Normalize(), i * 0.0123f - 6.0f);
+        const uint64_t bits = ReduceAnimationKeysProcess::EncodeQuaternion48(q);
+        EXPECT_EQ(0u, bits >> 48);
+
+        // q and -q are the same rotation
+        const aiQuaternion r = ReduceAnimationKeysProcess::DecodeQuaternion48(bits);
+        const ai_real s = (q.x * r.x + q.y * r.y + q.z * r.z + q.w * r.w) < 0.0f ? -1.0f : 1.0f;
+        const aiVector3D dv(q.x - s * r.x, q.y - s * r.y, q.z - s * r.z);
+        const ai_real dw = q.w - s * r.w;
+        EXPECT_LT(std::sqrt(dv.SquareLength() + dw * dw), 1e-4f);
+    }
+
+    aiNodeAnim *anim = CreateChannel(50);
+    for (unsigned int i = 0; i < 50; ++i) {
+        anim->mRotationKeys[i].mValue = aiQuaternion(aiVector3D(1.0f, 0.0f, 0.0f), std::sin(i * 0.2f));
+    }
+    mProcess.SetQuantizeRotations(true);
+    const ReduceAnimationKeysProcess::ChannelReport report = mProcess.ReduceChannel(anim);
+    EXPECT_LE(report.mMaxRotationError, AI_RAK_DEFAULT_ROTATION_TOLERANCE);
+    EXPECT_LT(anim->mNumRotationKeys, 50u);
+    for (unsigned int i = 0; i < anim->mNumRotationKeys; ++i) {
+        const aiQuaternion &q = anim->mRotationKeys[i].mValue;
+        const aiQuaternion r = ReduceAnimationKeysProcess::DecodeQuaternion48(ReduceAnimationKeysProcess::EncodeQuaternion48(q));
+        EXPECT_NEAR(std::abs(q.x * r.x + q.y * r.y + q.z * r.z + q.w * r.w), 1.0f, 1e-6f);
+    }
+    delete anim;
+}
@@ -175,3 +175,31 @@ TEST_F(RemoveRedundantMatsTest, testRedundantMaterialsWithExcludeList) {
     EXPECT_EQ(AI_SUCCESS, aiGetMaterialString(pcScene1->mMaterials[3], AI_MATKEY_NAME, &sName));
     EXPECT_STREQ("Complex material name", sName.data);
 }
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(RemoveRedundantMatsTest, testRedundantMaterialsPropertyOrder) {
+    // material 1 again, with the properties added in a different order
+    aiString mTemp;
+    mTemp.Set("Reordered");
+    aiMaterial *pcMat = new aiMaterial();
+    int i = 1;
+    float f = 4.0f;
+    pcMat->AddProperty<int>(&i, 1, AI_MATKEY_ENABLE_WIREFRAME);
+    pcMat->AddProperty(&mTemp, AI_MATKEY_NAME);
+    pcMat->AddProperty<float>(&f, 1, AI_MATKEY_BUMPSCALING);
+
+    delete pcScene1->mMaterials[3];
+    pcScene1->mMaterials[3] = pcMat;
+
+    // same properties with another value must be kept
+    f = 8.0f;
+    pcScene1->mMaterials[2]->AddProperty<float>(&f, 1, AI_MATKEY_BUMPSCALING);
+
+    piProcess->SetFixedMaterialsString();
+    piProcess->Execute(pcScene1);
+    EXPECT_EQ(4U, pcScene1->mNumMaterials);
+    EXPECT_EQ(1U, pcScene1->mMeshes[1]->mMaterialIndex);
+    EXPECT_EQ(2U, pcScene1->mMeshes[2]->mMaterialIndex);
+    EXPECT_EQ(1U, pcScene1->mMeshes[3]->mMaterialIndex);
+    EXPECT_EQ(3U, pcScene1->mMeshes[4]->mMaterialIndex);
+}
@@ -0,0 +1,255 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2022, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+#include "AbstractImportExportBase.h"
+#include "AssetLib/SceneCache/SceneCacheFormat.h"
+#include "SceneDiffer.h"
+#include "UnitTestPCH.h"
+#include <assimp/postprocess.h>
+#include <assimp/scene.h>
+#include <assimp/Exporter.hpp>
+#include <assimp/Importer.hpp>
+
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+using namespace Assimp;
+
+#ifndef ASSIMP_BUILD_NO_EXPORT
+
+class utSceneCacheImportExport : public AbstractImportExportBase {
+public:
+    bool importerTest() override {
+        Importer importer;
+        const aiScene *scene = importer.ReadFile(ASSIMP_TEST_MODELS_DIR "/OBJ/spider.obj", aiProcess_ValidateDataStructure);
+
+        Exporter exporter;
+        EXPECT_EQ(aiReturn_SUCCESS, exporter.Export(scene, "aicache", ASSIMP_TEST_MODELS_DIR "/OBJ/spider_out.aicache"));
+        const aiScene *newScene = importer.ReadFile(ASSIMP_TEST_MODELS_DIR "/OBJ/spider_out.aicache", aiProcess_ValidateDataStructure);
+
+        return newScene != nullptr;
+    }
+};
+
+TEST_F(utSceneCacheImportExport, importExportSceneCacheTest) {
+    EXPECT_TRUE(importerTest());
+}
+
+TEST_F(utSceneCacheImportExport, roundTripKeepsBonesAndAnimations) {
+    Importer original;
+    const aiScene *expected = original.ReadFile(ASSIMP_TEST_MODELS_DIR "/FBX/huesitos.fbx", aiProcess_ValidateDataStructure);
+    ASSERT_NE(nullptr, expected);
+    ASSERT_GT(expected->mNumAnimations, 0u);
+
+    Exporter exporter;
+    ASSERT_EQ(aiReturn_SUCCESS, exporter.Export(expected, "aicache", ASSIMP_TEST_MODELS_DIR "/FBX/huesitos_out.aicache"));
+    Importer importer;
+    const aiScene *scene = importer.ReadFile(ASSIMP_TEST_MODELS_DIR "/FBX/huesitos_out.aicache", aiProcess_ValidateDataStructure);
+    ASSERT_NE(nullptr, scene);
+
+    SceneDiffer differ;
+    EXPECT_TRUE(differ.isEqual(expected, scene));
+
+    for (unsigned int i = 0; i < expected->mNumMeshes; ++i) {
+        const aiMesh *a = expected->mMeshes[i], *b = scene->mMeshes[i];
+        ASSERT_EQ(a->mNumBones, b->mNumBones);
+        for (unsigned int j = 0; j < a->mNumBones; ++j) {
+            EXPECT_STREQ(a->mBones[j]->mName.C_Str(), b->mBones[j]->mName.C_Str());
+            ASSERT_EQ(a->mBones[j]->mNumWeights, b->mBones[j]->mNumWeights);
+            EXPECT_EQ(0, memcmp(a->mBones[j]->mWeights, b->mBones[j]->mWeights, a->mBones[j]->mNumWeights * sizeof(aiVertexWeight)));
+            EXPECT_TRUE(a->mBones[j]->mOffsetMatrix.Equal(b->mBones[j]->mOffsetMatrix));
+        }
+    }
+
+    ASSERT_EQ(expected->mNumAnimations, scene->mNumAnimations);
+    for (unsigned int i = 0; i < expected->mNumAnimations; ++i) {
+        const aiAnimation *a = expected->mAnimations[i], *b = scene->mAnimations[i];
+        EXPECT_EQ(a->mDuration, b->mDuration);
+        ASSERT_EQ(a->mNumChannels, b->mNumChannels);
+        for (unsigned int c = 0; c < a->mNumChannels; ++c) {
+            const aiNodeAnim *ca = a->mChannels[c], *cb = b->mChannels[c];
+            EXPECT_STREQ(ca->mNodeName.C_Str(), cb->mNodeName.C_Str());
+            ASSERT_EQ(ca->mNumRotationKeys, cb->mNumRotationKeys);
+            for (unsigned int k = 0; k < ca->mNumRotationKeys; ++k) {
+                EXPECT_EQ(ca->mRotationKeys[k].mTime, cb->mRotationKeys[k].mTime);
+                EXPECT_TRUE(ca->mRotationKeys[k].mValue == cb->mRotationKeys[k].mValue);
+            }
+        }
+    }
+
+    // the node graph is rebuilt with the same names and parents
+    std::vector<std::pair<const aiNode *, const aiNode *>> stack = { { expected->mRootNode, scene->mRootNode } };
+    while (!stack.empty()) {
+        const aiNode *a = stack.back().first, *b = stack.back().second;
+        stack.pop_back();
+        EXPECT_STREQ(a->mName.C_Str(), b->mName.C_Str());
+        EXPECT_TRUE(a->mTransformation.Equal(b->mTransformation));
+        ASSERT_EQ(a->mNumChildren, b->mNumChildren);
+        ASSERT_EQ(a->mNumMeshes, b->mNumMeshes);
+        for (unsigned int j = 0; j < a->mNumChildren; ++j) {
+            EXPECT_EQ(b, b->mChildren[j]->mParent);
+            stack.emplace_back(a->mChildren[j], b->mChildren[j]);
+        }
+    }
+}
+
+TEST_F(utSceneCacheImportExport, truncatedCacheIsRejected) {
+    Importer importer;
+    const aiScene *scene = importer.ReadFile(ASSIMP_TEST_MODELS_DIR "/OBJ/spider.obj", 0);
+    ASSERT_NE(nullptr, scene);
+    Exporter exporter;
+    ASSERT_EQ(aiReturn_SUCCESS, exporter.Export(scene, "aicache", ASSIMP_TEST_MODELS_DIR "/OBJ/spider_out.aicache"));
+
+    std::ifstream in(ASSIMP_TEST_MODELS_DIR "/OBJ/spider_out.aicache", std::ios::binary);
+    std::vector<char> data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    ASSERT_GT(data.size(), 1024u);
+    data.resize(data.size() - 1024);
+
+    EXPECT_EQ(nullptr, importer.ReadFileFromMemory(data.data(), data.size(), 0, "aicache"));
+}
+
+// Exports the scene to a cache in 8 byte aligned memory, as the importer reads it
+static std::vector<uint64_t> ExportCache(const aiScene *scene) {
+    Exporter exporter;
+    const aiExportDataBlob *blob = exporter.ExportToBlob(scene, "aicache");
+    EXPECT_NE(nullptr, blob);
+    if (blob == nullptr) {
+        return {};
+    }
+    std::vector<uint64_t> data(blob->size / sizeof(uint64_t) + 1);
+    memcpy(data.data(), blob->data, blob->size);
+    data.resize((blob->size + sizeof(uint64_t) - 1) / sizeof(uint64_t));
+    return data;
+}
+
+TEST_F(utSceneCacheImportExport, outOfRangeReferencesAreRejected) {
+    using namespace Assimp::SceneCache;
+    Importer original;
+    const aiScene *scene = original.ReadFile(ASSIMP_TEST_MODELS_DIR "/FBX/huesitos.fbx", aiProcess_ValidateDataStructure);
+    ASSERT_NE(nullptr, scene);
+    const std::vector<uint64_t> data = ExportCache(scene);
+    ASSERT_FALSE(data.empty());
+    const size_t size = data.size() * sizeof(uint64_t);
+    Importer importer;
+    ASSERT_NE(nullptr, importer.ReadFileFromMemory(data.data(), size, 0, "aicache"));
+
+    std::vector<uint64_t> faces = data;
+    Header *header = reinterpret_cast<Header *>(faces.data());
+    Mesh *mesh = reinterpret_cast<Mesh *>(reinterpret_cast<char *>(faces.data()) + header->mMeshes.mOffset);
+    reinterpret_cast<uint32_t *>(reinterpret_cast<char *>(faces.data()) + mesh->mIndices.mOffset)[0] = mesh->mNumVertices;
+    EXPECT_EQ(nullptr, importer.ReadFileFromMemory(faces.data(), size, 0, "aicache"));
+
+    std::vector<uint64_t> nodes = data;
+    header = reinterpret_cast<Header *>(nodes.data());
+    Node *node = reinterpret_cast<Node *>(reinterpret_cast<char *>(nodes.data()) + header->mNodes.mOffset);
+    for (uint64_t i = 0; i < header->mNodes.mCount; ++i) {
+        if (node[i].mMeshes.mCount) {
+            reinterpret_cast<uint32_t *>(reinterpret_cast<char *>(nodes.data()) + node[i].mMeshes.mOffset)[0] = static_cast<uint32_t>(header->mMeshes.mCount);
+            break;
+        }
+    }
+    EXPECT_EQ(nullptr, importer.ReadFileFromMemory(nodes.data(), size, 0, "aicache"));
+
+    // metadata that contains itself
+    std::vector<uint64_t> metadata = data;
+    header = reinterpret_cast<Header *>(metadata.data());
+    node = reinterpret_cast<Node *>(reinterpret_cast<char *>(metadata.data()) + header->mNodes.mOffset);
+    bool patched = false;
+    for (uint64_t i = 0; i < header->mNodes.mCount && !patched; ++i) {
+        if (node[i].mMetadata.mCount) {
+            MetadataEntry *entry = reinterpret_cast<MetadataEntry *>(reinterpret_cast<char *>(metadata.data()) + node[i].mMetadata.mOffset);
+            entry->mType = AI_AIMETADATA;
+            entry->mData = node[i].mMetadata;
+            patched = true;
+        }
+    }
+    ASSERT_TRUE(patched);
+    EXPECT_EQ(nullptr, importer.ReadFileFromMemory(metadata.data(), size, 0, "aicache"));
+}
+
+TEST_F(utSceneCacheImportExport, invalidSkinningIsRejected) {
+    using namespace Assimp::SceneCache;
+    Importer original;
+    original.SetPropertyInteger(AI_CONFIG_PP_LBW_PACK_INFLUENCES, 4);
+    const aiScene *scene = original.ReadFile(ASSIMP_TEST_MODELS_DIR "/FBX/huesitos.fbx", aiProcess_LimitBoneWeights | aiProcess_ValidateDataStructure);
+    ASSERT_NE(nullptr, scene);
+    const std::vector<uint64_t> data = ExportCache(scene);
+    ASSERT_FALSE(data.empty());
+    const size_t size = data.size() * sizeof(uint64_t);
+    Importer importer;
+    ASSERT_NE(nullptr, importer.ReadFileFromMemory(data.data(), size, 0, "aicache"));
+
+    // the first skinned mesh of a copy of the cache
+    auto skinnedMesh = [](std::vector<uint64_t> &copy) -> Mesh * {
+        const Header *header = reinterpret_cast<const Header *>(copy.data());
+        Mesh *meshes = reinterpret_cast<Mesh *>(reinterpret_cast<char *>(copy.data()) + header->mMeshes.mOffset);
+        for (uint64_t i = 0; i < header->mMeshes.mCount; ++i) {
+            if (meshes[i].mBones.mCount && meshes[i].mNumInfluences) {
+                return &meshes[i];
+            }
+        }
+        return nullptr;
+    };
+
+    std::vector<uint64_t> weights = data;
+    Mesh *mesh = skinnedMesh(weights);
+    ASSERT_NE(nullptr, mesh);
+    const Bone *bone = reinterpret_cast<const Bone *>(reinterpret_cast<char *>(weights.data()) + mesh->mBones.mOffset);
+    ASSERT_GT(bone->mWeights.mCount, 0u);
+    reinterpret_cast<aiVertexWeight *>(reinterpret_cast<char *>(weights.data()) + bone->mWeights.mOffset)->mVertexId = mesh->mNumVertices;
+    EXPECT_EQ(nullptr, importer.ReadFileFromMemory(weights.data(), size, 0, "aicache"));
+
+    std::vector<uint64_t> influences = data;
+    mesh = skinnedMesh(influences);
+    ASSERT_EQ(1u, mesh->mInfluenceIndexSize);
+    reinterpret_cast<uint8_t *>(influences.data())[mesh->mInfluenceIndices] = static_cast<uint8_t>(mesh->mBones.mCount);
+    EXPECT_EQ(nullptr, importer.ReadFileFromMemory(influences.data(), size, 0, "aicache"));
+
+    std::vector<uint64_t> missing = data;
+    skinnedMesh(missing)->mInfluenceWeights = 0;
+    EXPECT_EQ(nullptr, importer.ReadFileFromMemory(missing.data(), size, 0, "aicache"));
+
+    std::vector<uint64_t> material = data;
+    skinnedMesh(material)->mMaterialIndex = static_cast<uint32_t>(reinterpret_cast<const Header *>(material.data())->mMaterials.mCount);
+    EXPECT_EQ(nullptr, importer.ReadFileFromMemory(material.data(), size, 0, "aicache"));
+}
+
+#endif // #ifndef ASSIMP_BUILD_NO_EXPORT
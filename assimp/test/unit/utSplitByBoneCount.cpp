@@ -0,0 +1,154 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2022, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+#include "UnitTestPCH.h"
+
+#include "PostProcessing/SplitByBoneCountProcess.h"
+#include <assimp/Exceptional.h>
+#include <assimp/scene.h>
+
+using namespace Assimp;
+
+class utSplitByBoneCountProcess : public ::testing::Test {
+protected:
+    class TestProcess : public SplitByBoneCountProcess {
+    public:
+        using SplitByBoneCountProcess::Execute;
+    };
+
+    // 64 triangles with unique vertices, each vertex is fully influenced by one of 16 bones
+    static aiScene *createScene() {
+        static const unsigned int NumFaces = 64, NumBones = 16;
+        aiMesh *mesh = new aiMesh();
+        mesh->mPrimitiveTypes = aiPrimitiveType_TRIANGLE;
+        mesh->mNumVertices = NumFaces * 3;
+        mesh->mVertices = new aiVector3D[mesh->mNumVertices];
+        mesh->mNumFaces = NumFaces;
+        mesh->mFaces = new aiFace[NumFaces];
+        std::vector<std::vector<aiVertexWeight>> weights(NumBones);
+        for (unsigned int i = 0; i < NumFaces; ++i) {
+            mesh->mFaces[i].mNumIndices = 3;
+            mesh->mFaces[i].mIndices = new unsigned int[3];
+            for (unsigned int j = 0; j < 3; ++j) {
+                const unsigned int v = i * 3 + j;
+                mesh->mFaces[i].mIndices[j] = v;
+                mesh->mVertices[v] = aiVector3D((float)v, 0.f, 0.f);
+                weights[(i * 5 + j * 3) % NumBones].emplace_back(v, 1.f);
+            }
+        }
+        mesh->mNumBones = NumBones;
+        mesh->mBones = new aiBone *[NumBones];
+        for (unsigned int b = 0; b < NumBones; ++b) {
+            aiBone *bone = mesh->mBones[b] = new aiBone();
+            bone->mName.Set("bone" + std::to_string(b));
+            bone->mNumWeights = static_cast<unsigned int>(weights[b].size());
+            bone->mWeights = new aiVertexWeight[bone->mNumWeights];
+            std::copy(weights[b].begin(), weights[b].end(), bone->mWeights);
+        }
+
+        aiScene *scene = new aiScene();
+        scene->mNumMeshes = 1;
+        scene->mMeshes = new aiMesh *[1];
+        scene->mMeshes[0] = mesh;
+        scene->mRootNode = new aiNode();
+        scene->mRootNode->mNumMeshes = 1;
+        scene->mRootNode->mMeshes = new unsigned int[1]{ 0 };
+        return scene;
+    }
+
+    static void checkSplit(const aiScene *scene, size_t maxBones) {
+        unsigned int numFaces = 0;
+        for (unsigned int m = 0; m < scene->mNumMeshes; ++m) {
+            const aiMesh *mesh = scene->mMeshes[m];
+            EXPECT_LE(mesh->mNumBones, maxBones);
+            numFaces += mesh->mNumFaces;
+
+            // every vertex keeps its weight, and the bone is the one of the source vertex
+            std::vector<unsigned int> weightsPerVertex(mesh->mNumVertices, 0);
+            for (unsigned int b = 0; b < mesh->mNumBones; ++b) {
+                const aiBone *bone = mesh->mBones[b];
+                for (unsigned int w = 0; w < bone->mNumWeights; ++w) {
+                    const unsigned int v = bone->mWeights[w].mVertexId;
+                    ++weightsPerVertex[v];
+                    const unsigned int src = static_cast<unsigned int>(mesh->mVertices[v].x);
+                    EXPECT_EQ("bone" + std::to_string(((src / 3) * 5 + (src % 3) * 3) % 16), bone->mName.C_Str());
+                }
+            }
+            for (unsigned int v = 0; v < mesh->mNumVertices; ++v) {
+                EXPECT_EQ(1u, weightsPerVertex[v]);
+            }
+        }
+        EXPECT_EQ(64u, numFaces);
+        EXPECT_EQ(scene->mNumMeshes, scene->mRootNode->mNumMeshes);
+    }
+};
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(utSplitByBoneCountProcess, splitTest) {
+    std::unique_ptr<aiScene> scene(createScene());
+    TestProcess process;
+    process.mMaxBoneCount = 6;
+    process.Execute(scene.get());
+    EXPECT_LT(1u, scene->mNumMeshes);
+    checkSplit(scene.get(), 6);
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(utSplitByBoneCountProcess, splitBoneLocalityTest) {
+    std::unique_ptr<aiScene> scene(createScene());
+    TestProcess process;
+    process.mMaxBoneCount = 6;
+    process.Execute(scene.get());
+    const unsigned int numMeshes = scene->mNumMeshes;
+
+    scene.reset(createScene());
+    process.mBoneLocality = true;
+    process.Execute(scene.get());
+    EXPECT_LE(scene->mNumMeshes, numMeshes);
+    checkSplit(scene.get(), 6);
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(utSplitByBoneCountProcess, faceExceedsBoneCountTest) {
+    std::unique_ptr<aiScene> scene(createScene());
+    TestProcess process;
+    process.mMaxBoneCount = 2;
+    EXPECT_THROW(process.Execute(scene.get()), DeadlyImportError);
+}
@@ -43,6 +43,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "PostProcessing/SplitLargeMeshes.h"
 #include <assimp/scene.h>
 
+#include <random>
+
 using namespace std;
 using namespace Assimp;
 
@@ -153,3 +155,91 @@ TEST_F(SplitLargeMeshesTest, testTriangleSplit) {
     }
     EXPECT_EQ(0, iOldFaceNum);
 }
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(SplitLargeMeshesTest, testSpatialVertexSplitKeepsBones) {
+    std::vector<std::pair<aiMesh *, unsigned int>> avOut;
+
+    // a long strip of shared vertices, with the faces in random order
+    const unsigned int iColumns = 3000;
+    aiMesh *pcMesh = new aiMesh();
+    pcMesh->mNumVertices = 2 * (iColumns + 1);
+    pcMesh->mVertices = new aiVector3D[pcMesh->mNumVertices];
+    for (unsigned int i = 0; i <= iColumns; ++i) {
+        pcMesh->mVertices[2 * i] = aiVector3D((ai_real)i, 0.0, 0.0);
+        pcMesh->mVertices[2 * i + 1] = aiVector3D((ai_real)i, 1.0, 0.0);
+    }
+
+    std::vector<unsigned int> faces(2 * iColumns);
+    for (unsigned int i = 0; i < faces.size(); ++i) {
+        faces[i] = i;
+    }
+    std::shuffle(faces.begin(), faces.end(), std::mt19937(42));
+    pcMesh->mNumFaces = (unsigned int)faces.size();
+    pcMesh->mFaces = new aiFace[pcMesh->mNumFaces];
+    for (unsigned int i = 0; i < pcMesh->mNumFaces; ++i) {
+        const unsigned int c = faces[i] / 2, base = 2 * c;
+        aiFace &face = pcMesh->mFaces[i];
+        face.mNumIndices = 3;
+        face.mIndices = new unsigned int[3];
+        face.mIndices[0] = base + (faces[i] % 2);
+        face.mIndices[1] = base + 2;
+        face.mIndices[2] = (faces[i] % 2) ? base + 3 : base + 1;
+    }
+
+    // the left half of the strip is bound to the first bone, the right half to the second
+    pcMesh->mNumBones = 2;
+    pcMesh->mBones = new aiBone *[2];
+    for (unsigned int b = 0; b < 2; ++b) {
+        aiBone *bone = pcMesh->mBones[b] = new aiBone();
+        bone->mName.Set(b ? "right" : "left");
+        const unsigned int first = b ? iColumns : 0;
+        bone->mNumWeights = b ? pcMesh->mNumVertices - iColumns : iColumns;
+        bone->mWeights = new aiVertexWeight[bone->mNumWeights];
+        for (unsigned int i = 0; i < bone->mNumWeights; ++i) {
+            bone->mWeights[i] = aiVertexWeight(first + i, 1.0f);
+        }
+    }
+
+    piProcessVertex->SetSpatialSplit(true);
+    piProcessVertex->SplitMesh(0, pcMesh, avOut);
+    EXPECT_GT(avOut.size(), 6U);
+
+    unsigned int iNumFaces = 0;
+    for (auto &entry : avOut) {
+        aiMesh *mesh = entry.first;
+        EXPECT_LE(mesh->mNumVertices, 1000U);
+        iNumFaces += mesh->mNumFaces;
+
+        // each submesh covers a compact part of the strip
+        ai_real minX = 1e10f, maxX = -1e10f;
+        for (unsigned int i = 0; i < mesh->mNumFaces; ++i) {
+            ASSERT_EQ(3U, mesh->mFaces[i].mNumIndices);
+            for (unsigned int n = 0; n < 3; ++n) {
+                ASSERT_LT(mesh->mFaces[i].mIndices[n], mesh->mNumVertices);
+                const ai_real x = mesh->mVertices[mesh->mFaces[i].mIndices[n]].x;
+                minX = std::min(minX, x);
+                maxX = std::max(maxX, x);
+            }
+        }
+        EXPECT_LT(maxX - minX, (ai_real)(iColumns / 2));
+
+        // every vertex keeps exactly its own weight
+        std::vector<unsigned int> weights(mesh->mNumVertices, 0);
+        for (unsigned int b = 0; b < mesh->mNumBones; ++b) {
+            const aiBone *bone = mesh->mBones[b];
+            const bool right = bone->mName == aiString("right");
+            for (unsigned int w = 0; w < bone->mNumWeights; ++w) {
+                const unsigned int v = bone->mWeights[w].mVertexId;
+                ASSERT_LT(v, mesh->mNumVertices);
+                EXPECT_EQ(right, mesh->mVertices[v].x >= (ai_real)(iColumns / 2));
+                ++weights[v];
+            }
+        }
+        for (unsigned int w : weights) {
+            EXPECT_EQ(1U, w);
+        }
+        delete mesh;
+    }
+    EXPECT_EQ(2 * iColumns, iNumFaces);
+}
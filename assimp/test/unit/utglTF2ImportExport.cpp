@@ -40,6 +40,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 #include "AbstractImportExportBase.h"
 #include "UnitTestPCH.h"
+#include "Common/ParallelFor.h"
 
 #include <assimp/commonMetaData.h>
 #include <assimp/postprocess.h>
@@ -50,8 +51,13 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/DefaultLogger.hpp>
 
 #include <rapidjson/schema.h>
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
 
+#include <algorithm>
 #include <array>
+#include <chrono>
+#include <fstream>
 
 #include <assimp/material.h>
 #include <assimp/GltfMaterial.h>
@@ -749,6 +755,89 @@ TEST_F(utglTF2ImportExport, import_dracoEncoded) {
 #endif
 }
 
+#ifdef ASSIMP_ENABLE_DRACO
+// Decodes 1020 Draco primitives, the engine's 34 with fresh accessors 30 times over, run with --gtest_also_run_disabled_tests
+TEST_F(utglTF2ImportExport, DISABLED_dracoDecodeBenchmark) {
+    std::ifstream in(ASSIMP_TEST_MODELS_DIR "/glTF2/draco/2CylinderEngine.gltf");
+    ASSERT_TRUE(in.good());
+    const std::string json((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+    rapidjson::Document doc;
+    doc.Parse(json.c_str());
+    ASSERT_FALSE(doc.HasParseError());
+    auto &alloc = doc.GetAllocator();
+    rapidjson::Value &accessors = doc["accessors"];
+    for (auto &mesh : doc["meshes"].GetArray()) {
+        rapidjson::Value &primitives = mesh["primitives"];
+        const rapidjson::SizeType numPrimitives = primitives.Size();
+        for (unsigned int copy = 1; copy < 30; ++copy) {
+            for (rapidjson::SizeType p = 0; p < numPrimitives; ++p) {
+                rapidjson::Value prim(primitives[p], alloc);
+                auto cloneAccessor = [&](rapidjson::Value &ref) {
+                    rapidjson::Value acc(accessors[ref.GetUint()], alloc);
+                    ref.SetUint(accessors.Size());
+                    accessors.PushBack(acc, alloc);
+                };
+                rapidjson::Value &attributes = prim["attributes"];
+                for (auto attrib = attributes.MemberBegin(); attrib != attributes.MemberEnd(); ++attrib) {
+                    cloneAccessor(attrib->value);
+                }
+                cloneAccessor(prim["indices"]);
+                primitives.PushBack(prim, alloc);
+            }
+        }
+    }
+    rapidjson::StringBuffer buffer;
+    rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+    doc.Accept(writer);
+    {
+        std::ofstream out(ASSIMP_TEST_MODELS_DIR "/glTF2/draco/2CylinderEngine_benchmark_out.gltf");
+        out << buffer.GetString();
+    }
+
+    Assimp::Importer importer;
+    const auto begin = std::chrono::steady_clock::now();
+    const aiScene *scene = importer.ReadFile(ASSIMP_TEST_MODELS_DIR "/glTF2/draco/2CylinderEngine_benchmark_out.gltf", 0);
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - begin;
+    ASSERT_NE(scene, nullptr);
+    EXPECT_EQ(scene->mNumMeshes, 1020u);
+    std::cout << scene->mNumMeshes << " Draco primitives on " << GetNumWorkerThreads() << " threads: " << elapsed.count() << " s" << std::endl;
+}
+#endif
+
+TEST_F(utglTF2ImportExport, import_meshoptEncoded) {
+    // 20x20 vertex grid, exponential filtered positions, the indices once as triangle and once as index sequence stream
+    Assimp::Importer importer;
+    const aiScene *scene = importer.ReadFile(ASSIMP_TEST_MODELS_DIR "/glTF2/meshopt/MeshoptGrid.gltf", aiProcess_ValidateDataStructure);
+    ASSERT_NE(scene, nullptr);
+    ASSERT_EQ(scene->mNumMeshes, 2u);
+    for (unsigned int m = 0; m < scene->mNumMeshes; ++m) {
+        const aiMesh *mesh = scene->mMeshes[m];
+        ASSERT_EQ(mesh->mNumVertices, 400u);
+        ASSERT_EQ(mesh->mNumFaces, 722u);
+        for (unsigned int y = 0; y < 20; ++y) {
+            for (unsigned int x = 0; x < 20; ++x) {
+                const unsigned int i = y * 20 + x;
+                EXPECT_EQ(mesh->mVertices[i], aiVector3D(x * 0.25f, y * 0.25f, 0.0f));
+                EXPECT_EQ(mesh->mNormals[i], aiVector3D(0.0f, 0.0f, 1.0f));
+            }
+        }
+        for (unsigned int f = 0; f < mesh->mNumFaces; ++f) {
+            const unsigned int i = (f / 2 / 19) * 20 + (f / 2 % 19);
+            const unsigned int expected[2][3] = { { i, i + 1, i + 20 }, { i + 1, i + 21, i + 20 } };
+            const aiFace &face = mesh->mFaces[f];
+            ASSERT_EQ(face.mNumIndices, 3u);
+            // the triangle codec may rotate a triangle, the winding stays the same
+            const unsigned int *first = std::find(face.mIndices, face.mIndices + 3, expected[f % 2][0]);
+            ASSERT_NE(first, face.mIndices + 3);
+            const unsigned int offset = static_cast<unsigned int>(first - face.mIndices);
+            for (unsigned int k = 0; k < 3; ++k) {
+                EXPECT_EQ(face.mIndices[(offset + k) % 3], expected[f % 2][k]);
+            }
+        }
+    }
+}
+
 TEST_F(utglTF2ImportExport, wrongTypes) {
     // Deliberately broken version of the BoxTextured.gltf asset.
     using tup_T = std::tuple<std::string, std::string, std::string, std::string>;